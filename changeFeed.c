@@ -0,0 +1,322 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "changeFeed.h"
+#include "chessLock.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHANGE_FEED_MIN_CAPACITY 16
+#define CHANGE_FEED_MAX_CAPACITY (1 << 24)
+
+/** Type for a callback of the feed, and the sequence number of the last event before it was subscribed */
+typedef struct change_subscriber_t {
+    ChessChangeCallback callback;
+    void *context;
+    long long subscribed;
+} ChangeSubscriber;
+
+/**
+* The ring is written by the thread which changes the chess system. The events waiting for the subscribers are
+* also queued in the outbox, which the delivering thread takes as a whole, so the ring can be written over while
+* the callbacks run. The outbox, the subscribers and the delivery state are guarded by the feed's lock, which is
+* never held while a callback runs.
+*/
+struct change_feed_t {
+    ChessChangeEvent *events;
+    int capacity;
+    int batch_size;
+    long long sequence;
+    ChessChangeEvent *outbox;
+    int outbox_size;
+    int outbox_capacity;
+    bool flush_requested;
+    ChangeSubscriber *subscribers;
+    int number_of_subscribers;
+    bool delivering;
+    ChessMutex lock;
+};
+
+ChangeFeed changeFeedCreate(int capacity, int batch_size)
+{
+    ChangeFeed feed = malloc(sizeof(*feed));
+    if (feed == NULL)
+    {
+        return NULL;
+    }
+
+    feed->capacity = CHANGE_FEED_MIN_CAPACITY;
+    while (feed->capacity < capacity && feed->capacity < CHANGE_FEED_MAX_CAPACITY)
+    {
+        feed->capacity = feed->capacity * 2;
+    }
+    feed->events = malloc(sizeof(*feed->events) * feed->capacity);
+    if (feed->events == NULL || chessMutexInit(&feed->lock) == false)
+    {
+        free(feed->events);
+        free(feed);
+        return NULL;
+    }
+    feed->sequence = 0;
+    feed->outbox = NULL;
+    feed->outbox_size = 0;
+    feed->outbox_capacity = 0;
+    feed->flush_requested = false;
+    feed->subscribers = NULL;
+    feed->number_of_subscribers = 0;
+    feed->delivering = false;
+    changeFeedSetBatchSize(feed, batch_size);
+    return feed;
+}
+
+void changeFeedDestroy(ChangeFeed feed)
+{
+    if (feed == NULL)
+    {
+        return;
+    }
+    chessMutexDestroy(&feed->lock);
+    free(feed->events);
+    free(feed->outbox);
+    free(feed->subscribers);
+    free(feed);
+}
+
+void changeFeedSetBatchSize(ChangeFeed feed, int batch_size)
+{
+    if (feed == NULL)
+    {
+        return;
+    }
+    chessMutexLock(&feed->lock);
+    feed->batch_size = (batch_size < 1) ? 1 : (batch_size > feed->capacity) ? feed->capacity : batch_size;
+    chessMutexUnlock(&feed->lock);
+}
+
+/**
+*	changeFeedQueue: adds an event to the outbox of the subscribers. Must be called with the feed's lock held.
+*
+* @param feed - The feed.
+* @param event - The event.
+* @return
+* 	false - In case of memory error. The event is not queued.
+*   true - Otherwise.
+*/
+static bool changeFeedQueue(ChangeFeed feed, const ChessChangeEvent *event)
+{
+    if (feed->outbox_size == feed->outbox_capacity)
+    {
+        int new_capacity = (feed->outbox_capacity == 0) ? feed->batch_size : 2 * feed->outbox_capacity;
+        ChessChangeEvent *outbox = realloc(feed->outbox, sizeof(*outbox) * new_capacity);
+        if (outbox == NULL)
+        {
+            return false;
+        }
+        feed->outbox = outbox;
+        feed->outbox_capacity = new_capacity;
+    }
+    feed->outbox[feed->outbox_size++] = *event;
+    return true;
+}
+
+void changeFeedAppend(ChangeFeed feed, ChessChangeType type, int tournament_id, int game_id, int first_player,
+                      int second_player, int winner, int play_time)
+{
+    if (feed == NULL)
+    {
+        return;
+    }
+
+    ChessChangeEvent *event = &feed->events[feed->sequence & (feed->capacity - 1)];
+    event->sequence = feed->sequence + 1;
+    event->type = type;
+    event->tournament_id = tournament_id;
+    event->game_id = game_id;
+    event->first_player = first_player;
+    event->second_player = second_player;
+    event->winner = winner;
+    event->play_time = play_time;
+    chessMutexLock(&feed->lock);
+    feed->sequence++;
+    if (feed->number_of_subscribers > 0)
+    {
+        changeFeedQueue(feed, event);
+    }
+    chessMutexUnlock(&feed->lock);
+}
+
+bool changeFeedSubscribe(ChangeFeed feed, ChessChangeCallback callback, void *context)
+{
+    if (feed == NULL || callback == NULL)
+    {
+        return false;
+    }
+
+    chessMutexLock(&feed->lock);
+    ChangeSubscriber *subscribers = realloc(feed->subscribers,
+                                            sizeof(*subscribers) * (feed->number_of_subscribers + 1));
+    if (subscribers != NULL)
+    {
+        ChangeSubscriber subscriber = {callback, context, feed->sequence};
+        subscribers[feed->number_of_subscribers++] = subscriber;
+        feed->subscribers = subscribers;
+    }
+    chessMutexUnlock(&feed->lock);
+    return subscribers != NULL;
+}
+
+bool changeFeedUnsubscribe(ChangeFeed feed, ChessChangeCallback callback, void *context)
+{
+    if (feed == NULL || callback == NULL)
+    {
+        return false;
+    }
+
+    bool removed = false;
+    chessMutexLock(&feed->lock);
+    for (int index = 0; index < feed->number_of_subscribers && removed == false; index++)
+    {
+        if (feed->subscribers[index].callback == callback && feed->subscribers[index].context == context)
+        {
+            memmove(&feed->subscribers[index], &feed->subscribers[index + 1],
+                    sizeof(*feed->subscribers) * (feed->number_of_subscribers - index - 1));
+            feed->number_of_subscribers--;
+            removed = true;
+        }
+    }
+    chessMutexUnlock(&feed->lock);
+    return removed;
+}
+
+/**
+*	changeFeedDeliverBatch: hands a batch of events to the subscribers, each only the events recorded after it
+*                           was subscribed. Called without the feed's lock.
+*
+* @param events - The events, in the order of their sequence numbers, with no gaps.
+* @param number_of_events - The number of events.
+* @param subscribers - The subscribers at the time the batch was taken.
+* @param number_of_subscribers - The number of subscribers.
+* @return
+* 	None
+*/
+static void changeFeedDeliverBatch(const ChessChangeEvent *events, int number_of_events,
+                                   const ChangeSubscriber *subscribers, int number_of_subscribers)
+{
+    for (int index = 0; index < number_of_subscribers; index++)
+    {
+        long long skipped = subscribers[index].subscribed - events[0].sequence + 1;
+        int first = (skipped < 0) ? 0 : (skipped > number_of_events) ? number_of_events : (int) skipped;
+        if (first < number_of_events)
+        {
+            subscribers[index].callback(&events[first], number_of_events - first, subscribers[index].context);
+        }
+    }
+}
+
+/**
+*	changeFeedIsDeliveryDue: checks if the waiting events should be handed to the subscribers. Must be called with
+*                            the feed's lock held.
+*
+* @param feed - The feed.
+* @return
+* 	true - If a batch is complete, or a flush was requested and events are waiting.
+*   false - Otherwise.
+*/
+static bool changeFeedIsDeliveryDue(ChangeFeed feed)
+{
+    if (feed->outbox_size == 0)
+    {
+        feed->flush_requested = false;
+        return false;
+    }
+    return feed->flush_requested == true || feed->outbox_size >= feed->batch_size;
+}
+
+void changeFeedDeliver(ChangeFeed feed)
+{
+    if (feed == NULL)
+    {
+        return;
+    }
+
+    chessMutexLock(&feed->lock);
+    if (feed->delivering == true)
+    {
+        // The thread which is delivering hands over these events too, once its callbacks return
+        chessMutexUnlock(&feed->lock);
+        return;
+    }
+    feed->delivering = true;
+    while (changeFeedIsDeliveryDue(feed) == true)
+    {
+        ChessChangeEvent *events = feed->outbox;
+        int number_of_events = feed->outbox_size;
+        int number_of_subscribers = feed->number_of_subscribers;
+        ChangeSubscriber *subscribers = malloc(sizeof(*subscribers) * (number_of_subscribers + 1));
+        if (subscribers == NULL)
+        {
+            break;
+        }
+        memcpy(subscribers, feed->subscribers, sizeof(*subscribers) * number_of_subscribers);
+        feed->outbox = NULL;
+        feed->outbox_size = 0;
+        feed->outbox_capacity = 0;
+        chessMutexUnlock(&feed->lock);
+
+        changeFeedDeliverBatch(events, number_of_events, subscribers, number_of_subscribers);
+        free(subscribers);
+        free(events);
+        chessMutexLock(&feed->lock);
+    }
+    feed->delivering = false;
+    chessMutexUnlock(&feed->lock);
+}
+
+void changeFeedRequestFlush(ChangeFeed feed)
+{
+    if (feed == NULL)
+    {
+        return;
+    }
+    chessMutexLock(&feed->lock);
+    feed->flush_requested = true;
+    chessMutexUnlock(&feed->lock);
+}
+
+void changeFeedFlush(ChangeFeed feed)
+{
+    changeFeedRequestFlush(feed);
+    changeFeedDeliver(feed);
+}
+
+int changeFeedRead(ChangeFeed feed, long long since_sequence, ChessChangeEvent *events, int max_events)
+{
+    if (feed == NULL || events == NULL || max_events <= 0)
+    {
+        return 0;
+    }
+
+    long long oldest = feed->sequence - feed->capacity + 1;
+    long long first = (since_sequence + 1 > oldest) ? since_sequence + 1 : oldest;
+    first = (first < 1) ? 1 : first;
+    int number_of_events = 0;
+    for (long long sequence = first; sequence <= feed->sequence && number_of_events < max_events; sequence++)
+    {
+        events[number_of_events++] = feed->events[(sequence - 1) & (feed->capacity - 1)];
+    }
+    return number_of_events;
+}
+
+size_t changeFeedGetMemoryFootprint(ChangeFeed feed)
+{
+    if (feed == NULL)
+    {
+        return 0;
+    }
+    chessMutexLock(&feed->lock);
+    size_t footprint = sizeof(*feed) + sizeof(*feed->events) * feed->capacity +
+                       sizeof(*feed->outbox) * feed->outbox_capacity +
+                       sizeof(*feed->subscribers) * feed->number_of_subscribers;
+    chessMutexUnlock(&feed->lock);
+    return footprint;
+}
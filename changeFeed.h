@@ -0,0 +1,153 @@
+#ifndef CHANGE_FEED_H_
+#define CHANGE_FEED_H_
+
+#include "chessSystemExtensions.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* Change Feed
+*
+* Keeps the latest changes of the chess system as compact events in a ring buffer, each numbered by a sequence
+* number that grows by one with every event. Consumers either read the events after the last sequence number
+* they saw, or subscribe a callback which is handed the new events in batches - once a batch worth of events is
+* waiting, and when the feed is flushed. Readers that fall more than the capacity of the ring behind find a gap
+* in the sequence numbers, and subscribers never miss events, as the events waiting for them are queued apart
+* from the ring.
+*
+* Events are added while the chess system is locked, and handed to the subscribers by changeFeedDeliver once it
+* is unlocked, so callbacks may call back into the chess system. A single thread delivers at a time, and a thread
+* which finds another one delivering leaves its events to it.
+*
+* The following functions are available:
+*   changeFeedCreate	- Creates a new empty feed
+*   changeFeedDestroy	- Deletes an existing feed and frees all resources
+*   changeFeedSetBatchSize	- Sets the number of events handed to subscribers at a time
+*   changeFeedAppend	- Adds an event to the feed
+*   changeFeedSubscribe	- Adds a callback which is handed the new events
+*   changeFeedUnsubscribe	- Removes a callback
+*   changeFeedDeliver	- Hands the waiting events to the subscribers, if a batch is complete or a flush was requested
+*   changeFeedRequestFlush	- Marks all the waiting events to be handed over by the next delivery
+*   changeFeedFlush	- Hands all the waiting events to the subscribers
+*   changeFeedRead	- Copies the events which follow a sequence number
+*   changeFeedGetMemoryFootprint	- Gets the size in bytes of the feed
+*/
+
+/** Type for defining the change feed */
+typedef struct change_feed_t *ChangeFeed;
+
+/**
+* changeFeedCreate: Allocates a new empty feed.
+*
+* @param capacity - The number of events kept, rounded up to a power of two.
+* @param batch_size - The number of events handed to subscribers at a time. See changeFeedSetBatchSize.
+* @return
+* 	NULL - if allocations failed.
+* 	A new ChangeFeed in case of success.
+*/
+ChangeFeed changeFeedCreate(int capacity, int batch_size);
+
+/**
+* changeFeedDestroy: Deallocates an existing feed. Waiting events are not handed to the subscribers.
+*
+* @param feed - Target feed to be deallocated. If feed is NULL nothing will be done.
+*/
+void changeFeedDestroy(ChangeFeed feed);
+
+/**
+* changeFeedSetBatchSize: Sets the number of waiting events at which they are handed to the subscribers.
+*
+* @param feed - The feed.
+* @param batch_size - The number of events. Values below 1 are handled as 1, and values above the capacity as
+* 	the capacity.
+*/
+void changeFeedSetBatchSize(ChangeFeed feed, int batch_size);
+
+/**
+* changeFeedAppend: Adds an event to the feed, numbered by the next sequence number, and queues it for the
+* subscribers. The event is not handed to them until changeFeedDeliver is called.
+*
+* @param feed - The feed. If feed is NULL nothing will be done.
+* @param type - The type of the event.
+* @param tournament_id - The tournament of the event.
+* @param game_id - The game of the event.
+* @param first_player - The first player of the event.
+* @param second_player - The second player of the event.
+* @param winner - The winner of the event.
+* @param play_time - The play time of the event.
+*/
+void changeFeedAppend(ChangeFeed feed, ChessChangeType type, int tournament_id, int game_id, int first_player,
+                      int second_player, int winner, int play_time);
+
+/**
+* changeFeedSubscribe: Adds a callback which is handed the events added from now on.
+*
+* @param feed - The feed.
+* @param callback - The callback.
+* @param context - Passed to the callback with every batch.
+* @return
+* 	false - if a parameter is NULL or an allocation failed.
+* 	true - if the callback was added.
+*/
+bool changeFeedSubscribe(ChangeFeed feed, ChessChangeCallback callback, void *context);
+
+/**
+* changeFeedUnsubscribe: Removes a callback, without handing it the waiting events. A batch which is being handed
+* out while the callback is removed may still reach it.
+*
+* @param feed - The feed.
+* @param callback - The callback.
+* @param context - The context the callback was added with.
+* @return
+* 	false - if a parameter is NULL or the callback wasn't added with the context.
+* 	true - if the callback was removed.
+*/
+bool changeFeedUnsubscribe(ChangeFeed feed, ChessChangeCallback callback, void *context);
+
+/**
+* changeFeedDeliver: Hands the waiting events to the subscribers, if a batch worth of them is waiting or a flush
+* was requested. Must be called without holding any lock of the chess system, as the callbacks may lock it.
+*
+* @param feed - The feed. If feed is NULL nothing will be done.
+*/
+void changeFeedDeliver(ChangeFeed feed);
+
+/**
+* changeFeedRequestFlush: Marks all the waiting events to be handed to the subscribers by the next
+* changeFeedDeliver, even if a batch isn't complete.
+*
+* @param feed - The feed. If feed is NULL nothing will be done.
+*/
+void changeFeedRequestFlush(ChangeFeed feed);
+
+/**
+* changeFeedFlush: Hands all the waiting events to the subscribers. See changeFeedDeliver.
+*
+* @param feed - The feed. If feed is NULL nothing will be done.
+*/
+void changeFeedFlush(ChangeFeed feed);
+
+/**
+* changeFeedRead: Copies the events which follow a sequence number, oldest first. Events which were already
+* written over are skipped, so the first event copied follows since_sequence only if none were.
+*
+* @param feed - The feed.
+* @param since_sequence - The sequence number of the last event already read, 0 for none.
+* @param events - An array to copy the events into.
+* @param max_events - The size of the array.
+* @return
+* 	The number of events copied, 0 if feed or events are NULL.
+*/
+int changeFeedRead(ChangeFeed feed, long long since_sequence, ChessChangeEvent *events, int max_events);
+
+/**
+* changeFeedGetMemoryFootprint: Gets the size of the feed.
+*
+* @param feed - The feed.
+* @return
+* 	0 - if feed is NULL.
+* 	The size in bytes otherwise.
+*/
+size_t changeFeedGetMemoryFootprint(ChangeFeed feed);
+
+#endif /* CHANGE_FEED_H_ */
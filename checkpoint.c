@@ -0,0 +1,724 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "checkpoint.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#define CHECKPOINT_MAGIC "CHSK"
+#define CHECKPOINT_MAGIC_SIZE 4
+#define CHECKPOINT_BYTE_ORDER 0x01020304u
+#define CHECKPOINT_TEMPORARY_SUFFIX ".tmp"
+#define CHECKPOINT_BUFFER_SIZE (1 << 20)
+#define CHECKPOINT_COPY_CHUNK_SIZE (1 << 16)
+#define CHECKPOINT_INITIAL_CAPACITY 16
+#define CHECKPOINT_OWN_FILE 0
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+
+/** Type for the header of a checkpoint file */
+typedef struct checkpoint_header_t {
+    char magic[CHECKPOINT_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t reserved;
+    uint64_t content_id;
+    uint64_t file_id;
+    int64_t journal_sequence;
+    int64_t directory_offset;
+    int32_t number_of_files;
+    int32_t number_of_segments;
+} CheckpointHeader;
+
+/** Type for an entry of the files table of a checkpoint file, followed by the file's path */
+typedef struct checkpoint_file_record_t {
+    uint64_t file_id;
+    int32_t path_length;
+    int32_t reserved;
+} CheckpointFileRecord;
+
+/** Type for an entry of the directory of a checkpoint file */
+typedef struct checkpoint_entry_t {
+    int32_t key;
+    int32_t file;
+    int64_t offset;
+    int64_t size;
+} CheckpointEntry;
+
+/** Type for a file which segments of a checkpoint are read from */
+typedef struct checkpoint_file_t {
+    char *path;
+    uint64_t file_id;
+    FILE *file;
+} CheckpointFile;
+
+struct checkpoint_t {
+    CheckpointHeader header;
+    CheckpointFile *files;
+    CheckpointEntry *entries;
+};
+
+struct checkpoint_writer_t {
+    char *path;
+    char *temporary_path;
+    FILE *file;
+    Checkpoint previous;
+    CheckpointHeader header;
+    CheckpointFile *files;
+    int files_capacity;
+    CheckpointEntry *entries;
+    int entries_capacity;
+};
+
+static pthread_mutex_t checkpoint_id_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t checkpoint_id_counter = 0;
+
+/**
+*	checkpointGenerateID: generates an ID for a checkpoint, which is unique with high probability.
+*
+* @return
+* 	A non zero ID.
+*/
+static uint64_t checkpointGenerateID()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    pthread_mutex_lock(&checkpoint_id_lock);
+    uint64_t counter = ++checkpoint_id_counter;
+    pthread_mutex_unlock(&checkpoint_id_lock);
+
+    // splitmix64 finalizer over the time, the process and a per process counter
+    uint64_t id = (uint64_t) now.tv_sec * NANOSECONDS_PER_SECOND + (uint64_t) now.tv_nsec;
+    id ^= ((uint64_t) getpid() << 32) ^ (counter * 0x9E3779B97F4A7C15ULL);
+    id = (id ^ (id >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    id = (id ^ (id >> 27)) * 0x94D049BB133111EBULL;
+    id ^= id >> 31;
+    return (id != 0) ? id : 1;
+}
+
+/**
+*	copyPath: copies a path, optionally appending a suffix to it.
+*
+* @param path - The path to copy.
+* @param suffix - The suffix to append. May be NULL.
+* @return
+* 	NULL - In case of memory error.
+*   The copied path otherwise.
+*/
+static char *copyPath(const char *path, const char *suffix)
+{
+    size_t suffix_length = (suffix != NULL) ? strlen(suffix) : 0;
+    char *path_cpy = malloc(strlen(path) + suffix_length + 1);
+    if (path_cpy == NULL)
+    {
+        return NULL;
+    }
+    strcpy(path_cpy, path);
+    if (suffix != NULL)
+    {
+        strcat(path_cpy, suffix);
+    }
+    return path_cpy;
+}
+
+/**
+*	isHeaderValid: checks that a checkpoint header is of a supported checkpoint.
+*
+* @param header - The header to check.
+* @return
+* 	true - If the header is valid.
+*   false - Otherwise.
+*/
+static bool isHeaderValid(const CheckpointHeader *header)
+{
+    return memcmp(header->magic, CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_SIZE) == 0 &&
+           header->version == CHECKPOINT_VERSION && header->byte_order == CHECKPOINT_BYTE_ORDER &&
+           header->journal_sequence >= 0 && header->directory_offset > 0 && header->number_of_files > 0 &&
+           header->number_of_segments >= 0;
+}
+
+/**
+*	readFileHeader: opens a checkpoint file and reads its header.
+*
+* @param path - The path of the checkpoint file.
+* @param header - Output for the header.
+* @param result - Output for the error, if the file couldn't be opened or is not a checkpoint.
+* @return
+* 	NULL - If the file couldn't be opened or is not a checkpoint. result is set in that case.
+* 	The opened file otherwise.
+*/
+static FILE *readFileHeader(const char *path, CheckpointHeader *header, SnapshotResult *result)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        *result = SNAPSHOT_FILE_ERROR;
+        return NULL;
+    }
+    setvbuf(file, NULL, _IOFBF, CHECKPOINT_BUFFER_SIZE);
+    if (fread(header, sizeof(*header), 1, file) != 1 || isHeaderValid(header) == false)
+    {
+        fclose(file);
+        *result = SNAPSHOT_INVALID_FORMAT;
+        return NULL;
+    }
+    return file;
+}
+
+/**
+*	readDirectory: reads the files table and the directory of an opened checkpoint, and checks them.
+*
+* @param checkpoint - The checkpoint, whose own file is open and whose header was read.
+* @return
+* 	false - If the directory is not valid, or allocations failed.
+*   true - Otherwise.
+*/
+static bool readDirectory(Checkpoint checkpoint)
+{
+    const CheckpointHeader *header = &checkpoint->header;
+    FILE *file = checkpoint->files[CHECKPOINT_OWN_FILE].file;
+    if (fseeko(file, header->directory_offset, SEEK_SET) != 0)
+    {
+        return false;
+    }
+
+    for (int index = 1; index < header->number_of_files; index++)
+    {
+        CheckpointFileRecord record;
+        if (fread(&record, sizeof(record), 1, file) != 1 || record.path_length <= 0)
+        {
+            return false;
+        }
+        checkpoint->files[index].file_id = record.file_id;
+        checkpoint->files[index].path = malloc(record.path_length + 1);
+        if (checkpoint->files[index].path == NULL ||
+            fread(checkpoint->files[index].path, 1, record.path_length, file) != (size_t) record.path_length)
+        {
+            return false;
+        }
+        checkpoint->files[index].path[record.path_length] = '\0';
+    }
+
+    if (fread(checkpoint->entries, sizeof(*checkpoint->entries), header->number_of_segments, file) !=
+        (size_t) header->number_of_segments)
+    {
+        return false;
+    }
+    for (int index = 0; index < header->number_of_segments; index++)
+    {
+        const CheckpointEntry *entry = &checkpoint->entries[index];
+        if (entry->file < 0 || entry->file >= header->number_of_files || entry->offset < 0 || entry->size < 0 ||
+            (index > 0 && checkpoint->entries[index - 1].key >= entry->key))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Checkpoint checkpointOpen(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    CheckpointHeader header;
+    SnapshotResult result = SNAPSHOT_SUCCESS;
+    FILE *file = readFileHeader(path, &header, &result);
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    Checkpoint checkpoint = malloc(sizeof(*checkpoint));
+    if (checkpoint == NULL)
+    {
+        fclose(file);
+        return NULL;
+    }
+    checkpoint->header = header;
+    checkpoint->files = calloc(header.number_of_files, sizeof(*checkpoint->files));
+    checkpoint->entries = malloc(sizeof(*checkpoint->entries) * header.number_of_segments + 1);
+    if (checkpoint->files == NULL || checkpoint->entries == NULL)
+    {
+        free(checkpoint->files);
+        free(checkpoint->entries);
+        free(checkpoint);
+        fclose(file);
+        return NULL;
+    }
+    checkpoint->files[CHECKPOINT_OWN_FILE].file = file;
+    checkpoint->files[CHECKPOINT_OWN_FILE].file_id = header.file_id;
+    checkpoint->files[CHECKPOINT_OWN_FILE].path = copyPath(path, NULL);
+    if (checkpoint->files[CHECKPOINT_OWN_FILE].path == NULL || readDirectory(checkpoint) == false)
+    {
+        checkpointClose(checkpoint);
+        return NULL;
+    }
+    return checkpoint;
+}
+
+void checkpointClose(Checkpoint checkpoint)
+{
+    if (checkpoint == NULL)
+    {
+        return;
+    }
+    for (int index = 0; index < checkpoint->header.number_of_files; index++)
+    {
+        if (checkpoint->files[index].file != NULL)
+        {
+            fclose(checkpoint->files[index].file);
+        }
+        free(checkpoint->files[index].path);
+    }
+    free(checkpoint->files);
+    free(checkpoint->entries);
+    free(checkpoint);
+}
+
+unsigned long long checkpointGetID(Checkpoint checkpoint)
+{
+    return (checkpoint != NULL) ? checkpoint->header.content_id : 0;
+}
+
+long long checkpointGetJournalSequence(Checkpoint checkpoint)
+{
+    return (checkpoint != NULL) ? checkpoint->header.journal_sequence : 0;
+}
+
+int checkpointGetNumberOfSegments(Checkpoint checkpoint)
+{
+    return (checkpoint != NULL) ? checkpoint->header.number_of_segments : 0;
+}
+
+int checkpointGetNumberOfFiles(Checkpoint checkpoint)
+{
+    return (checkpoint != NULL) ? checkpoint->header.number_of_files : 0;
+}
+
+int checkpointGetSegmentKey(Checkpoint checkpoint, int index)
+{
+    return checkpoint->entries[index].key;
+}
+
+/**
+*	checkpointGetSegmentFile: gets the open file which holds a segment of a checkpoint, opening it on first use.
+*
+* @param checkpoint - The checkpoint.
+* @param entry - The directory entry of the segment.
+* @param result - Output for the error, if the file couldn't be opened or is not the linked file.
+* @return
+* 	NULL - If the file couldn't be opened, or is not the file the checkpoint linked. result is set in that case.
+* 	The file, positioned at the segment, otherwise.
+*/
+static FILE *checkpointGetSegmentFile(Checkpoint checkpoint, const CheckpointEntry *entry, SnapshotResult *result)
+{
+    CheckpointFile *segment_file = &checkpoint->files[entry->file];
+    if (segment_file->file == NULL)
+    {
+        CheckpointHeader header;
+        segment_file->file = readFileHeader(segment_file->path, &header, result);
+        if (segment_file->file == NULL)
+        {
+            return NULL;
+        }
+        if (header.file_id != segment_file->file_id)
+        {
+            fclose(segment_file->file);
+            segment_file->file = NULL;
+            *result = SNAPSHOT_INVALID_FORMAT;
+            return NULL;
+        }
+    }
+    if (fseeko(segment_file->file, entry->offset, SEEK_SET) != 0)
+    {
+        *result = SNAPSHOT_INVALID_FORMAT;
+        return NULL;
+    }
+    return segment_file->file;
+}
+
+SnapshotResult checkpointReadSegment(Checkpoint checkpoint, int index, Snapshot *segment)
+{
+    if (checkpoint == NULL || segment == NULL || index < 0 || index >= checkpoint->header.number_of_segments)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    memset(segment, 0, sizeof(*segment));
+
+    const CheckpointEntry *entry = &checkpoint->entries[index];
+    SnapshotResult result = SNAPSHOT_SUCCESS;
+    FILE *file = checkpointGetSegmentFile(checkpoint, entry, &result);
+    if (file == NULL)
+    {
+        return result;
+    }
+    result = snapshotReadSections(file, segment);
+    if (result == SNAPSHOT_SUCCESS && ftello(file) != entry->offset + entry->size)
+    {
+        snapshotClear(segment);
+        result = SNAPSHOT_INVALID_FORMAT;
+    }
+    return result;
+}
+
+CheckpointWriter checkpointWriterCreate(const char *path, Checkpoint previous, long long journal_sequence)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    CheckpointWriter writer = calloc(1, sizeof(*writer));
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+    writer->previous = previous;
+    writer->path = copyPath(path, NULL);
+    writer->temporary_path = copyPath(path, CHECKPOINT_TEMPORARY_SUFFIX);
+    writer->files = calloc(CHECKPOINT_INITIAL_CAPACITY, sizeof(*writer->files));
+    writer->entries = malloc(sizeof(*writer->entries) * CHECKPOINT_INITIAL_CAPACITY);
+    if (writer->path == NULL || writer->temporary_path == NULL || writer->files == NULL || writer->entries == NULL)
+    {
+        checkpointWriterAbort(writer);
+        return NULL;
+    }
+    writer->files_capacity = CHECKPOINT_INITIAL_CAPACITY;
+    writer->entries_capacity = CHECKPOINT_INITIAL_CAPACITY;
+
+    CheckpointHeader header = {CHECKPOINT_MAGIC, CHECKPOINT_VERSION, CHECKPOINT_BYTE_ORDER, 0,
+                               checkpointGenerateID(), checkpointGenerateID(), journal_sequence, 0, 1, 0};
+    writer->header = header;
+    writer->files[CHECKPOINT_OWN_FILE].file_id = header.file_id;
+
+    writer->file = fopen(writer->temporary_path, "wb");
+    if (writer->file == NULL)
+    {
+        checkpointWriterAbort(writer);
+        return NULL;
+    }
+    setvbuf(writer->file, NULL, _IOFBF, CHECKPOINT_BUFFER_SIZE);
+    if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1)
+    {
+        checkpointWriterAbort(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+/**
+*	writerAddEntry: adds an entry to the directory of a new checkpoint.
+*
+* @param writer - The new checkpoint.
+* @param entry - The entry to add.
+* @return
+* 	false - If the entry's key is out of order, or allocations failed.
+*   true - Otherwise.
+*/
+static bool writerAddEntry(CheckpointWriter writer, const CheckpointEntry *entry)
+{
+    int number_of_entries = writer->header.number_of_segments;
+    if (number_of_entries > 0 && writer->entries[number_of_entries - 1].key >= entry->key)
+    {
+        return false;
+    }
+    if (number_of_entries == writer->entries_capacity)
+    {
+        CheckpointEntry *entries = realloc(writer->entries, sizeof(*entries) * writer->entries_capacity * 2);
+        if (entries == NULL)
+        {
+            return false;
+        }
+        writer->entries = entries;
+        writer->entries_capacity *= 2;
+    }
+    writer->entries[writer->header.number_of_segments++] = *entry;
+    return true;
+}
+
+/**
+*	writerFindFile: finds a linked file in the files table of a new checkpoint, adding it if it's missing.
+*
+* @param writer - The new checkpoint.
+* @param linked_file - The linked file.
+* @return
+* 	-1 - If the linked file is in the new checkpoint's path, or in case of memory error.
+*   The index of the file in the files table otherwise.
+*/
+static int writerFindFile(CheckpointWriter writer, const CheckpointFile *linked_file)
+{
+    // The new checkpoint replaces the file in its path, so it can't link to that file
+    if (strcmp(linked_file->path, writer->path) == 0)
+    {
+        return -1;
+    }
+    int number_of_files = writer->header.number_of_files;
+    for (int index = 1; index < number_of_files; index++)
+    {
+        if (writer->files[index].file_id == linked_file->file_id)
+        {
+            return index;
+        }
+    }
+
+    if (number_of_files == writer->files_capacity)
+    {
+        CheckpointFile *files = realloc(writer->files, sizeof(*files) * writer->files_capacity * 2);
+        if (files == NULL)
+        {
+            return -1;
+        }
+        writer->files = files;
+        writer->files_capacity *= 2;
+    }
+    writer->files[number_of_files].file = NULL;
+    writer->files[number_of_files].file_id = linked_file->file_id;
+    writer->files[number_of_files].path = copyPath(linked_file->path, NULL);
+    if (writer->files[number_of_files].path == NULL)
+    {
+        return -1;
+    }
+    return writer->header.number_of_files++;
+}
+
+bool checkpointWriteSegment(CheckpointWriter writer, int key, const Snapshot *segment)
+{
+    if (writer == NULL || segment == NULL)
+    {
+        return false;
+    }
+
+    CheckpointEntry entry = {key, CHECKPOINT_OWN_FILE, ftello(writer->file), 0};
+    if (entry.offset < 0 || snapshotWriteSections(writer->file, segment) == false)
+    {
+        return false;
+    }
+    entry.size = ftello(writer->file) - entry.offset;
+    return writerAddEntry(writer, &entry);
+}
+
+/**
+*	findSegment: finds the directory entry of a segment of a checkpoint.
+*
+* @param checkpoint - The checkpoint.
+* @param key - The key of the segment.
+* @return
+* 	NULL - If the checkpoint has no segment with the key.
+*   The entry of the segment otherwise.
+*/
+static const CheckpointEntry *findSegment(Checkpoint checkpoint, int key)
+{
+    const CheckpointEntry *low = checkpoint->entries;
+    const CheckpointEntry *high = checkpoint->entries + checkpoint->header.number_of_segments;
+    while (low < high)
+    {
+        const CheckpointEntry *middle = low + (high - low) / 2;
+        if (middle->key < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return (low < checkpoint->entries + checkpoint->header.number_of_segments && low->key == key) ? low : NULL;
+}
+
+bool checkpointLinkSegment(CheckpointWriter writer, int key)
+{
+    if (writer == NULL || writer->previous == NULL)
+    {
+        return false;
+    }
+
+    const CheckpointEntry *previous_entry = findSegment(writer->previous, key);
+    if (previous_entry == NULL)
+    {
+        return false;
+    }
+    int file = writerFindFile(writer, &writer->previous->files[previous_entry->file]);
+    if (file < 0)
+    {
+        return false;
+    }
+    CheckpointEntry entry = {key, file, previous_entry->offset, previous_entry->size};
+    return writerAddEntry(writer, &entry);
+}
+
+unsigned long long checkpointWriterGetID(CheckpointWriter writer)
+{
+    return (writer != NULL) ? writer->header.content_id : 0;
+}
+
+int checkpointWriterGetNumberOfFiles(CheckpointWriter writer)
+{
+    return (writer != NULL) ? writer->header.number_of_files : 0;
+}
+
+/**
+*	writerWriteDirectory: writes the files table and the directory of a new checkpoint at its end, and
+*                         rewrites its header.
+*
+* @param writer - The new checkpoint.
+* @return
+* 	false - If writing failed.
+*   true - Otherwise.
+*/
+static bool writerWriteDirectory(CheckpointWriter writer)
+{
+    writer->header.directory_offset = ftello(writer->file);
+    if (writer->header.directory_offset < 0)
+    {
+        return false;
+    }
+    for (int index = 1; index < writer->header.number_of_files; index++)
+    {
+        CheckpointFileRecord record = {writer->files[index].file_id, (int32_t) strlen(writer->files[index].path), 0};
+        if (fwrite(&record, sizeof(record), 1, writer->file) != 1 ||
+            fwrite(writer->files[index].path, 1, record.path_length, writer->file) != (size_t) record.path_length)
+        {
+            return false;
+        }
+    }
+    int number_of_entries = writer->header.number_of_segments;
+    return fwrite(writer->entries, sizeof(*writer->entries), number_of_entries, writer->file) ==
+           (size_t) number_of_entries &&
+           fseeko(writer->file, 0, SEEK_SET) == 0 &&
+           fwrite(&writer->header, sizeof(writer->header), 1, writer->file) == 1;
+}
+
+bool checkpointWriterCommit(CheckpointWriter writer)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+
+    bool written = writerWriteDirectory(writer);
+    written = (fclose(writer->file) == 0) && written;
+    writer->file = NULL;
+    written = written && rename(writer->temporary_path, writer->path) == 0;
+    checkpointWriterAbort(writer);
+    return written;
+}
+
+void checkpointWriterAbort(CheckpointWriter writer)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+    if (writer->file != NULL)
+    {
+        fclose(writer->file);
+    }
+    if (writer->temporary_path != NULL)
+    {
+        remove(writer->temporary_path);
+    }
+    if (writer->files != NULL)
+    {
+        for (int index = 1; index < writer->header.number_of_files; index++)
+        {
+            free(writer->files[index].path);
+        }
+    }
+    free(writer->files);
+    free(writer->entries);
+    free(writer->path);
+    free(writer->temporary_path);
+    free(writer);
+}
+
+/**
+*	copySegment: copies the bytes of a segment of a checkpoint into a new checkpoint, as a segment of its own file.
+*
+* @param writer - The new checkpoint.
+* @param checkpoint - The checkpoint to copy from.
+* @param index - The index of the segment in the checkpoint.
+* @param buffer - A buffer of CHECKPOINT_COPY_CHUNK_SIZE bytes.
+* @return
+* 	See checkpointCompact.
+*/
+static SnapshotResult copySegment(CheckpointWriter writer, Checkpoint checkpoint, int index, char *buffer)
+{
+    const CheckpointEntry *entry = &checkpoint->entries[index];
+    SnapshotResult result = SNAPSHOT_SUCCESS;
+    FILE *file = checkpointGetSegmentFile(checkpoint, entry, &result);
+    if (file == NULL)
+    {
+        return result;
+    }
+
+    CheckpointEntry new_entry = {entry->key, CHECKPOINT_OWN_FILE, ftello(writer->file), entry->size};
+    if (new_entry.offset < 0)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    for (int64_t remaining = entry->size; remaining > 0;)
+    {
+        size_t chunk = (remaining < CHECKPOINT_COPY_CHUNK_SIZE) ? (size_t) remaining : CHECKPOINT_COPY_CHUNK_SIZE;
+        if (fread(buffer, 1, chunk, file) != chunk)
+        {
+            return SNAPSHOT_INVALID_FORMAT;
+        }
+        if (fwrite(buffer, 1, chunk, writer->file) != chunk)
+        {
+            return SNAPSHOT_FILE_ERROR;
+        }
+        remaining -= chunk;
+    }
+    return (writerAddEntry(writer, &new_entry) == true) ? SNAPSHOT_SUCCESS : SNAPSHOT_OUT_OF_MEMORY;
+}
+
+SnapshotResult checkpointCompact(const char *path, const char *compacted_path)
+{
+    if (path == NULL || compacted_path == NULL || strcmp(path, compacted_path) == 0)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+
+    CheckpointHeader header;
+    SnapshotResult result = SNAPSHOT_SUCCESS;
+    FILE *file = readFileHeader(path, &header, &result);
+    if (file == NULL)
+    {
+        return result;
+    }
+    fclose(file);
+
+    Checkpoint checkpoint = checkpointOpen(path);
+    CheckpointWriter writer = (checkpoint != NULL) ?
+                              checkpointWriterCreate(compacted_path, NULL, checkpoint->header.journal_sequence) : NULL;
+    char *buffer = malloc(CHECKPOINT_COPY_CHUNK_SIZE);
+    if (checkpoint == NULL || writer == NULL || buffer == NULL)
+    {
+        result = (checkpoint == NULL) ? SNAPSHOT_INVALID_FORMAT : SNAPSHOT_OUT_OF_MEMORY;
+        free(buffer);
+        checkpointWriterAbort(writer);
+        checkpointClose(checkpoint);
+        return result;
+    }
+    writer->header.content_id = checkpoint->header.content_id;
+
+    for (int index = 0; index < checkpoint->header.number_of_segments && result == SNAPSHOT_SUCCESS; index++)
+    {
+        result = copySegment(writer, checkpoint, index, buffer);
+    }
+    free(buffer);
+    checkpointClose(checkpoint);
+    if (result != SNAPSHOT_SUCCESS)
+    {
+        checkpointWriterAbort(writer);
+        return result;
+    }
+    return (checkpointWriterCommit(writer) == true) ? SNAPSHOT_SUCCESS : SNAPSHOT_FILE_ERROR;
+}
@@ -0,0 +1,228 @@
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <stdbool.h>
+#include "snapshot.h"
+
+/**
+* Chess System Checkpoint File
+*
+* A checkpoint stores a chess system as independent segments - one per tournament, and one for the players of
+* the whole system - each holding the sections of a snapshot (see snapshot.h). A segment that didn't change since
+* the previous checkpoint is not written again: the checkpoint's directory links it to the file of an earlier
+* checkpoint which holds it. The file is laid out as follows:
+*   header      - Versioned, with the checkpoint's IDs, its journal sequence, and the position of the directory.
+*   segments    - The segments written into this checkpoint.
+*   files       - The earlier checkpoint files which linked segments are read from.
+*   directory   - One entry per segment, sorted by key: the file holding it, its offset and its size.
+*
+* Every checkpoint file has a unique file ID, and the files table records the ID each linked file had, so a
+* file that was replaced since is detected instead of being misread. Checkpoint files are never modified once
+* written, and a file must be kept while later checkpoints link to it. checkpointCompact copies a checkpoint
+* with all of its segments into a single file, which bounds the number of files a restore reads. It only reads
+* existing files, so it may run in the background while new checkpoints are written.
+*
+* The following functions are available:
+*   checkpointWriterCreate	- Starts writing a new checkpoint
+*   checkpointWriteSegment	- Writes a segment into a new checkpoint
+*   checkpointLinkSegment	- Links a segment of the previous checkpoint into a new checkpoint
+*   checkpointWriterGetID	- Gets the content ID of a new checkpoint
+*   checkpointWriterGetNumberOfFiles	- Gets the number of files a new checkpoint's segments are read from
+*   checkpointWriterCommit	- Completes a new checkpoint
+*   checkpointWriterAbort	- Discards a new checkpoint
+*   checkpointOpen			- Opens a checkpoint for reading
+*   checkpointClose			- Closes a checkpoint
+*   checkpointGetID			- Gets the content ID of a checkpoint
+*   checkpointGetJournalSequence	- Gets the journal sequence of a checkpoint
+*   checkpointGetNumberOfSegments	- Gets the number of segments of a checkpoint
+*   checkpointGetNumberOfFiles	- Gets the number of files a checkpoint's segments are read from
+*   checkpointGetSegmentKey	- Gets the key of a segment of a checkpoint
+*   checkpointReadSegment	- Reads a segment of a checkpoint
+*   checkpointCompact		- Copies a checkpoint and all of its linked segments into a single file
+*/
+
+#define CHECKPOINT_VERSION 1
+/** The key of the segment of the system's players. Tournament segments are keyed by tournament ID. */
+#define CHECKPOINT_PLAYERS_SEGMENT 0
+
+/** Type for defining a checkpoint which is being written */
+typedef struct checkpoint_writer_t *CheckpointWriter;
+
+/** Type for defining a checkpoint opened for reading */
+typedef struct checkpoint_t *Checkpoint;
+
+/**
+* checkpointWriterCreate: Starts writing a new checkpoint. The checkpoint is written to a temporary file,
+* 	which replaces the file in the given path once it is committed.
+*
+* @param path - The path of the new checkpoint file.
+* @param previous - The checkpoint which segments may be linked from. May be NULL. Must stay open until the
+* 	new checkpoint is committed or aborted.
+* @param journal_sequence - The sequence number of the last journal record the checkpoint includes.
+* @return
+* 	NULL - if the file couldn't be created, or allocations failed.
+* 	A new CheckpointWriter in case of success.
+*/
+CheckpointWriter checkpointWriterCreate(const char *path, Checkpoint previous, long long journal_sequence);
+
+/**
+* checkpointWriteSegment: Writes a segment into the new checkpoint. Segments must be added in increasing key order.
+*
+* @param writer - The new checkpoint.
+* @param key - The key of the segment.
+* @param segment - The sections of the segment.
+* @return
+* 	false - if the key is out of order, or writing failed.
+* 	true - otherwise.
+*/
+bool checkpointWriteSegment(CheckpointWriter writer, int key, const Snapshot *segment);
+
+/**
+* checkpointLinkSegment: Adds a segment of the previous checkpoint to the new checkpoint, without copying it.
+* 	Segments must be added in increasing key order.
+*
+* @param writer - The new checkpoint.
+* @param key - The key of the segment.
+* @return
+* 	false - if there is no previous checkpoint, it has no segment with the key, the segment is held by the
+* 	        file the new checkpoint replaces, the key is out of order, or allocations failed.
+* 	true - otherwise.
+*/
+bool checkpointLinkSegment(CheckpointWriter writer, int key);
+
+/**
+* checkpointWriterGetID: Gets the content ID of the new checkpoint, which its compacted copies keep.
+*
+* @param writer - The new checkpoint.
+* @return
+* 	0 - if writer is NULL.
+* 	The content ID otherwise.
+*/
+unsigned long long checkpointWriterGetID(CheckpointWriter writer);
+
+/**
+* checkpointWriterGetNumberOfFiles: Gets the number of files the new checkpoint's segments are read from so far,
+* 	including its own file.
+*
+* @param writer - The new checkpoint.
+* @return
+* 	0 - if writer is NULL.
+* 	The number of files otherwise.
+*/
+int checkpointWriterGetNumberOfFiles(CheckpointWriter writer);
+
+/**
+* checkpointWriterCommit: Writes the directory of the new checkpoint, moves it to its path, and deallocates
+* 	the writer.
+*
+* @param writer - The new checkpoint.
+* @return
+* 	false - if the checkpoint couldn't be written. The file in the path is left unchanged in that case.
+* 	true - otherwise.
+*/
+bool checkpointWriterCommit(CheckpointWriter writer);
+
+/**
+* checkpointWriterAbort: Discards the new checkpoint and deallocates the writer.
+*
+* @param writer - The new checkpoint. If writer is NULL nothing will be done.
+*/
+void checkpointWriterAbort(CheckpointWriter writer);
+
+/**
+* checkpointOpen: Opens the checkpoint in the given path, and reads its directory.
+*
+* @param path - The path of the checkpoint file.
+* @return
+* 	NULL - if the file couldn't be opened, is not a supported checkpoint, or allocations failed.
+* 	A new Checkpoint in case of success.
+*/
+Checkpoint checkpointOpen(const char *path);
+
+/**
+* checkpointClose: Closes the checkpoint and the files of its linked segments.
+*
+* @param checkpoint - Target checkpoint to be closed. If checkpoint is NULL nothing will be done.
+*/
+void checkpointClose(Checkpoint checkpoint);
+
+/**
+* checkpointGetID: Gets the content ID of the checkpoint.
+*
+* @param checkpoint - The checkpoint.
+* @return
+* 	0 - if checkpoint is NULL.
+* 	The content ID otherwise.
+*/
+unsigned long long checkpointGetID(Checkpoint checkpoint);
+
+/**
+* checkpointGetJournalSequence: Gets the sequence number of the last journal record the checkpoint includes.
+*
+* @param checkpoint - The checkpoint.
+* @return
+* 	0 - if checkpoint is NULL.
+* 	The journal sequence otherwise.
+*/
+long long checkpointGetJournalSequence(Checkpoint checkpoint);
+
+/**
+* checkpointGetNumberOfSegments: Gets the number of segments of the checkpoint.
+*
+* @param checkpoint - The checkpoint.
+* @return
+* 	0 - if checkpoint is NULL.
+* 	The number of segments otherwise.
+*/
+int checkpointGetNumberOfSegments(Checkpoint checkpoint);
+
+/**
+* checkpointGetNumberOfFiles: Gets the number of files the checkpoint's segments are read from, including
+* 	the checkpoint's own file.
+*
+* @param checkpoint - The checkpoint.
+* @return
+* 	0 - if checkpoint is NULL.
+* 	The number of files otherwise.
+*/
+int checkpointGetNumberOfFiles(Checkpoint checkpoint);
+
+/**
+* checkpointGetSegmentKey: Gets the key of a segment of the checkpoint. Segments are sorted by key.
+*
+* @param checkpoint - The checkpoint.
+* @param index - The index of the segment, between 0 and the number of segments.
+* @return
+* 	The key of the segment.
+*/
+int checkpointGetSegmentKey(Checkpoint checkpoint, int index);
+
+/**
+* checkpointReadSegment: Reads a segment of the checkpoint, from the file which holds it.
+*
+* @param checkpoint - The checkpoint.
+* @param index - The index of the segment, between 0 and the number of segments.
+* @param segment - The sections to fill. They must be freed with snapshotClear.
+* @return
+* 	SNAPSHOT_FILE_ERROR - if the file which holds the segment couldn't be opened.
+* 	SNAPSHOT_INVALID_FORMAT - if that file is not the one the checkpoint linked, or the segment is corrupted.
+* 	SNAPSHOT_OUT_OF_MEMORY - if an allocation failed.
+* 	SNAPSHOT_SUCCESS - if the segment was read.
+*/
+SnapshotResult checkpointReadSegment(Checkpoint checkpoint, int index, Snapshot *segment);
+
+/**
+* checkpointCompact: Copies the checkpoint in the given path, with all of its linked segments, into a single
+* 	checkpoint file which links no other file. The copy keeps the checkpoint's content ID and journal sequence.
+*
+* @param path - The path of the checkpoint to compact.
+* @param compacted_path - The path of the compacted checkpoint. Must be different from path.
+* @return
+* 	SNAPSHOT_FILE_ERROR - if a file couldn't be opened or written.
+* 	SNAPSHOT_INVALID_FORMAT - if the checkpoint or a file it links is not valid.
+* 	SNAPSHOT_OUT_OF_MEMORY - if an allocation failed.
+* 	SNAPSHOT_SUCCESS - if the checkpoint was compacted.
+*/
+SnapshotResult checkpointCompact(const char *path, const char *compacted_path);
+
+#endif /* CHECKPOINT_H_ */
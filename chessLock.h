@@ -0,0 +1,93 @@
+#ifndef CHESS_LOCK_H_
+#define CHESS_LOCK_H_
+
+#include <stdbool.h>
+
+/**
+* Chess Lock
+*
+* The locks of the thread safe build of the chess system, which is compiled with CHESS_THREAD_SAFE defined.
+* Without it the locks are empty and every operation on them does nothing, so the single threaded build pays
+* nothing for them.
+*
+* The locks are always taken in the same order, so no two threads can wait for each other:
+*   1. The chess system's lock - shared by chessAddGame, exclusive for every other function.
+*   2. The lock of the tournaments map, held only while a tournament is looked up.
+*   3. The lock of a tournament.
+*   4. The locks of the players' directory stripes, in the order of the stripes.
+*   5. The lock of the players maps, held only while a player is looked up or added.
+*   6. The lock of the chess system's counters, archive, change feed and journal.
+*
+* Values which threads read without holding a lock are accessed through the atomic macros, which are plain
+* reads and writes in the single threaded build.
+*
+* The following macros are available:
+*   chessMutexInit	- Initializes a mutex, evaluating to true on success
+*   chessMutexDestroy	- Destroys a mutex
+*   chessMutexLock	- Locks a mutex
+*   chessMutexUnlock	- Unlocks a mutex
+*   chessRwLockInit	- Initializes a reader-writer lock, evaluating to true on success
+*   chessRwLockDestroy	- Destroys a reader-writer lock
+*   chessRwLockShared	- Locks a reader-writer lock for sharing
+*   chessRwLockExclusive	- Locks a reader-writer lock exclusively
+*   chessRwLockUnlock	- Unlocks a reader-writer lock
+*   chessAtomicLoad	- Reads a value written by another thread, acquiring what was written before it
+*   chessAtomicStore	- Writes a value for other threads, releasing what was written before it
+*   chessAtomicStoreRelaxed	- Writes a value for other threads, with no ordering
+*   chessAtomicAdd	- Adds to a value, fully ordered, evaluating to the new value
+*   chessAtomicLoadOrdered	- Reads a value, fully ordered with chessAtomicAdd
+*   chessYield	- Lets other threads run while waiting for them
+*/
+
+#ifdef CHESS_THREAD_SAFE
+
+#include <pthread.h>
+#include <sched.h>
+
+/** Type for a lock held by a single thread at a time */
+typedef pthread_mutex_t ChessMutex;
+/** Type for a lock held by many threads at a time for sharing, or by a single thread exclusively */
+typedef pthread_rwlock_t ChessRwLock;
+
+#define chessMutexInit(mutex) (pthread_mutex_init((mutex), NULL) == 0)
+#define chessMutexDestroy(mutex) pthread_mutex_destroy(mutex)
+#define chessMutexLock(mutex) pthread_mutex_lock(mutex)
+#define chessMutexUnlock(mutex) pthread_mutex_unlock(mutex)
+#define chessRwLockInit(lock) (pthread_rwlock_init((lock), NULL) == 0)
+#define chessRwLockDestroy(lock) pthread_rwlock_destroy(lock)
+#define chessRwLockShared(lock) pthread_rwlock_rdlock(lock)
+#define chessRwLockExclusive(lock) pthread_rwlock_wrlock(lock)
+#define chessRwLockUnlock(lock) pthread_rwlock_unlock(lock)
+
+#define chessAtomicLoad(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define chessAtomicStore(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#define chessAtomicStoreRelaxed(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELAXED)
+#define chessAtomicAdd(pointer, value) __atomic_add_fetch((pointer), (value), __ATOMIC_SEQ_CST)
+#define chessAtomicLoadOrdered(pointer) __atomic_load_n((pointer), __ATOMIC_SEQ_CST)
+#define chessYield() sched_yield()
+
+#else
+
+typedef char ChessMutex;
+typedef char ChessRwLock;
+
+#define chessMutexInit(mutex) ((void) (mutex), true)
+#define chessMutexDestroy(mutex) ((void) (mutex))
+#define chessMutexLock(mutex) ((void) (mutex))
+#define chessMutexUnlock(mutex) ((void) (mutex))
+#define chessRwLockInit(lock) ((void) (lock), true)
+#define chessRwLockDestroy(lock) ((void) (lock))
+#define chessRwLockShared(lock) ((void) (lock))
+#define chessRwLockExclusive(lock) ((void) (lock))
+#define chessRwLockUnlock(lock) ((void) (lock))
+
+#define chessAtomicLoad(pointer) (*(pointer))
+#define chessAtomicStore(pointer, value) (*(pointer) = (value))
+#define chessAtomicStoreRelaxed(pointer, value) (*(pointer) = (value))
+#define chessAtomicAdd(pointer, value) (*(pointer) += (value))
+#define chessAtomicLoadOrdered(pointer) (*(pointer))
+#define chessYield() ((void) 0)
+
+#endif /* CHESS_THREAD_SAFE */
+
+#endif /* CHESS_LOCK_H_ */
@@ -1,934 +1,6098 @@
-#include "chessSystem.h"
-#include "tournament.h"
-#include "game.h"
-#include "map.h"
-#include "player.h"
-#include <stdlib.h>
-#include <stdio.h>
-
-#define NUMBER_OF_PLAYERS_IN_GAME 2
-
-/** Type for representing a chess system that organizes chess tournaments */
-struct chess_system_t
-{
-    Map tournaments;
-    Map players;
-};
-
-ChessSystem chessCreate()
-{
-    ChessSystem chess = malloc(sizeof(*chess));
-    if (chess == NULL)
-    {
-        return CHESS_OUT_OF_MEMORY;
-    }
-
-    chess->tournaments = tournamentMapFactory();
-    if (chess->tournaments == NULL)
-    {
-        free(chess);
-        return CHESS_OUT_OF_MEMORY;
-    }
-
-    chess->players = playerMapFactory();
-    if (chess->players == NULL)
-    {
-        mapDestroy(chess->tournaments);
-        free(chess);
-        return CHESS_OUT_OF_MEMORY;
-    }
-    return chess;
-}
-
-void chessDestroy(ChessSystem chess)
-{
-    if (chess == NULL)
-    {
-        return;
-    }
-
-    mapDestroy(chess->tournaments);
-    mapDestroy(chess->players);
-    free(chess);
-}
-
-/**
-*	isValidID: check validity of a given ID.
-*
-* @param id - The ID to check validity.
-*
-* @return
-* 	true - If ID is valid.
-*   false - If ID is not valid.
-*/
-static bool isValidID(int id)
-{
-    return (id > 0);
-}
-
-/**
-*	isMaxGamesPerPlayerValid: check validity of max games per player for a tournament.
-*
-* @param max - Max games value to which check validity.
-*
-* @return
-* 	true - If value is valid.
-*   false - If value is not valid.
-*/
-static bool isMaxGamesPerPlayerValid(int max)
-{
-    return (max > 0);
-}
-
-/**
-*	isPlayTimeValid: check validity of given play time.
-*
-* @param time - The play time to which check validity.
-*
-* @return
-* 	true - If time is valid.
-*   false - If time is not valid.
-*/
-static bool isPlayTimeValid(int time)
-{
-    return (time >= 0);
-}
-
-/**
-*	isLocationValid: check validity of a given location.
-*
-* @param str - The location string to which check validity.
-*
-* @return
-* 	true - If location is valid.
-*   false - If location is not valid.
-*/
-static bool isLocationValid(const char *str)
-{
-    if (*str < 'A' || *str > 'Z')
-    {
-        return false;
-    }
-
-    while (*(++str) != '\0')
-    {
-        if (*str != ' ' && (*str < 'a' || *str > 'z'))
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-/**
-*	chessOutOfMemoryDestroy: destroying a given chess system and returning a memory error.
-*
-* @param chess - The chess system which to destroy.
-*
-* @return
-* 	CHESS_OUT_OF_MEMORY - Memory error.
-*/
-static ChessResult chessOutOfMemoryDestroy(ChessSystem chess)
-{
-    chessDestroy(chess);
-    return CHESS_OUT_OF_MEMORY;
-}
-
-/**
-*	chessAddTournamentErrorCheck: checks errors for chessAddTournament function and returns
-*                                 relevant error value.
-*
-* @param chess - See chessSystem.h
-*
-* @return
-*   See chessSystem.h
-*/
-static ChessResult chessAddTournamentErrorCheck(ChessSystem chess, int tournament_id, 
-                                      int max_games_per_player, const char *tournament_location)
-{
-    if (chess == NULL || tournament_location == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isValidID(tournament_id) == false)
-    {
-        return CHESS_INVALID_ID;
-    }
-
-    if (mapContains(chess->tournaments, &tournament_id) == true)
-    {
-        return CHESS_TOURNAMENT_ALREADY_EXISTS;
-    }
-
-    if (isLocationValid(tournament_location) == false)
-    {
-        return CHESS_INVALID_LOCATION;
-    }
-
-    if (isMaxGamesPerPlayerValid(max_games_per_player) == false)
-    {
-        return CHESS_INVALID_MAX_GAMES;
-    } 
-    return CHESS_SUCCESS;
-}
-
-ChessResult chessAddTournament(ChessSystem chess, int tournament_id,
-                               int max_games_per_player, const char *tournament_location)
-{
-    ChessResult error_type = chessAddTournamentErrorCheck(chess, tournament_id,
-                                                          max_games_per_player, tournament_location);
-
-    if (error_type != CHESS_SUCCESS)
-    {
-        return error_type;
-    } 
-
-    Tournament new_tournament = tournamentCreate(max_games_per_player, tournament_location);
-    if (new_tournament == NULL)
-    {
-        return chessOutOfMemoryDestroy(chess);
-    }
-
-    if (mapPut(chess->tournaments, &tournament_id, new_tournament) != MAP_SUCCESS)
-    {
-        tournamentDestroy(new_tournament);
-        return chessOutOfMemoryDestroy(chess);
-    }
-    tournamentDestroy(new_tournament);
-    return CHESS_SUCCESS;
-}
-
-/**
-*	playersAddStatsToMap: add given players score and playtime to players map.
-*
-* @param players_map - The players map to which add stats.  
-* @param player1 - First player's ID. Must be positive.
-* @param player2 - Second player's ID. Must be positive.
-* @param winner - indicates the winner in the match.
-*
-* @return
-* 	None
-*/
-static void playersAddStatsToMap(Map players_map, int player1, int player2, Winner winner, int play_time)
-{
-    Player first_player = mapGet(players_map, &player1);
-    Player second_player = mapGet(players_map, &player2);
-    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
-    playersAddScore(players, winner);
-    playersAddPlayTime(players, play_time);
-}
-
-/**
-*	isGameExistInTournament: check if the given game exists in the given tournament
-*
-* @param tournament - The tournament to check. 
-* @param player1 - First player's ID. Must be positive.
-* @param player2 - Second player's ID. Must be positive.
-*
-* @return
-* 	true - If the given game exists in the tournament.
-*   false - If the given game doesn't exist in the tournament.
-*/
-static bool isGameExistInTournament(Tournament tournament, int player1, int player2)
-{
-    MAP_FOREACH(Game, current_game_id, tournamentGetGamesMap(tournament))
-    {
-        Game current_game = mapGet(tournamentGetGamesMap(tournament) ,current_game_id);
-        free(current_game_id);
-        int first_player = gameGetFirstPlayer(current_game);
-        int second_player = gameGetSecondPlayer(current_game);
-
-        if ((first_player == player1 && second_player == player2) ||
-            (first_player == player2 && second_player == player1))
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
-/**
-*	playerSetupInMap: check if a given player exists in players map - if not, he is added to the map,
-*                     else nothing is done. If the players map belongs to a tournament, the function
-*                     updates the number of players in the tournament.
-*                     
-*
-* @param tournament - The tournament to update number of players if the players map belongs to a tournament. 
-* @param players_map - The players map which to check and update player.  
-* @param player_id - player's ID. Must be positive.
-*
-* @return
-* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
-*   MAP_SUCCESS - If the player setup was done successfully.
-*/
-static MapResult playerSetupInMap(Tournament tournament, Map player_map, int player_id)
-{
-    MapResult error_type = MAP_SUCCESS;
-
-    if (mapContains(player_map, &player_id) == false)
-    {
-        Player player = playerCreate(player_id);
-        if (player == NULL)
-        {
-            return MAP_OUT_OF_MEMORY;
-        }
-
-        if(mapPut(player_map, &player_id, player) != MAP_SUCCESS)
-        {
-            error_type = MAP_OUT_OF_MEMORY;
-        }
-        playerDestroy(player);
-
-        if (player_map == tournamentGetPlayersMap(tournament))
-        {
-            tournamentUpdateNumberOfPlayers(tournament);
-        }
-    }
-    return error_type;
-}
-
-/**
-*	playerMapUpdatePlayers: Updates the players map with the two given players, if they don't exist in the map.
-*                     
-*
-* @param tournament - The tournament to update number of players if the players map belongs to a tournament. 
-* @param players_map - The players map which to check and update players.  
-* @param first_player - First player's ID. Must be positive.
-* @param second_player - Second player's ID. Must be positive.
-*
-* @return
-* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
-*   MAP_SUCCESS - If the players setup was done successfully.
-*/
-MapResult playerMapUpdatePlayers(Tournament tournament, Map players_map, int first_player, int second_player)
-{
-    if (playerSetupInMap(tournament, players_map, first_player) != MAP_SUCCESS)
-    {
-        return MAP_OUT_OF_MEMORY;
-    }
-    
-    if (playerSetupInMap(tournament, players_map, second_player) != MAP_SUCCESS)
-    {
-        return MAP_OUT_OF_MEMORY;
-    }
-    return MAP_SUCCESS;
-}
-
-/**
-*	newGameSystemAssign: Assigns a new game to the tournament games map and updates the players map with the
-*                        two given players, if they don't exist in the map.              
-*
-* @param tournament - The tournament in which the new game occurs.
-* @param chess_players_map - The chess system's general players map, which needed to be updated.
-* @param tournament_games_map - The games map of the tournament, where the new game would be assigned to.
-* @param tournament_players_map - The players map of the tournament, which needed to be updated.
-* @param new_game- The new game to assign to games map.  
-* @param new_game_id - New game's id.
-* @param first_player - First player's ID. Must be positive.
-* @param second_player - Second player's ID. Must be positive.
-*
-* @return
-* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
-*   MAP_SUCCESS - If the new game was successfully assigned and players map was updated.
-*/
-static ChessResult newGameSystemAssign(Tournament tournament, Map chess_players_map, 
-                                       Map tournament_games_map, Map tournament_players_map,
-                                       Game new_game, int new_game_id, int first_player, int second_player)
-{
-    if (mapPut(tournament_games_map, &new_game_id, new_game) != MAP_SUCCESS ||
-        playerMapUpdatePlayers(tournament, chess_players_map, first_player, second_player) != MAP_SUCCESS ||
-        playerMapUpdatePlayers(tournament, tournament_players_map, first_player, second_player) != MAP_SUCCESS)
-    {
-        return CHESS_OUT_OF_MEMORY;
-    }
-    return CHESS_SUCCESS;
-}
-
-/**
-*	chessAddGameErrorCheck: checks errors for chessAddGame function and returns
-*                                 relevant error value.
-*
-* @param chess - See chessSystem.h
-*
-* @return
-*   See chessSystem.h
-*/
-static ChessResult chessAddGameErrorCheck(ChessSystem chess, int tournament_id, int first_player,
-                                          int second_player, Winner winner, int play_time)
-{
-    if (chess == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isValidID(tournament_id) == false ||
-        isValidID(first_player) == false || 
-        isValidID(second_player) == false ||
-        first_player == second_player)
-    {
-        return CHESS_INVALID_ID;
-    }
-
-    if (mapContains(chess->tournaments, &tournament_id) == false)
-    {
-        return CHESS_TOURNAMENT_NOT_EXIST;
-    }
-
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    if (tournamentGetWinner(tournament) != TOURNAMENT_NOT_ENDED)
-    {
-        return CHESS_TOURNAMENT_ENDED;
-    }
-
-    if (isGameExistInTournament(tournament, first_player, second_player) == true)
-    {
-        return CHESS_GAME_ALREADY_EXISTS;
-    }
-
-    if (isPlayTimeValid(play_time) == false)
-    {
-        return CHESS_INVALID_PLAY_TIME;
-    }
-
-    if (isMaxGamesPerPlayerExceeded(tournament, first_player) == true || 
-        isMaxGamesPerPlayerExceeded(tournament, second_player) == true)
-    {
-        return CHESS_EXCEEDED_GAMES;
-    }
-    return CHESS_SUCCESS;
-}
-
-ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player,
-                         int second_player, Winner winner, int play_time)
-{
-    ChessResult error_type = chessAddGameErrorCheck(chess, tournament_id, first_player,
-                                                    second_player, winner, play_time);
-
-    if (error_type != CHESS_SUCCESS)
-    {
-        return error_type;
-    } 
-    
-    Tournament current_tournament = mapGet(chess->tournaments, &tournament_id);
-    Map tournament_games_map = tournamentGetGamesMap(current_tournament);
-    Map tournament_players_map = tournamentGetPlayersMap(current_tournament);
-    Game new_game = gameCreate(winner, play_time, first_player, second_player);
-    if (new_game == NULL)
-    {
-        return chessOutOfMemoryDestroy(chess);
-    }
-
-    int new_game_id = (mapGetSize(tournament_games_map) + 1);
-    
-    if (newGameSystemAssign(current_tournament, chess->players, tournament_games_map, tournament_players_map,
-                            new_game, new_game_id, first_player, second_player) != CHESS_SUCCESS)
-    {
-        gameDestroy(new_game);
-        chessOutOfMemoryDestroy(chess);
-    }
-
-    playersAddStatsToMap(chess->players, first_player, second_player, winner, play_time);
-    playersAddStatsToMap(tournament_players_map, first_player, second_player, winner, play_time);
-    tournamentUpdateStats(current_tournament, play_time);
-
-    gameDestroy(new_game);
-    return CHESS_SUCCESS;
-}
-
-/**
-*	playersRemoveStats: remove given players score and playtime from players map.
-*
-* @param players_map - The players map from which to remove player stats.  
-* @param player1 - First player's ID. Must be positive.
-* @param player2 - Second player's ID. Must be positive.
-* @param winner - Indicates the winner in the match.
-*
-* @return
-* 	None
-*/
-static void playersRemoveStats(Map players_map, int player1, int player2, Winner winner, int play_time)
-{
-    if (isValidID(player1) == false && isValidID(player2) == false)
-    {
-        return;
-    }
-    Player first_player = mapGet(players_map, &player1);
-    Player second_player = mapGet(players_map, &player2);
-    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
-    playersRemoveScore(players, winner);
-    playersRemovePlayTime(players, play_time);
-}
-
-/**
-*	chessRemoveTournamentErrorCheck: checks errors for chessRemoveTournament function and returns
-*                                 relevant error value.
-*
-* @param chess - See chessSystem.h
-*
-* @return
-*   See chessSystem.h
-*/
-static ChessResult chessRemoveTournamentErrorCheck(ChessSystem chess, int tournament_id) 
-{
-    if (chess == NULL || chess->tournaments == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isValidID(tournament_id) == false)
-    {
-        return CHESS_INVALID_ID;
-    }
-
-    if (mapContains(chess->tournaments, &tournament_id) == false)
-    {
-        return CHESS_TOURNAMENT_NOT_EXIST;
-    }
-    return CHESS_SUCCESS;
-}
-
-ChessResult chessRemoveTournament(ChessSystem chess, int tournament_id)
-{
-    ChessResult error_type = chessRemoveTournamentErrorCheck(chess, tournament_id);
-    if (error_type != CHESS_SUCCESS)
-    {
-        return error_type;
-    }
-
-    Tournament current_tournament = mapGet(chess->tournaments, &tournament_id);
-
-    MAP_FOREACH(Game, current_game_id, tournamentGetGamesMap(current_tournament))
-    {
-        Game current_game = mapGet(tournamentGetGamesMap(current_tournament) ,current_game_id);
-        playersRemoveStats(chess->players, gameGetFirstPlayer(current_game), gameGetSecondPlayer(current_game),
-                            gameGetWinner(current_game), gameGetPlayTime(current_game));
-        free(current_game_id);
-    }
-
-    mapRemove(chess->tournaments, &tournament_id);
-    return CHESS_SUCCESS;
-}
-
-/**
-*	playersMapTechnicalWinUpdateScore: Assigns a technical win to the opponent of the given player and              
-*                                      updates players scores.
-*
-* @param players_map - The players map, which needed to be updated with technical win score.
-* @param game- The game which to update.  
-* @param player1 - First player's ID. Must be positive.
-* @param player2 - Second player's ID. Must be positive.
-* @param opponent - The ID of the opponent in the game, who gets a technical win.
-* @param winner - The winner of the game before the technical win occurs.
-*
-* @return
-*   None
-*/
-static void playersMapTechnicalWinUpdateScore(Map players_map, Game game, int player1, int player2,
-                                    int opponent, Winner winner)
-{
-    if (isValidID(player1) == false || isValidID(player2) == false)
-    {
-        return;
-    }
-    Player first_player = mapGet(players_map, &player1);
-    Player second_player = mapGet(players_map, &player2);
-    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
-    Winner new_winner = (opponent == player1) ? FIRST_PLAYER : SECOND_PLAYER;
-    playersRemoveScore(players, winner);
-    playersAddScore(players, new_winner);
-}
-
-/**
-*	chessRemovePlayerErrorCheck: checks errors for chessRemovePlayer function and returns
-*                                 relevant error value.
-*
-* @param chess - See chessSystem.h
-*
-* @return
-*   See chessSystem.h
-*/
-static ChessResult chessRemovePlayerErrorCheck(ChessSystem chess, int player_id)
-{
-    if (chess == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isValidID(player_id) == false)
-    {
-        return CHESS_INVALID_ID;
-    }
-
-    if (mapContains(chess->players, &player_id) == false)
-    {
-        return CHESS_PLAYER_NOT_EXIST;
-    }
-    return CHESS_SUCCESS;
-}
-
-ChessResult chessRemovePlayer(ChessSystem chess, int player_id)
-{
-    ChessResult error_type = chessRemovePlayerErrorCheck(chess, player_id);
-
-    if (error_type != CHESS_SUCCESS)
-    {
-        return error_type;
-    }
-
-    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
-    {
-        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
-        if (tournamentGetWinner(current_tournament) == TOURNAMENT_NOT_ENDED)
-        {
-            MAP_FOREACH(Game, current_game_id, tournamentGetGamesMap(current_tournament))
-            {
-                Game current_game = mapGet(tournamentGetGamesMap(current_tournament) ,current_game_id);
-                Map tournament_players_map = tournamentGetPlayersMap(current_tournament);
-
-                if (isPlayerInCurrentGame(current_game, player_id) == true)            
-                {
-                    int opponent_id = gameGetOpponent(current_game, player_id);
-                    if (isValidID(opponent_id) == true)
-                    {
-                        playersMapTechnicalWinUpdateScore(chess->players, current_game, gameGetFirstPlayer(current_game),
-                                                          gameGetSecondPlayer(current_game), opponent_id, 
-                                                          gameGetWinner(current_game));
-                        
-                        playersMapTechnicalWinUpdateScore(tournament_players_map, current_game, 
-                                                        gameGetFirstPlayer(current_game),
-                                                        gameGetSecondPlayer(current_game), opponent_id, 
-                                                        gameGetWinner(current_game));
-
-                        gameSetWinner(current_game, opponent_id);
-                    }
-                    gameUpdateDeletedPlayerID(current_game, player_id);
-                }
-                free(current_game_id);
-            }
-        }
-        mapRemove(tournamentGetPlayersMap(current_tournament), &player_id); 
-        free(current_tournament_id);
-    }
-    mapRemove(chess->players, &player_id);
-    
-    return CHESS_SUCCESS;
-}
-
-/** Type for a generic data geting function, which is used for determing the tournament's winner */
-typedef int (*getDataFunc)(Player);
-
-/**
-*	comparePlayerData: Generically comapre players data and returning the differnce between the datas.                   
-*
-* @param players[] - Array that contains the two player whose data is being compared.
-* @param func - A generic data get function, in order to get the player's desired data.  
-*
-* @return
-* 	difference - The numeric value of the differnce between the two players' data. 
-*/
-static int comparePlayerData(Player players[], getDataFunc func)
-{
-    int first_player_data = func(players[FIRST_PLAYER]);
-    int second_player_data = func(players[SECOND_PLAYER]);
-    int difference = first_player_data - second_player_data;
-
-    return difference;
-}
-
-/**
-*	paritySign: checks if the given index is even or odd and returns 1 or -1 accordingly.                   
-*
-* @param index - Index which to check parity
-*
-* @return
-* 	1 - If the index is even.
-*  -1 - If the index is odd.
-*/
-static int paritySign(int index)
-{
-    return ((index % 2 == 0) - (index % 2 != 0));
-}
-
-/**
-*	tournamentFindWinner: Finds and returns the winner of the tournament between two given players.
-*                         The function compares the players' scores - If different, returns the player
-                          with the higher score. Else, it compares the players' loses - If different, 
-                          returns the player with the lower number of loses. Else, it compares the players'
-                          wins - If different, returns the player with the higher number of wins. Else, it
-                          compares the players' ID and returns the player with the lower ID.
-*                       
-*
-* @param first_player - First player to check.
-* @param second_player - Second player to check.  
-*
-* @return
-*   The player who won the tournament between the given two.
-*/
-static Player tournamentFindWinner(Player first_player, Player second_player)
-{
-    getDataFunc checks[] = {playerGetScore, playerGetLoses, playerGetWins, playerGetID};
-    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player}; 
-    int difference = 0, index = 0;
-
-    for (; index < (sizeof(checks) / sizeof(*checks)); index++)
-    {
-        difference = comparePlayerData(players, checks[index]);
-        if (difference != 0)
-        {
-            break;
-        }
-    } 
-    return players[difference * paritySign(index) < 0];
-}
-
-/**
-*	chessEndTournamentErrorCheck: checks errors for chessEndTournament function and returns
-*                                 relevant error value.
-*
-* @param chess - See chessSystem.h
-*
-* @return
-*   See chessSystem.h
-*/
-static ChessResult chessEndTournamentErrorCheck(ChessSystem chess, int tournament_id)
-{
-    if (chess == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isValidID(tournament_id) == false)
-    {
-        return CHESS_INVALID_ID;
-    }
-
-    if (mapContains(chess->tournaments, &tournament_id) == false)
-    {
-        return CHESS_TOURNAMENT_NOT_EXIST;
-    }
-
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    if (tournamentGetWinner(tournament) != TOURNAMENT_NOT_ENDED)
-    {
-        return CHESS_TOURNAMENT_ENDED;
-    }
-
-    if (mapGetSize(tournamentGetGamesMap(tournament)) == 0)
-    {
-        return CHESS_NO_GAMES;
-    }
-    return CHESS_SUCCESS;
-}
-
-ChessResult chessEndTournament(ChessSystem chess, int tournament_id)
-{
-    ChessResult error_type = chessEndTournamentErrorCheck(chess, tournament_id);
-    if (error_type != CHESS_SUCCESS)
-    {
-        return error_type;
-    }
-
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    Map tournament_players_map = tournamentGetPlayersMap(tournament);
-    MapKeyElement current_winner_id = mapGetFirst(tournament_players_map);
-    Player current_winner = mapGet(tournament_players_map, current_winner_id);
-    
-    MAP_FOREACH(Player, current_player_id, tournament_players_map)
-    {
-        Player current_player = mapGet(tournament_players_map ,current_player_id);
-        free(current_player_id);
-        if (isValidID(playerGetID(current_player)) == false)
-        {
-            continue;
-        }
-        current_winner = tournamentFindWinner(current_winner, current_player);
-        
-    }
-    tournamentSetWinner(tournament, playerGetID(current_winner));
-    free(current_winner_id);
-    return CHESS_SUCCESS;
-}
-
-/**
-*	chessCalculateAveragePlayTimeErrorCheck: checks errors for chessCalculateAveragePlayTime
-*                                            function and returns relevant error value.
-*
-* @param chess - See chessSystem.h
-*
-* @return
-*   See chessSystem.h
-*/
-ChessResult chessCalculateAveragePlayTimeErrorCheck(ChessSystem chess, int player_id)
-{
-    if (chess == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isValidID(player_id) == false)
-    {
-        return CHESS_INVALID_ID;
-    }
-
-    if (mapContains(chess->players, &player_id) == false)
-    {
-        return CHESS_PLAYER_NOT_EXIST;
-    }
-    return CHESS_SUCCESS;
-}
-
-double chessCalculateAveragePlayTime(ChessSystem chess, int player_id, ChessResult *chess_result)
-{
-    *chess_result = chessCalculateAveragePlayTimeErrorCheck(chess, player_id);
-    if (*chess_result != CHESS_SUCCESS)
-    {
-        return *chess_result;
-    }
-
-    Player player = mapGet(chess->players, &player_id);
-    double total_play_time = playerGetTotalPlayTime(player);
-    if(total_play_time == 0)
-    {
-        return total_play_time;
-    }
-    double wins = playerGetWins(player);
-    double loses = playerGetLoses(player);
-    double draws = playerGetDraws(player);
-    return total_play_time / (wins + loses + draws);
-}
-
-ChessResult chessSavePlayersLevels(ChessSystem chess, FILE *file)
-{
-    if(chess == NULL || file == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    Map players_rank_map = playersRankMapFactory();
-    if (players_rank_map == NULL)
-    {
-        return CHESS_OUT_OF_MEMORY;
-    }
-
-    MAP_FOREACH(Player, current_player_id, chess->players)
-    {
-        Player current_player = mapGet(chess->players ,current_player_id);
-        if (playerGetTotalPlayTime(current_player) == 0)
-        {
-            free(current_player_id);
-            continue;
-        }
-        double level = playerGetLevel(current_player);
-        int id = playerGetID(current_player);
-
-        Rank current_player_rank = playerRankCreate(level , id);
-        if (current_player_rank == NULL)
-        {
-            mapDestroy(players_rank_map);
-            return CHESS_OUT_OF_MEMORY;
-        }
-
-        if(mapPut(players_rank_map, current_player_rank, current_player) != MAP_SUCCESS)
-        {
-            mapDestroy(players_rank_map);
-            return CHESS_OUT_OF_MEMORY;
-        }
-        playerRankDestroy(current_player_rank);
-        free(current_player_id);
-    }
-
-    MAP_FOREACH(Rank, current_player_rank, players_rank_map)
-    {
-        if (fprintf(file, "%d %.2lf\n", playerRankGetID(current_player_rank),
-                                        playerRankGetLevel(current_player_rank)) < 0)
-        {
-            mapDestroy(players_rank_map);
-            return CHESS_SAVE_FAILURE;
-        }
-        free(current_player_rank);
-    }
-    mapDestroy(players_rank_map);
-    return CHESS_SUCCESS;
-}
-
-/**
-*	isAnyTournamentEnded: checks if any tournament in the chess system was ended.
-*
-* @param chess - The chess system which is being checked.
-*
-* @return
-* 	true - If a ended tournament was found.
-*   false - If no ended tournament was found.
-*/
-static bool isAnyTournamentEnded(ChessSystem chess)
-{
-    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
-    {
-        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
-        free(current_tournament_id);
-        if (tournamentGetWinner(current_tournament) != TOURNAMENT_NOT_ENDED)
-        {
-            return true;
-        } 
-    }
-    return false;
-}
-
-
-ChessResult chessSaveTournamentStatistics(ChessSystem chess, char *path_file)
-{
-    if (chess == NULL || path_file == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
-    if (isAnyTournamentEnded(chess) == false)
-    {
-        return CHESS_NO_TOURNAMENTS_ENDED;
-    }
-
-    FILE* file_tournament_stats = fopen(path_file, "w");
-    if (!file_tournament_stats)
-    {
-        return CHESS_SAVE_FAILURE;
-    }
-    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
-    {
-        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
-        int winner = tournamentGetWinner(current_tournament);
-        if (isValidID(winner) == false)
-        {
-            free(current_tournament_id); 
-            continue;
-        }
-        int longest_game_time = tournamentGetLongestGameTime(current_tournament);
-        const char* location = tournamentGetLocation(current_tournament);
-        int number_of_games = tournamentGetNumberOfGames(current_tournament);
-        double average_game_time = 0;
-        if (number_of_games != 0)
-        {
-            average_game_time = (double) tournamentGetTotalPlayTime(current_tournament) / (double) number_of_games;
-        }
-        int number_of_players = tournamentGetNumberOfPlayers(current_tournament);
-        
-        if (fprintf(file_tournament_stats, "%d\n"
-                          "%d\n"
-                          "%.2lf\n"
-                          "%s\n"
-                          "%d\n"
-                          "%d\n",
-                          winner,
-                          longest_game_time,
-                          average_game_time,
-                          location,
-                          number_of_games,
-                          number_of_players) < 0)
-        {
-            return CHESS_SAVE_FAILURE;
-        }    
-        free(current_tournament_id);        
-    }
-        fclose(file_tournament_stats);
-        return CHESS_SUCCESS;
-}
\ No newline at end of file
+#define _POSIX_C_SOURCE 200809L
+
+#include "chessSystem.h"
+#include "tournament.h"
+#include "game.h"
+#include "map.h"
+#include "player.h"
+#include "gameIndex.h"
+#include "gameLog.h"
+#include "gamePairSet.h"
+#include "snapshot.h"
+#include "journal.h"
+#include "checkpoint.h"
+#include "readOnly.h"
+#include "exportSession.h"
+#include "reportWriter.h"
+#include "lzBlock.h"
+#include "gameArchive.h"
+#include "changeFeed.h"
+#include "submissionRing.h"
+#include "submissionQueue.h"
+#include "playerDirectory.h"
+#include "chessLock.h"
+#include "chessSystemExtensions.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+
+#define NUMBER_OF_PLAYERS_IN_GAME 2
+#define IMPORT_BATCH_SIZE 1024
+#define UNLIMITED_MEMORY 0
+#define CHANGE_FEED_DEFAULT_CAPACITY 4096
+#define CHANGE_FEED_DEFAULT_BATCH_SIZE 256
+
+/** Estimated size in bytes of a map entry's node and copied key, on top of its data */
+#define MAP_ENTRY_MEMORY_ESTIMATE (3 * sizeof(void*) + sizeof(int))
+/** Estimated size in bytes of an empty map */
+#define MAP_MEMORY_ESTIMATE (8 * sizeof(void*))
+/** Estimated size in bytes of a game's references in its two players' game indexes */
+#define GAME_INDEX_ENTRY_MEMORY_ESTIMATE (NUMBER_OF_PLAYERS_IN_GAME * 2 * sizeof(int))
+/** Estimated size in bytes of a player's game index, without its games */
+#define GAME_INDEX_MEMORY_ESTIMATE (MAP_ENTRY_MEMORY_ESTIMATE + sizeof(void*) + 2 * sizeof(int))
+
+/** Initial number of removed players the chess system keeps track of for levels deltas */
+#define LEVELS_TOMBSTONES_INITIAL_CAPACITY 16
+/** Most removed players the chess system keeps track of, before it forgets the older half of them */
+#define LEVELS_TOMBSTONES_MAX_CAPACITY 1024
+
+/** Type for a player removed from the chess system, and the version of the levels clock it was removed at */
+typedef struct levels_tombstone_t
+{
+    int player_id;
+    long long version;
+} LevelsTombstone;
+
+/** Type for representing a chess system that organizes chess tournaments */
+struct chess_system_t
+{
+    Map tournaments;
+    Map players;
+    int game_index_capacity;
+    size_t memory_limit;
+    size_t tournaments_memory;
+    size_t memory_reserved;
+    int number_of_games;
+    int tournament_player_entries;
+    Journal journal;
+    long long journal_sequence;
+    bool players_dirty;
+    unsigned long long checkpoint_id;
+    long long levels_version;
+    long long levels_oldest_token;
+    LevelsTombstone *tombstones;
+    int number_of_tombstones;
+    int tombstones_capacity;
+    TournamentCache spill_cache;
+    GameArchive archive;
+    ChangeFeed feed;
+    PlayerDirectory directory;
+    long long exclusive_levels_version;
+    int exclusive_number_of_games;
+    ChessRwLock lock;
+    ChessMutex tournaments_lock;
+    ChessMutex players_lock;
+    ChessMutex tail_lock;
+};
+
+/**
+*	chessLockShared: locks the chess system for sharing, in the thread safe build. Threads which share the
+*                    system take its inner locks for the tournaments and players they touch.
+*
+* @param chess - The chess system. If chess is NULL nothing will be done.
+*
+* @return
+* 	None
+*/
+static void chessLockShared(ChessSystem chess)
+{
+    if (chess != NULL)
+    {
+        chessRwLockShared(&chess->lock);
+    }
+}
+
+/**
+*	chessLockExclusive: locks the chess system exclusively, in the thread safe build, and notes the versions
+*                       chessUnlockExclusive checks for changed players.
+*
+* @param chess - The chess system. If chess is NULL nothing will be done.
+*
+* @return
+* 	None
+*/
+static void chessLockExclusive(ChessSystem chess)
+{
+    if (chess != NULL)
+    {
+        chessRwLockExclusive(&chess->lock);
+        chess->exclusive_levels_version = chess->levels_version;
+        chess->exclusive_number_of_games = chess->number_of_games;
+    }
+}
+
+/**
+*	chessUnlock: unlocks the chess system, locked by chessLockShared, and then hands the waiting change events to
+*                the subscribed callbacks, so they may call back into the chess system.
+*
+* @param chess - The chess system. If chess is NULL nothing will be done.
+*
+* @return
+* 	None
+*/
+static void chessUnlock(ChessSystem chess)
+{
+    if (chess != NULL)
+    {
+        ChangeFeed feed = chess->feed;
+        chessRwLockUnlock(&chess->lock);
+        changeFeedDeliver(feed);
+    }
+}
+
+/**
+*	chessUnlockExclusive: unlocks the chess system, locked by chessLockExclusive. If players or games changed
+*                         while it was locked, the statistics published in the player directory are invalidated,
+*                         since only chessAddGame publishes the statistics it changes. The waiting change events
+*                         are handed to the subscribed callbacks after the lock is released.
+*
+* @param chess - The chess system. If chess is NULL nothing will be done.
+*
+* @return
+* 	None
+*/
+static void chessUnlockExclusive(ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return;
+    }
+    if (chess->levels_version != chess->exclusive_levels_version ||
+        chess->number_of_games != chess->exclusive_number_of_games)
+    {
+        playerDirectoryInvalidate(chess->directory);
+    }
+    ChangeFeed feed = chess->feed;
+    chessRwLockUnlock(&chess->lock);
+    changeFeedDeliver(feed);
+}
+
+/**
+*	chessInitLocks: initializes the locks of a new chess system.
+*
+* @param chess - The new chess system.
+*
+* @return
+* 	false - If a lock couldn't be initialized. None of the locks is left initialized in that case.
+*   true - Otherwise.
+*/
+static bool chessInitLocks(ChessSystem chess)
+{
+    if (chessRwLockInit(&chess->lock) == false)
+    {
+        return false;
+    }
+    if (chessMutexInit(&chess->tournaments_lock) == false)
+    {
+        chessRwLockDestroy(&chess->lock);
+        return false;
+    }
+    if (chessMutexInit(&chess->players_lock) == false)
+    {
+        chessMutexDestroy(&chess->tournaments_lock);
+        chessRwLockDestroy(&chess->lock);
+        return false;
+    }
+    if (chessMutexInit(&chess->tail_lock) == false)
+    {
+        chessMutexDestroy(&chess->players_lock);
+        chessMutexDestroy(&chess->tournaments_lock);
+        chessRwLockDestroy(&chess->lock);
+        return false;
+    }
+    return true;
+}
+
+/**
+*	chessDestroyLocks: destroys the locks of a chess system.
+*
+* @param chess - The chess system, which no thread holds a lock of.
+*
+* @return
+* 	None
+*/
+static void chessDestroyLocks(ChessSystem chess)
+{
+    chessMutexDestroy(&chess->tail_lock);
+    chessMutexDestroy(&chess->players_lock);
+    chessMutexDestroy(&chess->tournaments_lock);
+    chessRwLockDestroy(&chess->lock);
+}
+
+/**
+*	chessAcquirePools: registers a new chess system as a user of the pools games and players are allocated from.
+*
+* @return
+* 	false - If there was a memory allocation error. No pool is acquired in that case.
+*   true - If both pools were acquired.
+*/
+static bool chessAcquirePools()
+{
+    if (gamePoolAcquire() == false)
+    {
+        return false;
+    }
+    if (playerPoolAcquire() == false)
+    {
+        gamePoolRelease();
+        return false;
+    }
+    return true;
+}
+
+/**
+*	configMultiply: multiplies two non-negative configuration values, saturating instead of overflowing.
+*
+* @param first - The first value.
+* @param second - The second value.
+*
+* @return
+* 	The product, or INT_MAX if it doesn't fit in an int.
+*/
+static int configMultiply(int first, int second)
+{
+    if (first <= 0 || second <= 0)
+    {
+        return 0;
+    }
+    return (first > INT_MAX / second) ? INT_MAX : first * second;
+}
+
+/**
+*	chessReserveCapacity: pre-sizes the object pools and game indexes for the expected amount of data.
+*
+* @param chess - The chess system which is being configured.
+* @param config - The capacity hints.
+*
+* @return
+* 	false - If there was a memory allocation error.
+*   true - If the capacity was reserved successfully.
+*/
+static bool chessReserveCapacity(ChessSystem chess, const ChessConfig *config)
+{
+    int expected_games = configMultiply(config->expected_tournaments, config->expected_games_per_tournament);
+    int players_per_tournament = configMultiply(config->expected_games_per_tournament, NUMBER_OF_PLAYERS_IN_GAME);
+    if (config->expected_players > 0 && players_per_tournament > config->expected_players)
+    {
+        players_per_tournament = config->expected_players;
+    }
+    int tournament_players = configMultiply(config->expected_tournaments, players_per_tournament);
+    int expected_player_entries = (config->expected_players > INT_MAX - tournament_players) ?
+                                  INT_MAX : config->expected_players + tournament_players;
+
+    if (config->expected_players > 0)
+    {
+        int games_per_player = configMultiply(expected_games, NUMBER_OF_PLAYERS_IN_GAME) / config->expected_players;
+        chess->game_index_capacity = (games_per_player > GAME_INDEX_INITIAL_CAPACITY) ?
+                                     games_per_player : GAME_INDEX_INITIAL_CAPACITY;
+    }
+
+    int arena_games = config->initial_arena_size / gameGetMemoryFootprint();
+    int arena_players = config->initial_arena_size / playerGetMemoryFootprint();
+    return gamePoolReserve((arena_games > expected_games) ? arena_games : expected_games) == true &&
+           playerPoolReserve((arena_players > expected_player_entries) ?
+                             arena_players : expected_player_entries) == true;
+}
+
+ChessSystem chessCreate()
+{
+    return chessCreateWithConfig(NULL);
+}
+
+ChessSystem chessCreateWithConfig(const ChessConfig *config)
+{
+    ChessSystem chess = malloc(sizeof(*chess));
+    if (chess == NULL)
+    {
+        return NULL;
+    }
+
+    chess->game_index_capacity = GAME_INDEX_INITIAL_CAPACITY;
+    chess->memory_limit = (config != NULL) ? config->memory_budget : UNLIMITED_MEMORY;
+    chess->tournaments_memory = 0;
+    chess->memory_reserved = 0;
+    chess->number_of_games = 0;
+    chess->tournament_player_entries = 0;
+    chess->journal = NULL;
+    chess->journal_sequence = 0;
+    chess->players_dirty = true;
+    chess->checkpoint_id = 0;
+    chess->levels_version = 0;
+    chess->levels_oldest_token = 0;
+    chess->tombstones = NULL;
+    chess->number_of_tombstones = 0;
+    chess->tombstones_capacity = 0;
+    chess->spill_cache = NULL;
+    chess->archive = NULL;
+    chess->feed = NULL;
+    if (chessInitLocks(chess) == false)
+    {
+        free(chess);
+        return NULL;
+    }
+    chess->directory = playerDirectoryCreate();
+    chess->tournaments = tournamentMapFactory();
+    if (chess->directory == NULL || chess->tournaments == NULL)
+    {
+        mapDestroy(chess->tournaments);
+        playerDirectoryDestroy(chess->directory);
+        chessDestroyLocks(chess);
+        free(chess);
+        return NULL;
+    }
+
+    chess->players = playerMapFactory();
+    if (chess->players == NULL)
+    {
+        mapDestroy(chess->tournaments);
+        playerDirectoryDestroy(chess->directory);
+        chessDestroyLocks(chess);
+        free(chess);
+        return NULL;
+    }
+
+    if (chessAcquirePools() == false)
+    {
+        mapDestroy(chess->players);
+        mapDestroy(chess->tournaments);
+        playerDirectoryDestroy(chess->directory);
+        chessDestroyLocks(chess);
+        free(chess);
+        return NULL;
+    }
+
+    if (config != NULL && chessReserveCapacity(chess, config) == false)
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+    return chess;
+}
+
+void chessDestroy(ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return;
+    }
+
+    changeFeedFlush(chess->feed);
+    changeFeedDestroy(chess->feed);
+    mapDestroy(chess->tournaments);
+    mapDestroy(chess->players);
+    tournamentCacheDestroy(chess->spill_cache);
+    gameArchiveDestroy(chess->archive);
+    journalClose(chess->journal);
+    free(chess->tombstones);
+    playerDirectoryDestroy(chess->directory);
+    chessDestroyLocks(chess);
+    free(chess);
+    playerPoolRelease();
+    gamePoolRelease();
+}
+
+/**
+*	chessTouchPlayers: marks the levels of two players of the chess system as changed, by stamping them with
+*                      the next version of the levels clock. IDs which are not in the system are ignored.
+*
+* @param chess - The chess system.
+* @param first_player - The ID of the first player.
+* @param second_player - The ID of the second player.
+*
+* @return
+* 	None
+*/
+static void chessTouchPlayers(ChessSystem chess, int first_player, int second_player)
+{
+    int player_ids[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        Player player = mapGet(chess->players, &player_ids[index]);
+        if (player != NULL)
+        {
+            playerSetVersion(player, ++chess->levels_version);
+        }
+    }
+}
+
+/**
+*	chessForgetOldTombstones: forgets the older half of the removed players the chess system keeps track of, and
+*                             moves the oldest token levels deltas can be produced for past them.
+*
+* @param chess - The chess system, which keeps track of at least two removed players.
+*
+* @return
+* 	None
+*/
+static void chessForgetOldTombstones(ChessSystem chess)
+{
+    int forgotten = chess->number_of_tombstones / 2;
+    chess->levels_oldest_token = chess->tombstones[forgotten - 1].version;
+    chess->number_of_tombstones -= forgotten;
+    memmove(chess->tombstones, chess->tombstones + forgotten,
+            chess->number_of_tombstones * sizeof(*chess->tombstones));
+}
+
+/**
+*	chessRecordRemovedPlayer: keeps track of a player removed from the chess system, so levels deltas report
+*                             the removal. Only the latest LEVELS_TOMBSTONES_MAX_CAPACITY removals are kept, and
+*                             if there is no memory to keep track of a removal, all of them are forgotten.
+*                             Deltas since tokens older than the forgotten removals are answered with all the
+*                             players instead.
+*
+* @param chess - The chess system.
+* @param player_id - The ID of the removed player.
+*
+* @return
+* 	None
+*/
+static void chessRecordRemovedPlayer(ChessSystem chess, int player_id)
+{
+    chess->levels_version++;
+    if (chess->number_of_tombstones == LEVELS_TOMBSTONES_MAX_CAPACITY)
+    {
+        chessForgetOldTombstones(chess);
+    }
+    if (chess->number_of_tombstones == chess->tombstones_capacity)
+    {
+        int new_capacity = (chess->tombstones_capacity == 0) ? LEVELS_TOMBSTONES_INITIAL_CAPACITY :
+                           2 * chess->tombstones_capacity;
+        LevelsTombstone *new_tombstones = realloc(chess->tombstones, new_capacity * sizeof(*new_tombstones));
+        if (new_tombstones == NULL)
+        {
+            chess->levels_oldest_token = chess->levels_version;
+            return;
+        }
+        chess->tombstones = new_tombstones;
+        chess->tombstones_capacity = new_capacity;
+    }
+    chess->tombstones[chess->number_of_tombstones].player_id = player_id;
+    chess->tombstones[chess->number_of_tombstones].version = chess->levels_version;
+    chess->number_of_tombstones++;
+}
+
+/**
+*	chessArchivePut: writes a game into the chess system's game archive, if the archive was built. An archive
+*                    which can't be kept in sync is dropped, and built again by the next scan.
+*
+* @param chess - The chess system.
+* @param tournament_id - The ID of the game's tournament.
+* @param game_id - The ID of the game in its tournament.
+* @param game - The game.
+*
+* @return
+* 	None
+*/
+static void chessArchivePut(ChessSystem chess, int tournament_id, int game_id, Game game)
+{
+    if (chess->archive != NULL &&
+        gameArchivePut(chess->archive, tournament_id, game_id, gameGetFirstPlayer(game), gameGetSecondPlayer(game),
+                       gameGetWinner(game), gameGetPlayTime(game)) == false)
+    {
+        gameArchiveDestroy(chess->archive);
+        chess->archive = NULL;
+    }
+}
+
+/**
+*	chessPublishChange: records a change to the chess system in its change feed, if the feed is enabled.
+*
+* @param chess - The chess system.
+* @param type - The type of the change.
+* @param tournament_id - The tournament of the change.
+* @param first_player - The first player of the change.
+* @param second_player - The second player of the change.
+* @param winner - The winner of the change.
+*
+* @return
+* 	None
+*/
+static void chessPublishChange(ChessSystem chess, ChessChangeType type, int tournament_id, int first_player,
+                               int second_player, int winner)
+{
+    if (chess->feed != NULL)
+    {
+        changeFeedAppend(chess->feed, type, tournament_id, 0, first_player, second_player, winner, 0);
+    }
+}
+
+/**
+*	chessPublishGame: records a change to a game in the chess system's change feed, if the feed is enabled.
+*
+* @param chess - The chess system.
+* @param type - The type of the change.
+* @param tournament_id - The ID of the game's tournament.
+* @param game_id - The ID of the game in its tournament.
+* @param game - The game as it is after the change, or NULL if it was removed.
+*
+* @return
+* 	None
+*/
+static void chessPublishGame(ChessSystem chess, ChessChangeType type, int tournament_id, int game_id, Game game)
+{
+    if (chess->feed != NULL)
+    {
+        changeFeedAppend(chess->feed, type, tournament_id, game_id, game == NULL ? 0 : gameGetFirstPlayer(game),
+                         game == NULL ? 0 : gameGetSecondPlayer(game), game == NULL ? 0 : gameGetWinner(game),
+                         game == NULL ? 0 : gameGetPlayTime(game));
+    }
+}
+
+/**
+*	isValidID: check validity of a given ID.
+*
+* @param id - The ID to check validity.
+*
+* @return
+* 	true - If ID is valid.
+*   false - If ID is not valid.
+*/
+static bool isValidID(int id)
+{
+    return (id > 0);
+}
+
+/**
+*	isMaxGamesPerPlayerValid: check validity of max games per player for a tournament.
+*
+* @param max - Max games value to which check validity.
+*
+* @return
+* 	true - If value is valid.
+*   false - If value is not valid.
+*/
+static bool isMaxGamesPerPlayerValid(int max)
+{
+    return (max > 0);
+}
+
+/**
+*	isPlayTimeValid: check validity of given play time.
+*
+* @param time - The play time to which check validity.
+*
+* @return
+* 	true - If time is valid.
+*   false - If time is not valid.
+*/
+static bool isPlayTimeValid(int time)
+{
+    return (time >= 0);
+}
+
+/**
+*	isLocationValid: check validity of a given location.
+*
+* @param str - The location string to which check validity.
+*
+* @return
+* 	true - If location is valid.
+*   false - If location is not valid.
+*/
+static bool isLocationValid(const char *str)
+{
+    if (*str < 'A' || *str > 'Z')
+    {
+        return false;
+    }
+
+    while (*(++str) != '\0')
+    {
+        if (*str != ' ' && (*str < 'a' || *str > 'z'))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*	tournamentMemoryEstimate: estimates the memory held by a tournament, without its games and players.
+*
+* @param tournament - The tournament whose memory is estimated.
+*
+* @return
+* 	The estimated size in bytes.
+*/
+static size_t tournamentMemoryEstimate(Tournament tournament)
+{
+    return tournamentGetMemoryFootprint(tournament) + NUMBER_OF_PLAYERS_IN_GAME * MAP_MEMORY_ESTIMATE +
+           MAP_ENTRY_MEMORY_ESTIMATE;
+}
+
+/**
+*	gameMemoryEstimate: estimates the memory held by a single game, including its players' references to it.
+*
+* @return
+* 	The estimated size in bytes.
+*/
+static size_t gameMemoryEstimate()
+{
+    return gameGetMemoryFootprint() + MAP_ENTRY_MEMORY_ESTIMATE + GAME_INDEX_ENTRY_MEMORY_ESTIMATE;
+}
+
+/**
+*	playerMemoryEstimate: estimates the memory held by a single player entry in a tournament's players map.
+*                         Players of the system's players map also hold a game index.
+*
+* @param is_system_player - Whether the entry belongs to the system's players map.
+*
+* @return
+* 	The estimated size in bytes.
+*/
+static size_t playerMemoryEstimate(bool is_system_player)
+{
+    return playerGetMemoryFootprint() + MAP_ENTRY_MEMORY_ESTIMATE +
+           (is_system_player == true ? GAME_INDEX_MEMORY_ESTIMATE : 0);
+}
+
+/**
+*	chessEstimateMemoryUsage: estimates the memory held by the chess system.
+*
+* @param chess - The chess system whose memory is estimated.
+*
+* @return
+* 	The estimated size in bytes.
+*/
+static size_t chessEstimateMemoryUsage(ChessSystem chess)
+{
+    // Evicted games are only referenced by the players' game indexes
+    int evicted_games = 0, evicted_players = 0;
+    tournamentCacheGetEvicted(chess->spill_cache, &evicted_games, &evicted_players);
+    return sizeof(*chess) + 3 * MAP_MEMORY_ESTIMATE + chess->tournaments_memory +
+           (size_t) (chess->number_of_games - evicted_games) * gameMemoryEstimate() +
+           (size_t) evicted_games * GAME_INDEX_ENTRY_MEMORY_ESTIMATE +
+           (size_t) mapGetSize(chess->players) * playerMemoryEstimate(true) +
+           (size_t) (chess->tournament_player_entries - evicted_players) * playerMemoryEstimate(false) +
+           gameArchiveGetMemoryFootprint(chess->archive) + changeFeedGetMemoryFootprint(chess->feed);
+}
+
+/**
+*	chessHasMemoryFor: checks if the chess system's memory budget has room for more memory, besides the memory
+*                      reserved for the games being added. The tail lock must be locked, or the whole chess
+*                      system locked exclusively.
+*
+* @param chess - The chess system which is being checked.
+* @param size - The size in bytes of the memory that is about to be added.
+*
+* @return
+* 	true - If the system has no budget, or the memory fits in it.
+*   false - Otherwise.
+*/
+static bool chessHasMemoryFor(ChessSystem chess, size_t size)
+{
+    return chess->memory_limit == UNLIMITED_MEMORY ||
+           chessEstimateMemoryUsage(chess) + chess->memory_reserved + size <= chess->memory_limit;
+}
+
+/**
+*	chessAddGameMemoryEstimate: estimates the memory a new game would add to the chess system.
+*
+* @param tournament - The tournament in which the new game occurs.
+* @param players - The IDs of the game's players.
+* @param system_players - The game's players in the system's players map, NULL for players who are not there.
+*
+* @return
+* 	The estimated size in bytes.
+*/
+static size_t chessAddGameMemoryEstimate(Tournament tournament, int *players, Player *system_players)
+{
+    size_t size = gameMemoryEstimate();
+
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        if (system_players[index] == NULL)
+        {
+            size = size + playerMemoryEstimate(true);
+        }
+        if (mapContains(tournamentGetPlayersMap(tournament), &players[index]) == false)
+        {
+            size = size + playerMemoryEstimate(false);
+        }
+    }
+    return size;
+}
+
+static ChessResult chessSetMemoryBudgetLocked(ChessSystem chess, size_t memory_budget)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    chess->memory_limit = memory_budget;
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessGetMemoryUsageLocked(ChessSystem chess, size_t *memory_used, size_t *memory_budget)
+{
+    if (chess == NULL || memory_used == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    *memory_used = chessEstimateMemoryUsage(chess);
+    if (memory_budget != NULL)
+    {
+        *memory_budget = chess->memory_limit;
+    }
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessEnableSpillLocked(ChessSystem chess, const char *path, int cache_capacity)
+{
+    if (chess == NULL || path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (chess->spill_cache != NULL)
+    {
+        tournamentCacheSetCapacity(chess->spill_cache, cache_capacity);
+        return CHESS_SUCCESS;
+    }
+
+    chess->spill_cache = tournamentCacheCreate(path, cache_capacity);
+    if (chess->spill_cache == NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    ChessResult result = CHESS_SUCCESS;
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments, current_tournament_id);
+        if (tournamentGetWinner(current_tournament) != TOURNAMENT_NOT_ENDED &&
+            tournamentSpill(current_tournament, chess->spill_cache) == false)
+        {
+            result = CHESS_SAVE_FAILURE;
+        }
+        free(current_tournament_id);
+    }
+    return result;
+}
+
+/**
+*	chessJournalRecord: records a mutation which was applied to the chess system in its journal, if one
+*                       is attached. If the record couldn't be written, the journal is detached.
+*
+* @param chess - The chess system which was mutated.
+* @param type - The type of the mutation.
+* @param arguments - The arguments of the mutation, as many as its type has.
+* @param text - The location of a new tournament. NULL for other mutations.
+*
+* @return
+* 	CHESS_SAVE_FAILURE - If the record couldn't be written.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessJournalRecord(ChessSystem chess, JournalRecordType type, const int *arguments,
+                                      const char *text)
+{
+    if (chess->journal == NULL)
+    {
+        return CHESS_SUCCESS;
+    }
+
+    JournalRecord record = {type, chess->journal_sequence + 1, {0}, text};
+    for (int index = 0; index < JOURNAL_MAX_ARGUMENTS; index++)
+    {
+        record.arguments[index] = arguments[index];
+    }
+    if (journalAppend(chess->journal, &record) == false)
+    {
+        journalClose(chess->journal);
+        chess->journal = NULL;
+        return CHESS_SAVE_FAILURE;
+    }
+    chess->journal_sequence = record.sequence;
+    return CHESS_SUCCESS;
+}
+
+/**
+*	chessAddTournamentErrorCheck: checks errors for chessAddTournament function and returns
+*                                 relevant error value.
+*
+* @param chess - See chessSystem.h
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult chessAddTournamentErrorCheck(ChessSystem chess, int tournament_id, 
+                                      int max_games_per_player, const char *tournament_location)
+{
+    if (chess == NULL || tournament_location == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(tournament_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (mapContains(chess->tournaments, &tournament_id) == true)
+    {
+        return CHESS_TOURNAMENT_ALREADY_EXISTS;
+    }
+
+    if (isLocationValid(tournament_location) == false)
+    {
+        return CHESS_INVALID_LOCATION;
+    }
+
+    if (isMaxGamesPerPlayerValid(max_games_per_player) == false)
+    {
+        return CHESS_INVALID_MAX_GAMES;
+    } 
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessAddTournamentLocked(ChessSystem chess, int tournament_id, int max_games_per_player,
+                                            const char *tournament_location)
+{
+    ChessResult error_type = chessAddTournamentErrorCheck(chess, tournament_id,
+                                                          max_games_per_player, tournament_location);
+
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    } 
+
+    Tournament new_tournament = tournamentCreate(max_games_per_player, tournament_location);
+    if (new_tournament == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    size_t tournament_memory = tournamentMemoryEstimate(new_tournament);
+    if (chessHasMemoryFor(chess, tournament_memory) == false ||
+        mapPut(chess->tournaments, &tournament_id, new_tournament) != MAP_SUCCESS)
+    {
+        tournamentDestroy(new_tournament);
+        return CHESS_OUT_OF_MEMORY;
+    }
+    chess->tournaments_memory += tournament_memory;
+    tournamentDestroy(new_tournament);
+    chessPublishChange(chess, CHESS_CHANGE_TOURNAMENT_ADDED, tournament_id, 0, 0, 0);
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {tournament_id, max_games_per_player};
+    return chessJournalRecord(chess, JOURNAL_ADD_TOURNAMENT, arguments, tournament_location);
+}
+
+/**
+*	playersAddStatsToMap: add given players score and playtime to players map.
+*
+* @param players_map - The players map to which add stats.  
+* @param player1 - First player's ID. Must be positive.
+* @param player2 - Second player's ID. Must be positive.
+* @param winner - indicates the winner in the match.
+*
+* @return
+* 	None
+*/
+static void playersAddStatsToMap(Map players_map, int player1, int player2, Winner winner, int play_time)
+{
+    Player first_player = mapGet(players_map, &player1);
+    Player second_player = mapGet(players_map, &player2);
+    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
+    playersAddScore(players, winner);
+    playersAddPlayTime(players, play_time);
+}
+
+/**
+*	isGameExistInTournament: check if the given game exists in the given tournament. Only the games of the
+*                            player with the smaller game index are scanned.
+*
+* @param tournament_id - The ID of the tournament to check.
+* @param tournament - The tournament to check.
+* @param player1 - First player's ID. Must be positive.
+* @param player2 - Second player's ID. Must be positive.
+* @param first_index - The game index of the first player, NULL if the player has none.
+* @param second_index - The game index of the second player, NULL if the player has none.
+*
+* @return
+* 	true - If the given game exists in the tournament.
+*   false - If the given game doesn't exist in the tournament.
+*/
+static bool isGameExistInTournament(int tournament_id, Tournament tournament, int player1, int player2,
+                                    GameIndex first_index, GameIndex second_index)
+{
+    if (first_index == NULL || second_index == NULL)
+    {
+        return false;
+    }
+
+    GameIndex index = (gameIndexGetSize(first_index) <= gameIndexGetSize(second_index)) ? first_index : second_index;
+    for (int position = 0; position < gameIndexGetSize(index); position++)
+    {
+        if (gameIndexGetTournamentID(index, position) != tournament_id)
+        {
+            continue;
+        }
+        int game_id = gameIndexGetGameID(index, position);
+        Game current_game = mapGet(tournamentGetGamesMap(tournament), &game_id);
+        if (current_game != NULL && isPlayerInCurrentGame(current_game, player1) == true &&
+            isPlayerInCurrentGame(current_game, player2) == true)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+*	playerSetupInMap: check if a given player exists in players map - if not, he is added to the map,
+*                     else nothing is done. If the players map belongs to a tournament, the function
+*                     updates the number of players in the tournament.
+*                     
+*
+* @param tournament - The tournament to update number of players if the players map belongs to a tournament. 
+* @param players_map - The players map which to check and update player.  
+* @param player_id - player's ID. Must be positive.
+* @param created - Output which is set to true if the player was added to the map.
+*
+* @return
+* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
+*   MAP_SUCCESS - If the player setup was done successfully.
+*/
+static MapResult playerSetupInMap(Tournament tournament, Map player_map, int player_id, bool *created)
+{
+    if (mapContains(player_map, &player_id) == false)
+    {
+        Player player = playerCreate(player_id);
+        if (player == NULL)
+        {
+            return MAP_OUT_OF_MEMORY;
+        }
+
+        MapResult put_result = mapPut(player_map, &player_id, player);
+        playerDestroy(player);
+        if (put_result != MAP_SUCCESS)
+        {
+            return MAP_OUT_OF_MEMORY;
+        }
+        *created = true;
+
+        if (player_map == tournamentGetPlayersMap(tournament))
+        {
+            tournamentUpdateNumberOfPlayers(tournament);
+        }
+    }
+    return MAP_SUCCESS;
+}
+
+/**
+*	playerGamesSetup: creates the game index of the given player of the system's players map, if the player
+*                     has none.
+*
+* @param chess - The chess system which holds the player.
+* @param player - The player.
+* @param created - Output which is set to true if the player's index was created.
+*
+* @return
+* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
+*   MAP_SUCCESS - If the player has a game index.
+*/
+static MapResult playerGamesSetup(ChessSystem chess, Player player, bool *created)
+{
+    if (playerGetGames(player) == NULL)
+    {
+        GameIndex new_index = gameIndexCreate(chess->game_index_capacity);
+        if (new_index == NULL)
+        {
+            return MAP_OUT_OF_MEMORY;
+        }
+        playerSetGames(player, new_index);
+        *created = true;
+    }
+    return MAP_SUCCESS;
+}
+
+/**
+*	playerGamesAdd: adds a game to the game index of the given player, creating the player's index if needed.
+*
+* @param chess - The chess system which holds the player.
+* @param player - The player who participated in the game, from the system's players map.
+* @param tournament_id - The ID of the game's tournament.
+* @param game_id - The ID of the game in its tournament.
+* @param created - Output which is set to true if the player's index was created.
+*
+* @return
+* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
+*   MAP_SUCCESS - If the game was added successfully.
+*/
+static MapResult playerGamesAdd(ChessSystem chess, Player player, int tournament_id, int game_id, bool *created)
+{
+    if (playerGamesSetup(chess, player, created) != MAP_SUCCESS ||
+        gameIndexAdd(playerGetGames(player), tournament_id, game_id) == false)
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+    return MAP_SUCCESS;
+}
+
+/** Type for recording which entries a new game added to the system, so they can be rolled back */
+typedef struct game_assignment_t
+{
+    int tournament_id;
+    int game_id;
+    int players[NUMBER_OF_PLAYERS_IN_GAME];
+    bool game_added;
+    bool player_created[NUMBER_OF_PLAYERS_IN_GAME];
+    bool tournament_player_created[NUMBER_OF_PLAYERS_IN_GAME];
+    bool index_created[NUMBER_OF_PLAYERS_IN_GAME];
+    bool index_added[NUMBER_OF_PLAYERS_IN_GAME];
+    Player system_players[NUMBER_OF_PLAYERS_IN_GAME];
+    GameIndex indexes[NUMBER_OF_PLAYERS_IN_GAME];
+    size_t reserved_memory;
+} GameAssignment;
+
+/**
+*	chessFindPlayer: finds a player in the system's players map, and its game index, through the player directory.
+*                    A player which is in the maps but not in the directory is added to it. The directory stripe
+*                    of the player must be locked.
+*
+* @param chess - The chess system.
+* @param player_id - The ID of the player.
+* @param player - Output for the player, NULL if it doesn't exist.
+* @param games - Output for the player's game index, NULL if it doesn't exist.
+*
+* @return
+* 	None
+*/
+static void chessFindPlayer(ChessSystem chess, int player_id, Player *player, GameIndex *games)
+{
+    if (playerDirectoryFind(chess->directory, player_id, player, games) == true)
+    {
+        return;
+    }
+
+    chessMutexLock(&chess->players_lock);
+    *player = mapGet(chess->players, &player_id);
+    *games = playerGetGames(*player);
+    chessMutexUnlock(&chess->players_lock);
+    // The directory only saves walking the maps, so a player which didn't fit in it is still found later
+    if (*player != NULL && *games != NULL)
+    {
+        playerDirectoryInsert(chess->directory, player_id, *player, *games);
+    }
+}
+
+/**
+*	chessFindGamePlayers: finds the players of a new game in the system's players map, and their game indexes,
+*                         through the player directory. The directory stripes of the players must be locked.
+*
+* @param chess - The chess system to which the game is added.
+* @param assignment - The IDs of the game's players. Their players and game indexes are set, to NULL for the
+*                     ones which don't exist.
+*
+* @return
+* 	None
+*/
+static void chessFindGamePlayers(ChessSystem chess, GameAssignment *assignment)
+{
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        chessFindPlayer(chess, assignment->players[index], &assignment->system_players[index],
+                        &assignment->indexes[index]);
+    }
+}
+
+/**
+*	chessPublishPlayer: publishes the statistics of a player in the player directory, for the readers which don't
+*                       lock the chess system. The directory stripe of the player must be locked.
+*
+* @param chess - The chess system.
+* @param player - The player.
+*
+* @return
+* 	None
+*/
+static void chessPublishPlayer(ChessSystem chess, Player player)
+{
+    PlayerDirectoryStats stats = {playerGetWins(player), playerGetLoses(player), playerGetDraws(player),
+                                  playerGetTotalPlayTime(player)};
+    playerDirectoryPublish(chess->directory, playerGetID(player), &stats);
+}
+
+/**
+*	chessSetupGamePlayer: adds a player of a new game to the system's players map and creates the player's game
+*                         index, if they don't exist yet, and adds the player to the player directory. The
+*                         directory stripe of the player must be locked.
+*
+* @param chess - The chess system to which the game is added.
+* @param tournament - The tournament in which the new game occurs.
+* @param assignment - The IDs of the game and its players, and the record of the added entries.
+* @param index - The index of the player in the game.
+*
+* @return
+* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
+*   MAP_SUCCESS - If the player and the game index exist.
+*/
+static MapResult chessSetupGamePlayer(ChessSystem chess, Tournament tournament, GameAssignment *assignment,
+                                      int index)
+{
+    if (assignment->system_players[index] != NULL && assignment->indexes[index] != NULL)
+    {
+        return MAP_SUCCESS;
+    }
+
+    int player_id = assignment->players[index];
+    chessMutexLock(&chess->players_lock);
+    MapResult result = playerSetupInMap(tournament, chess->players, player_id, &assignment->player_created[index]);
+    assignment->system_players[index] = mapGet(chess->players, &player_id);
+    if (result == MAP_SUCCESS)
+    {
+        result = playerGamesSetup(chess, assignment->system_players[index], &assignment->index_created[index]);
+    }
+    assignment->indexes[index] = playerGetGames(assignment->system_players[index]);
+    chessMutexUnlock(&chess->players_lock);
+    if (result == MAP_SUCCESS)
+    {
+        playerDirectoryInsert(chess->directory, player_id, assignment->system_players[index],
+                              assignment->indexes[index]);
+    }
+    return result;
+}
+
+/**
+*	newGameSystemAssign: Assigns a new game to the tournament games map, updates the system's and the
+*                        tournament's players maps with the two players if they don't exist in them, and adds
+*                        the game to the players' game indexes. Everything that was added is recorded, so it
+*                        can be rolled back if one of the steps fails.
+*
+* @param chess - The chess system to which the game is added.
+* @param tournament - The tournament in which the new game occurs.
+* @param new_game- The new game to assign to games map.  
+* @param assignment - The IDs of the game and its players, and the record of the added entries.
+*
+* @return
+* 	CHESS_OUT_OF_MEMORY - If there was a memory allocation error.
+*   CHESS_SUCCESS - If the new game was successfully assigned and the maps were updated.
+*/
+static ChessResult newGameSystemAssign(ChessSystem chess, Tournament tournament, Game new_game,
+                                       GameAssignment *assignment)
+{
+    if (mapPut(tournamentGetGamesMap(tournament), &assignment->game_id, new_game) != MAP_SUCCESS)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    assignment->game_added = true;
+
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        int player_id = assignment->players[index];
+        if (chessSetupGamePlayer(chess, tournament, assignment, index) != MAP_SUCCESS ||
+            playerSetupInMap(tournament, tournamentGetPlayersMap(tournament), player_id,
+                             &assignment->tournament_player_created[index]) != MAP_SUCCESS ||
+            gameIndexAdd(assignment->indexes[index], assignment->tournament_id, assignment->game_id) == false)
+        {
+            return CHESS_OUT_OF_MEMORY;
+        }
+        assignment->index_added[index] = true;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	newGameSystemRollback: Removes everything a failed newGameSystemAssign added to the system,
+*                          leaving it exactly as it was before. The directory stripes of the players must be
+*                          locked, or the whole chess system locked exclusively.
+*
+* @param chess - The chess system to which the game was being added.
+* @param tournament - The tournament in which the new game occurs.
+* @param assignment - The record of the entries that were added.
+*
+* @return
+* 	None
+*/
+static void newGameSystemRollback(ChessSystem chess, Tournament tournament, GameAssignment *assignment)
+{
+    chessMutexLock(&chess->players_lock);
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        int player_id = assignment->players[index];
+        Player player = mapGet(chess->players, &player_id);
+        if (assignment->index_added[index] == true)
+        {
+            gameIndexRemoveLast(playerGetGames(player));
+        }
+        if (assignment->index_created[index] == true || assignment->player_created[index] == true)
+        {
+            playerDirectoryRemove(chess->directory, player_id);
+        }
+        if (assignment->index_created[index] == true)
+        {
+            playerSetGames(player, NULL);
+        }
+        if (assignment->tournament_player_created[index] == true)
+        {
+            mapRemove(tournamentGetPlayersMap(tournament), &player_id);
+            tournamentDecreaseNumberOfPlayers(tournament);
+        }
+        if (assignment->player_created[index] == true)
+        {
+            mapRemove(chess->players, &player_id);
+        }
+    }
+    chessMutexUnlock(&chess->players_lock);
+    if (assignment->game_added == true)
+    {
+        mapRemove(tournamentGetGamesMap(tournament), &assignment->game_id);
+    }
+}
+
+/**
+*	chessFindTournament: finds a tournament in the chess system's tournaments map.
+*
+* @param chess - The chess system.
+* @param tournament_id - The ID of the tournament.
+*
+* @return
+* 	NULL - If the tournament doesn't exist.
+*   The tournament otherwise.
+*/
+static Tournament chessFindTournament(ChessSystem chess, int tournament_id)
+{
+    chessMutexLock(&chess->tournaments_lock);
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    chessMutexUnlock(&chess->tournaments_lock);
+    return tournament;
+}
+
+/**
+*	chessAddGameErrorCheck: checks the errors of chessAddGame function that don't depend on the tournament's
+*                           games, and returns relevant error value.
+*
+* @param chess - See chessSystem.h
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult chessAddGameErrorCheck(ChessSystem chess, int tournament_id, int first_player,
+                                          int second_player)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(tournament_id) == false ||
+        isValidID(first_player) == false || 
+        isValidID(second_player) == false ||
+        first_player == second_player)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (chessFindTournament(chess, tournament_id) == NULL)
+    {
+        return CHESS_TOURNAMENT_NOT_EXIST;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	tournamentAddGameErrorCheck: checks the errors of chessAddGame function that depend on the tournament,
+*                                and returns relevant error value. If the system has a memory budget, the
+*                                memory of the new game is reserved in it, until the game is added or fails.
+*
+* @param chess - See chessSystem.h
+* @param tournament - The tournament in which the new game occurs.
+* @param assignment - The IDs of the game's tournament and players, with the players found by
+*                     chessFindGamePlayers. The reserved memory is set.
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult tournamentAddGameErrorCheck(ChessSystem chess, Tournament tournament,
+                                               GameAssignment *assignment, int play_time)
+{
+    int first_player = assignment->players[0];
+    int second_player = assignment->players[1];
+    if (tournamentGetWinner(tournament) != TOURNAMENT_NOT_ENDED)
+    {
+        return CHESS_TOURNAMENT_ENDED;
+    }
+
+    if (isGameExistInTournament(assignment->tournament_id, tournament, first_player, second_player,
+                                assignment->indexes[0], assignment->indexes[1]) == true)
+    {
+        return CHESS_GAME_ALREADY_EXISTS;
+    }
+
+    if (isPlayTimeValid(play_time) == false)
+    {
+        return CHESS_INVALID_PLAY_TIME;
+    }
+
+    if (isMaxGamesPerPlayerExceeded(tournament, first_player) == true || 
+        isMaxGamesPerPlayerExceeded(tournament, second_player) == true)
+    {
+        return CHESS_EXCEEDED_GAMES;
+    }
+
+    if (chess->memory_limit != UNLIMITED_MEMORY)
+    {
+        size_t size = chessAddGameMemoryEstimate(tournament, assignment->players, assignment->system_players);
+        chessMutexLock(&chess->players_lock);
+        chessMutexLock(&chess->tail_lock);
+        // Games added at once by other threads fit in the budget along with the reserved memory
+        bool has_memory = chessHasMemoryFor(chess, size);
+        if (has_memory == true)
+        {
+            chess->memory_reserved += size;
+            assignment->reserved_memory = size;
+        }
+        chessMutexUnlock(&chess->tail_lock);
+        chessMutexUnlock(&chess->players_lock);
+        if (has_memory == false)
+        {
+            return CHESS_OUT_OF_MEMORY;
+        }
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	chessReleaseReservedMemory: releases the memory reserved for a new game which failed to be added.
+*
+* @param chess - The chess system to which the game was being added.
+* @param assignment - The record of the new game, with the memory reserved by tournamentAddGameErrorCheck.
+*
+* @return
+* 	None
+*/
+static void chessReleaseReservedMemory(ChessSystem chess, GameAssignment *assignment)
+{
+    chessMutexLock(&chess->tail_lock);
+    chess->memory_reserved -= assignment->reserved_memory;
+    chessMutexUnlock(&chess->tail_lock);
+    assignment->reserved_memory = 0;
+}
+
+/**
+*	tournamentAssignGame: adds a new game to the given tournament and to the system, once its errors were
+*                         checked. The tournament and the directory stripes of the players must be locked.
+*                         The memory reserved for the game is released once it is counted by the system.
+*
+* @param chess - See chessSystem.h
+* @param tournament - The tournament in which the new game occurs.
+* @param assignment - The IDs of the game's tournament and players, with the players found by
+*                     chessFindGamePlayers. The ID of the game is set.
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult tournamentAssignGame(ChessSystem chess, Tournament tournament, GameAssignment *assignment,
+                                        Winner winner, int play_time)
+{
+    int tournament_id = assignment->tournament_id;
+    int first_player = assignment->players[0];
+    int second_player = assignment->players[1];
+    Game new_game = gameCreate(winner, play_time, first_player, second_player);
+    if (new_game == NULL)
+    {
+        chessReleaseReservedMemory(chess, assignment);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    assignment->game_id = tournamentGenerateGameID(tournament);
+    tournamentSetDirty(tournament, true);
+    if (newGameSystemAssign(chess, tournament, new_game, assignment) != CHESS_SUCCESS)
+    {
+        newGameSystemRollback(chess, tournament, assignment);
+        chessReleaseReservedMemory(chess, assignment);
+        gameDestroy(new_game);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    playersAddScore(assignment->system_players, winner);
+    playersAddPlayTime(assignment->system_players, play_time);
+    playersAddStatsToMap(tournamentGetPlayersMap(tournament), first_player, second_player, winner, play_time);
+    tournamentUpdateStats(tournament, play_time);
+    chessPublishPlayer(chess, assignment->system_players[0]);
+    chessPublishPlayer(chess, assignment->system_players[1]);
+
+    chessMutexLock(&chess->tail_lock);
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        chess->tournament_player_entries += (assignment->tournament_player_created[index] == true);
+        playerSetVersion(assignment->system_players[index], ++chess->levels_version);
+    }
+    chess->number_of_games++;
+    chess->memory_reserved -= assignment->reserved_memory;
+    chess->players_dirty = true;
+    chessArchivePut(chess, tournament_id, assignment->game_id, new_game);
+    chessPublishGame(chess, CHESS_CHANGE_GAME_ADDED, tournament_id, assignment->game_id, new_game);
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {tournament_id, first_player, second_player, winner, play_time};
+    ChessResult result = chessJournalRecord(chess, JOURNAL_ADD_GAME, arguments, NULL);
+    chessMutexUnlock(&chess->tail_lock);
+
+    gameDestroy(new_game);
+    return result;
+}
+
+/**
+*	tournamentAddGame: adds a new game to the given tournament, after checking the errors that depend on
+*                      the tournament. The tournament's ID and the players' IDs must have been checked already.
+*                      Games of different tournaments may be added by several threads at once.
+*
+* @param chess - See chessSystem.h
+* @param tournament - The tournament in which the new game occurs.
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult tournamentAddGame(ChessSystem chess, int tournament_id, Tournament tournament,
+                                     int first_player, int second_player, Winner winner, int play_time)
+{
+    GameAssignment assignment = {.tournament_id = tournament_id, .players = {first_player, second_player}};
+    tournamentLock(tournament);
+    playerDirectoryLock(chess->directory, first_player, second_player);
+    chessFindGamePlayers(chess, &assignment);
+    ChessResult result = tournamentAddGameErrorCheck(chess, tournament, &assignment, play_time);
+    if (result == CHESS_SUCCESS)
+    {
+        result = tournamentAssignGame(chess, tournament, &assignment, winner, play_time);
+    }
+    playerDirectoryUnlock(chess->directory, first_player, second_player);
+    tournamentUnlock(tournament);
+    return result;
+}
+
+static ChessResult chessAddGameLocked(ChessSystem chess, int tournament_id, int first_player, int second_player,
+                                      Winner winner, int play_time)
+{
+    ChessResult error_type = chessAddGameErrorCheck(chess, tournament_id, first_player, second_player);
+
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    } 
+    
+    Tournament current_tournament = chessFindTournament(chess, tournament_id);
+    return tournamentAddGame(chess, tournament_id, current_tournament, first_player, second_player,
+                             winner, play_time);
+}
+
+/**
+*	chessImportRecord: adds a single game read from a game log to the chess system.
+*
+* @param chess - The chess system to which the game is added.
+* @param record - The game record.
+* @param cached_id - The ID of the tournament of the previous record, updated to the record's tournament.
+* @param cached_tournament - The tournament of the previous record, updated to the record's tournament.
+*
+* @return
+*   CHESS_INVALID_ID - If the record is malformed.
+*   Otherwise, the result chessAddGame would have returned for the record.
+*/
+static ChessResult chessImportRecord(ChessSystem chess, const GameLogRecord *record, int *cached_id,
+                                     Tournament *cached_tournament)
+{
+    if (record->valid == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    // Logs are usually grouped by tournament, so the last tournament found is reused
+    if (*cached_tournament == NULL || *cached_id != record->tournament_id)
+    {
+        ChessResult error_type = chessAddGameErrorCheck(chess, record->tournament_id, record->first_player,
+                                                        record->second_player);
+        if (error_type != CHESS_SUCCESS)
+        {
+            return error_type;
+        }
+        *cached_id = record->tournament_id;
+        *cached_tournament = mapGet(chess->tournaments, cached_id);
+    }
+    else if (isValidID(record->first_player) == false || isValidID(record->second_player) == false ||
+             record->first_player == record->second_player)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    return tournamentAddGame(chess, record->tournament_id, *cached_tournament, record->first_player,
+                             record->second_player, record->winner, record->play_time);
+}
+
+/**
+*	importStatsAddError: records an error of a game log line in the import statistics.
+*
+* @param stats - The import statistics.
+* @param line - The line of the error in the game log.
+* @param error_type - The error of the line.
+*
+* @return
+* 	None
+*/
+static void importStatsAddError(ChessImportStats *stats, int line, ChessResult error_type)
+{
+    if (stats->number_of_errors < stats->max_errors)
+    {
+        stats->errors[stats->number_of_errors].line = line;
+        stats->errors[stats->number_of_errors].result = error_type;
+    }
+    stats->number_of_errors++;
+}
+
+/**
+*	chessImportRecords: adds the games of the given game log records to the chess system, one by one.
+*
+* @param chess - The chess system to which the games are added.
+* @param records - The game log records.
+* @param number_of_records - The number of records.
+* @param stats - The import statistics to update.
+* @param cached_id - The ID of the tournament of the previous record. Updated after each record.
+* @param cached_tournament - The tournament of the previous record. Updated after each record.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - If a record failed on memory. The records after it are not added.
+*   CHESS_SAVE_FAILURE - If a game was added, but couldn't be recorded in the journal.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessImportRecords(ChessSystem chess, const GameLogRecord *records, int number_of_records,
+                                      ChessImportStats *stats, int *cached_id, Tournament *cached_tournament)
+{
+    ChessResult result = CHESS_SUCCESS;
+    for (int index = 0; index < number_of_records; index++)
+    {
+        ChessResult line_result = chessImportRecord(chess, &records[index], cached_id, cached_tournament);
+        stats->lines_read++;
+        if (line_result == CHESS_SUCCESS || line_result == CHESS_SAVE_FAILURE)
+        {
+            stats->games_added++;
+            result = (line_result == CHESS_SAVE_FAILURE) ? CHESS_SAVE_FAILURE : result;
+            continue;
+        }
+        importStatsAddError(stats, records[index].line, line_result);
+        if (line_result == CHESS_OUT_OF_MEMORY)
+        {
+            return CHESS_OUT_OF_MEMORY;
+        }
+    }
+    return result;
+}
+
+/**
+*	chessImportErrorCheck: checks the arguments of the import functions, and resets the import statistics.
+*
+* @param chess - See chessSystemExtensions.h
+*
+* @return
+*   See chessSystemExtensions.h
+*/
+static ChessResult chessImportErrorCheck(ChessSystem chess, const char *path, ChessImportStats *stats)
+{
+    if (chess == NULL || path == NULL || stats == NULL || (stats->errors == NULL && stats->max_errors > 0))
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    stats->lines_read = 0;
+    stats->games_added = 0;
+    stats->number_of_errors = 0;
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessImportGamesLocked(ChessSystem chess, const char *path, ChessImportStats *stats)
+{
+    ChessResult error_type = chessImportErrorCheck(chess, path, stats);
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+
+    GameLogReader reader = gameLogReaderCreate(path);
+    if (reader == NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    GameLogRecord *records = malloc(sizeof(*records) * IMPORT_BATCH_SIZE);
+    if (records == NULL)
+    {
+        gameLogReaderDestroy(reader);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    ChessResult result = CHESS_SUCCESS;
+    int cached_id = 0;
+    Tournament cached_tournament = NULL;
+    int number_of_records = 0;
+    while (result != CHESS_OUT_OF_MEMORY &&
+           (number_of_records = gameLogReaderRead(reader, records, IMPORT_BATCH_SIZE)) > 0)
+    {
+        ChessResult batch_result = chessImportRecords(chess, records, number_of_records, stats, &cached_id,
+                                                      &cached_tournament);
+        result = (batch_result != CHESS_SUCCESS) ? batch_result : result;
+    }
+
+    free(records);
+    gameLogReaderDestroy(reader);
+    return result;
+}
+
+/**
+*	playersRemoveStats: remove given players score and playtime from players map.
+*
+* @param players_map - The players map from which to remove player stats.  
+* @param player1 - First player's ID. Must be positive.
+* @param player2 - Second player's ID. Must be positive.
+* @param winner - Indicates the winner in the match.
+*
+* @return
+* 	None
+*/
+static void playersRemoveStats(Map players_map, int player1, int player2, Winner winner, int play_time)
+{
+    if (isValidID(player1) == false && isValidID(player2) == false)
+    {
+        return;
+    }
+    Player first_player = mapGet(players_map, &player1);
+    Player second_player = mapGet(players_map, &player2);
+    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
+    playersRemoveScore(players, winner);
+    playersRemovePlayTime(players, play_time);
+}
+
+/**
+*	chessRemoveTournamentGames: remove the score and playtime of every game in the given tournament
+*                               from the chess system's players map, and the games from the players' game indexes.
+*                               The tournament's memory is released from the system's memory usage.
+*
+* @param chess - The chess system from which the tournament is being removed.
+* @param tournament_id - The ID of the tournament which is being removed.
+* @param tournament - The tournament whose games are being removed.
+*
+* @return
+* 	None
+*/
+static void chessRemoveTournamentGames(ChessSystem chess, int tournament_id, Tournament tournament)
+{
+    chess->tournaments_memory -= tournamentMemoryEstimate(tournament);
+    chess->number_of_games -= mapGetSize(tournamentGetGamesMap(tournament));
+    chess->tournament_player_entries -= mapGetSize(tournamentGetPlayersMap(tournament));
+    chess->players_dirty = true;
+
+    MAP_FOREACH(Game, current_game_id, tournamentGetGamesMap(tournament))
+    {
+        Game current_game = mapGet(tournamentGetGamesMap(tournament) ,current_game_id);
+        int first_player = gameGetFirstPlayer(current_game);
+        int second_player = gameGetSecondPlayer(current_game);
+        playersRemoveStats(chess->players, first_player, second_player,
+                            gameGetWinner(current_game), gameGetPlayTime(current_game));
+        chessTouchPlayers(chess, first_player, second_player);
+        gameArchiveRemove(chess->archive, tournament_id, *(int*) current_game_id);
+        gameIndexRemoveTournament(playerGetGames(mapGet(chess->players, &first_player)), tournament_id);
+        gameIndexRemoveTournament(playerGetGames(mapGet(chess->players, &second_player)), tournament_id);
+        free(current_game_id);
+    }
+}
+
+/**
+*	chessRemoveTournamentErrorCheck: checks errors for chessRemoveTournament function and returns
+*                                 relevant error value.
+*
+* @param chess - See chessSystem.h
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult chessRemoveTournamentErrorCheck(ChessSystem chess, int tournament_id) 
+{
+    if (chess == NULL || chess->tournaments == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(tournament_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (mapContains(chess->tournaments, &tournament_id) == false)
+    {
+        return CHESS_TOURNAMENT_NOT_EXIST;
+    }
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessRemoveTournamentLocked(ChessSystem chess, int tournament_id)
+{
+    ChessResult error_type = chessRemoveTournamentErrorCheck(chess, tournament_id);
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+
+    Tournament current_tournament = mapGet(chess->tournaments, &tournament_id);
+    chessRemoveTournamentGames(chess, tournament_id, current_tournament);
+
+    mapRemove(chess->tournaments, &tournament_id);
+    chessPublishChange(chess, CHESS_CHANGE_TOURNAMENT_REMOVED, tournament_id, 0, 0, 0);
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {tournament_id};
+    return chessJournalRecord(chess, JOURNAL_REMOVE_TOURNAMENT, arguments, NULL);
+}
+
+/**
+*	playersMapTechnicalWinUpdateScore: Assigns a technical win to the opponent of the given player and              
+*                                      updates players scores.
+*
+* @param players_map - The players map, which needed to be updated with technical win score.
+* @param player1 - First player's ID. Must be positive.
+* @param player2 - Second player's ID. Must be positive.
+* @param opponent - The ID of the opponent in the game, who gets a technical win.
+* @param winner - The winner of the game before the technical win occurs.
+*
+* @return
+*   None
+*/
+static void playersMapTechnicalWinUpdateScore(Map players_map, int player1, int player2,
+                                    int opponent, Winner winner)
+{
+    if (isValidID(player1) == false || isValidID(player2) == false)
+    {
+        return;
+    }
+    Player first_player = mapGet(players_map, &player1);
+    Player second_player = mapGet(players_map, &player2);
+    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
+    Winner new_winner = (opponent == player1) ? FIRST_PLAYER : SECOND_PLAYER;
+    playersRemoveScore(players, winner);
+    playersAddScore(players, new_winner);
+}
+
+/**
+*	gameRemovePlayer: Removes the given player from the given game - the opponent gets a technical win
+*                     (if he wasn't removed already) and the player's ID in the game is marked as deleted.
+*
+* @param chess_players_map - The chess system's general players map, which needed to be updated.
+* @param tournament_players_map - The players map of the game's tournament, which needed to be updated.
+* @param game - The game from which to remove the player. The player must participate in it.
+* @param player_id - The ID of the removed player.
+*
+* @return
+*   None
+*/
+static void gameRemovePlayer(Map chess_players_map, Map tournament_players_map, Game game, int player_id)
+{
+    int opponent_id = gameGetOpponent(game, player_id);
+    if (isValidID(opponent_id) == true)
+    {
+        playersMapTechnicalWinUpdateScore(chess_players_map, gameGetFirstPlayer(game),
+                                          gameGetSecondPlayer(game), opponent_id, gameGetWinner(game));
+
+        playersMapTechnicalWinUpdateScore(tournament_players_map, gameGetFirstPlayer(game),
+                                          gameGetSecondPlayer(game), opponent_id, gameGetWinner(game));
+
+        gameSetWinner(game, opponent_id);
+    }
+    gameUpdateDeletedPlayerID(game, player_id);
+}
+
+/**
+*	compareInt: Compares two integers. Used for sorting arrays of IDs.
+*
+* @param element1 - The first integer to compare.
+* @param element2 - The second integer to compare.
+*
+* @return
+* 	A positive number if the first integer is greater, zero if equal, otherwise negative.
+*/
+static int compareInt(const void *element1, const void *element2)
+{
+    return *(const int*) element1 - *(const int*) element2;
+}
+
+/**
+*	chessFindPlayedTournaments: finds the tournaments the given players played in, by their game indexes. A player
+*                               only has an entry in a tournament's players map if it had a game there, so
+*                               evicted tournaments missing from the result needn't be read back to remove the
+*                               players from them.
+*
+* @param chess - The chess system.
+* @param player_ids - The IDs of the players.
+* @param number_of_players - The number of players.
+* @param number_of_tournaments - Output for the number of tournaments found.
+*
+* @return
+* 	NULL - In case of memory error.
+*   The sorted IDs of the tournaments, without repetitions, which the caller frees.
+*/
+static int* chessFindPlayedTournaments(ChessSystem chess, const int *player_ids, int number_of_players,
+                                       int *number_of_tournaments)
+{
+    int capacity = 0;
+    for (int index = 0; index < number_of_players; index++)
+    {
+        capacity += gameIndexGetSize(playerGetGames(mapGet(chess->players, (MapKeyElement) &player_ids[index])));
+    }
+    int *tournament_ids = malloc(sizeof(*tournament_ids) * (capacity + 1));
+    if (tournament_ids == NULL)
+    {
+        return NULL;
+    }
+
+    int count = 0;
+    for (int index = 0; index < number_of_players; index++)
+    {
+        GameIndex game_index = playerGetGames(mapGet(chess->players, (MapKeyElement) &player_ids[index]));
+        for (int position = 0; position < gameIndexGetSize(game_index); position++)
+        {
+            tournament_ids[count++] = gameIndexGetTournamentID(game_index, position);
+        }
+    }
+    qsort(tournament_ids, count, sizeof(*tournament_ids), compareInt);
+
+    *number_of_tournaments = 0;
+    for (int index = 0; index < count; index++)
+    {
+        if (index == 0 || tournament_ids[index] != tournament_ids[index - 1])
+        {
+            tournament_ids[(*number_of_tournaments)++] = tournament_ids[index];
+        }
+    }
+    return tournament_ids;
+}
+
+/**
+*	isTournamentUnplayed: checks if a tournament is evicted to the spill file, and none of the players whose
+*                         tournaments were found by chessFindPlayedTournaments played in it.
+*
+* @param tournament_id - The ID of the tournament.
+* @param tournament - The tournament.
+* @param played_tournaments - The tournaments the players played in, or NULL if spilling is not enabled.
+* @param number_of_played - The number of tournaments the players played in.
+*
+* @return
+* 	true - If the tournament can be skipped without reading it back.
+*   false - Otherwise.
+*/
+static bool isTournamentUnplayed(int tournament_id, Tournament tournament, const int *played_tournaments,
+                                 int number_of_played)
+{
+    return played_tournaments != NULL && tournamentIsEvicted(tournament) == true &&
+           bsearch(&tournament_id, played_tournaments, number_of_played, sizeof(*played_tournaments),
+                   compareInt) == NULL;
+}
+
+/**
+*	chessRemovePlayerErrorCheck: checks errors for chessRemovePlayer function and returns
+*                                 relevant error value.
+*
+* @param chess - See chessSystem.h
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult chessRemovePlayerErrorCheck(ChessSystem chess, int player_id)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(player_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (mapContains(chess->players, &player_id) == false)
+    {
+        return CHESS_PLAYER_NOT_EXIST;
+    }
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessRemovePlayerLocked(ChessSystem chess, int player_id)
+{
+    ChessResult error_type = chessRemovePlayerErrorCheck(chess, player_id);
+
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+
+    int number_of_played = 0;
+    int *played_tournaments = NULL;
+    if (chess->spill_cache != NULL &&
+        (played_tournaments = chessFindPlayedTournaments(chess, &player_id, 1, &number_of_played)) == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
+        if (isTournamentUnplayed(*(int*) current_tournament_id, current_tournament, played_tournaments,
+                                 number_of_played) == true)
+        {
+            free(current_tournament_id);
+            continue;
+        }
+        if (tournamentGetWinner(current_tournament) == TOURNAMENT_NOT_ENDED)
+        {
+            MAP_FOREACH(Game, current_game_id, tournamentGetGamesMap(current_tournament))
+            {
+                Game current_game = mapGet(tournamentGetGamesMap(current_tournament) ,current_game_id);
+                Map tournament_players_map = tournamentGetPlayersMap(current_tournament);
+
+                if (isPlayerInCurrentGame(current_game, player_id) == true)            
+                {
+                    chessTouchPlayers(chess, gameGetFirstPlayer(current_game), gameGetSecondPlayer(current_game));
+                    gameRemovePlayer(chess->players, tournament_players_map, current_game, player_id);
+                    chessArchivePut(chess, *(int*) current_tournament_id, *(int*) current_game_id, current_game);
+                    chessPublishGame(chess, CHESS_CHANGE_GAME_CHANGED, *(int*) current_tournament_id,
+                                     *(int*) current_game_id, current_game);
+                    tournamentSetDirty(current_tournament, true);
+                }
+                free(current_game_id);
+            }
+        }
+        if (mapRemove(tournamentGetPlayersMap(current_tournament), &player_id) == MAP_SUCCESS)
+        {
+            chess->tournament_player_entries--;
+            tournamentSetDirty(current_tournament, true);
+        }
+        free(current_tournament_id);
+    }
+    free(played_tournaments);
+    playerDirectoryRemove(chess->directory, player_id);
+    mapRemove(chess->players, &player_id);
+    chess->players_dirty = true;
+    chessRecordRemovedPlayer(chess, player_id);
+    chessPublishChange(chess, CHESS_CHANGE_PLAYER_REMOVED, 0, player_id, 0, 0);
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {player_id};
+    return chessJournalRecord(chess, JOURNAL_REMOVE_PLAYER, arguments, NULL);
+}
+
+/** Type for pairing a removed ID with its position in the caller's removal order */
+typedef struct removal_entry_t
+{
+    int id;
+    int order;
+} RemovalEntry;
+
+/**
+*	compareRemovalEntry: Compares two removal entries by ID, and by removal order for equal IDs.
+*                        Used for sorting and searching removal sets.
+*
+* @param element1 - The first removal entry to compare.
+* @param element2 - The second removal entry to compare.
+*
+* @return
+* 	A positive number if the first entry is greater, zero if equal, otherwise negative.
+*/
+static int compareRemovalEntry(const void *element1, const void *element2)
+{
+    const RemovalEntry *first_entry = element1;
+    const RemovalEntry *second_entry = element2;
+
+    if (first_entry->id != second_entry->id)
+    {
+        return first_entry->id - second_entry->id;
+    }
+    return first_entry->order - second_entry->order;
+}
+
+/**
+*	removalSetCreate: Creates a sorted set of the given IDs which are valid and exist in the given map.
+*                     IDs that would fail when removed one by one in the given order (invalid, missing,
+*                     or already removed by an earlier occurrence) are left out, and the error of the
+*                     first such ID is reported.
+*
+* @param map - The map in which the IDs need to exist.
+* @param ids - The IDs to remove, in removal order.
+* @param number_of_ids - The number of IDs in the array. Must be positive.
+* @param not_exist_error - The error to report for an ID which doesn't exist in the map.
+* @param set_size - Output for the number of entries in the created set.
+* @param error - Output for the error of the first ID that was left out, CHESS_SUCCESS if none.
+*
+* @return
+* 	NULL - If there was a memory allocation error.
+*   The removal set, sorted by ID, otherwise. Must be freed by the caller.
+*/
+static RemovalEntry *removalSetCreate(Map map, const int *ids, int number_of_ids, ChessResult not_exist_error,
+                                      int *set_size, ChessResult *error)
+{
+    RemovalEntry *removal_set = malloc(sizeof(*removal_set) * number_of_ids);
+    if (removal_set == NULL)
+    {
+        return NULL;
+    }
+
+    // Duplicates are only found once sorted, so the first failing ID is tracked by its removal order
+    int size = 0, first_failure = number_of_ids;
+    *error = CHESS_SUCCESS;
+    for (int index = 0; index < number_of_ids; index++)
+    {
+        if (isValidID(ids[index]) == false || mapContains(map, (MapKeyElement) &ids[index]) == false)
+        {
+            if (index < first_failure)
+            {
+                first_failure = index;
+                *error = (isValidID(ids[index]) == false) ? CHESS_INVALID_ID : not_exist_error;
+            }
+            continue;
+        }
+        removal_set[size].id = ids[index];
+        removal_set[size].order = index;
+        size++;
+    }
+    qsort(removal_set, size, sizeof(*removal_set), compareRemovalEntry);
+
+    int unique_size = 0;
+    for (int index = 0; index < size; index++)
+    {
+        if (unique_size > 0 && removal_set[unique_size - 1].id == removal_set[index].id)
+        {
+            if (removal_set[index].order < first_failure)
+            {
+                first_failure = removal_set[index].order;
+                *error = not_exist_error;
+            }
+            continue;
+        }
+        removal_set[unique_size++] = removal_set[index];
+    }
+    *set_size = unique_size;
+    return removal_set;
+}
+
+/**
+*	removalSetFindOrder: Finds the removal order of the given ID in the given removal set.
+*
+* @param removal_set - The removal set to search in.
+* @param set_size - The number of entries in the removal set.
+* @param id - The ID to look for.
+*
+* @return
+* 	-1 - If the ID is not in the set.
+*   The position of the ID in the caller's removal order otherwise.
+*/
+static int removalSetFindOrder(RemovalEntry *removal_set, int set_size, int id)
+{
+    if (isValidID(id) == false)
+    {
+        return -1;
+    }
+    RemovalEntry *low = removal_set, *high = removal_set + set_size;
+    while (low < high)
+    {
+        RemovalEntry *middle = low + (high - low) / 2;
+        if (middle->id < id)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return (low < removal_set + set_size && low->id == id) ? low->order : -1;
+}
+
+/**
+*	chessJournalRemovals: records the removals of a bulk removal in the journal, one record per removed ID,
+*                         in the caller's removal order, as if the IDs were removed one by one.
+*
+* @param chess - The chess system which was mutated.
+* @param type - The type of the removal.
+* @param ids - The IDs to remove, in removal order.
+* @param number_of_ids - The number of IDs in the array.
+* @param removal_set - The set of the IDs which were removed.
+* @param set_size - The number of entries in the removal set.
+*
+* @return
+* 	CHESS_SAVE_FAILURE - If a record couldn't be written.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessJournalRemovals(ChessSystem chess, JournalRecordType type, const int *ids,
+                                        int number_of_ids, RemovalEntry *removal_set, int set_size)
+{
+    ChessResult result = CHESS_SUCCESS;
+    for (int index = 0; index < number_of_ids && result == CHESS_SUCCESS && chess->journal != NULL; index++)
+    {
+        if (removalSetFindOrder(removal_set, set_size, ids[index]) == index)
+        {
+            int arguments[JOURNAL_MAX_ARGUMENTS] = {ids[index]};
+            result = chessJournalRecord(chess, type, arguments, NULL);
+        }
+    }
+    return result;
+}
+
+/**
+*	chessPublishRemovals: records the removals of a bulk removal in the change feed, in the order of the IDs
+*                         given by the caller.
+*
+* @param chess - The chess system.
+* @param type - The type of the removals.
+* @param ids - The IDs given by the caller.
+* @param number_of_ids - The number of IDs in the array.
+* @param removal_set - The set of the IDs which were removed.
+* @param set_size - The number of entries in the removal set.
+*
+* @return
+* 	None
+*/
+static void chessPublishRemovals(ChessSystem chess, ChessChangeType type, const int *ids, int number_of_ids,
+                                 RemovalEntry *removal_set, int set_size)
+{
+    for (int index = 0; index < number_of_ids && chess->feed != NULL; index++)
+    {
+        if (removalSetFindOrder(removal_set, set_size, ids[index]) == index)
+        {
+            chessPublishChange(chess, type, (type == CHESS_CHANGE_TOURNAMENT_REMOVED) ? ids[index] : 0,
+                               (type == CHESS_CHANGE_PLAYER_REMOVED) ? ids[index] : 0, 0, 0);
+        }
+    }
+}
+
+/**
+*	gameRemovePlayersInOrder: Removes every player of the given game who is in the removal set, in the
+*                             same order their removal was requested.
+*
+* @param chess_players_map - The chess system's general players map, which needed to be updated.
+* @param tournament_players_map - The players map of the game's tournament, which needed to be updated.
+* @param game - The game from which to remove the players.
+* @param removal_set - The set of removed players.
+* @param set_size - The number of entries in the removal set.
+*
+* @return
+*   true - If a player was removed from the game.
+*   false - Otherwise.
+*/
+static bool gameRemovePlayersInOrder(Map chess_players_map, Map tournament_players_map, Game game,
+                                     RemovalEntry *removal_set, int set_size)
+{
+    int players[NUMBER_OF_PLAYERS_IN_GAME] = {gameGetFirstPlayer(game), gameGetSecondPlayer(game)};
+    int orders[NUMBER_OF_PLAYERS_IN_GAME] = {removalSetFindOrder(removal_set, set_size, players[FIRST_PLAYER]),
+                                             removalSetFindOrder(removal_set, set_size, players[SECOND_PLAYER])};
+    int first_removed = (orders[SECOND_PLAYER] >= 0 &&
+                         (orders[FIRST_PLAYER] < 0 || orders[SECOND_PLAYER] < orders[FIRST_PLAYER]));
+
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        int current = (first_removed + index) % NUMBER_OF_PLAYERS_IN_GAME;
+        if (orders[current] >= 0)
+        {
+            gameRemovePlayer(chess_players_map, tournament_players_map, game, players[current]);
+        }
+    }
+    return orders[FIRST_PLAYER] >= 0 || orders[SECOND_PLAYER] >= 0;
+}
+
+static ChessResult chessRemovePlayersLocked(ChessSystem chess, const int *player_ids, int number_of_players)
+{
+    if (chess == NULL || (player_ids == NULL && number_of_players > 0))
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (number_of_players <= 0)
+    {
+        return CHESS_SUCCESS;
+    }
+
+    ChessResult error_type = CHESS_SUCCESS;
+    int set_size = 0;
+    RemovalEntry *removal_set = removalSetCreate(chess->players, player_ids, number_of_players,
+                                                 CHESS_PLAYER_NOT_EXIST, &set_size, &error_type);
+    if (removal_set == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    int number_of_played = 0;
+    int *played_tournaments = NULL;
+    if (chess->spill_cache != NULL &&
+        (played_tournaments = chessFindPlayedTournaments(chess, player_ids, number_of_players,
+                                                         &number_of_played)) == NULL)
+    {
+        free(removal_set);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
+        if (isTournamentUnplayed(*(int*) current_tournament_id, current_tournament, played_tournaments,
+                                 number_of_played) == true)
+        {
+            free(current_tournament_id);
+            continue;
+        }
+        Map tournament_players_map = tournamentGetPlayersMap(current_tournament);
+        if (tournamentGetWinner(current_tournament) == TOURNAMENT_NOT_ENDED)
+        {
+            MAP_FOREACH(Game, current_game_id, tournamentGetGamesMap(current_tournament))
+            {
+                Game current_game = mapGet(tournamentGetGamesMap(current_tournament) ,current_game_id);
+                int first_player = gameGetFirstPlayer(current_game);
+                int second_player = gameGetSecondPlayer(current_game);
+                if (gameRemovePlayersInOrder(chess->players, tournament_players_map, current_game,
+                                             removal_set, set_size) == true)
+                {
+                    chessTouchPlayers(chess, first_player, second_player);
+                    chessArchivePut(chess, *(int*) current_tournament_id, *(int*) current_game_id, current_game);
+                    chessPublishGame(chess, CHESS_CHANGE_GAME_CHANGED, *(int*) current_tournament_id,
+                                     *(int*) current_game_id, current_game);
+                    tournamentSetDirty(current_tournament, true);
+                }
+                free(current_game_id);
+            }
+        }
+        for (int index = 0; index < set_size; index++)
+        {
+            if (mapRemove(tournament_players_map, &removal_set[index].id) == MAP_SUCCESS)
+            {
+                chess->tournament_player_entries--;
+                tournamentSetDirty(current_tournament, true);
+            }
+        }
+        free(current_tournament_id);
+    }
+
+    free(played_tournaments);
+    for (int index = 0; index < set_size; index++)
+    {
+        playerDirectoryRemove(chess->directory, removal_set[index].id);
+        mapRemove(chess->players, &removal_set[index].id);
+        chessRecordRemovedPlayer(chess, removal_set[index].id);
+    }
+    chess->players_dirty = (set_size > 0) ? true : chess->players_dirty;
+    chessPublishRemovals(chess, CHESS_CHANGE_PLAYER_REMOVED, player_ids, number_of_players, removal_set, set_size);
+    ChessResult journal_result = chessJournalRemovals(chess, JOURNAL_REMOVE_PLAYER, player_ids, number_of_players,
+                                                      removal_set, set_size);
+    free(removal_set);
+    return (journal_result != CHESS_SUCCESS) ? journal_result : error_type;
+}
+
+static ChessResult chessRemoveTournamentsLocked(ChessSystem chess, const int *tournament_ids, int number_of_tournaments)
+{
+    if (chess == NULL || (tournament_ids == NULL && number_of_tournaments > 0))
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (number_of_tournaments <= 0)
+    {
+        return CHESS_SUCCESS;
+    }
+
+    ChessResult error_type = CHESS_SUCCESS;
+    int set_size = 0;
+    RemovalEntry *removal_set = removalSetCreate(chess->tournaments, tournament_ids, number_of_tournaments,
+                                                 CHESS_TOURNAMENT_NOT_EXIST, &set_size, &error_type);
+    if (removal_set == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        if (removalSetFindOrder(removal_set, set_size, *(int*) current_tournament_id) >= 0)
+        {
+            Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
+            chessRemoveTournamentGames(chess, *(int*) current_tournament_id, current_tournament);
+        }
+        free(current_tournament_id);
+    }
+
+    for (int index = 0; index < set_size; index++)
+    {
+        mapRemove(chess->tournaments, &removal_set[index].id);
+    }
+    chessPublishRemovals(chess, CHESS_CHANGE_TOURNAMENT_REMOVED, tournament_ids, number_of_tournaments, removal_set,
+                         set_size);
+    ChessResult journal_result = chessJournalRemovals(chess, JOURNAL_REMOVE_TOURNAMENT, tournament_ids,
+                                                      number_of_tournaments, removal_set, set_size);
+    free(removal_set);
+    return (journal_result != CHESS_SUCCESS) ? journal_result : error_type;
+}
+
+/**
+*	chessGameErrorCheck: checks errors for the functions that modify an existing game
+*                        (chessUpdateGameResult and chessRemoveGame) and returns relevant error value.
+*
+* @param chess - See chessSystemExtensions.h
+*
+* @return
+*   See chessSystemExtensions.h
+*/
+static ChessResult chessGameErrorCheck(ChessSystem chess, int tournament_id, int game_id)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(tournament_id) == false || isValidID(game_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (mapContains(chess->tournaments, &tournament_id) == false)
+    {
+        return CHESS_TOURNAMENT_NOT_EXIST;
+    }
+
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    if (tournamentGetWinner(tournament) != TOURNAMENT_NOT_ENDED)
+    {
+        return CHESS_TOURNAMENT_ENDED;
+    }
+
+    if (mapContains(tournamentGetGamesMap(tournament), &game_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	playersReplaceStats: replaces a game's old result and play time with new ones in the given players map.
+*                        If one of the players was removed, only the play time is replaced.
+*
+* @param players_map - The players map in which to replace the stats.
+* @param game - The game whose result is being replaced. Still holds the old result.
+* @param new_winner - The new result of the game.
+* @param new_play_time - The new play time of the game.
+*
+* @return
+* 	None
+*/
+static void playersReplaceStats(Map players_map, Game game, Winner new_winner, int new_play_time)
+{
+    int player1 = gameGetFirstPlayer(game);
+    int player2 = gameGetSecondPlayer(game);
+    if (isValidID(player1) == false && isValidID(player2) == false)
+    {
+        return;
+    }
+    Player first_player = mapGet(players_map, &player1);
+    Player second_player = mapGet(players_map, &player2);
+    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player};
+
+    if (isValidID(player1) == true && isValidID(player2) == true)
+    {
+        playersRemoveScore(players, gameGetWinner(game));
+        playersAddScore(players, new_winner);
+    }
+    playersRemovePlayTime(players, gameGetPlayTime(game));
+    playersAddPlayTime(players, new_play_time);
+}
+
+static ChessResult chessUpdateGameResultLocked(ChessSystem chess, int tournament_id, int game_id, Winner new_winner,
+                                               int new_play_time)
+{
+    ChessResult error_type = chessGameErrorCheck(chess, tournament_id, game_id);
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+
+    if (isPlayTimeValid(new_play_time) == false)
+    {
+        return CHESS_INVALID_PLAY_TIME;
+    }
+
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    Game game = mapGet(tournamentGetGamesMap(tournament), &game_id);
+    if ((isValidID(gameGetFirstPlayer(game)) == false || isValidID(gameGetSecondPlayer(game)) == false) &&
+        new_winner != (Winner) gameGetWinner(game))
+    {
+        return CHESS_PLAYER_NOT_EXIST;
+    }
+
+    int old_play_time = gameGetPlayTime(game);
+    playersReplaceStats(chess->players, game, new_winner, new_play_time);
+    playersReplaceStats(tournamentGetPlayersMap(tournament), game, new_winner, new_play_time);
+    gameSetResult(game, new_winner);
+    gameSetPlayTime(game, new_play_time);
+
+    tournamentRemoveGameStats(tournament, old_play_time);
+    tournamentUpdateStats(tournament, new_play_time);
+    tournamentSetDirty(tournament, true);
+    chess->players_dirty = true;
+    chessTouchPlayers(chess, gameGetFirstPlayer(game), gameGetSecondPlayer(game));
+    chessArchivePut(chess, tournament_id, game_id, game);
+    chessPublishGame(chess, CHESS_CHANGE_GAME_CHANGED, tournament_id, game_id, game);
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {tournament_id, game_id, new_winner, new_play_time};
+    return chessJournalRecord(chess, JOURNAL_UPDATE_GAME_RESULT, arguments, NULL);
+}
+
+static ChessResult chessRemoveGameLocked(ChessSystem chess, int tournament_id, int game_id)
+{
+    ChessResult error_type = chessGameErrorCheck(chess, tournament_id, game_id);
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    Game game = mapGet(tournamentGetGamesMap(tournament), &game_id);
+    int play_time = gameGetPlayTime(game);
+
+    playersRemoveStats(chess->players, gameGetFirstPlayer(game), gameGetSecondPlayer(game),
+                       gameGetWinner(game), play_time);
+    playersRemoveStats(tournamentGetPlayersMap(tournament), gameGetFirstPlayer(game), gameGetSecondPlayer(game),
+                       gameGetWinner(game), play_time);
+
+    chessTouchPlayers(chess, gameGetFirstPlayer(game), gameGetSecondPlayer(game));
+    gameArchiveRemove(chess->archive, tournament_id, game_id);
+    chessPublishGame(chess, CHESS_CHANGE_GAME_REMOVED, tournament_id, game_id, NULL);
+    mapRemove(tournamentGetGamesMap(tournament), &game_id);
+    tournamentRemoveGameStats(tournament, play_time);
+    tournamentSetDirty(tournament, true);
+    chess->number_of_games--;
+    chess->players_dirty = true;
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {tournament_id, game_id};
+    return chessJournalRecord(chess, JOURNAL_REMOVE_GAME, arguments, NULL);
+}
+
+/** Type for a tournament and an opponent which a player has a game against in it */
+typedef struct opponent_entry_t
+{
+    int tournament_id;
+    int opponent_id;
+} OpponentEntry;
+
+/**
+*	compareOpponentEntry: Compares two opponent entries by tournament ID, and by opponent ID for equal
+*                         tournaments. Used for sorting and searching opponent entries.
+*
+* @param element1 - The first opponent entry to compare.
+* @param element2 - The second opponent entry to compare.
+*
+* @return
+* 	A positive number if the first entry is greater, zero if equal, otherwise negative.
+*/
+static int compareOpponentEntry(const void *element1, const void *element2)
+{
+    const OpponentEntry *first_entry = element1;
+    const OpponentEntry *second_entry = element2;
+
+    if (first_entry->tournament_id != second_entry->tournament_id)
+    {
+        return first_entry->tournament_id - second_entry->tournament_id;
+    }
+    return first_entry->opponent_id - second_entry->opponent_id;
+}
+
+/**
+*	chessGetIndexedGame: Gets the game in the given position of a player's game index.
+*
+* @param chess - The chess system which contains the game.
+* @param index - The player's game index.
+* @param position - The position of the game in the index.
+*
+* @return
+* 	NULL - If the game or its tournament was removed.
+*   The game otherwise.
+*/
+static Game chessGetIndexedGame(ChessSystem chess, GameIndex index, int position)
+{
+    int tournament_id = gameIndexGetTournamentID(index, position);
+    int game_id = gameIndexGetGameID(index, position);
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    return mapGet(tournamentGetGamesMap(tournament), &game_id);
+}
+
+/**
+*	chessFindMergeConflicts: Finds the games of the dropped player which would conflict with the games of
+*                            the kept player after merging - games between the two players, and games against
+*                            an opponent whom the kept player also played in the same tournament.
+*
+* @param chess - The chess system which contains the players.
+* @param keep_id - The ID of the kept player.
+* @param drop_id - The ID of the dropped player.
+* @param conflicts - Array to fill with the conflicts found. May be NULL if max_conflicts is 0.
+* @param max_conflicts - The size of the conflicts array.
+* @param number_of_conflicts - Output for the total number of conflicts found.
+*
+* @return
+* 	CHESS_OUT_OF_MEMORY - If there was a memory allocation error.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessFindMergeConflicts(ChessSystem chess, int keep_id, int drop_id, ChessMergeConflict *conflicts,
+                                           int max_conflicts, int *number_of_conflicts)
+{
+    GameIndex keep_index = playerGetGames(mapGet(chess->players, &keep_id));
+    GameIndex drop_index = playerGetGames(mapGet(chess->players, &drop_id));
+    OpponentEntry *keep_opponents = malloc(sizeof(*keep_opponents) * (gameIndexGetSize(keep_index) + 1));
+    if (keep_opponents == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    int number_of_opponents = 0;
+    for (int position = 0; position < gameIndexGetSize(keep_index); position++)
+    {
+        Game current_game = chessGetIndexedGame(chess, keep_index, position);
+        if (current_game != NULL)
+        {
+            keep_opponents[number_of_opponents].tournament_id = gameIndexGetTournamentID(keep_index, position);
+            keep_opponents[number_of_opponents].opponent_id = gameGetOpponent(current_game, keep_id);
+            number_of_opponents++;
+        }
+    }
+    qsort(keep_opponents, number_of_opponents, sizeof(*keep_opponents), compareOpponentEntry);
+
+    *number_of_conflicts = 0;
+    for (int position = 0; position < gameIndexGetSize(drop_index); position++)
+    {
+        Game current_game = chessGetIndexedGame(chess, drop_index, position);
+        if (current_game == NULL)
+        {
+            continue;
+        }
+        OpponentEntry entry = {gameIndexGetTournamentID(drop_index, position), gameGetOpponent(current_game, drop_id)};
+        if (entry.opponent_id == keep_id ||
+            (isValidID(entry.opponent_id) == true &&
+             bsearch(&entry, keep_opponents, number_of_opponents, sizeof(*keep_opponents), compareOpponentEntry) != NULL))
+        {
+            if (*number_of_conflicts < max_conflicts)
+            {
+                conflicts[*number_of_conflicts].tournament_id = entry.tournament_id;
+                conflicts[*number_of_conflicts].opponent_id = entry.opponent_id;
+            }
+            (*number_of_conflicts)++;
+        }
+    }
+    free(keep_opponents);
+    return CHESS_SUCCESS;
+}
+
+/**
+*	playersMapRelabelPlayer: Adds a copy of the dropped player under the kept player's ID to the given
+*                            players map, if the dropped player is in the map and the kept player is not.
+*
+* @param players_map - The players map in which to relabel the player.
+* @param keep_id - The ID of the kept player.
+* @param drop_id - The ID of the dropped player.
+* @param relabeled - Output for whether a relabeled copy was added.
+*
+* @return
+* 	MAP_OUT_OF_MEMORY - If there was a memory allocation error.
+*   MAP_SUCCESS - Otherwise.
+*/
+static MapResult playersMapRelabelPlayer(Map players_map, int keep_id, int drop_id, bool *relabeled)
+{
+    *relabeled = false;
+    Player drop_player = mapGet(players_map, &drop_id);
+    if (drop_player == NULL || mapContains(players_map, &keep_id) == true)
+    {
+        return MAP_SUCCESS;
+    }
+
+    playerSetID(drop_player, keep_id);
+    MapResult result = mapPut(players_map, &keep_id, drop_player);
+    playerSetID(drop_player, drop_id);
+    *relabeled = (result == MAP_SUCCESS);
+    return result;
+}
+
+/**
+*	playersMapMergePlayers: Merges the dropped player into the kept player in the given players map, and
+*                           removes the dropped player. Does not allocate memory.
+*                           If the kept player was just relabeled from the dropped player, only the dropped
+*                           player is removed. Otherwise, if the players map belongs to a tournament, the
+*                           function updates the number of players in the tournament.
+*
+* @param chess - The chess system which contains the players map.
+* @param tournament - The tournament to update number of players if the players map belongs to a tournament.
+* @param players_map - The players map in which to merge the players.
+* @param keep_id - The ID of the kept player.
+* @param drop_id - The ID of the dropped player.
+* @param relabeled - Whether the kept player was relabeled from the dropped player by playersMapRelabelPlayer.
+*/
+static void playersMapMergePlayers(ChessSystem chess, Tournament tournament, Map players_map, int keep_id,
+                                   int drop_id, bool relabeled)
+{
+    Player drop_player = mapGet(players_map, &drop_id);
+    if (drop_player == NULL)
+    {
+        return;
+    }
+
+    if (relabeled == false)
+    {
+        playerAddStats(mapGet(players_map, &keep_id), drop_player);
+        if (tournament != NULL)
+        {
+            tournamentDecreaseNumberOfPlayers(tournament);
+        }
+    }
+    mapRemove(players_map, &drop_id);
+    if (tournament != NULL)
+    {
+        chess->tournament_player_entries--;
+    }
+}
+
+/**
+*	chessMergeTournamentsRollback: Removes the relabeled copies of the dropped player which were added to the
+*                                  players maps of the given tournaments.
+*
+* @param chess - The chess system which contains the tournaments.
+* @param tournament_ids - The sorted IDs of the tournaments, with possible duplicates.
+* @param relabeled - For every tournament ID, whether a relabeled copy was added to its tournament.
+* @param number_of_tournaments - The number of tournament IDs to roll back.
+* @param keep_id - The ID of the kept player.
+*/
+static void chessMergeTournamentsRollback(ChessSystem chess, int *tournament_ids, bool *relabeled,
+                                          int number_of_tournaments, int keep_id)
+{
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        if (relabeled[index] == true)
+        {
+            Tournament current_tournament = mapGet(chess->tournaments, &tournament_ids[index]);
+            mapRemove(tournamentGetPlayersMap(current_tournament), &keep_id);
+        }
+    }
+}
+
+/**
+*	chessMergePlayersErrorCheck: checks errors for chessMergePlayers function and returns
+*                                relevant error value.
+*
+* @param chess - See chessSystemExtensions.h
+*
+* @return
+*   See chessSystemExtensions.h
+*/
+static ChessResult chessMergePlayersErrorCheck(ChessSystem chess, int keep_id, int drop_id,
+                                               ChessMergeConflict *conflicts, int max_conflicts)
+{
+    if (chess == NULL || (conflicts == NULL && max_conflicts > 0))
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(keep_id) == false || isValidID(drop_id) == false || keep_id == drop_id)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (mapContains(chess->players, &keep_id) == false || mapContains(chess->players, &drop_id) == false)
+    {
+        return CHESS_PLAYER_NOT_EXIST;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	chessMergeExceedsMaxGames: checks whether merging the players would leave the kept player with more games
+*                              than allowed in any of the dropped player's tournaments.
+*
+* @param chess - The chess system which contains the tournaments.
+* @param tournament_ids - The sorted IDs of the dropped player's tournaments, with possible duplicates.
+* @param number_of_tournaments - The number of tournament IDs.
+* @param keep_id - The ID of the kept player.
+* @param drop_id - The ID of the dropped player.
+*
+* @return
+*   true - if the merged player would play more games than allowed in one of the tournaments.
+*   false - otherwise.
+*/
+static bool chessMergeExceedsMaxGames(ChessSystem chess, int *tournament_ids, int number_of_tournaments,
+                                      int keep_id, int drop_id)
+{
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments, &tournament_ids[index]);
+        if ((index > 0 && tournament_ids[index] == tournament_ids[index - 1]) || current_tournament == NULL)
+        {
+            continue;
+        }
+        int merged_games = countGamesPlayerPlayedInTournament(current_tournament, keep_id) +
+                           countGamesPlayerPlayedInTournament(current_tournament, drop_id);
+        if (merged_games > tournamentGetMaxGamesPerPlayer(current_tournament))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static ChessResult chessMergePlayersLocked(ChessSystem chess, int keep_id, int drop_id, ChessMergeConflict *conflicts,
+                                           int max_conflicts, int *number_of_conflicts)
+{
+    int conflicts_found = 0;
+    ChessResult error_type = chessMergePlayersErrorCheck(chess, keep_id, drop_id, conflicts, max_conflicts);
+    if (error_type == CHESS_SUCCESS)
+    {
+        error_type = chessFindMergeConflicts(chess, keep_id, drop_id, conflicts, max_conflicts, &conflicts_found);
+    }
+    if (number_of_conflicts != NULL)
+    {
+        *number_of_conflicts = conflicts_found;
+    }
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+    if (conflicts_found > 0)
+    {
+        return CHESS_GAME_ALREADY_EXISTS;
+    }
+
+    GameIndex drop_index = playerGetGames(mapGet(chess->players, &drop_id));
+    int *tournament_ids = malloc(sizeof(*tournament_ids) * (gameIndexGetSize(drop_index) + 1));
+    bool *relabeled = malloc(sizeof(*relabeled) * (gameIndexGetSize(drop_index) + 1));
+    if (tournament_ids == NULL || relabeled == NULL)
+    {
+        free(tournament_ids);
+        free(relabeled);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    int number_of_tournaments = 0;
+    for (int position = 0; position < gameIndexGetSize(drop_index); position++)
+    {
+        tournament_ids[number_of_tournaments++] = gameIndexGetTournamentID(drop_index, position);
+    }
+    qsort(tournament_ids, number_of_tournaments, sizeof(*tournament_ids), compareInt);
+    if (chessMergeExceedsMaxGames(chess, tournament_ids, number_of_tournaments, keep_id, drop_id) == true)
+    {
+        free(tournament_ids);
+        free(relabeled);
+        return CHESS_EXCEEDED_GAMES;
+    }
+
+    // First pass allocates everything the merge needs, so that a memory error leaves the system unchanged.
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        relabeled[index] = false;
+        Tournament current_tournament = mapGet(chess->tournaments, &tournament_ids[index]);
+        if ((index > 0 && tournament_ids[index] == tournament_ids[index - 1]) || current_tournament == NULL)
+        {
+            continue;
+        }
+        if (playersMapRelabelPlayer(tournamentGetPlayersMap(current_tournament), keep_id, drop_id,
+                                    &relabeled[index]) != MAP_SUCCESS)
+        {
+            chessMergeTournamentsRollback(chess, tournament_ids, relabeled, index, keep_id);
+            free(tournament_ids);
+            free(relabeled);
+            return CHESS_OUT_OF_MEMORY;
+        }
+    }
+    Player keep_player = mapGet(chess->players, &keep_id);
+    bool keep_index_created = false;
+    if (drop_index != NULL && (playerGamesSetup(chess, keep_player, &keep_index_created) != MAP_SUCCESS ||
+                               gameIndexAppend(playerGetGames(keep_player), drop_index) == false))
+    {
+        chessMergeTournamentsRollback(chess, tournament_ids, relabeled, number_of_tournaments, keep_id);
+        free(tournament_ids);
+        free(relabeled);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    // Second pass only moves and releases data, and cannot fail.
+    for (int position = 0; position < gameIndexGetSize(drop_index); position++)
+    {
+        Game game = chessGetIndexedGame(chess, drop_index, position);
+        gameReplacePlayerID(game, drop_id, keep_id);
+        chessArchivePut(chess, gameIndexGetTournamentID(drop_index, position),
+                        gameIndexGetGameID(drop_index, position), game);
+        chessPublishGame(chess, CHESS_CHANGE_GAME_CHANGED, gameIndexGetTournamentID(drop_index, position),
+                         gameIndexGetGameID(drop_index, position), game);
+    }
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments, &tournament_ids[index]);
+        if ((index > 0 && tournament_ids[index] == tournament_ids[index - 1]) || current_tournament == NULL)
+        {
+            continue;
+        }
+        playersMapMergePlayers(chess, current_tournament, tournamentGetPlayersMap(current_tournament),
+                               keep_id, drop_id, relabeled[index]);
+        tournamentSetDirty(current_tournament, true);
+        if (tournamentGetWinner(current_tournament) == drop_id)
+        {
+            tournamentSetWinner(current_tournament, keep_id);
+        }
+    }
+    free(tournament_ids);
+    free(relabeled);
+
+    playersMapMergePlayers(chess, NULL, chess->players, keep_id, drop_id, false);
+    // A kept player relabeled from the dropped one is a new entry of the players map
+    playerDirectoryRemove(chess->directory, keep_id);
+    playerDirectoryRemove(chess->directory, drop_id);
+    chess->players_dirty = true;
+    chessTouchPlayers(chess, keep_id, keep_id);
+    chessRecordRemovedPlayer(chess, drop_id);
+    chessPublishChange(chess, CHESS_CHANGE_PLAYERS_MERGED, 0, keep_id, drop_id, 0);
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {keep_id, drop_id};
+    return chessJournalRecord(chess, JOURNAL_MERGE_PLAYERS, arguments, NULL);
+}
+
+/**
+*	cacheTournamentStatistics: renders the statistics of a ended tournament, and caches them in the tournament.
+*                              They don't change until the tournament is changed, which drops them.
+*
+* @param tournament - The ended tournament.
+*
+* @return
+* 	false - In case of memory error. The tournament is left without cached statistics.
+*   true - Otherwise.
+*/
+static bool cacheTournamentStatistics(Tournament tournament)
+{
+    const char* location = tournamentGetLocation(tournament);
+    int length = 0;
+    char* statistics = reportRenderTournamentStatistics(tournamentGetWinner(tournament),
+                                                        tournamentGetLongestGameTime(tournament),
+                                                        tournamentGetTotalPlayTime(tournament),
+                                                        tournamentGetNumberOfGames(tournament),
+                                                        tournamentGetNumberOfPlayers(tournament), location,
+                                                        (int) strlen(location), &length);
+    if (statistics == NULL)
+    {
+        return false;
+    }
+    tournamentSetStatistics(tournament, statistics, length);
+    return true;
+}
+
+/** Type for a generic data geting function, which is used for determing the tournament's winner */
+typedef int (*getDataFunc)(Player);
+
+/**
+*	comparePlayerData: Generically comapre players data and returning the differnce between the datas.                   
+*
+* @param players[] - Array that contains the two player whose data is being compared.
+* @param func - A generic data get function, in order to get the player's desired data.  
+*
+* @return
+* 	difference - The numeric value of the differnce between the two players' data. 
+*/
+static int comparePlayerData(Player players[], getDataFunc func)
+{
+    int first_player_data = func(players[FIRST_PLAYER]);
+    int second_player_data = func(players[SECOND_PLAYER]);
+    int difference = first_player_data - second_player_data;
+
+    return difference;
+}
+
+/**
+*	paritySign: checks if the given index is even or odd and returns 1 or -1 accordingly.                   
+*
+* @param index - Index which to check parity
+*
+* @return
+* 	1 - If the index is even.
+*  -1 - If the index is odd.
+*/
+static int paritySign(int index)
+{
+    return ((index % 2 == 0) - (index % 2 != 0));
+}
+
+/**
+*	tournamentFindWinner: Finds and returns the winner of the tournament between two given players.
+*                         The function compares the players' scores - If different, returns the player
+                          with the higher score. Else, it compares the players' loses - If different, 
+                          returns the player with the lower number of loses. Else, it compares the players'
+                          wins - If different, returns the player with the higher number of wins. Else, it
+                          compares the players' ID and returns the player with the lower ID.
+*                       
+*
+* @param first_player - First player to check.
+* @param second_player - Second player to check.  
+*
+* @return
+*   The player who won the tournament between the given two.
+*/
+static Player tournamentFindWinner(Player first_player, Player second_player)
+{
+    getDataFunc checks[] = {playerGetScore, playerGetLoses, playerGetWins, playerGetID};
+    Player players[NUMBER_OF_PLAYERS_IN_GAME] = {first_player, second_player}; 
+    int difference = 0, index = 0;
+
+    for (; index < (int) (sizeof(checks) / sizeof(*checks)); index++)
+    {
+        difference = comparePlayerData(players, checks[index]);
+        if (difference != 0)
+        {
+            break;
+        }
+    } 
+    return players[difference * paritySign(index) < 0];
+}
+
+/**
+*	chessEndTournamentErrorCheck: checks errors for chessEndTournament function and returns
+*                                 relevant error value.
+*
+* @param chess - See chessSystem.h
+*
+* @return
+*   See chessSystem.h
+*/
+static ChessResult chessEndTournamentErrorCheck(ChessSystem chess, int tournament_id)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(tournament_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (mapContains(chess->tournaments, &tournament_id) == false)
+    {
+        return CHESS_TOURNAMENT_NOT_EXIST;
+    }
+
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    if (tournamentGetWinner(tournament) != TOURNAMENT_NOT_ENDED)
+    {
+        return CHESS_TOURNAMENT_ENDED;
+    }
+
+    if (mapGetSize(tournamentGetGamesMap(tournament)) == 0)
+    {
+        return CHESS_NO_GAMES;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	tournamentDecideWinner: finds the winner of a tournament which is ending, sets it, and caches the
+*                           tournament's statistics. Touches nothing but the tournament, so several tournaments
+*                           may be decided by several threads at once.
+*
+* @param tournament - The tournament. Must have games, and must not have been spilled.
+*
+* @return
+* 	None
+*/
+static void tournamentDecideWinner(Tournament tournament)
+{
+    Map tournament_players_map = tournamentGetPlayersMap(tournament);
+    MapKeyElement current_winner_id = mapGetFirst(tournament_players_map);
+    Player current_winner = mapGet(tournament_players_map, current_winner_id);
+    
+    MAP_FOREACH(Player, current_player_id, tournament_players_map)
+    {
+        Player current_player = mapGet(tournament_players_map ,current_player_id);
+        free(current_player_id);
+        if (isValidID(playerGetID(current_player)) == false)
+        {
+            continue;
+        }
+        current_winner = tournamentFindWinner(current_winner, current_player);
+        
+    }
+    tournamentSetWinner(tournament, playerGetID(current_winner));
+    tournamentSetDirty(tournament, true);
+    free(current_winner_id);
+    // Without memory for the cache, the statistics are rendered when they are saved
+    cacheTournamentStatistics(tournament);
+}
+
+/**
+*	chessRecordEndedTournament: spills a tournament whose winner was decided, and records its end in the change
+*                               feed and the journal.
+*
+* @param chess - The chess system.
+* @param tournament_id - The ID of the tournament.
+* @param tournament - The tournament.
+*
+* @return
+*   CHESS_SAVE_FAILURE - If the end couldn't be recorded in the journal.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessRecordEndedTournament(ChessSystem chess, int tournament_id, Tournament tournament)
+{
+    // A tournament which can't be spilled stays in memory
+    if (chess->spill_cache != NULL)
+    {
+        tournamentSpill(tournament, chess->spill_cache);
+    }
+    chessPublishChange(chess, CHESS_CHANGE_TOURNAMENT_ENDED, tournament_id, 0, 0, tournamentGetWinner(tournament));
+
+    int arguments[JOURNAL_MAX_ARGUMENTS] = {tournament_id};
+    return chessJournalRecord(chess, JOURNAL_END_TOURNAMENT, arguments, NULL);
+}
+
+static ChessResult chessEndTournamentLocked(ChessSystem chess, int tournament_id)
+{
+    ChessResult error_type = chessEndTournamentErrorCheck(chess, tournament_id);
+    if (error_type != CHESS_SUCCESS)
+    {
+        return error_type;
+    }
+
+    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    tournamentDecideWinner(tournament);
+    return chessRecordEndedTournament(chess, tournament_id, tournament);
+}
+
+/** Type for the work of a single thread of chessEndTournaments */
+typedef struct end_tournaments_worker_t {
+    Tournament *tournaments;
+    int number_of_tournaments;
+    int worker;
+    int number_of_workers;
+} EndTournamentsWorker;
+
+/**
+*	endTournamentsWorkerRun: decides the winners of the worker's share of the ending tournaments - every
+*                            tournament whose index has the worker's remainder.
+*
+* @param argument - The worker.
+*
+* @return
+* 	NULL
+*/
+static void *endTournamentsWorkerRun(void *argument)
+{
+    EndTournamentsWorker *worker = argument;
+    for (int index = worker->worker; index < worker->number_of_tournaments; index += worker->number_of_workers)
+    {
+        tournamentDecideWinner(worker->tournaments[index]);
+    }
+    return NULL;
+}
+
+/**
+*	endTournamentsRunWorkers: decides the winners of the ending tournaments, each worker on its own thread. A
+*                             worker whose thread couldn't be started runs on the calling thread once the others
+*                             finish.
+*
+* @param tournaments - The ending tournaments.
+* @param number_of_tournaments - The number of tournaments.
+* @param number_of_workers - The number of workers.
+*
+* @return
+* 	false - In case of memory error. No winner was decided.
+*   true - Otherwise.
+*/
+static bool endTournamentsRunWorkers(Tournament *tournaments, int number_of_tournaments, int number_of_workers)
+{
+    EndTournamentsWorker *workers = malloc(sizeof(*workers) * number_of_workers);
+    pthread_t *threads = malloc(sizeof(*threads) * number_of_workers);
+    bool *started = calloc(number_of_workers, sizeof(*started));
+    if (workers == NULL || threads == NULL || started == NULL)
+    {
+        free(workers);
+        free(threads);
+        free(started);
+        return false;
+    }
+
+    for (int worker = 0; worker < number_of_workers; worker++)
+    {
+        EndTournamentsWorker current = {tournaments, number_of_tournaments, worker, number_of_workers};
+        workers[worker] = current;
+        started[worker] = (pthread_create(&threads[worker], NULL, endTournamentsWorkerRun, &workers[worker]) == 0);
+    }
+    for (int worker = 0; worker < number_of_workers; worker++)
+    {
+        if (started[worker] == true)
+        {
+            pthread_join(threads[worker], NULL);
+        }
+    }
+    for (int worker = 0; worker < number_of_workers; worker++)
+    {
+        if (started[worker] == false)
+        {
+            endTournamentsWorkerRun(&workers[worker]);
+        }
+    }
+    free(workers);
+    free(threads);
+    free(started);
+    return true;
+}
+
+/**
+*	endTournamentsCheckErrors: sets the result chessEndTournament would return for each ID, if the IDs were ended
+*                              one after the other. A repeated ID which would end is ended by its first occurrence
+*                              only.
+*
+* @param chess - The chess system.
+* @param tournament_ids - The IDs of the tournaments to end.
+* @param number_of_tournaments - The number of IDs.
+* @param results - Output for the result of each ID.
+*
+* @return
+* 	false - In case of memory error. The results are not set.
+*   true - Otherwise.
+*/
+static bool endTournamentsCheckErrors(ChessSystem chess, const int *tournament_ids, int number_of_tournaments,
+                                      ChessResult *results)
+{
+    RemovalEntry *ending = malloc(sizeof(*ending) * number_of_tournaments);
+    if (ending == NULL)
+    {
+        return false;
+    }
+
+    int number_of_ending = 0;
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        results[index] = chessEndTournamentErrorCheck(chess, tournament_ids[index]);
+        if (results[index] == CHESS_SUCCESS)
+        {
+            ending[number_of_ending].id = tournament_ids[index];
+            ending[number_of_ending].order = index;
+            number_of_ending++;
+        }
+    }
+    qsort(ending, number_of_ending, sizeof(*ending), compareRemovalEntry);
+    for (int index = 1; index < number_of_ending; index++)
+    {
+        if (ending[index].id == ending[index - 1].id)
+        {
+            results[ending[index].order] = CHESS_TOURNAMENT_ENDED;
+        }
+    }
+    free(ending);
+    return true;
+}
+
+static ChessResult chessEndTournamentsLocked(ChessSystem chess, const int *tournament_ids, int number_of_tournaments,
+                                             ChessResult *results, int number_of_threads)
+{
+    if (chess == NULL || ((tournament_ids == NULL || results == NULL) && number_of_tournaments > 0))
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    Tournament *tournaments = (number_of_threads > 1 && number_of_tournaments > 1) ?
+                              malloc(sizeof(*tournaments) * number_of_tournaments) : NULL;
+    if (tournaments == NULL ||
+        endTournamentsCheckErrors(chess, tournament_ids, number_of_tournaments, results) == false)
+    {
+        // Without the memory to split the work, the tournaments are ended one after the other
+        free(tournaments);
+        for (int index = 0; index < number_of_tournaments; index++)
+        {
+            results[index] = chessEndTournamentLocked(chess, tournament_ids[index]);
+        }
+        return CHESS_SUCCESS;
+    }
+
+    int number_of_ending = 0;
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        if (results[index] == CHESS_SUCCESS)
+        {
+            tournaments[number_of_ending++] = mapGet(chess->tournaments, (MapKeyElement) &tournament_ids[index]);
+        }
+    }
+    int number_of_workers = (number_of_threads < number_of_ending) ? number_of_threads : number_of_ending;
+    if (number_of_ending > 0 && endTournamentsRunWorkers(tournaments, number_of_ending, number_of_workers) == false)
+    {
+        EndTournamentsWorker single_worker = {tournaments, number_of_ending, 0, 1};
+        endTournamentsWorkerRun(&single_worker);
+    }
+
+    // Spilling and recording run in the order of the IDs, as the calls one after the other would
+    for (int index = 0, ending = 0; index < number_of_tournaments; index++)
+    {
+        if (results[index] == CHESS_SUCCESS)
+        {
+            results[index] = chessRecordEndedTournament(chess, tournament_ids[index], tournaments[ending++]);
+        }
+    }
+    free(tournaments);
+    return CHESS_SUCCESS;
+}
+
+/**
+*	chessReadPlayerStats: reads the statistics of a player from the player directory, without locking the chess
+*                         system. Statistics which were not published since the directory was last invalidated
+*                         are published first, with the chess system shared.
+*
+* @param chess - The chess system.
+* @param player_id - The ID of the player.
+* @param stats - Output for the statistics of the player.
+*
+* @return
+* 	CHESS_NULL_ARGUMENT - If chess is NULL.
+*   CHESS_INVALID_ID - If the player ID is not positive.
+*   CHESS_PLAYER_NOT_EXIST - If the player is not in the chess system.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessReadPlayerStats(ChessSystem chess, int player_id, PlayerDirectoryStats *stats)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isValidID(player_id) == false)
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (playerDirectoryRead(chess->directory, player_id, stats) == true)
+    {
+        return CHESS_SUCCESS;
+    }
+
+    Player player = NULL;
+    GameIndex games = NULL;
+    chessLockShared(chess);
+    playerDirectoryLock(chess->directory, player_id, player_id);
+    chessFindPlayer(chess, player_id, &player, &games);
+    if (player != NULL)
+    {
+        stats->wins = playerGetWins(player);
+        stats->loses = playerGetLoses(player);
+        stats->draws = playerGetDraws(player);
+        stats->total_play_time = playerGetTotalPlayTime(player);
+        playerDirectoryPublish(chess->directory, player_id, stats);
+    }
+    playerDirectoryUnlock(chess->directory, player_id, player_id);
+    chessUnlock(chess);
+    return (player == NULL) ? CHESS_PLAYER_NOT_EXIST : CHESS_SUCCESS;
+}
+
+/**
+*	chessRankPlayers: ranks the chess system's players who played, from the highest level to the lowest.
+*
+* @param chess - The chess system.
+*
+* @return
+* 	NULL - In case of memory error.
+*   A map from the players' ranks to the players otherwise.
+*/
+static Map chessRankPlayers(ChessSystem chess)
+{
+    Map players_rank_map = playersRankMapFactory();
+    if (players_rank_map == NULL)
+    {
+        return NULL;
+    }
+
+    MAP_FOREACH(Player, current_player_id, chess->players)
+    {
+        Player current_player = mapGet(chess->players ,current_player_id);
+        free(current_player_id);
+        if (playerGetTotalPlayTime(current_player) == 0)
+        {
+            continue;
+        }
+        double level = playerGetLevel(current_player);
+        int id = playerGetID(current_player);
+
+        Rank current_player_rank = playerRankCreate(level , id);
+        if (current_player_rank == NULL)
+        {
+            mapDestroy(players_rank_map);
+            return NULL;
+        }
+
+        if(mapPut(players_rank_map, current_player_rank, current_player) != MAP_SUCCESS)
+        {
+            playerRankDestroy(current_player_rank);
+            mapDestroy(players_rank_map);
+            return NULL;
+        }
+        playerRankDestroy(current_player_rank);
+    }
+    return players_rank_map;
+}
+
+/** Type for a function which writes the level of a single player in one of the levels formats */
+typedef bool (*writeLevelFunc)(ReportWriter, int, double);
+
+/**
+*	writeJsonLevel: writes a player's level as a line holding a JSON object.
+*
+* @param writer - The writer of the report.
+* @param player_id - The ID of the player.
+* @param level - The level of the player.
+*
+* @return
+* 	false - If writing failed.
+*   true - Otherwise.
+*/
+static bool writeJsonLevel(ReportWriter writer, int player_id, double level)
+{
+    return reportWriterPutString(writer, "{\"id\":") && reportWriterPutInt(writer, player_id) &&
+           reportWriterPutString(writer, ",\"level\":") && reportWriterPutFixed2(writer, level) &&
+           reportWriterPutString(writer, "}\n");
+}
+
+/**
+*	writeBinaryLevel: writes a player's level as a ChessLevelRecord.
+*
+* @param writer - The writer of the report.
+* @param player_id - The ID of the player.
+* @param level - The level of the player.
+*
+* @return
+* 	false - If writing failed.
+*   true - Otherwise.
+*/
+static bool writeBinaryLevel(ReportWriter writer, int player_id, double level)
+{
+    return reportWriterPutUint32(writer, (uint32_t) player_id) &&
+           reportWriterPutUint32(writer, (uint32_t) (int32_t) reportRoundFixed2(level));
+}
+
+/**
+*	writeBinaryLevelsHeader: writes the ChessLevelsHeader of a binary levels report.
+*
+* @param writer - The writer of the report.
+* @param number_of_records - The number of players in the report.
+*
+* @return
+* 	false - If writing failed.
+*   true - Otherwise.
+*/
+static bool writeBinaryLevelsHeader(ReportWriter writer, int number_of_records)
+{
+    return reportWriterPutBytes(writer, CHESS_LEVELS_BINARY_MAGIC, CHESS_LEVELS_BINARY_MAGIC_SIZE) &&
+           reportWriterPutUint32(writer, CHESS_LEVELS_BINARY_VERSION) &&
+           reportWriterPutUint32(writer, sizeof(ChessLevelRecord)) &&
+           reportWriterPutUint32(writer, (uint32_t) number_of_records);
+}
+
+/**
+*	writePlayersLevelsInFormat: writes the levels of the chess system's players, from the highest level to the
+*                               lowest, in a given format.
+*
+* @param chess - The chess system.
+* @param writer - The writer of the report.
+* @param format - The format of the report.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - In case of memory error.
+*   CHESS_SAVE_FAILURE - If writing failed, or the format is unknown.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult writePlayersLevelsInFormat(ChessSystem chess, ReportWriter writer, ChessLevelsFormat format)
+{
+    writeLevelFunc write_level = NULL;
+    switch (format)
+    {
+        case CHESS_LEVELS_TEXT:
+            write_level = reportWriterPutLevel;
+            break;
+        case CHESS_LEVELS_BINARY:
+            write_level = writeBinaryLevel;
+            break;
+        case CHESS_LEVELS_JSON_LINES:
+            write_level = writeJsonLevel;
+            break;
+        default:
+            return CHESS_SAVE_FAILURE;
+    }
+
+    Map players_rank_map = chessRankPlayers(chess);
+    if (players_rank_map == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    bool written = (format != CHESS_LEVELS_BINARY) ||
+                   writeBinaryLevelsHeader(writer, mapGetSize(players_rank_map));
+    MAP_FOREACH(Rank, current_player_rank, players_rank_map)
+    {
+        written = written && write_level(writer, playerRankGetID(current_player_rank),
+                                         playerRankGetLevel(current_player_rank));
+        free(current_player_rank);
+    }
+    mapDestroy(players_rank_map);
+    return (written == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+/**
+*	writePlayersLevels: writes the levels of the chess system's players as text, from the highest level to the
+*                       lowest.
+*
+* @param chess - The chess system.
+* @param writer - The writer of the report.
+*
+* @return
+*   See writePlayersLevelsInFormat.
+*/
+static ChessResult writePlayersLevels(ChessSystem chess, ReportWriter writer)
+{
+    return writePlayersLevelsInFormat(chess, writer, CHESS_LEVELS_TEXT);
+}
+
+/** Type for a function which writes a report of the chess system */
+typedef ChessResult (*writeReportFunc)(ChessSystem, ReportWriter);
+
+/**
+*	chessFinishReport: flushes the writer of a report, deallocates it, and gets the result of the report.
+*
+* @param writer - The writer of the report.
+* @param result - The result of writing the report.
+* @param write_error - The error returned if writing failed: CHESS_OUT_OF_MEMORY for memory buffers, and
+*                      CHESS_SAVE_FAILURE for files.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - In case of memory error.
+*   write_error - If writing failed.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult chessFinishReport(ReportWriter writer, ChessResult result, ChessResult write_error)
+{
+    bool written = reportWriterFlush(writer);
+    reportWriterDestroy(writer);
+    if (result == CHESS_SAVE_FAILURE || (result == CHESS_SUCCESS && written == false))
+    {
+        return write_error;
+    }
+    return result;
+}
+
+/**
+*	chessWriteReport: writes a report of the chess system through a writer, and deallocates the writer.
+*
+* @param chess - The chess system.
+* @param writer - The writer of the report. NULL if creating it failed.
+* @param write_report - The function which writes the report.
+* @param write_error - See chessFinishReport.
+*
+* @return
+*   See chessFinishReport.
+*/
+static ChessResult chessWriteReport(ChessSystem chess, ReportWriter writer, writeReportFunc write_report,
+                                    ChessResult write_error)
+{
+    if (writer == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return chessFinishReport(writer, write_report(chess, writer), write_error);
+}
+
+static ChessResult chessSavePlayersLevelsLocked(ChessSystem chess, FILE *file)
+{
+    if(chess == NULL || file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    return chessWriteReport(chess, reportWriterCreate(file), writePlayersLevels, CHESS_SAVE_FAILURE);
+}
+
+static ChessResult chessSavePlayersLevelsExLocked(ChessSystem chess, FILE *file, ChessLevelsFormat format)
+{
+    if(chess == NULL || file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    ReportWriter writer = reportWriterCreate(file);
+    if (writer == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return chessFinishReport(writer, writePlayersLevelsInFormat(chess, writer, format), CHESS_SAVE_FAILURE);
+}
+
+static ChessResult chessSavePlayersLevelsCompressedLocked(ChessSystem chess, FILE *file, ChessLevelsFormat format)
+{
+    if(chess == NULL || file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    ReportWriter writer = reportWriterCreateCompressed(file);
+    if (writer == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return chessFinishReport(writer, writePlayersLevelsInFormat(chess, writer, format), CHESS_SAVE_FAILURE);
+}
+
+static ChessResult chessSavePlayersLevelsToBufferLocked(ChessSystem chess, ChessReportBuffer *buffer)
+{
+    if(chess == NULL || buffer == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    return chessWriteReport(chess, reportWriterCreateForMemory(&buffer->data, &buffer->length, &buffer->capacity),
+                            writePlayersLevels, CHESS_OUT_OF_MEMORY);
+}
+
+static ChessResult chessSavePlayersLevelsToFdLocked(ChessSystem chess, int fd)
+{
+    if(chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (fd < 0)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    return chessWriteReport(chess, reportWriterCreateForFd(fd), writePlayersLevels, CHESS_SAVE_FAILURE);
+}
+
+/** Type for a player in a levels delta: either changed, with its current level, or removed */
+typedef struct levels_delta_entry_t
+{
+    int player_id;
+    bool removed;
+    double level;
+} LevelsDeltaEntry;
+
+/**
+*	compareLevelsDeltaEntry: Compares two levels delta entries by ID, and puts a changed player before a
+*                            removal of the same ID.
+*
+* @param element1 - The first entry.
+* @param element2 - The second entry.
+*
+* @return
+* 	A negative number if the first entry comes first, a positive number if the second does, 0 otherwise.
+*/
+static int compareLevelsDeltaEntry(const void *element1, const void *element2)
+{
+    const LevelsDeltaEntry *entry1 = element1;
+    const LevelsDeltaEntry *entry2 = element2;
+    if (entry1->player_id != entry2->player_id)
+    {
+        return (entry1->player_id < entry2->player_id) ? -1 : 1;
+    }
+    return (int) entry1->removed - (int) entry2->removed;
+}
+
+/**
+*	writePlayersLevelsDelta: writes the players whose level changed since a given token, and the players removed
+*                            since it, sorted by ID. A changed player is written as a line of "%d %.2lf", and
+*                            a removed player, or a player left without any play time, as a line of "%d -".
+*
+* @param chess - The chess system.
+* @param writer - The writer of the report.
+* @param since_token - The token of the previous delta, or 0 to write all the players.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - In case of memory error.
+*   CHESS_SAVE_FAILURE - If writing failed.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult writePlayersLevelsDelta(ChessSystem chess, ReportWriter writer, long long since_token)
+{
+    int capacity = mapGetSize(chess->players) + chess->number_of_tombstones;
+    LevelsDeltaEntry *entries = malloc((capacity > 0 ? capacity : 1) * sizeof(*entries));
+    if (entries == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    int number_of_entries = 0;
+    MAP_FOREACH(Player, current_player_id, chess->players)
+    {
+        Player current_player = mapGet(chess->players, current_player_id);
+        free(current_player_id);
+        bool has_level = (playerGetTotalPlayTime(current_player) != 0);
+        if (playerGetVersion(current_player) <= since_token || (since_token == 0 && has_level == false))
+        {
+            continue;
+        }
+        entries[number_of_entries].player_id = playerGetID(current_player);
+        entries[number_of_entries].removed = (has_level == false);
+        entries[number_of_entries].level = playerGetLevel(current_player);
+        number_of_entries++;
+    }
+    for (int index = 0; index < chess->number_of_tombstones && since_token > 0; index++)
+    {
+        if (chess->tombstones[index].version > since_token)
+        {
+            entries[number_of_entries].player_id = chess->tombstones[index].player_id;
+            entries[number_of_entries].removed = true;
+            entries[number_of_entries].level = 0;
+            number_of_entries++;
+        }
+    }
+    qsort(entries, number_of_entries, sizeof(*entries), compareLevelsDeltaEntry);
+
+    bool written = true;
+    for (int index = 0; index < number_of_entries && written == true; index++)
+    {
+        // A removed ID which was added back is written once, with its current state.
+        if (index > 0 && entries[index].player_id == entries[index - 1].player_id)
+        {
+            continue;
+        }
+        if (entries[index].removed == true)
+        {
+            written = reportWriterPutInt(writer, entries[index].player_id) &&
+                      reportWriterPutString(writer, " -\n");
+        }
+        else
+        {
+            written = reportWriterPutLevel(writer, entries[index].player_id, entries[index].level);
+        }
+    }
+    free(entries);
+    return (written == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+static ChessResult chessSavePlayersLevelsDeltaLocked(ChessSystem chess, FILE *file, long long since_token,
+                                                     long long *new_token)
+{
+    if(chess == NULL || file == NULL || new_token == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (since_token < 0 || since_token > chess->levels_version)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    ReportWriter writer = reportWriterCreate(file);
+    if (writer == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    ChessResult result = CHESS_SUCCESS;
+    if (since_token > 0 && since_token < chess->levels_oldest_token)
+    {
+        // The removals since the token were forgotten, so the consumer gets every player again
+        result = (reportWriterPutString(writer, "*\n") == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+        since_token = 0;
+    }
+    if (result == CHESS_SUCCESS)
+    {
+        result = writePlayersLevelsDelta(chess, writer, since_token);
+    }
+    result = chessFinishReport(writer, result, CHESS_SAVE_FAILURE);
+    if (result == CHESS_SUCCESS)
+    {
+        *new_token = chess->levels_version;
+    }
+    return result;
+}
+
+/**
+*	isAnyTournamentEnded: checks if any tournament in the chess system was ended.
+*
+* @param chess - The chess system which is being checked.
+*
+* @return
+* 	true - If a ended tournament was found.
+*   false - If no ended tournament was found.
+*/
+static bool isAnyTournamentEnded(ChessSystem chess)
+{
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
+        free(current_tournament_id);
+        if (tournamentGetWinner(current_tournament) != TOURNAMENT_NOT_ENDED)
+        {
+            return true;
+        } 
+    }
+    return false;
+}
+
+
+/**
+*	writeTournamentStatistics: writes the statistics of the chess system's ended tournaments, by tournament ID.
+*
+* @param chess - The chess system.
+* @param writer - The writer of the report.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - In case of memory error.
+*   CHESS_SAVE_FAILURE - If writing failed.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult writeTournamentStatistics(ChessSystem chess, ReportWriter writer)
+{
+    ChessResult result = CHESS_SUCCESS;
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments ,current_tournament_id);
+        if (result == CHESS_SUCCESS && isValidID(tournamentGetWinner(current_tournament)) == true)
+        {
+            // Tournaments loaded from files, or whose statistics changed, are rendered on their first save
+            int length = 0;
+            const char* statistics = tournamentGetStatistics(current_tournament, &length);
+            if (statistics == NULL && cacheTournamentStatistics(current_tournament) == false)
+            {
+                result = CHESS_OUT_OF_MEMORY;
+            }
+            statistics = tournamentGetStatistics(current_tournament, &length);
+            if (result == CHESS_SUCCESS && reportWriterPutBytes(writer, statistics, length) == false)
+            {
+                result = CHESS_SAVE_FAILURE;
+            }
+        }
+        free(current_tournament_id);
+    }
+    return result;
+}
+
+static ChessResult chessSaveTournamentStatisticsLocked(ChessSystem chess, char *path_file)
+{
+    if (chess == NULL || path_file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (isAnyTournamentEnded(chess) == false)
+    {
+        return CHESS_NO_TOURNAMENTS_ENDED;
+    }
+
+    FILE* file_tournament_stats = fopen(path_file, "w");
+    if (!file_tournament_stats)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    ChessResult result = chessWriteReport(chess, reportWriterCreate(file_tournament_stats),
+                                          writeTournamentStatistics, CHESS_SAVE_FAILURE);
+    if (fclose(file_tournament_stats) != 0 && result == CHESS_SUCCESS)
+    {
+        result = CHESS_SAVE_FAILURE;
+    }
+    return result;
+}
+
+static ChessResult chessSaveTournamentStatisticsToBufferLocked(ChessSystem chess, ChessReportBuffer *buffer)
+{
+    if (chess == NULL || buffer == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (isAnyTournamentEnded(chess) == false)
+    {
+        return CHESS_NO_TOURNAMENTS_ENDED;
+    }
+    return chessWriteReport(chess, reportWriterCreateForMemory(&buffer->data, &buffer->length, &buffer->capacity),
+                            writeTournamentStatistics, CHESS_OUT_OF_MEMORY);
+}
+
+static ChessResult chessSaveTournamentStatisticsToFdLocked(ChessSystem chess, int fd)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (isAnyTournamentEnded(chess) == false)
+    {
+        return CHESS_NO_TOURNAMENTS_ENDED;
+    }
+    if (fd < 0)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    return chessWriteReport(chess, reportWriterCreateForFd(fd), writeTournamentStatistics, CHESS_SAVE_FAILURE);
+}
+
+/**
+*	exportCopyLevels: copies the levels of the chess system's players with play time into the export session,
+*                     in ID order. The session sorts them as it steps.
+*
+* @param session - The export session.
+* @param chess - The chess system.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool exportCopyLevels(ChessExportSession session, ChessSystem chess)
+{
+    if (exportSessionReserveLevels(session, mapGetSize(chess->players)) == false)
+    {
+        return false;
+    }
+
+    MAP_FOREACH(Player, current_player_id, chess->players)
+    {
+        Player current_player = mapGet(chess->players, current_player_id);
+        free(current_player_id);
+        if (playerGetTotalPlayTime(current_player) != 0)
+        {
+            exportSessionAddLevel(session, playerGetID(current_player), playerGetLevel(current_player));
+        }
+    }
+    return true;
+}
+
+/**
+*	exportCopyStatistics: copies the statistics blocks of the chess system's ended tournaments into the export
+*                         session, by tournament ID, rendering the blocks which aren't cached yet.
+*
+* @param session - The export session.
+* @param chess - The chess system.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool exportCopyStatistics(ChessExportSession session, ChessSystem chess)
+{
+    int total_length = 0;
+    int number_of_ended = 0;
+    bool cached = true;
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments, current_tournament_id);
+        free(current_tournament_id);
+        if (cached == false || isValidID(tournamentGetWinner(current_tournament)) == false)
+        {
+            continue;
+        }
+        int length = 0;
+        if (tournamentGetStatistics(current_tournament, &length) == NULL)
+        {
+            cached = cacheTournamentStatistics(current_tournament);
+            tournamentGetStatistics(current_tournament, &length);
+        }
+        total_length += length;
+        number_of_ended++;
+    }
+
+    if (cached == false || exportSessionReserveStatistics(session, number_of_ended, total_length) == false)
+    {
+        return false;
+    }
+
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments, current_tournament_id);
+        free(current_tournament_id);
+        if (isValidID(tournamentGetWinner(current_tournament)) == false)
+        {
+            continue;
+        }
+        int length = 0;
+        const char* statistics = tournamentGetStatistics(current_tournament, &length);
+        exportSessionAddStatistics(session, statistics, length);
+    }
+    return true;
+}
+
+static ChessExportSession chessExportBeginLocked(ChessSystem chess, FILE *levels_file, FILE *statistics_file,
+                                                 ChessResult *chess_result)
+{
+    ChessResult ignored_result = CHESS_SUCCESS;
+    ChessResult *result = (chess_result == NULL) ? &ignored_result : chess_result;
+    if (chess == NULL || (levels_file == NULL && statistics_file == NULL))
+    {
+        *result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+    if (statistics_file != NULL && isAnyTournamentEnded(chess) == false)
+    {
+        *result = CHESS_NO_TOURNAMENTS_ENDED;
+        return NULL;
+    }
+
+    ChessExportSession session = exportSessionCreate(levels_file, statistics_file);
+    if (session == NULL || (levels_file != NULL && exportCopyLevels(session, chess) == false) ||
+        (statistics_file != NULL && exportCopyStatistics(session, chess) == false))
+    {
+        exportSessionDestroy(session);
+        *result = CHESS_OUT_OF_MEMORY;
+        return NULL;
+    }
+    *result = CHESS_SUCCESS;
+    return session;
+}
+
+ChessResult chessExportStep(ChessExportSession session, int max_records, bool *done)
+{
+    if (session == NULL || done == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    return exportSessionStep(session, max_records, done);
+}
+
+ChessResult chessExportEnd(ChessExportSession session)
+{
+    if (session == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    return exportSessionDestroy(session);
+}
+
+ChessResult chessDecompressFile(const char *path, const char *output_path)
+{
+    if (path == NULL || output_path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    FILE *input = fopen(path, "rb");
+    if (input == NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+
+    FILE *output = fopen(output_path, "wb");
+    LzReader reader = lzReaderCreate(input);
+    char *buffer = malloc(LZ_BLOCK_SIZE);
+    ChessResult result = CHESS_SUCCESS;
+    if (output == NULL)
+    {
+        result = CHESS_SAVE_FAILURE;
+    }
+    else if (reader == NULL || buffer == NULL)
+    {
+        result = CHESS_OUT_OF_MEMORY;
+    }
+    else
+    {
+        size_t read = 0;
+        do
+        {
+            read = lzReaderRead(reader, buffer, LZ_BLOCK_SIZE);
+        } while (read > 0 && fwrite(buffer, 1, read, output) == read);
+        // Data left over at the end means it couldn't be written
+        result = (read > 0 || lzReaderFailed(reader) == true) ? CHESS_SAVE_FAILURE : CHESS_SUCCESS;
+    }
+
+    free(buffer);
+    lzReaderDestroy(reader);
+    fclose(input);
+    if (output != NULL)
+    {
+        result = (fclose(output) != 0 && result == CHESS_SUCCESS) ? CHESS_SAVE_FAILURE : result;
+        if (result != CHESS_SUCCESS)
+        {
+            remove(output_path);
+        }
+    }
+    return result;
+}
+
+/** Type for a tournament of a parallel import, and the worker which imports its games */
+typedef struct import_tournament_t {
+    int tournament_id;
+    Tournament tournament;
+    int number_of_records;
+    int worker;
+} ImportTournament;
+
+/** Type for the outcome of a single game log record in a parallel import */
+typedef struct import_outcome_t {
+    ImportTournament *tournament;
+    ChessResult result;
+    bool added;
+    int game_id;
+    bool tournament_player_created[NUMBER_OF_PLAYERS_IN_GAME];
+} ImportOutcome;
+
+/** Type for the work of a single thread of a parallel import */
+typedef struct import_worker_t {
+    const GameLogRecord *records;
+    ImportOutcome *outcomes;
+    int number_of_records;
+    ImportTournament *tournaments;
+    int number_of_tournaments;
+    int worker;
+} ImportWorker;
+
+/**
+*	compareImportTournament: Compares two import tournaments by their IDs.
+*
+* @param element1 - The first import tournament to compare.
+* @param element2 - The second import tournament to compare.
+*
+* @return
+* 	A positive number if the first ID is greater, zero if equal, otherwise negative.
+*/
+static int compareImportTournament(const void *element1, const void *element2)
+{
+    return ((const ImportTournament*) element1)->tournament_id - ((const ImportTournament*) element2)->tournament_id;
+}
+
+/**
+*	compareImportTournamentLoad: Compares two import tournaments by their number of records, larger first,
+*                                and by their IDs for equal numbers.
+*
+* @param element1 - Pointer to the first import tournament to compare.
+* @param element2 - Pointer to the second import tournament to compare.
+*
+* @return
+* 	A negative number if the first tournament is imported first, zero if equal, otherwise positive.
+*/
+static int compareImportTournamentLoad(const void *element1, const void *element2)
+{
+    const ImportTournament *first = *(ImportTournament* const*) element1;
+    const ImportTournament *second = *(ImportTournament* const*) element2;
+    if (first->number_of_records != second->number_of_records)
+    {
+        return second->number_of_records - first->number_of_records;
+    }
+    return first->tournament_id - second->tournament_id;
+}
+
+/**
+*	importWorkerAddGame: adds a game to its tournament's games and players maps, without touching the
+*                        system's players map and game indexes. Everything that was added is recorded in
+*                        the outcome, and removed again if the game fails on memory.
+*
+* @param pairs - The pairs of players who already played each other in the worker's tournaments.
+* @param record - The game record.
+* @param outcome - The outcome of the record, to which the game's ID and the created players are written.
+*
+* @return
+*   See chessAddGame, apart from the errors checked before the workers start.
+*/
+static ChessResult importWorkerAddGame(GamePairSet pairs, const GameLogRecord *record, ImportOutcome *outcome)
+{
+    Tournament tournament = outcome->tournament->tournament;
+    int players[NUMBER_OF_PLAYERS_IN_GAME] = {record->first_player, record->second_player};
+    if (gamePairSetContains(pairs, record->tournament_id, players[0], players[1]) == true)
+    {
+        return CHESS_GAME_ALREADY_EXISTS;
+    }
+    if (isPlayTimeValid(record->play_time) == false)
+    {
+        return CHESS_INVALID_PLAY_TIME;
+    }
+    if (isMaxGamesPerPlayerExceeded(tournament, players[0]) == true ||
+        isMaxGamesPerPlayerExceeded(tournament, players[1]) == true)
+    {
+        return CHESS_EXCEEDED_GAMES;
+    }
+
+    Game new_game = gameCreate(record->winner, record->play_time, players[0], players[1]);
+    if (new_game == NULL || gamePairSetAdd(pairs, record->tournament_id, players[0], players[1]) == false)
+    {
+        gameDestroy(new_game);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    Map players_map = tournamentGetPlayersMap(tournament);
+    outcome->game_id = tournamentGenerateGameID(tournament);
+    tournamentSetDirty(tournament, true);
+    bool game_added = (mapPut(tournamentGetGamesMap(tournament), &outcome->game_id, new_game) == MAP_SUCCESS);
+    gameDestroy(new_game);
+    if (game_added == false ||
+        playerSetupInMap(tournament, players_map, players[0], &outcome->tournament_player_created[0]) != MAP_SUCCESS ||
+        playerSetupInMap(tournament, players_map, players[1], &outcome->tournament_player_created[1]) != MAP_SUCCESS)
+    {
+        for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+        {
+            if (outcome->tournament_player_created[index] == true)
+            {
+                mapRemove(players_map, &players[index]);
+                tournamentDecreaseNumberOfPlayers(tournament);
+            }
+        }
+        mapRemove(tournamentGetGamesMap(tournament), &outcome->game_id);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    playersAddStatsToMap(players_map, players[0], players[1], record->winner, record->play_time);
+    tournamentUpdateStats(tournament, record->play_time);
+    return CHESS_SUCCESS;
+}
+
+/**
+*	importWorkerSeedPairs: adds the pairs of players of the existing games in the worker's tournaments.
+*
+* @param worker - The worker whose tournaments are scanned.
+* @param pairs - The set to add the pairs to.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool importWorkerSeedPairs(ImportWorker *worker, GamePairSet pairs)
+{
+    for (int index = 0; index < worker->number_of_tournaments; index++)
+    {
+        ImportTournament *current = &worker->tournaments[index];
+        if (current->worker != worker->worker)
+        {
+            continue;
+        }
+        Map games_map = tournamentGetGamesMap(current->tournament);
+        MAP_FOREACH(int*, current_game_id, games_map)
+        {
+            Game current_game = mapGet(games_map, current_game_id);
+            free(current_game_id);
+            if (gamePairSetAdd(pairs, current->tournament_id, gameGetFirstPlayer(current_game),
+                               gameGetSecondPlayer(current_game)) == false)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+*	importWorkerRun: imports the records of the worker's tournaments, in the order of the game log.
+*                    The worker stops at the first record which fails on memory.
+*
+* @param argument - The worker.
+*
+* @return
+* 	NULL
+*/
+static void *importWorkerRun(void *argument)
+{
+    ImportWorker *worker = argument;
+    GamePairSet pairs = gamePairSetCreate(worker->number_of_records);
+    bool seeded = (pairs != NULL && importWorkerSeedPairs(worker, pairs) == true);
+
+    for (int index = 0; index < worker->number_of_records; index++)
+    {
+        ImportOutcome *outcome = &worker->outcomes[index];
+        if (outcome->tournament == NULL || outcome->tournament->worker != worker->worker)
+        {
+            continue;
+        }
+        outcome->result = (seeded == true) ?
+                          importWorkerAddGame(pairs, &worker->records[index], outcome) : CHESS_OUT_OF_MEMORY;
+        outcome->added = (outcome->result == CHESS_SUCCESS);
+        if (outcome->result == CHESS_OUT_OF_MEMORY)
+        {
+            break;
+        }
+    }
+    gamePairSetDestroy(pairs);
+    return NULL;
+}
+
+/**
+*	importApplyToSystem: adds a game which a worker added to its tournament to the system's players map
+*                        and to the players' game indexes.
+*
+* @param chess - The chess system to which the game is added.
+* @param record - The game record.
+* @param outcome - The outcome of the record in the worker.
+*
+* @return
+* 	CHESS_OUT_OF_MEMORY - If there was a memory allocation error. The system's players map and game indexes
+*                         are left unchanged.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult importApplyToSystem(ChessSystem chess, const GameLogRecord *record, ImportOutcome *outcome)
+{
+    Tournament tournament = outcome->tournament->tournament;
+    GameAssignment assignment = {.tournament_id = record->tournament_id, .game_id = outcome->game_id,
+                                 .players = {record->first_player, record->second_player}};
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        int player_id = assignment.players[index];
+        if (playerSetupInMap(tournament, chess->players, player_id,
+                             &assignment.player_created[index]) != MAP_SUCCESS ||
+            playerGamesAdd(chess, mapGet(chess->players, &player_id), assignment.tournament_id, assignment.game_id,
+                           &assignment.index_created[index]) != MAP_SUCCESS)
+        {
+            newGameSystemRollback(chess, tournament, &assignment);
+            return CHESS_OUT_OF_MEMORY;
+        }
+        assignment.index_added[index] = true;
+    }
+
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        chess->tournament_player_entries += (outcome->tournament_player_created[index] == true);
+    }
+    chess->number_of_games++;
+    playersAddStatsToMap(chess->players, record->first_player, record->second_player, record->winner,
+                         record->play_time);
+    chess->players_dirty = true;
+    chessTouchPlayers(chess, record->first_player, record->second_player);
+    Game game = mapGet(tournamentGetGamesMap(tournament), &outcome->game_id);
+    chessArchivePut(chess, record->tournament_id, outcome->game_id, game);
+    chessPublishGame(chess, CHESS_CHANGE_GAME_ADDED, record->tournament_id, outcome->game_id, game);
+    return CHESS_SUCCESS;
+}
+
+/**
+*	importUndoTournamentGame: removes a game which a worker added to its tournament, but which was not
+*                             added to the system because an earlier record failed on memory.
+*
+* @param record - The game record.
+* @param outcome - The outcome of the record in the worker.
+*
+* @return
+* 	None
+*/
+static void importUndoTournamentGame(const GameLogRecord *record, ImportOutcome *outcome)
+{
+    Tournament tournament = outcome->tournament->tournament;
+    Map players_map = tournamentGetPlayersMap(tournament);
+    int players[NUMBER_OF_PLAYERS_IN_GAME] = {record->first_player, record->second_player};
+
+    playersRemoveStats(players_map, players[0], players[1], record->winner, record->play_time);
+    tournamentRemoveGameStats(tournament, record->play_time);
+    mapRemove(tournamentGetGamesMap(tournament), &outcome->game_id);
+    for (int index = 0; index < NUMBER_OF_PLAYERS_IN_GAME; index++)
+    {
+        if (outcome->tournament_player_created[index] == true)
+        {
+            mapRemove(players_map, &players[index]);
+            tournamentDecreaseNumberOfPlayers(tournament);
+        }
+    }
+}
+
+/**
+*	importReadAllRecords: reads all the records of a game log.
+*
+* @param path - The path of the game log file.
+* @param number_of_records - Output for the number of records read.
+* @param result - Output for the error, if the log couldn't be read.
+*
+* @return
+* 	NULL - If the log couldn't be read, or it has no records.
+*   The records otherwise.
+*/
+static GameLogRecord *importReadAllRecords(const char *path, int *number_of_records, ChessResult *result)
+{
+    *number_of_records = 0;
+    GameLogReader reader = gameLogReaderCreate(path);
+    if (reader == NULL)
+    {
+        *result = CHESS_SAVE_FAILURE;
+        return NULL;
+    }
+
+    int capacity = IMPORT_BATCH_SIZE;
+    GameLogRecord *records = malloc(sizeof(*records) * capacity);
+    int records_read = 0;
+    while (records != NULL &&
+           (records_read = gameLogReaderRead(reader, records + *number_of_records,
+                                             capacity - *number_of_records)) > 0)
+    {
+        *number_of_records += records_read;
+        if (*number_of_records == capacity)
+        {
+            GameLogRecord *larger_records = realloc(records, sizeof(*records) * capacity * 2);
+            if (larger_records == NULL)
+            {
+                free(records);
+            }
+            records = larger_records;
+            capacity = capacity * 2;
+        }
+    }
+    gameLogReaderDestroy(reader);
+    *result = (records == NULL) ? CHESS_OUT_OF_MEMORY : CHESS_SUCCESS;
+    return records;
+}
+
+/**
+*	importCollectTournaments: checks the records whose errors don't depend on the tournaments' games, and
+*                             collects the tournaments of the rest, with the number of records of each.
+*                             Records of ended tournaments fail here, so the workers never touch a tournament
+*                             which may have been spilled.
+*
+* @param chess - The chess system to which the games are imported.
+* @param records - The game log records.
+* @param outcomes - The outcomes of the records. The results of records which failed are set.
+* @param number_of_records - The number of records.
+* @param number_of_tournaments - Output for the number of distinct tournaments collected.
+*
+* @return
+* 	NULL - In case of memory error.
+*   The collected tournaments, sorted by ID, otherwise.
+*/
+static ImportTournament *importCollectTournaments(ChessSystem chess, const GameLogRecord *records,
+                                                  ImportOutcome *outcomes, int number_of_records,
+                                                  int *number_of_tournaments)
+{
+    ImportTournament *tournaments = malloc(sizeof(*tournaments) * (number_of_records + 1));
+    if (tournaments == NULL)
+    {
+        return NULL;
+    }
+
+    int number_of_ids = 0;
+    for (int index = 0; index < number_of_records; index++)
+    {
+        outcomes[index].result = (records[index].valid == false) ? CHESS_INVALID_ID :
+                                 chessAddGameErrorCheck(chess, records[index].tournament_id,
+                                                        records[index].first_player, records[index].second_player);
+        if (outcomes[index].result == CHESS_SUCCESS &&
+            tournamentGetWinner(chessFindTournament(chess, records[index].tournament_id)) != TOURNAMENT_NOT_ENDED)
+        {
+            outcomes[index].result = CHESS_TOURNAMENT_ENDED;
+        }
+        if (outcomes[index].result == CHESS_SUCCESS)
+        {
+            tournaments[number_of_ids].tournament_id = records[index].tournament_id;
+            tournaments[number_of_ids].number_of_records = 1;
+            number_of_ids++;
+        }
+    }
+    qsort(tournaments, number_of_ids, sizeof(*tournaments), compareImportTournament);
+
+    *number_of_tournaments = 0;
+    for (int index = 0; index < number_of_ids; index++)
+    {
+        if (*number_of_tournaments > 0 &&
+            tournaments[*number_of_tournaments - 1].tournament_id == tournaments[index].tournament_id)
+        {
+            tournaments[*number_of_tournaments - 1].number_of_records++;
+            continue;
+        }
+        tournaments[*number_of_tournaments] = tournaments[index];
+        tournaments[*number_of_tournaments].tournament = mapGet(chess->tournaments,
+                                                                &tournaments[index].tournament_id);
+        (*number_of_tournaments)++;
+    }
+
+    for (int index = 0; index < number_of_records; index++)
+    {
+        if (outcomes[index].result == CHESS_SUCCESS)
+        {
+            ImportTournament key = {.tournament_id = records[index].tournament_id};
+            outcomes[index].tournament = bsearch(&key, tournaments, *number_of_tournaments, sizeof(*tournaments),
+                                                 compareImportTournament);
+        }
+    }
+    return tournaments;
+}
+
+/**
+*	importAssignWorkers: assigns the tournaments to the workers, so that each worker gets a similar
+*                        number of records. Larger tournaments are assigned first, each to the worker
+*                        with the fewest records so far.
+*
+* @param tournaments - The tournaments to assign.
+* @param number_of_tournaments - The number of tournaments.
+* @param number_of_workers - The number of workers.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool importAssignWorkers(ImportTournament *tournaments, int number_of_tournaments, int number_of_workers)
+{
+    ImportTournament **order = malloc(sizeof(*order) * (number_of_tournaments + 1));
+    int *loads = calloc(number_of_workers, sizeof(*loads));
+    if (order == NULL || loads == NULL)
+    {
+        free(order);
+        free(loads);
+        return false;
+    }
+
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        order[index] = &tournaments[index];
+    }
+    qsort(order, number_of_tournaments, sizeof(*order), compareImportTournamentLoad);
+
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        int lightest = 0;
+        for (int worker = 1; worker < number_of_workers; worker++)
+        {
+            if (loads[worker] < loads[lightest])
+            {
+                lightest = worker;
+            }
+        }
+        order[index]->worker = lightest;
+        loads[lightest] += order[index]->number_of_records;
+    }
+    free(order);
+    free(loads);
+    return true;
+}
+
+/**
+*	importRunWorkers: runs the workers of a parallel import, each on its own thread. A worker whose thread
+*                     couldn't be started runs on the calling thread once the others finish.
+*
+* @param records - The game log records.
+* @param outcomes - The outcomes of the records.
+* @param number_of_records - The number of records.
+* @param tournaments - The tournaments of the import, assigned to workers.
+* @param number_of_tournaments - The number of tournaments.
+* @param number_of_workers - The number of workers.
+*
+* @return
+* 	false - In case of memory error. No worker was run.
+*   true - Otherwise.
+*/
+static bool importRunWorkers(const GameLogRecord *records, ImportOutcome *outcomes, int number_of_records,
+                             ImportTournament *tournaments, int number_of_tournaments, int number_of_workers)
+{
+    ImportWorker *workers = malloc(sizeof(*workers) * number_of_workers);
+    pthread_t *threads = malloc(sizeof(*threads) * number_of_workers);
+    bool *started = calloc(number_of_workers, sizeof(*started));
+    if (workers == NULL || threads == NULL || started == NULL)
+    {
+        free(workers);
+        free(threads);
+        free(started);
+        return false;
+    }
+
+    for (int worker = 0; worker < number_of_workers; worker++)
+    {
+        ImportWorker current = {records, outcomes, number_of_records, tournaments, number_of_tournaments, worker};
+        workers[worker] = current;
+        started[worker] = (pthread_create(&threads[worker], NULL, importWorkerRun, &workers[worker]) == 0);
+    }
+    for (int worker = 0; worker < number_of_workers; worker++)
+    {
+        if (started[worker] == true)
+        {
+            pthread_join(threads[worker], NULL);
+        }
+    }
+    for (int worker = 0; worker < number_of_workers; worker++)
+    {
+        if (started[worker] == false)
+        {
+            importWorkerRun(&workers[worker]);
+        }
+    }
+    free(workers);
+    free(threads);
+    free(started);
+    return true;
+}
+
+/**
+*	importMergeOutcomes: adds the games the workers imported to the system's players map and game indexes,
+*                        and reports the records' errors, in the order of the game log. Once a record failed on
+*                        memory, the games of the records after it are removed from their tournaments.
+*
+* @param chess - The chess system to which the games are imported.
+* @param records - The game log records.
+* @param outcomes - The outcomes of the records.
+* @param number_of_records - The number of records.
+* @param stats - The import statistics to update.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - If a record failed on memory.
+*   CHESS_SAVE_FAILURE - If a game was added, but couldn't be recorded in the journal.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult importMergeOutcomes(ChessSystem chess, const GameLogRecord *records, ImportOutcome *outcomes,
+                                       int number_of_records, ChessImportStats *stats)
+{
+    ChessResult journal_result = CHESS_SUCCESS;
+    int stop = number_of_records;
+    for (int index = 0; index < number_of_records && stop == number_of_records; index++)
+    {
+        if (outcomes[index].result == CHESS_OUT_OF_MEMORY ||
+            (outcomes[index].result == CHESS_SUCCESS &&
+             importApplyToSystem(chess, &records[index], &outcomes[index]) != CHESS_SUCCESS))
+        {
+            stop = index;
+            break;
+        }
+        stats->lines_read++;
+        if (outcomes[index].result == CHESS_SUCCESS)
+        {
+            stats->games_added++;
+            int arguments[JOURNAL_MAX_ARGUMENTS] = {records[index].tournament_id, records[index].first_player,
+                                                    records[index].second_player, records[index].winner,
+                                                    records[index].play_time};
+            if (chessJournalRecord(chess, JOURNAL_ADD_GAME, arguments, NULL) != CHESS_SUCCESS)
+            {
+                journal_result = CHESS_SAVE_FAILURE;
+            }
+        }
+        else
+        {
+            importStatsAddError(stats, records[index].line, outcomes[index].result);
+        }
+    }
+    if (stop == number_of_records)
+    {
+        return journal_result;
+    }
+
+    stats->lines_read++;
+    importStatsAddError(stats, records[stop].line, CHESS_OUT_OF_MEMORY);
+    for (int index = number_of_records - 1; index >= stop; index--)
+    {
+        if (outcomes[index].added == true)
+        {
+            importUndoTournamentGame(&records[index], &outcomes[index]);
+        }
+    }
+    return CHESS_OUT_OF_MEMORY;
+}
+
+/**
+*	importHasMemoryFor: checks if the chess system's memory budget has room for the given number of games,
+*                       assuming each of them adds two new players to the system and to its tournament.
+*
+* @param chess - The chess system to which the games are imported.
+* @param number_of_games - The number of games.
+*
+* @return
+* 	true - If the games fit in the budget.
+*   false - Otherwise.
+*/
+static bool importHasMemoryFor(ChessSystem chess, int number_of_games)
+{
+    size_t game_size = gameMemoryEstimate() +
+                       NUMBER_OF_PLAYERS_IN_GAME * (playerMemoryEstimate(true) + playerMemoryEstimate(false));
+    return chessHasMemoryFor(chess, game_size * (size_t) number_of_games);
+}
+
+static ChessResult chessImportGamesParallelLocked(ChessSystem chess, const char *path, ChessImportStats *stats,
+                                                  int number_of_threads)
+{
+    ChessResult result = chessImportErrorCheck(chess, path, stats);
+    if (result != CHESS_SUCCESS || number_of_threads <= 1)
+    {
+        return (result != CHESS_SUCCESS) ? result : chessImportGamesLocked(chess, path, stats);
+    }
+
+    int number_of_records = 0;
+    GameLogRecord *records = importReadAllRecords(path, &number_of_records, &result);
+    ImportOutcome *outcomes = (records != NULL) ? calloc(number_of_records + 1, sizeof(*outcomes)) : NULL;
+    if (outcomes == NULL)
+    {
+        free(records);
+        return (result != CHESS_SUCCESS) ? result : CHESS_OUT_OF_MEMORY;
+    }
+
+    int number_of_tournaments = 0;
+    ImportTournament *tournaments = importCollectTournaments(chess, records, outcomes, number_of_records,
+                                                             &number_of_tournaments);
+    int number_of_games = 0;
+    for (int index = 0; index < number_of_tournaments; index++)
+    {
+        number_of_games += tournaments[index].number_of_records;
+    }
+    int number_of_workers = (number_of_threads < number_of_tournaments) ? number_of_threads : number_of_tournaments;
+
+    if (tournaments == NULL || gamePoolReserve(number_of_games) == false)
+    {
+        result = CHESS_OUT_OF_MEMORY;
+    }
+    else if (number_of_workers <= 1 || importHasMemoryFor(chess, number_of_games) == false)
+    {
+        // A budget that may run out is only checked in order by a sequential import
+        int cached_id = 0;
+        Tournament cached_tournament = NULL;
+        result = chessImportRecords(chess, records, number_of_records, stats, &cached_id, &cached_tournament);
+    }
+    else if (importAssignWorkers(tournaments, number_of_tournaments, number_of_workers) == false ||
+             importRunWorkers(records, outcomes, number_of_records, tournaments, number_of_tournaments,
+                              number_of_workers) == false)
+    {
+        result = CHESS_OUT_OF_MEMORY;
+    }
+    else
+    {
+        result = importMergeOutcomes(chess, records, outcomes, number_of_records, stats);
+    }
+
+    free(tournaments);
+    free(outcomes);
+    free(records);
+    return result;
+}
+
+/**
+*	snapshotFillPlayers: fills the snapshot records of the players of a players map, sorted by ID.
+*
+* @param players_map - The players map.
+* @param records - The records to fill, with room for all the players of the map.
+*
+* @return
+* 	The number of records filled.
+*/
+static int snapshotFillPlayers(Map players_map, SnapshotPlayer *records)
+{
+    int number_of_records = 0;
+    MAP_FOREACH(int*, current_player_id, players_map)
+    {
+        Player current_player = mapGet(players_map, current_player_id);
+        SnapshotPlayer record = {*current_player_id, playerGetWins(current_player), playerGetLoses(current_player),
+                                 playerGetDraws(current_player), playerGetTotalPlayTime(current_player)};
+        records[number_of_records++] = record;
+        free(current_player_id);
+    }
+    return number_of_records;
+}
+
+/**
+*	snapshotFillTournament: fills the snapshot records of a tournament, its location, games and players.
+*
+* @param snapshot - The snapshot to fill. Its counts are used as the positions to fill from, and are
+*                   increased by the records filled.
+* @param tournament_id - The ID of the tournament.
+* @param tournament - The tournament.
+*
+* @return
+* 	None
+*/
+static void snapshotFillTournament(Snapshot *snapshot, int tournament_id, Tournament tournament)
+{
+    Map games_map = tournamentGetGamesMap(tournament);
+    SnapshotTournament *record = &snapshot->tournaments[snapshot->number_of_tournaments++];
+    const char *location = tournamentGetLocation(tournament);
+    SnapshotTournament tournament_record = {tournament_id, tournamentGetMaxGamesPerPlayer(tournament),
+                                            tournamentGetWinner(tournament), tournamentGetNumberOfGames(tournament),
+                                            tournamentGetNumberOfPlayers(tournament),
+                                            tournamentGetTotalPlayTime(tournament), tournamentGetLastGameID(tournament),
+                                            (int) strlen(location), mapGetSize(games_map),
+                                            mapGetSize(tournamentGetPlayersMap(tournament))};
+    *record = tournament_record;
+    memcpy(snapshot->locations + snapshot->locations_size, location, record->location_length);
+    snapshot->locations_size += record->location_length;
+
+    MAP_FOREACH(int*, current_game_id, games_map)
+    {
+        Game current_game = mapGet(games_map, current_game_id);
+        SnapshotGame game_record = {*current_game_id, gameGetFirstPlayer(current_game),
+                                    gameGetSecondPlayer(current_game), gameGetWinner(current_game),
+                                    gameGetPlayTime(current_game)};
+        snapshot->games[snapshot->number_of_games++] = game_record;
+        free(current_game_id);
+    }
+    snapshot->number_of_tournament_players += snapshotFillPlayers(tournamentGetPlayersMap(tournament),
+                                                  snapshot->tournament_players + snapshot->number_of_tournament_players);
+}
+
+/**
+*	chessWriteSnapshot: saves the whole chess system to a snapshot file.
+*
+* @param chess - The chess system.
+* @param path - The path of the snapshot file.
+* @param compressed - Whether to compress the file.
+*
+* @return
+*   See chessSaveSnapshot.
+*/
+static ChessResult chessWriteSnapshot(ChessSystem chess, const char *path, bool compressed)
+{
+    if (chess == NULL || path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    size_t locations_size = 0, number_of_games = 0, number_of_tournament_players = 0;
+    MAP_FOREACH(int*, current_tournament_id, chess->tournaments)
+    {
+        Tournament current_tournament = mapGet(chess->tournaments, current_tournament_id);
+        locations_size += strlen(tournamentGetLocation(current_tournament));
+        number_of_games += mapGetSize(tournamentGetGamesMap(current_tournament));
+        number_of_tournament_players += mapGetSize(tournamentGetPlayersMap(current_tournament));
+        free(current_tournament_id);
+    }
+
+    Snapshot snapshot = {0};
+    snapshot.tournaments = malloc(sizeof(*snapshot.tournaments) * (mapGetSize(chess->tournaments) + 1));
+    snapshot.locations = malloc(locations_size + 1);
+    snapshot.games = malloc(sizeof(*snapshot.games) * (number_of_games + 1));
+    snapshot.tournament_players = malloc(sizeof(*snapshot.tournament_players) * (number_of_tournament_players + 1));
+    snapshot.players = malloc(sizeof(*snapshot.players) * (mapGetSize(chess->players) + 1));
+    if (snapshot.tournaments == NULL || snapshot.locations == NULL || snapshot.games == NULL ||
+        snapshot.tournament_players == NULL || snapshot.players == NULL)
+    {
+        snapshotClear(&snapshot);
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    MAP_FOREACH(int*, current_tournament_id, chess->tournaments)
+    {
+        snapshotFillTournament(&snapshot, *current_tournament_id, mapGet(chess->tournaments, current_tournament_id));
+        free(current_tournament_id);
+    }
+    snapshot.number_of_players = snapshotFillPlayers(chess->players, snapshot.players);
+    snapshot.journal_sequence = chess->journal_sequence;
+
+    bool written = snapshotWrite(path, &snapshot, compressed);
+    snapshotClear(&snapshot);
+    return (written == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+static ChessResult chessSaveSnapshotLocked(ChessSystem chess, const char *path)
+{
+    return chessWriteSnapshot(chess, path, false);
+}
+
+static ChessResult chessSaveSnapshotCompressedLocked(ChessSystem chess, const char *path)
+{
+    return chessWriteSnapshot(chess, path, true);
+}
+
+/**
+*	snapshotLoadPlayers: adds the players of snapshot records to a players map.
+*
+* @param players_map - The players map to add the players to.
+* @param records - The player records.
+* @param number_of_records - The number of records.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool snapshotLoadPlayers(Map players_map, const SnapshotPlayer *records, int number_of_records)
+{
+    for (int index = 0; index < number_of_records; index++)
+    {
+        Player player = playerCreate(records[index].player_id);
+        if (player == NULL)
+        {
+            return false;
+        }
+        playerSetStats(player, records[index].wins, records[index].loses, records[index].draws,
+                       records[index].total_play_time);
+        MapResult put_result = mapPut(players_map, (MapKeyElement) &records[index].player_id, player);
+        playerDestroy(player);
+        if (put_result != MAP_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*	snapshotLoadTournament: adds a tournament of a snapshot, with its games and players, to the chess system,
+*                           and adds its games to the players' game indexes. The system's players must be loaded.
+*
+* @param chess - The chess system to load into.
+* @param record - The tournament record.
+* @param location - The tournament's location, not terminated.
+* @param games - The tournament's game records.
+* @param players - The tournament's player records.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool snapshotLoadTournament(ChessSystem chess, const SnapshotTournament *record, const char *location,
+                                   const SnapshotGame *games, const SnapshotPlayer *players)
+{
+    char *location_string = malloc(record->location_length + 1);
+    if (location_string == NULL)
+    {
+        return false;
+    }
+    memcpy(location_string, location, record->location_length);
+    location_string[record->location_length] = '\0';
+    Tournament new_tournament = tournamentCreate(record->max_games_per_player, location_string);
+    free(location_string);
+    if (new_tournament == NULL)
+    {
+        return false;
+    }
+    MapResult put_result = mapPut(chess->tournaments, (MapKeyElement) &record->tournament_id, new_tournament);
+    tournamentDestroy(new_tournament);
+    if (put_result != MAP_SUCCESS)
+    {
+        return false;
+    }
+
+    Tournament tournament = mapGet(chess->tournaments, (MapKeyElement) &record->tournament_id);
+    chess->tournaments_memory += tournamentMemoryEstimate(tournament);
+    tournamentSetWinner(tournament, record->winner);
+    tournamentRestoreStats(tournament, record->number_of_games, record->number_of_players,
+                           record->total_play_time, record->last_game_id);
+
+    for (int index = 0; index < record->games_count; index++)
+    {
+        Game game = gameCreate((Winner) games[index].winner, games[index].play_time, games[index].first_player,
+                               games[index].second_player);
+        if (game == NULL)
+        {
+            return false;
+        }
+        put_result = mapPut(tournamentGetGamesMap(tournament), (MapKeyElement) &games[index].game_id, game);
+        gameDestroy(game);
+        if (put_result != MAP_SUCCESS)
+        {
+            return false;
+        }
+        chess->number_of_games++;
+
+        int game_players[NUMBER_OF_PLAYERS_IN_GAME] = {games[index].first_player, games[index].second_player};
+        for (int player = 0; player < NUMBER_OF_PLAYERS_IN_GAME; player++)
+        {
+            // The system's players are loaded first, and the removed players the games still name are not
+            bool created = false;
+            Player game_player = mapGet(chess->players, &game_players[player]);
+            if (game_player != NULL &&
+                playerGamesAdd(chess, game_player, record->tournament_id, games[index].game_id,
+                               &created) != MAP_SUCCESS)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (snapshotLoadPlayers(tournamentGetPlayersMap(tournament), players, record->players_count) == false)
+    {
+        return false;
+    }
+    chess->tournament_player_entries += record->players_count;
+    return true;
+}
+
+ChessSystem chessLoadSnapshot(const char *path, ChessResult *result)
+{
+    ChessResult dummy_result;
+    result = (result != NULL) ? result : &dummy_result;
+    if (path == NULL)
+    {
+        *result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+
+    Snapshot snapshot;
+    SnapshotResult read_result = snapshotRead(path, &snapshot);
+    if (read_result != SNAPSHOT_SUCCESS)
+    {
+        *result = (read_result == SNAPSHOT_OUT_OF_MEMORY) ? CHESS_OUT_OF_MEMORY : CHESS_SAVE_FAILURE;
+        return NULL;
+    }
+
+    ChessSystem chess = chessCreate();
+    bool loaded = chess != NULL && gamePoolReserve(snapshot.number_of_games) == true &&
+                  playerPoolReserve(snapshot.number_of_tournament_players + snapshot.number_of_players) == true &&
+                  snapshotLoadPlayers(chess->players, snapshot.players, snapshot.number_of_players) == true;
+    const char *location = snapshot.locations;
+    const SnapshotGame *games = snapshot.games;
+    const SnapshotPlayer *players = snapshot.tournament_players;
+    for (int index = 0; index < snapshot.number_of_tournaments && loaded == true; index++)
+    {
+        const SnapshotTournament *record = &snapshot.tournaments[index];
+        loaded = snapshotLoadTournament(chess, record, location, games, players);
+        location += record->location_length;
+        games += record->games_count;
+        players += record->players_count;
+    }
+    if (loaded == true)
+    {
+        chess->journal_sequence = snapshot.journal_sequence;
+    }
+    snapshotClear(&snapshot);
+
+    if (loaded == false)
+    {
+        chessDestroy(chess);
+        *result = CHESS_OUT_OF_MEMORY;
+        return NULL;
+    }
+    *result = CHESS_SUCCESS;
+    return chess;
+}
+
+/**
+*	journalSyncPolicy: converts the sync policy of the chess system interface to the journal's sync policy.
+*
+* @param sync - The sync policy of the chess system interface.
+*
+* @return
+* 	The matching journal sync policy. Unknown values sync every record.
+*/
+static JournalSyncPolicy journalSyncPolicy(ChessJournalSync sync)
+{
+    if (sync == CHESS_JOURNAL_SYNC_GROUP)
+    {
+        return JOURNAL_SYNC_GROUP;
+    }
+    return (sync == CHESS_JOURNAL_SYNC_NONE) ? JOURNAL_SYNC_NONE : JOURNAL_SYNC_EVERY_RECORD;
+}
+
+static ChessResult chessAttachJournalLocked(ChessSystem chess, const char *path, ChessJournalSync sync,
+                                            int group_commit_ms)
+{
+    if (chess == NULL || path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (chess->journal != NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    chess->journal = journalOpen(path, journalSyncPolicy(sync), group_commit_ms);
+    return (chess->journal != NULL) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+static ChessResult chessDetachJournalLocked(ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    bool synced = journalClose(chess->journal);
+    chess->journal = NULL;
+    return (synced == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+static ChessResult chessSyncJournalLocked(ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    return (journalSync(chess->journal) == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+/**
+*	chessApplyJournalRecord: applies a single mutation read from a journal to the chess system.
+*
+* @param chess - The chess system to apply the mutation to.
+* @param record - The journal record of the mutation.
+*
+* @return
+*   The result of the chess system function which applied the mutation.
+*/
+static ChessResult chessApplyJournalRecord(ChessSystem chess, const JournalRecord *record)
+{
+    const int *arguments = record->arguments;
+    switch (record->type)
+    {
+        case JOURNAL_ADD_TOURNAMENT:
+            return chessAddTournamentLocked(chess, arguments[0], arguments[1], record->text);
+        case JOURNAL_ADD_GAME:
+            return chessAddGameLocked(chess, arguments[0], arguments[1], arguments[2], (Winner) arguments[3],
+                                      arguments[4]);
+        case JOURNAL_REMOVE_TOURNAMENT:
+            return chessRemoveTournamentLocked(chess, arguments[0]);
+        case JOURNAL_REMOVE_PLAYER:
+            return chessRemovePlayerLocked(chess, arguments[0]);
+        case JOURNAL_END_TOURNAMENT:
+            return chessEndTournamentLocked(chess, arguments[0]);
+        case JOURNAL_UPDATE_GAME_RESULT:
+            return chessUpdateGameResultLocked(chess, arguments[0], arguments[1], (Winner) arguments[2],
+                                               arguments[3]);
+        case JOURNAL_REMOVE_GAME:
+            return chessRemoveGameLocked(chess, arguments[0], arguments[1]);
+        default:
+            return chessMergePlayersLocked(chess, arguments[0], arguments[1], NULL, 0, NULL);
+    }
+}
+
+static ChessResult chessReplayJournalLocked(ChessSystem chess, const char *path, int *records_applied)
+{
+    int dummy_records_applied;
+    records_applied = (records_applied != NULL) ? records_applied : &dummy_records_applied;
+    *records_applied = 0;
+    if (chess == NULL || path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    JournalReader reader = journalReaderCreate(path);
+    if (reader == NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+
+    // The replayed mutations are already recorded, so the system's own journal is set aside meanwhile
+    Journal journal = chess->journal;
+    chess->journal = NULL;
+    ChessResult result = CHESS_SUCCESS;
+    JournalRecord record;
+    while (result == CHESS_SUCCESS && journalReaderNext(reader, &record) == true)
+    {
+        if (record.sequence <= chess->journal_sequence)
+        {
+            continue;
+        }
+        // Only successful mutations are recorded, so other errors can only come from an unrelated journal
+        if (chessApplyJournalRecord(chess, &record) == CHESS_OUT_OF_MEMORY)
+        {
+            result = CHESS_OUT_OF_MEMORY;
+            break;
+        }
+        chess->journal_sequence = record.sequence;
+        (*records_applied)++;
+    }
+    chess->journal = journal;
+    journalReaderDestroy(reader);
+    return result;
+}
+
+ChessSystem chessRecover(const char *snapshot_path, const char *journal_path, ChessResult *chess_result)
+{
+    ChessResult dummy_result;
+    chess_result = (chess_result != NULL) ? chess_result : &dummy_result;
+    if (journal_path == NULL)
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+
+    ChessSystem chess = NULL;
+    if (snapshot_path != NULL)
+    {
+        chess = chessLoadSnapshot(snapshot_path, chess_result);
+    }
+    else
+    {
+        chess = chessCreate();
+        *chess_result = (chess != NULL) ? CHESS_SUCCESS : CHESS_OUT_OF_MEMORY;
+    }
+    if (chess == NULL)
+    {
+        return NULL;
+    }
+
+    *chess_result = chessReplayJournal(chess, journal_path, NULL);
+    if (*chess_result != CHESS_SUCCESS)
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+    return chess;
+}
+
+/**
+*	checkpointFillTournament: allocates the segment of a tournament and fills it.
+*
+* @param segment - The segment to fill. Must be freed with snapshotClear.
+* @param tournament_id - The ID of the tournament.
+* @param tournament - The tournament.
+*
+* @return
+* 	false - In case of memory error. The segment is left empty.
+*   true - Otherwise.
+*/
+static bool checkpointFillTournament(Snapshot *segment, int tournament_id, Tournament tournament)
+{
+    memset(segment, 0, sizeof(*segment));
+    segment->tournaments = malloc(sizeof(*segment->tournaments));
+    segment->locations = malloc(strlen(tournamentGetLocation(tournament)) + 1);
+    segment->games = malloc(sizeof(*segment->games) * (mapGetSize(tournamentGetGamesMap(tournament)) + 1));
+    segment->tournament_players = malloc(sizeof(*segment->tournament_players) *
+                                         (mapGetSize(tournamentGetPlayersMap(tournament)) + 1));
+    if (segment->tournaments == NULL || segment->locations == NULL || segment->games == NULL ||
+        segment->tournament_players == NULL)
+    {
+        snapshotClear(segment);
+        return false;
+    }
+    snapshotFillTournament(segment, tournament_id, tournament);
+    return true;
+}
+
+/**
+*	checkpointWriteTournament: adds the segment of a tournament to a new checkpoint. A tournament which didn't
+*                              change since the previous checkpoint is linked to it instead of being written.
+*
+* @param writer - The new checkpoint.
+* @param tournament_id - The ID of the tournament.
+* @param tournament - The tournament.
+* @param incremental - Whether the new checkpoint follows the system's previous checkpoint.
+*
+* @return
+*   CHESS_OUT_OF_MEMORY - In case of memory error.
+*   CHESS_SAVE_FAILURE - If the segment couldn't be written.
+*   CHESS_SUCCESS - Otherwise.
+*/
+static ChessResult checkpointWriteTournament(CheckpointWriter writer, int tournament_id, Tournament tournament,
+                                             bool incremental)
+{
+    if (incremental == true && tournamentIsDirty(tournament) == false &&
+        checkpointLinkSegment(writer, tournament_id) == true)
+    {
+        return CHESS_SUCCESS;
+    }
+
+    Snapshot segment;
+    if (checkpointFillTournament(&segment, tournament_id, tournament) == false)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    bool written = checkpointWriteSegment(writer, tournament_id, &segment);
+    snapshotClear(&segment);
+    return (written == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+/**
+*	checkpointWriteSystem: adds the segments of the chess system's players and tournaments to a new checkpoint.
+*
+* @param chess - The chess system.
+* @param writer - The new checkpoint.
+* @param incremental - Whether the new checkpoint follows the system's previous checkpoint.
+*
+* @return
+*   See checkpointWriteTournament.
+*/
+static ChessResult checkpointWriteSystem(ChessSystem chess, CheckpointWriter writer, bool incremental)
+{
+    if (incremental == false || chess->players_dirty == true ||
+        checkpointLinkSegment(writer, CHECKPOINT_PLAYERS_SEGMENT) == false)
+    {
+        Snapshot segment;
+        memset(&segment, 0, sizeof(segment));
+        segment.players = malloc(sizeof(*segment.players) * (mapGetSize(chess->players) + 1));
+        if (segment.players == NULL)
+        {
+            return CHESS_OUT_OF_MEMORY;
+        }
+        segment.number_of_players = snapshotFillPlayers(chess->players, segment.players);
+        bool written = checkpointWriteSegment(writer, CHECKPOINT_PLAYERS_SEGMENT, &segment);
+        snapshotClear(&segment);
+        if (written == false)
+        {
+            return CHESS_SAVE_FAILURE;
+        }
+    }
+
+    ChessResult result = CHESS_SUCCESS;
+    MAP_FOREACH(int*, current_tournament_id, chess->tournaments)
+    {
+        if (result == CHESS_SUCCESS)
+        {
+            result = checkpointWriteTournament(writer, *current_tournament_id,
+                                               mapGet(chess->tournaments, current_tournament_id), incremental);
+        }
+        free(current_tournament_id);
+    }
+    return result;
+}
+
+/**
+*	chessMarkCheckpointed: marks the chess system's tournaments and players as saved in a checkpoint.
+*
+* @param chess - The chess system.
+* @param checkpoint_id - The content ID of the checkpoint.
+*
+* @return
+* 	None
+*/
+static void chessMarkCheckpointed(ChessSystem chess, unsigned long long checkpoint_id)
+{
+    MAP_FOREACH(int*, current_tournament_id, chess->tournaments)
+    {
+        tournamentSetDirty(mapGet(chess->tournaments, current_tournament_id), false);
+        free(current_tournament_id);
+    }
+    chess->players_dirty = false;
+    chess->checkpoint_id = checkpoint_id;
+}
+
+static ChessResult chessSaveCheckpointLocked(ChessSystem chess, const char *path, const char *previous_path,
+                                             int *number_of_files)
+{
+    if (chess == NULL || path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    // Only the system's own latest checkpoint, or a compacted copy of it, matches the dirty flags
+    Checkpoint previous = NULL;
+    if (previous_path != NULL && chess->checkpoint_id != 0)
+    {
+        previous = checkpointOpen(previous_path);
+        if (checkpointGetID(previous) != chess->checkpoint_id)
+        {
+            checkpointClose(previous);
+            previous = NULL;
+        }
+    }
+
+    CheckpointWriter writer = checkpointWriterCreate(path, previous, chess->journal_sequence);
+    if (writer == NULL)
+    {
+        checkpointClose(previous);
+        return CHESS_SAVE_FAILURE;
+    }
+    ChessResult result = checkpointWriteSystem(chess, writer, previous != NULL);
+    unsigned long long checkpoint_id = checkpointWriterGetID(writer);
+    int files = checkpointWriterGetNumberOfFiles(writer);
+    if (result != CHESS_SUCCESS)
+    {
+        checkpointWriterAbort(writer);
+    }
+    else if (checkpointWriterCommit(writer) == false)
+    {
+        result = CHESS_SAVE_FAILURE;
+    }
+    checkpointClose(previous);
+    if (result != CHESS_SUCCESS)
+    {
+        return result;
+    }
+
+    chessMarkCheckpointed(chess, checkpoint_id);
+    if (number_of_files != NULL)
+    {
+        *number_of_files = files;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	checkpointLoadSegment: adds a segment read from a checkpoint to the chess system.
+*
+* @param chess - The chess system to load into.
+* @param key - The key of the segment.
+* @param segment - The segment.
+*
+* @return
+*   SNAPSHOT_INVALID_FORMAT - If the segment doesn't match its key.
+*   SNAPSHOT_OUT_OF_MEMORY - In case of memory error.
+*   SNAPSHOT_SUCCESS - Otherwise.
+*/
+static SnapshotResult checkpointLoadSegment(ChessSystem chess, int key, const Snapshot *segment)
+{
+    if (key == CHECKPOINT_PLAYERS_SEGMENT)
+    {
+        if (segment->number_of_tournaments != 0)
+        {
+            return SNAPSHOT_INVALID_FORMAT;
+        }
+        return (snapshotLoadPlayers(chess->players, segment->players, segment->number_of_players) == true) ?
+               SNAPSHOT_SUCCESS : SNAPSHOT_OUT_OF_MEMORY;
+    }
+
+    if (isValidID(key) == false || segment->number_of_tournaments != 1 ||
+        segment->tournaments[0].tournament_id != key || segment->number_of_players != 0)
+    {
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+    if (snapshotLoadTournament(chess, &segment->tournaments[0], segment->locations, segment->games,
+                               segment->tournament_players) == false)
+    {
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    tournamentSetDirty(mapGet(chess->tournaments, &key), false);
+    return SNAPSHOT_SUCCESS;
+}
+
+ChessSystem chessLoadCheckpoint(const char *path, ChessResult *chess_result)
+{
+    ChessResult dummy_result;
+    chess_result = (chess_result != NULL) ? chess_result : &dummy_result;
+    if (path == NULL)
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+
+    Checkpoint checkpoint = checkpointOpen(path);
+    if (checkpoint == NULL)
+    {
+        *chess_result = CHESS_SAVE_FAILURE;
+        return NULL;
+    }
+    ChessSystem chess = chessCreate();
+    SnapshotResult result = (chess != NULL) ? SNAPSHOT_SUCCESS : SNAPSHOT_OUT_OF_MEMORY;
+    int number_of_segments = checkpointGetNumberOfSegments(checkpoint);
+    if (result == SNAPSHOT_SUCCESS &&
+        (number_of_segments == 0 || checkpointGetSegmentKey(checkpoint, 0) != CHECKPOINT_PLAYERS_SEGMENT))
+    {
+        result = SNAPSHOT_INVALID_FORMAT;
+    }
+    for (int index = 0; index < number_of_segments && result == SNAPSHOT_SUCCESS; index++)
+    {
+        Snapshot segment;
+        result = checkpointReadSegment(checkpoint, index, &segment);
+        if (result == SNAPSHOT_SUCCESS)
+        {
+            result = checkpointLoadSegment(chess, checkpointGetSegmentKey(checkpoint, index), &segment);
+            snapshotClear(&segment);
+        }
+    }
+
+    if (result != SNAPSHOT_SUCCESS)
+    {
+        checkpointClose(checkpoint);
+        chessDestroy(chess);
+        *chess_result = (result == SNAPSHOT_OUT_OF_MEMORY) ? CHESS_OUT_OF_MEMORY : CHESS_SAVE_FAILURE;
+        return NULL;
+    }
+    chess->players_dirty = false;
+    chess->checkpoint_id = checkpointGetID(checkpoint);
+    chess->journal_sequence = checkpointGetJournalSequence(checkpoint);
+    checkpointClose(checkpoint);
+    *chess_result = CHESS_SUCCESS;
+    return chess;
+}
+
+ChessResult chessCompactCheckpoint(const char *path, const char *compacted_path)
+{
+    if (path == NULL || compacted_path == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    SnapshotResult result = checkpointCompact(path, compacted_path);
+    if (result == SNAPSHOT_OUT_OF_MEMORY)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return (result == SNAPSHOT_SUCCESS) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+ChessReadOnly chessOpenReadOnly(const char *path, ChessResult *chess_result)
+{
+    ChessResult dummy_result;
+    chess_result = (chess_result != NULL) ? chess_result : &dummy_result;
+    if (path == NULL)
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+    return readOnlyOpen(path, chess_result);
+}
+
+void chessCloseReadOnly(ChessReadOnly chess)
+{
+    readOnlyClose(chess);
+}
+
+double chessReadOnlyCalculateAveragePlayTime(ChessReadOnly chess, int player_id, ChessResult *chess_result)
+{
+    SnapshotPlayer player;
+    if (chess == NULL)
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+    }
+    else if (isValidID(player_id) == false)
+    {
+        *chess_result = CHESS_INVALID_ID;
+    }
+    else if (readOnlyFindPlayer(chess, player_id, &player) == false)
+    {
+        *chess_result = CHESS_PLAYER_NOT_EXIST;
+    }
+    else
+    {
+        *chess_result = CHESS_SUCCESS;
+    }
+    if (*chess_result != CHESS_SUCCESS)
+    {
+        return *chess_result;
+    }
+
+    double total_play_time = player.total_play_time;
+    if (total_play_time == 0)
+    {
+        return total_play_time;
+    }
+    return total_play_time / ((double) player.wins + player.loses + player.draws);
+}
+
+ChessResult chessReadOnlySavePlayersLevels(ChessReadOnly chess, FILE *file)
+{
+    if (chess == NULL || file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    ReportWriter writer = reportWriterCreate(file);
+    if (writer == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return chessFinishReport(writer, readOnlyWritePlayersLevels(chess, writer), CHESS_SAVE_FAILURE);
+}
+
+ChessResult chessReadOnlySaveTournamentStatistics(ChessReadOnly chess, char *path_file)
+{
+    if (chess == NULL || path_file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (readOnlyHasEndedTournaments(chess) == false)
+    {
+        return CHESS_NO_TOURNAMENTS_ENDED;
+    }
+
+    FILE* file_tournament_stats = fopen(path_file, "w");
+    if (!file_tournament_stats)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+    ReportWriter writer = reportWriterCreate(file_tournament_stats);
+    ChessResult result = (writer == NULL) ? CHESS_OUT_OF_MEMORY :
+                         chessFinishReport(writer, readOnlyWriteTournamentStatistics(chess, writer),
+                                           CHESS_SAVE_FAILURE);
+    if (fclose(file_tournament_stats) != 0 && result == CHESS_SUCCESS)
+    {
+        result = CHESS_SAVE_FAILURE;
+    }
+    return result;
+}
+
+/**
+*	chessBuildArchive: builds the chess system's game archive from the games of all its tournaments, reading
+*                      spilled tournaments back.
+*
+* @param chess - The chess system whose games are archived.
+*
+* @return
+* 	false - If there was a memory allocation error, or a spilled tournament couldn't be read back.
+*   true - If the archive was built.
+*/
+static bool chessBuildArchive(ChessSystem chess)
+{
+    GameArchive archive = gameArchiveCreate(chess->number_of_games);
+    bool built = (archive != NULL);
+
+    MAP_FOREACH(Tournament, current_tournament_id, chess->tournaments)
+    {
+        Map games_map = NULL;
+        if (built == true)
+        {
+            games_map = tournamentGetGamesMap(mapGet(chess->tournaments, current_tournament_id));
+            built = (games_map != NULL);
+        }
+        MAP_FOREACH(Game, current_game_id, games_map)
+        {
+            Game current_game = mapGet(games_map, current_game_id);
+            built = built && gameArchivePut(archive, *(int*) current_tournament_id, *(int*) current_game_id,
+                                            gameGetFirstPlayer(current_game), gameGetSecondPlayer(current_game),
+                                            gameGetWinner(current_game), gameGetPlayTime(current_game));
+            free(current_game_id);
+        }
+        free(current_tournament_id);
+    }
+
+    if (built == false)
+    {
+        gameArchiveDestroy(archive);
+        return false;
+    }
+    chess->archive = archive;
+    return true;
+}
+
+/**
+*	chessScanGamesErrorCheck: checks errors for chessScanGames function and returns relevant error value.
+*
+* @param chess - See chessSystemExtensions.h
+* @param filter - See chessSystemExtensions.h
+* @param number_of_groups - See chessSystemExtensions.h
+*
+* @return
+*   See chessSystemExtensions.h
+*/
+static ChessResult chessScanGamesErrorCheck(ChessSystem chess, const ChessGameFilter *filter, int *number_of_groups)
+{
+    if (chess == NULL || number_of_groups == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (filter != NULL && (filter->tournament_id < 0 || filter->player_id < 0))
+    {
+        return CHESS_INVALID_ID;
+    }
+
+    if (filter != NULL && (filter->min_play_time < 0 || filter->max_play_time < 0))
+    {
+        return CHESS_INVALID_PLAY_TIME;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+*	chessArchiveFilter: converts the filter of a scan to the filter of the game archive.
+*
+* @param filter - The filter of the scan, NULL for all the games.
+*
+* @return
+* 	The filter of the game archive.
+*/
+static GameArchiveFilter chessArchiveFilter(const ChessGameFilter *filter)
+{
+    GameArchiveFilter archive_filter = {GAME_ARCHIVE_ANY_ID, GAME_ARCHIVE_ANY_ID, GAME_ARCHIVE_ANY_WINNER, 0, INT_MAX};
+    if (filter != NULL)
+    {
+        archive_filter.tournament_id = filter->tournament_id;
+        archive_filter.player_id = filter->player_id;
+        archive_filter.winner = (filter->match_winner == true) ? (int) filter->winner : GAME_ARCHIVE_ANY_WINNER;
+        archive_filter.min_play_time = filter->min_play_time;
+        archive_filter.max_play_time = (filter->max_play_time == 0) ? INT_MAX : filter->max_play_time;
+    }
+    return archive_filter;
+}
+
+/**
+*	chessArchiveGrouping: converts the grouping of a scan to the grouping of the game archive.
+*
+* @param grouping - The grouping of the scan.
+*
+* @return
+* 	The grouping of the game archive. Unknown groupings are handled as no grouping.
+*/
+static GameArchiveGrouping chessArchiveGrouping(ChessGameGrouping grouping)
+{
+    switch (grouping)
+    {
+        case CHESS_GROUP_BY_PLAYER:
+            return GAME_ARCHIVE_GROUP_BY_PLAYER;
+        case CHESS_GROUP_BY_TOURNAMENT:
+            return GAME_ARCHIVE_GROUP_BY_TOURNAMENT;
+        default:
+            return GAME_ARCHIVE_GROUP_NONE;
+    }
+}
+
+static ChessGameAggregate *chessScanGamesLocked(ChessSystem chess, const ChessGameFilter *filter,
+                                                ChessGameGrouping grouping, int *number_of_groups,
+                                                ChessResult *chess_result)
+{
+    if (chess_result == NULL)
+    {
+        return NULL;
+    }
+    *chess_result = chessScanGamesErrorCheck(chess, filter, number_of_groups);
+    if (*chess_result != CHESS_SUCCESS)
+    {
+        return NULL;
+    }
+
+    *chess_result = CHESS_OUT_OF_MEMORY;
+    if (chess->archive == NULL && chessBuildArchive(chess) == false)
+    {
+        return NULL;
+    }
+    GameArchiveFilter archive_filter = chessArchiveFilter(filter);
+    int count = 0;
+    GameArchiveAggregate *groups = gameArchiveScan(chess->archive, &archive_filter, chessArchiveGrouping(grouping),
+                                                   &count);
+    if (groups == NULL)
+    {
+        return NULL;
+    }
+    ChessGameAggregate *results = malloc(sizeof(*results) * (count > 0 ? count : 1));
+    if (results == NULL)
+    {
+        free(groups);
+        return NULL;
+    }
+
+    for (int index = 0; index < count; index++)
+    {
+        results[index].key = groups[index].key;
+        results[index].location = (grouping == CHESS_GROUP_BY_TOURNAMENT) ?
+                                  tournamentGetLocation(mapGet(chess->tournaments, &groups[index].key)) : NULL;
+        results[index].games = groups[index].games;
+        results[index].draws = groups[index].draws;
+        results[index].total_play_time = groups[index].total_play_time;
+        results[index].longest_play_time = groups[index].longest_play_time;
+    }
+    free(groups);
+    *number_of_groups = count;
+    *chess_result = CHESS_SUCCESS;
+    return results;
+}
+
+static ChessResult chessEnableChangeFeedLocked(ChessSystem chess, int capacity, int batch_size)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (chess->feed != NULL)
+    {
+        changeFeedSetBatchSize(chess->feed, batch_size);
+        return CHESS_SUCCESS;
+    }
+    chess->feed = changeFeedCreate(capacity, batch_size);
+    return (chess->feed != NULL) ? CHESS_SUCCESS : CHESS_OUT_OF_MEMORY;
+}
+
+static ChessResult chessSubscribeChangesLocked(ChessSystem chess, ChessChangeCallback callback, void *context)
+{
+    if (chess == NULL || callback == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (chess->feed == NULL &&
+        chessEnableChangeFeedLocked(chess, CHANGE_FEED_DEFAULT_CAPACITY,
+                                    CHANGE_FEED_DEFAULT_BATCH_SIZE) != CHESS_SUCCESS)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return (changeFeedSubscribe(chess->feed, callback, context) == true) ? CHESS_SUCCESS : CHESS_OUT_OF_MEMORY;
+}
+
+static ChessResult chessUnsubscribeChangesLocked(ChessSystem chess, ChessChangeCallback callback, void *context)
+{
+    if (chess == NULL || callback == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    changeFeedUnsubscribe(chess->feed, callback, context);
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessFlushChangesLocked(ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    // The events are handed over once the system is unlocked
+    changeFeedRequestFlush(chess->feed);
+    return CHESS_SUCCESS;
+}
+
+static ChessResult chessReadChangesLocked(ChessSystem chess, long long since_sequence, ChessChangeEvent *events,
+                                          int max_events, int *number_of_events)
+{
+    if (chess == NULL || number_of_events == NULL || (events == NULL && max_events > 0))
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    *number_of_events = changeFeedRead(chess->feed, since_sequence, events, max_events);
+    return CHESS_SUCCESS;
+}
+
+/**
+*	chessApplySubmissions: adds a batch of submitted games to the chess system, holding it shared once for the
+*                          whole batch, and hands each ticket its result. Used as the apply function of the
+*                          chess system's submission queues.
+*
+* @param records - The submitted games.
+* @param number_of_records - The number of games.
+* @param context - The chess system.
+*
+* @return
+* 	None
+*/
+static void chessApplySubmissions(const SubmissionRecord *records, int number_of_records, void *context)
+{
+    ChessSystem chess = context;
+    chessLockShared(chess);
+    for (int index = 0; index < number_of_records; index++)
+    {
+        const SubmissionRecord *record = &records[index];
+        ChessResult result = chessAddGameLocked(chess, record->tournament_id, record->first_player,
+                                                record->second_player, record->winner, record->play_time);
+        submissionTicketComplete(record->ticket, result);
+    }
+    chessUnlock(chess);
+}
+
+ChessSubmissionQueue chessOpenSubmissionQueue(ChessSystem chess, int capacity, int batch_size,
+                                              ChessResult *chess_result)
+{
+    ChessResult ignored_result;
+    chess_result = (chess_result == NULL) ? &ignored_result : chess_result;
+    if (chess == NULL)
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+
+    ChessSubmissionQueue queue = submissionQueueCreate(capacity, batch_size, chessApplySubmissions, chess);
+    *chess_result = (queue == NULL) ? CHESS_OUT_OF_MEMORY : CHESS_SUCCESS;
+    return queue;
+}
+
+bool chessSubmitGame(ChessSubmissionQueue queue, int tournament_id, int first_player, int second_player,
+                     Winner winner, int play_time, ChessSubmissionTicket *ticket)
+{
+    if (queue == NULL)
+    {
+        return false;
+    }
+
+    SubmissionRecord record = {tournament_id, first_player, second_player, winner, play_time, ticket};
+    return submissionQueuePush(queue, &record);
+}
+
+bool chessIsSubmissionDone(const ChessSubmissionTicket *ticket, ChessResult *result)
+{
+    return ticket != NULL && submissionTicketIsComplete(ticket, result) == true;
+}
+
+ChessResult chessWaitSubmission(const ChessSubmissionTicket *ticket)
+{
+    if (ticket == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    return submissionQueueWait(ticket);
+}
+
+void chessCloseSubmissionQueue(ChessSubmissionQueue queue)
+{
+    submissionQueueClose(queue);
+}
+
+/*
+* The public functions below lock the chess system around the functions which implement them, named with the
+* Locked suffix - chessAddGame for sharing, so games of different tournaments are added at once, and every
+* other function exclusively, since even looking up a map moves its iterator. In the single threaded build the
+* locks are empty.
+*/
+
+ChessResult chessSetMemoryBudget(ChessSystem chess, size_t memory_budget)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSetMemoryBudgetLocked(chess, memory_budget);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessGetMemoryUsage(ChessSystem chess, size_t *memory_used, size_t *memory_budget)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessGetMemoryUsageLocked(chess, memory_used, memory_budget);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessEnableSpill(ChessSystem chess, const char *path, int cache_capacity)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessEnableSpillLocked(chess, path, cache_capacity);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessAddTournament(ChessSystem chess, int tournament_id, int max_games_per_player,
+                               const char *tournament_location)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessAddTournamentLocked(chess, tournament_id, max_games_per_player, tournament_location);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player, int second_player, Winner winner,
+                         int play_time)
+{
+    chessLockShared(chess);
+    ChessResult result = chessAddGameLocked(chess, tournament_id, first_player, second_player, winner, play_time);
+    chessUnlock(chess);
+    return result;
+}
+
+ChessResult chessImportGames(ChessSystem chess, const char *path, ChessImportStats *stats)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessImportGamesLocked(chess, path, stats);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessRemoveTournament(ChessSystem chess, int tournament_id)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessRemoveTournamentLocked(chess, tournament_id);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessRemovePlayer(ChessSystem chess, int player_id)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessRemovePlayerLocked(chess, player_id);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessRemovePlayers(ChessSystem chess, const int *player_ids, int number_of_players)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessRemovePlayersLocked(chess, player_ids, number_of_players);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessRemoveTournaments(ChessSystem chess, const int *tournament_ids, int number_of_tournaments)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessRemoveTournamentsLocked(chess, tournament_ids, number_of_tournaments);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessUpdateGameResult(ChessSystem chess, int tournament_id, int game_id, Winner new_winner,
+                                  int new_play_time)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessUpdateGameResultLocked(chess, tournament_id, game_id, new_winner, new_play_time);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessRemoveGame(ChessSystem chess, int tournament_id, int game_id)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessRemoveGameLocked(chess, tournament_id, game_id);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessMergePlayers(ChessSystem chess, int keep_id, int drop_id, ChessMergeConflict *conflicts,
+                              int max_conflicts, int *number_of_conflicts)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessMergePlayersLocked(chess, keep_id, drop_id, conflicts,
+                                                 max_conflicts, number_of_conflicts);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessEndTournament(ChessSystem chess, int tournament_id)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessEndTournamentLocked(chess, tournament_id);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessEndTournaments(ChessSystem chess, const int *tournament_ids, int number_of_tournaments,
+                                ChessResult *results, int number_of_threads)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessEndTournamentsLocked(chess, tournament_ids, number_of_tournaments, results,
+                                                   number_of_threads);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+double chessCalculateAveragePlayTime(ChessSystem chess, int player_id, ChessResult *chess_result)
+{
+    PlayerDirectoryStats stats;
+    *chess_result = chessReadPlayerStats(chess, player_id, &stats);
+    if (*chess_result != CHESS_SUCCESS)
+    {
+        return *chess_result;
+    }
+
+    double total_play_time = stats.total_play_time;
+    if (total_play_time == 0)
+    {
+        return total_play_time;
+    }
+    return total_play_time / ((double) stats.wins + stats.loses + stats.draws);
+}
+
+ChessResult chessGetPlayerStats(ChessSystem chess, int player_id, ChessPlayerStats *stats)
+{
+    if (stats == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    PlayerDirectoryStats player_stats;
+    ChessResult result = chessReadPlayerStats(chess, player_id, &player_stats);
+    if (result == CHESS_SUCCESS)
+    {
+        stats->wins = player_stats.wins;
+        stats->losses = player_stats.loses;
+        stats->draws = player_stats.draws;
+        stats->total_play_time = player_stats.total_play_time;
+        stats->level = playerCalculateLevel(player_stats.wins, player_stats.loses, player_stats.draws);
+    }
+    return result;
+}
+
+ChessResult chessSavePlayersLevels(ChessSystem chess, FILE *file)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSavePlayersLevelsLocked(chess, file);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSavePlayersLevelsEx(ChessSystem chess, FILE *file, ChessLevelsFormat format)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSavePlayersLevelsExLocked(chess, file, format);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSavePlayersLevelsCompressed(ChessSystem chess, FILE *file, ChessLevelsFormat format)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSavePlayersLevelsCompressedLocked(chess, file, format);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSavePlayersLevelsToBuffer(ChessSystem chess, ChessReportBuffer *buffer)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSavePlayersLevelsToBufferLocked(chess, buffer);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSavePlayersLevelsToFd(ChessSystem chess, int fd)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSavePlayersLevelsToFdLocked(chess, fd);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSavePlayersLevelsDelta(ChessSystem chess, FILE *file, long long since_token, long long *new_token)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSavePlayersLevelsDeltaLocked(chess, file, since_token, new_token);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSaveTournamentStatistics(ChessSystem chess, char *path_file)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSaveTournamentStatisticsLocked(chess, path_file);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSaveTournamentStatisticsToBuffer(ChessSystem chess, ChessReportBuffer *buffer)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSaveTournamentStatisticsToBufferLocked(chess, buffer);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSaveTournamentStatisticsToFd(ChessSystem chess, int fd)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSaveTournamentStatisticsToFdLocked(chess, fd);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessExportSession chessExportBegin(ChessSystem chess, FILE *levels_file, FILE *statistics_file,
+                                    ChessResult *chess_result)
+{
+    chessLockExclusive(chess);
+    ChessExportSession result = chessExportBeginLocked(chess, levels_file, statistics_file, chess_result);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessImportGamesParallel(ChessSystem chess, const char *path, ChessImportStats *stats,
+                                     int number_of_threads)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessImportGamesParallelLocked(chess, path, stats, number_of_threads);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSaveSnapshot(ChessSystem chess, const char *path)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSaveSnapshotLocked(chess, path);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSaveSnapshotCompressed(ChessSystem chess, const char *path)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSaveSnapshotCompressedLocked(chess, path);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessAttachJournal(ChessSystem chess, const char *path, ChessJournalSync sync, int group_commit_ms)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessAttachJournalLocked(chess, path, sync, group_commit_ms);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessDetachJournal(ChessSystem chess)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessDetachJournalLocked(chess);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSyncJournal(ChessSystem chess)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSyncJournalLocked(chess);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessReplayJournal(ChessSystem chess, const char *path, int *records_applied)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessReplayJournalLocked(chess, path, records_applied);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSaveCheckpoint(ChessSystem chess, const char *path, const char *previous_path, int *number_of_files)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSaveCheckpointLocked(chess, path, previous_path, number_of_files);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessGameAggregate *chessScanGames(ChessSystem chess, const ChessGameFilter *filter, ChessGameGrouping grouping,
+                                   int *number_of_groups, ChessResult *chess_result)
+{
+    chessLockExclusive(chess);
+    ChessGameAggregate *result = chessScanGamesLocked(chess, filter, grouping, number_of_groups, chess_result);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessEnableChangeFeed(ChessSystem chess, int capacity, int batch_size)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessEnableChangeFeedLocked(chess, capacity, batch_size);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessSubscribeChanges(ChessSystem chess, ChessChangeCallback callback, void *context)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessSubscribeChangesLocked(chess, callback, context);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessUnsubscribeChanges(ChessSystem chess, ChessChangeCallback callback, void *context)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessUnsubscribeChangesLocked(chess, callback, context);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessFlushChanges(ChessSystem chess)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessFlushChangesLocked(chess);
+    chessUnlockExclusive(chess);
+    return result;
+}
+
+ChessResult chessReadChanges(ChessSystem chess, long long since_sequence, ChessChangeEvent *events, int max_events,
+                             int *number_of_events)
+{
+    chessLockExclusive(chess);
+    ChessResult result = chessReadChangesLocked(chess, since_sequence, events, max_events, number_of_events);
+    chessUnlockExclusive(chess);
+    return result;
+}
@@ -0,0 +1,1178 @@
+#ifndef CHESS_SYSTEM_EXTENSIONS_H_
+#define CHESS_SYSTEM_EXTENSIONS_H_
+
+#include "chessSystem.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Extensions to the chess system interface declared in chessSystem.h.
+ *
+ * The following functions are available:
+ *   chessCreateWithConfig   - Creates a chess system pre-sized for the expected amount of data.
+ *   chessRemovePlayers      - Removes a list of players in a single pass.
+ *   chessRemoveTournaments  - Removes a list of tournaments in a single pass.
+ *   chessEndTournaments     - Ends a list of tournaments, deciding their winners on several threads.
+ *   chessUpdateGameResult   - Corrects the result and play time of an existing game.
+ *   chessRemoveGame         - Removes a single game from a tournament.
+ *   chessMergePlayers       - Folds one player's games and statistics into another player.
+ *   chessSetMemoryBudget    - Caps the memory the chess system may use.
+ *   chessGetMemoryUsage     - Reports the memory used by the chess system and its budget.
+ *   chessEnableSpill        - Moves the games and players of ended tournaments to a spill file.
+ *   chessImportGames        - Adds the games of a text game log to the chess system.
+ *   chessImportGamesParallel - Adds the games of a text game log using several threads.
+ *   chessSaveSnapshot       - Saves the whole chess system to a binary snapshot file.
+ *   chessSaveSnapshotCompressed - Saves the whole chess system to a compressed snapshot file.
+ *   chessLoadSnapshot       - Creates a chess system from a binary snapshot file.
+ *   chessAttachJournal      - Starts recording the chess system's mutations in a journal file.
+ *   chessDetachJournal      - Stops recording mutations, and closes the journal.
+ *   chessSyncJournal        - Syncs the recorded mutations to the disk.
+ *   chessReplayJournal      - Applies the mutations recorded in a journal file to the chess system.
+ *   chessRecover            - Rebuilds a chess system from a snapshot and the journal written after it.
+ *   chessSaveCheckpoint     - Saves the tournaments and players that changed since the previous checkpoint.
+ *   chessLoadCheckpoint     - Creates a chess system from a checkpoint.
+ *   chessCompactCheckpoint  - Copies a checkpoint and the earlier checkpoints it links to into a single file.
+ *   chessSavePlayersLevelsEx - Saves the players' levels report as text, binary records or JSON lines.
+ *   chessSavePlayersLevelsCompressed - Saves the players' levels report in a given format, compressed.
+ *   chessSavePlayersLevelsDelta - Saves the levels of the players that changed or were removed since a token.
+ *   chessSavePlayersLevelsToBuffer - Appends the players' levels report to a memory buffer.
+ *   chessSavePlayersLevelsToFd - Writes the players' levels report to a file descriptor.
+ *   chessSaveTournamentStatisticsToBuffer - Appends the tournament statistics report to a memory buffer.
+ *   chessSaveTournamentStatisticsToFd - Writes the tournament statistics report to a file descriptor.
+ *   chessExportBegin        - Starts an export of the levels and statistics reports, written in chunks.
+ *   chessExportStep         - Writes the next chunk of an export.
+ *   chessExportEnd          - Ends an export, and deallocates it.
+ *   chessDecompressFile     - Decompresses a compressed snapshot or report into a plain file.
+ *   chessOpenReadOnly       - Opens a snapshot file for queries, read in place from memory-mapped pages.
+ *   chessCloseReadOnly      - Closes a read only chess system.
+ *   chessReadOnlyCalculateAveragePlayTime - Calculates a player's average game time in a read only chess system.
+ *   chessReadOnlySavePlayersLevels - Saves the players' levels report of a read only chess system.
+ *   chessReadOnlySaveTournamentStatistics - Saves the tournament statistics report of a read only chess system.
+ *   chessScanGames          - Sums, counts and takes the maximum over the games matching a filter, optionally grouped.
+ *   chessEnableChangeFeed   - Starts recording the chess system's changes as numbered events.
+ *   chessSubscribeChanges   - Adds a callback which is handed the new change events in batches.
+ *   chessUnsubscribeChanges - Removes a change events callback.
+ *   chessFlushChanges       - Hands the waiting change events to the callbacks.
+ *   chessReadChanges        - Reads the change events which follow a sequence number.
+ *   chessGetPlayerStats     - Reads a player's wins, losses, draws, play time and level.
+ *   chessOpenSubmissionQueue - Starts a thread which adds the games other threads submit to the chess system.
+ *   chessSubmitGame         - Submits a game to a submission queue, without waiting.
+ *   chessIsSubmissionDone   - Checks if a submitted game was added, and gets its result.
+ *   chessWaitSubmission     - Waits for a submitted game to be added, and gets its result.
+ *   chessCloseSubmissionQueue - Adds the games still waiting in a submission queue, and closes it.
+ *
+ * Compiled with CHESS_THREAD_SAFE defined, the functions of a chess system may be called from several threads
+ * at once. Calls to chessAddGame for different tournaments run in parallel, chessCalculateAveragePlayTime and
+ * chessGetPlayerStats read the statistics chessAddGame publishes without waiting for it, and every other function
+ * holds the whole system while it runs. chessDestroy must not be called while other calls are running, and change
+ * callbacks run while the system is held, so they must not call its functions.
+ */
+
+/** Type for a chess system which answers queries straight from a memory-mapped snapshot file */
+typedef struct chess_read_only_t *ChessReadOnly;
+
+/** Type for an export of the chess system's reports, which is written in chunks */
+typedef struct chess_export_session_t *ChessExportSession;
+
+/** Type for the capacity hints and tuning parameters of a new chess system */
+typedef struct chess_config_t {
+    int expected_players;
+    int expected_tournaments;
+    int expected_games_per_tournament;
+    int initial_arena_size;
+    size_t memory_budget;
+} ChessConfig;
+
+/** Type for describing a game that prevents two players from being merged */
+typedef struct chess_merge_conflict_t {
+    int tournament_id;
+    int opponent_id;
+} ChessMergeConflict;
+
+/** Type for describing a line of a game log that couldn't be imported */
+typedef struct chess_import_error_t {
+    int line;
+    ChessResult result;
+} ChessImportError;
+
+/** Type for the parameters and results of a game log import */
+typedef struct chess_import_stats_t {
+    ChessImportError *errors;
+    int max_errors;
+    int lines_read;
+    int games_added;
+    int number_of_errors;
+} ChessImportStats;
+
+/** Type for how often a journal is synced to the disk */
+typedef enum chess_journal_sync_t {
+    CHESS_JOURNAL_SYNC_EVERY_OPERATION,
+    CHESS_JOURNAL_SYNC_GROUP,
+    CHESS_JOURNAL_SYNC_NONE
+} ChessJournalSync;
+
+/**
+ * Type for a growable memory buffer which reports are appended to. data is allocated with malloc - it may
+ * start as NULL, with a length and capacity of 0 - and is grown with realloc, so it is always the caller's to
+ * free. The text is not null terminated, and a buffer may be reused for many reports by resetting its length.
+ */
+typedef struct chess_report_buffer_t {
+    char *data;
+    size_t length;
+    size_t capacity;
+} ChessReportBuffer;
+
+/** Type for the formats of the players' levels report */
+typedef enum chess_levels_format_t {
+    CHESS_LEVELS_TEXT,
+    CHESS_LEVELS_BINARY,
+    CHESS_LEVELS_JSON_LINES
+} ChessLevelsFormat;
+
+#define CHESS_LEVELS_BINARY_MAGIC "CHLV"
+#define CHESS_LEVELS_BINARY_MAGIC_SIZE 4
+#define CHESS_LEVELS_BINARY_VERSION 1
+/** Binary levels are stored in hundredths, rounded as the text report rounds them */
+#define CHESS_LEVELS_BINARY_SCALE 100
+
+/**
+ * Type for the header of a binary levels report, which is followed by number_of_records ChessLevelRecord.
+ * All fields are little-endian, so on little-endian hosts a mapped file may be read through these types.
+ */
+typedef struct chess_levels_header_t {
+    char magic[CHESS_LEVELS_BINARY_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t number_of_records;
+} ChessLevelsHeader;
+
+/** Type for the level of a single player in a binary levels report */
+typedef struct chess_level_record_t {
+    int32_t player_id;
+    int32_t level;
+} ChessLevelRecord;
+
+/**
+ * Type for selecting the games of a scan. tournament_id and player_id of 0 match any tournament and any player,
+ * and winner is only matched if match_winner is true. Play times are matched inclusively, and a max_play_time
+ * of 0 means no upper bound.
+ */
+typedef struct chess_game_filter_t {
+    int tournament_id;
+    int player_id;
+    bool match_winner;
+    Winner winner;
+    int min_play_time;
+    int max_play_time;
+} ChessGameFilter;
+
+/** Type for the grouping of the games of a scan */
+typedef enum chess_game_grouping_t {
+    CHESS_GROUP_NONE,
+    CHESS_GROUP_BY_PLAYER,
+    CHESS_GROUP_BY_TOURNAMENT
+} ChessGameGrouping;
+
+/**
+ * Type for the aggregates of a group of scanned games. key is the ID of the group's player or tournament, and
+ * location is the location of the group's tournament - NULL unless grouped by tournament.
+ */
+typedef struct chess_game_aggregate_t {
+    int key;
+    const char *location;
+    int games;
+    int draws;
+    long long total_play_time;
+    int longest_play_time;
+} ChessGameAggregate;
+
+/** Type for the kinds of changes to the chess system */
+typedef enum chess_change_type_t {
+    CHESS_CHANGE_TOURNAMENT_ADDED,
+    CHESS_CHANGE_GAME_ADDED,
+    CHESS_CHANGE_GAME_CHANGED,
+    CHESS_CHANGE_GAME_REMOVED,
+    CHESS_CHANGE_TOURNAMENT_ENDED,
+    CHESS_CHANGE_TOURNAMENT_REMOVED,
+    CHESS_CHANGE_PLAYER_REMOVED,
+    CHESS_CHANGE_PLAYERS_MERGED
+} ChessChangeType;
+
+/** Type for the statistics of a player, as counted for the players' levels report */
+typedef struct chess_player_stats_t {
+    int wins;
+    int losses;
+    int draws;
+    int total_play_time;
+    double level;
+} ChessPlayerStats;
+
+/**
+ * Type for a change to the chess system. Fields a type doesn't use are 0.
+ *   CHESS_CHANGE_TOURNAMENT_ADDED - tournament_id.
+ *   CHESS_CHANGE_GAME_ADDED / CHESS_CHANGE_GAME_CHANGED - all the fields of the game, as it is after the change.
+ *       A player removed while the tournament was running has a negative ID, and the opponent is the winner.
+ *   CHESS_CHANGE_GAME_REMOVED - tournament_id and game_id.
+ *   CHESS_CHANGE_TOURNAMENT_ENDED - tournament_id, and the ID of the tournament's winner in winner.
+ *   CHESS_CHANGE_TOURNAMENT_REMOVED - tournament_id. Its games are removed with it, without events of their own.
+ *   CHESS_CHANGE_PLAYER_REMOVED - the removed player in first_player. Follows the events of the games rewritten
+ *       by the removal.
+ *   CHESS_CHANGE_PLAYERS_MERGED - the kept player in first_player and the dropped player in second_player.
+ *       Follows the events of the games rewritten by the merge.
+ */
+typedef struct chess_change_event_t {
+    long long sequence;
+    ChessChangeType type;
+    int tournament_id;
+    int game_id;
+    int first_player;
+    int second_player;
+    int winner;
+    int play_time;
+} ChessChangeEvent;
+
+/**
+ * Type for a callback which is handed batches of change events, oldest first. Callbacks run after the change which
+ * completed the batch released the chess system's locks, on the thread which made it, so they may call any chess
+ * function - events of changes they make are handed over after they return. context is the pointer the callback
+ * was subscribed with.
+ */
+typedef void (*ChessChangeCallback)(const ChessChangeEvent *events, int number_of_events, void *context);
+
+/** Type for a queue of games submitted by many threads, which a thread of its own adds to a chess system */
+typedef struct chess_submission_queue_t *ChessSubmissionQueue;
+
+/**
+ * Type for following a submitted game until it is added. The fields are set by the queue, and are read through
+ * chessIsSubmissionDone and chessWaitSubmission.
+ */
+typedef struct chess_submission_ticket_t {
+    int done;
+    ChessResult result;
+} ChessSubmissionTicket;
+
+/**
+ * chessCreateWithConfig: creates a new empty chess system, pre-sized for the expected amount of data,
+ *                        so the first hours of ingest don't pay for growing the internal pools.
+ *                        The hints only affect performance - the system grows past them as needed.
+ *
+ * @param config - the capacity hints. Fields that are not positive are ignored. May be NULL, which is
+ *                 the same as calling chessCreate.
+ *                 expected_players - the number of players expected in the whole system.
+ *                 expected_tournaments - the number of tournaments expected in the whole system.
+ *                 expected_games_per_tournament - the number of games expected in each tournament.
+ *                 initial_arena_size - the least memory in bytes reserved up front for games, and the least
+ *                                      reserved for players.
+ *                 memory_budget - the memory budget of the system, see chessSetMemoryBudget. 0 means unlimited.
+ *
+ * @return
+ *     NULL - if an allocation failed.
+ *     a new chess system in case of success.
+ */
+ChessSystem chessCreateWithConfig(const ChessConfig *config);
+
+/**
+ * chessRemovePlayers: removes the given players from the chess system, in a single pass over
+ *                     the system's tournaments and games. The resulting state is identical to
+ *                     calling chessRemovePlayer once for each ID, in the given order.
+ *                     IDs for which that call would fail are skipped.
+ *
+ * @param chess - chess system that contains the players.
+ * @param player_ids - array of the IDs of the players to remove.
+ * @param number_of_players - the number of IDs in the array.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL, or player_ids is NULL while number_of_players is positive.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed. Nothing is removed in that case.
+ *     CHESS_INVALID_ID / CHESS_PLAYER_NOT_EXIST - the error of the first skipped ID, if any.
+ *     CHESS_SUCCESS - if all the players were removed successfully.
+ */
+ChessResult chessRemovePlayers(ChessSystem chess, const int *player_ids, int number_of_players);
+
+/**
+ * chessRemoveTournaments: removes the given tournaments from the chess system, in a single pass over
+ *                         the system's tournaments. The resulting state is identical to calling
+ *                         chessRemoveTournament once for each ID, in the given order.
+ *                         IDs for which that call would fail are skipped.
+ *
+ * @param chess - chess system that contains the tournaments.
+ * @param tournament_ids - array of the IDs of the tournaments to remove.
+ * @param number_of_tournaments - the number of IDs in the array.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL, or tournament_ids is NULL while number_of_tournaments is positive.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed. Nothing is removed in that case.
+ *     CHESS_INVALID_ID / CHESS_TOURNAMENT_NOT_EXIST - the error of the first skipped ID, if any.
+ *     CHESS_SUCCESS - if all the tournaments were removed successfully.
+ */
+ChessResult chessRemoveTournaments(ChessSystem chess, const int *tournament_ids, int number_of_tournaments);
+
+/**
+ * chessEndTournaments: ends the given tournaments, deciding the winners of different tournaments on several
+ *                      threads at once. The resulting state and the result of each ID are identical to calling
+ *                      chessEndTournament once for each ID, in the given order - so a repeated ID ends once,
+ *                      and its later occurrences are CHESS_TOURNAMENT_ENDED. Spilling the ended tournaments and
+ *                      recording them in the change feed and the journal still run in the given order.
+ *
+ * @param chess - chess system that contains the tournaments.
+ * @param tournament_ids - array of the IDs of the tournaments to end.
+ * @param number_of_tournaments - the number of IDs in the array.
+ * @param results - output array, of number_of_tournaments results, for the result of each ID. See
+ *                  chessEndTournament.
+ * @param number_of_threads - the number of threads to use. 1 or less ends the tournaments on the calling
+ *                            thread only.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL, or tournament_ids or results are NULL while number_of_tournaments
+ *                           is positive.
+ *     CHESS_SUCCESS - otherwise, whatever the results of the IDs.
+ */
+ChessResult chessEndTournaments(ChessSystem chess, const int *tournament_ids, int number_of_tournaments,
+                                ChessResult *results, int number_of_threads);
+
+/**
+ * chessUpdateGameResult: corrects the result and play time of an existing game, adjusting the
+ *                        tournament's and the players' statistics accordingly.
+ *                        Games in a tournament are identified by consecutive IDs starting from 1,
+ *                        in the order they were added. IDs of removed games are not reused.
+ *                        The result of a game in which a player was removed (technical win) can't be
+ *                        changed, but its play time can.
+ *
+ * @param chess - chess system that contains the tournament.
+ * @param tournament_id - the tournament ID. Must be positive, and unique.
+ * @param game_id - the ID of the game in the tournament. Must be positive.
+ * @param new_winner - the corrected result of the game.
+ * @param new_play_time - the corrected duration of the game in seconds. Must be non-negative.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_INVALID_ID - if the tournament ID or game ID is not positive, or the game doesn't exist.
+ *     CHESS_TOURNAMENT_NOT_EXIST - if the tournament does not exist in the system.
+ *     CHESS_TOURNAMENT_ENDED - if the tournament already ended.
+ *     CHESS_INVALID_PLAY_TIME - if the play time is negative.
+ *     CHESS_PLAYER_NOT_EXIST - if the result of a game with a removed player was changed.
+ *     CHESS_SUCCESS - if the game was updated successfully.
+ */
+ChessResult chessUpdateGameResult(ChessSystem chess, int tournament_id, int game_id,
+                                  Winner new_winner, int new_play_time);
+
+/**
+ * chessRemoveGame: removes a single game from a tournament, as if it never happened.
+ *                  The game's players stay in the tournament.
+ *
+ * @param chess - chess system that contains the tournament.
+ * @param tournament_id - the tournament ID. Must be positive, and unique.
+ * @param game_id - the ID of the game in the tournament. Must be positive.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_INVALID_ID - if the tournament ID or game ID is not positive, or the game doesn't exist.
+ *     CHESS_TOURNAMENT_NOT_EXIST - if the tournament does not exist in the system.
+ *     CHESS_TOURNAMENT_ENDED - if the tournament already ended.
+ *     CHESS_SUCCESS - if the game was removed successfully.
+ */
+ChessResult chessRemoveGame(ChessSystem chess, int tournament_id, int game_id);
+
+/**
+ * chessMergePlayers: merges two player IDs that belong to the same person. All the games of the dropped
+ *                    player are relabeled to the kept player, and the dropped player's statistics, in the
+ *                    system and in each tournament, are added to the kept player's. Tournaments won by the
+ *                    dropped player are credited to the kept player. The dropped player no longer exists
+ *                    after the merge.
+ *                    The cost is proportional to the number of games of the two players.
+ *                    Players who played each other, or played the same opponent in the same tournament,
+ *                    can't be merged - in that case nothing is changed and the conflicting games are reported.
+ *                    Players whose games in a tournament add up to more than the tournament's maximum games
+ *                    per player can't be merged either.
+ *
+ * @param chess - chess system that contains the players.
+ * @param keep_id - the ID of the player who remains after the merge.
+ * @param drop_id - the ID of the player who is merged into the kept player.
+ * @param conflicts - array to fill with the conflicting games, as the tournament and the dropped player's
+ *                    opponent (the kept player, if they played each other). May be NULL if max_conflicts is 0.
+ * @param max_conflicts - the size of the conflicts array. Conflicts beyond it are counted but not filled.
+ * @param number_of_conflicts - output for the total number of conflicts found. May be NULL.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL, or conflicts is NULL while max_conflicts is positive.
+ *     CHESS_INVALID_ID - if either ID is not positive, or both IDs are the same.
+ *     CHESS_PLAYER_NOT_EXIST - if either player does not exist in the system.
+ *     CHESS_GAME_ALREADY_EXISTS - if there are conflicting games.
+ *     CHESS_EXCEEDED_GAMES - if the merged player would play more games than allowed in a tournament.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed. Nothing is changed in that case.
+ *     CHESS_SUCCESS - if the players were merged successfully.
+ */
+ChessResult chessMergePlayers(ChessSystem chess, int keep_id, int drop_id, ChessMergeConflict *conflicts,
+                              int max_conflicts, int *number_of_conflicts);
+
+/**
+ * chessSetMemoryBudget: caps the memory the chess system may use. Once the budget is reached, chessAddTournament
+ *                       and chessAddGame fail with CHESS_OUT_OF_MEMORY and leave the system unchanged, so the
+ *                       caller can remove data, raise the budget, or retry later. Memory is estimated from
+ *                       the amount of tournaments, games and players in the system.
+ *                       Lowering the budget below the current usage doesn't remove any data.
+ *                       Without a budget, CHESS_OUT_OF_MEMORY is returned only if an allocation failed - in
+ *                       both cases the chess system remains valid and is not destroyed.
+ *
+ * @param chess - chess system to set the budget of.
+ * @param memory_budget - the budget in bytes. 0 means unlimited.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SUCCESS - if the budget was set successfully.
+ */
+ChessResult chessSetMemoryBudget(ChessSystem chess, size_t memory_budget);
+
+/**
+ * chessGetMemoryUsage: reports the estimated memory used by the chess system, and its budget.
+ *
+ * @param chess - chess system to report the memory of.
+ * @param memory_used - output for the estimated memory used by the system, in bytes.
+ * @param memory_budget - output for the memory budget of the system, 0 if unlimited. May be NULL.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or memory_used are NULL.
+ *     CHESS_SUCCESS - if the memory usage was reported successfully.
+ */
+ChessResult chessGetMemoryUsage(ChessSystem chess, size_t *memory_used, size_t *memory_budget);
+
+/**
+ * chessEnableSpill: moves the games and players of ended tournaments - both the ones already ended and the ones
+ *                   ended later - out of memory into a spill file, keeping only their summary in memory: the
+ *                   winner, location, statistics and counts. Saving the tournament statistics only reads the
+ *                   summary. Operations which need the games or players of a spilled tournament - removing it,
+ *                   removing or merging its players, and saving snapshots and checkpoints - read them back
+ *                   through a cache of the most recently used spilled tournaments. Removing players only reads
+ *                   back the tournaments they played in.
+ *                   The spill file is removed when the chess system is destroyed. Space of tournaments which were
+ *                   removed, or grew while they were in the cache, is not reused.
+ *                   chessImportGamesParallel refuses the games of ended tournaments before its threads start, so
+ *                   the threads never read spilled tournaments back, and the cache is only used by the calling
+ *                   thread.
+ *
+ * @param chess - a chess system.
+ * @param path - the path of the spill file, which is created, replacing any file in it. Ignored if spilling is
+ *               already enabled.
+ * @param cache_capacity - the number of spilled tournaments kept in memory. Values below 1 are handled as 1. If
+ *                         spilling is already enabled, only the capacity is changed.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path are NULL.
+ *     CHESS_SAVE_FAILURE - if the spill file couldn't be created, in which case spilling is not enabled, or an
+ *                          ended tournament couldn't be written to it, in which case it stays in memory.
+ *     CHESS_SUCCESS - if spilling was enabled.
+ */
+ChessResult chessEnableSpill(ChessSystem chess, const char *path, int cache_capacity);
+
+/**
+ * chessImportGames: adds the games of a text game log to the chess system, in the order of the log.
+ *                   Each line of the log is "tournament_id first_player second_player winner play_time",
+ *                   where winner is 0 for FIRST_PLAYER, 1 for SECOND_PLAYER and 2 for DRAW. Blank lines
+ *                   are skipped. The tournaments must already exist in the system.
+ *                   Every line is added exactly as chessAddGame would add it, and a line which fails is
+ *                   skipped and reported with the result chessAddGame would have returned for it.
+ *                   Malformed lines are reported as CHESS_INVALID_ID.
+ *
+ * @param chess - chess system to add the games to.
+ * @param path - the path of the game log file.
+ * @param stats - errors and max_errors are read: an array to fill with the lines that failed, and its size.
+ *                errors may be NULL if max_errors is 0. Errors beyond max_errors are counted but not filled.
+ *                lines_read, games_added and number_of_errors are filled with the number of non-blank lines
+ *                read, the number of games added and the number of lines that failed.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess, path or stats are NULL, or errors is NULL while max_errors is positive.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be opened.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed or the memory budget was reached. The import stops at
+ *                           the line which failed, which is the last error reported. Games of earlier lines
+ *                           remain in the system.
+ *     CHESS_SUCCESS - if the whole log was read, even if some lines failed.
+ */
+ChessResult chessImportGames(ChessSystem chess, const char *path, ChessImportStats *stats);
+
+/**
+ * chessImportGamesParallel: adds the games of a text game log to the chess system, using several threads.
+ *                           Each thread imports the games of its own tournaments, and the system's players
+ *                           and their statistics are then updated in the order of the log. The resulting
+ *                           system, statistics and errors are the same as chessImportGames would produce,
+ *                           whatever the number of threads.
+ *                           If the memory budget may run out during the import, the games are imported by
+ *                           the calling thread only, so the budget is checked in the order of the log.
+ *
+ * @param chess - chess system to add the games to. Must not be used by other threads during the import.
+ * @param path - the path of the game log file.
+ * @param stats - see chessImportGames.
+ * @param number_of_threads - the number of threads to use. 1 or less is the same as calling chessImportGames.
+ *
+ * @return
+ *     See chessImportGames.
+ */
+ChessResult chessImportGamesParallel(ChessSystem chess, const char *path, ChessImportStats *stats,
+                                     int number_of_threads);
+
+/**
+ * chessSaveSnapshot: saves the whole chess system - tournaments, games and players - to a versioned binary
+ *                    snapshot file, which chessLoadSnapshot can restore. An existing file is replaced only
+ *                    once the new snapshot was written completely.
+ *
+ * @param chess - chess system to save.
+ * @param path - the path of the snapshot file.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be written.
+ *     CHESS_SUCCESS - if the snapshot was saved successfully.
+ */
+ChessResult chessSaveSnapshot(ChessSystem chess, const char *path);
+
+/**
+ * chessSaveSnapshotCompressed: saves the whole chess system to a snapshot file as chessSaveSnapshot does,
+ *                              compressed with the built-in LZ block compressor. chessLoadSnapshot detects
+ *                              compressed files and reads them the same way.
+ *
+ * @param chess - chess system to save.
+ * @param path - the path of the snapshot file.
+ *
+ * @return
+ *     See chessSaveSnapshot.
+ */
+ChessResult chessSaveSnapshotCompressed(ChessSystem chess, const char *path);
+
+/**
+ * chessLoadSnapshot: creates a new chess system from a snapshot file saved by chessSaveSnapshot or
+ *                    chessSaveSnapshotCompressed.
+ *                    The new system has no memory budget.
+ *
+ * @param path - the path of the snapshot file.
+ * @param chess_result - output for the result of the load. May be NULL.
+ *                       CHESS_NULL_ARGUMENT - if path is NULL.
+ *                       CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *                       CHESS_SAVE_FAILURE - if the file couldn't be read, or is not a valid snapshot.
+ *                       CHESS_SUCCESS - if the system was loaded successfully.
+ *
+ * @return
+ *     NULL - if the load failed.
+ *     the loaded chess system in case of success.
+ */
+ChessSystem chessLoadSnapshot(const char *path, ChessResult *chess_result);
+
+/**
+ * chessAttachJournal: starts recording every successful mutation of the chess system in a journal file,
+ *                     so that the mutations made after the last snapshot survive a crash. Records are
+ *                     appended to an existing journal, after its last complete record.
+ *                     Once attached, a mutation whose record couldn't be written still takes effect, but
+ *                     returns CHESS_SAVE_FAILURE and detaches the journal - a new snapshot should be saved.
+ *
+ * @param chess - chess system to record.
+ * @param path - the path of the journal file.
+ * @param sync - how often the journal is synced to the disk:
+ *               CHESS_JOURNAL_SYNC_EVERY_OPERATION - before every mutation returns.
+ *               CHESS_JOURNAL_SYNC_GROUP - once group_commit_ms passed since the first mutation which is
+ *                                          not synced yet, by a background thread if no more mutations
+ *                                          follow, so a crash loses at most that much of the latest mutations.
+ *               CHESS_JOURNAL_SYNC_NONE - only by chessSyncJournal and chessDetachJournal.
+ * @param group_commit_ms - the group commit interval in milliseconds, for CHESS_JOURNAL_SYNC_GROUP.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path are NULL.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be opened or is not a journal, or a journal is already attached.
+ *     CHESS_SUCCESS - if the journal was attached successfully.
+ */
+ChessResult chessAttachJournal(ChessSystem chess, const char *path, ChessJournalSync sync, int group_commit_ms);
+
+/**
+ * chessDetachJournal: syncs the journal of the chess system and closes it. Does nothing if no journal
+ *                     is attached.
+ *
+ * @param chess - chess system whose journal to detach.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SAVE_FAILURE - if the pending records couldn't be synced.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessDetachJournal(ChessSystem chess);
+
+/**
+ * chessSyncJournal: syncs the records of the chess system's journal which are still pending.
+ *
+ * @param chess - chess system whose journal to sync.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SAVE_FAILURE - if no journal is attached, or the records couldn't be synced.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessSyncJournal(ChessSystem chess);
+
+/**
+ * chessReplayJournal: applies the mutations recorded in a journal file to the chess system, in order.
+ *                     Records the system already includes - those up to the journal position of the
+ *                     snapshot it was loaded from - are skipped, and replay stops at a torn record at the
+ *                     end of the journal. Replayed mutations are not recorded in the system's own journal.
+ *
+ * @param chess - chess system to apply the mutations to.
+ * @param path - the path of the journal file.
+ * @param records_applied - output for the number of records applied. May be NULL.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed. The records before it stay applied.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be opened or is not a journal.
+ *     CHESS_SUCCESS - if the journal was replayed successfully.
+ */
+ChessResult chessReplayJournal(ChessSystem chess, const char *path, int *records_applied);
+
+/**
+ * chessRecover: creates a chess system from a snapshot file and replays the journal written after it.
+ *
+ * @param snapshot_path - the path of the snapshot file. If NULL, the journal is replayed into a new
+ *                        empty chess system.
+ * @param journal_path - the path of the journal file.
+ * @param chess_result - output for the result of the recovery. May be NULL.
+ *                       CHESS_NULL_ARGUMENT - if journal_path is NULL.
+ *                       Otherwise, the result of chessLoadSnapshot or chessReplayJournal.
+ *
+ * @return
+ *     NULL - if the recovery failed.
+ *     the recovered chess system in case of success.
+ */
+ChessSystem chessRecover(const char *snapshot_path, const char *journal_path, ChessResult *chess_result);
+
+/**
+ * chessSaveCheckpoint: saves the chess system to a checkpoint file, which is made of one segment per
+ *                      tournament and one for the system's players. Given the system's previous checkpoint,
+ *                      only the segments that changed since are written, and the others are linked to the
+ *                      earlier checkpoint files which hold them - so those files must be kept. Ended
+ *                      tournaments rarely change, so most of a long running system is written only once.
+ *                      The checkpoint records the system's journal position, as a snapshot does.
+ *
+ * @param chess - chess system to save.
+ * @param path - the path of the checkpoint file. Must not be the path of a file the checkpoint links to.
+ * @param previous_path - the path of the system's latest checkpoint, or of a compacted copy of it. May be NULL.
+ *                        If NULL, or if it is not the system's latest checkpoint, every segment is written.
+ * @param number_of_files - output for the number of files the checkpoint is read from, including its own.
+ *                          May be NULL. Once it grows too large, the checkpoint should be compacted.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be written.
+ *     CHESS_SUCCESS - if the checkpoint was saved successfully.
+ */
+ChessResult chessSaveCheckpoint(ChessSystem chess, const char *path, const char *previous_path,
+                                int *number_of_files);
+
+/**
+ * chessLoadCheckpoint: creates a new chess system from a checkpoint saved by chessSaveCheckpoint, reading its
+ *                      linked segments from the earlier checkpoint files. The new system may save its next
+ *                      checkpoint incrementally, with the loaded checkpoint as the previous one.
+ *
+ * @param path - the path of the checkpoint file.
+ * @param chess_result - output for the result of the load. May be NULL.
+ *                       CHESS_NULL_ARGUMENT - if path is NULL.
+ *                       CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *                       CHESS_SAVE_FAILURE - if a file couldn't be read, was replaced since it was linked,
+ *                                            or is not a valid checkpoint.
+ *                       CHESS_SUCCESS - if the system was loaded successfully.
+ *
+ * @return
+ *     NULL - if the load failed.
+ *     the loaded chess system in case of success.
+ */
+ChessSystem chessLoadCheckpoint(const char *path, ChessResult *chess_result);
+
+/**
+ * chessCompactCheckpoint: copies a checkpoint, with the segments it links from earlier checkpoints, into a
+ *                         single file, so loading it reads one file. The copy counts as the same checkpoint,
+ *                         and may be passed as the previous checkpoint of the system's next checkpoint.
+ *                         Only checkpoint files are accessed, so it may run on another thread while the
+ *                         chess system keeps working.
+ *
+ * @param path - the path of the checkpoint to compact.
+ * @param compacted_path - the path of the compacted copy. Must be different from path.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if path or compacted_path are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if a file couldn't be read or written, or is not a valid checkpoint.
+ *     CHESS_SUCCESS - if the checkpoint was compacted successfully.
+ */
+ChessResult chessCompactCheckpoint(const char *path, const char *compacted_path);
+
+/**
+ * chessSavePlayersLevelsEx: saves the players' levels in a given format, in the order of
+ *                           chessSavePlayersLevels - from the highest level to the lowest.
+ *                           CHESS_LEVELS_TEXT - the "%d %.2lf" lines of chessSavePlayersLevels.
+ *                           CHESS_LEVELS_BINARY - a ChessLevelsHeader followed by a ChessLevelRecord per player,
+ *                                                 with the level in hundredths. The file should be opened in
+ *                                                 binary mode.
+ *                           CHESS_LEVELS_JSON_LINES - a line of {"id":<id>,"level":<level>} per player, with
+ *                                                     the level as in the text format.
+ *
+ * @param chess - a chess system.
+ * @param file - the file to write to.
+ * @param format - the format of the report.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if the format is unknown, or a write failed.
+ *     CHESS_SUCCESS - if the report was saved successfully.
+ */
+ChessResult chessSavePlayersLevelsEx(ChessSystem chess, FILE *file, ChessLevelsFormat format);
+
+/**
+ * chessSavePlayersLevelsCompressed: saves the report chessSavePlayersLevelsEx writes, compressed into an LZ
+ *                                   stream with the built-in block compressor, as it is written. The file
+ *                                   should be opened in binary mode. Several reports written to the same file
+ *                                   are decompressed by chessDecompressFile one after the other.
+ *
+ * @param chess - a chess system.
+ * @param file - the file to write to.
+ * @param format - the format of the report.
+ *
+ * @return
+ *     See chessSavePlayersLevelsEx.
+ */
+ChessResult chessSavePlayersLevelsCompressed(ChessSystem chess, FILE *file, ChessLevelsFormat format);
+
+/**
+ * chessSavePlayersLevelsDelta: saves the players whose level changed since a previous delta, so a consumer
+ *                              of the levels report can patch its copy instead of reading every player again.
+ *                              The players are written sorted by ID, one per line:
+ *                                  "<id> <level>" - a player whose level changed, as in chessSavePlayersLevels.
+ *                                  "<id> -"       - a player which was removed, or no longer has any play
+ *                                                   time, and is missing from the levels report.
+ *                              Only the latest removals are kept track of. A token older than the removals
+ *                              which were forgotten is answered with a full export: a first line of "*", telling
+ *                              the consumer to drop its copy, followed by every player with play time, as if
+ *                              since_token was 0.
+ *                              A player is changed by a game added, updated or removed, by a technical win when
+ *                              its opponent is removed, by a removed tournament, and by merging players.
+ *                              Tokens are valid for the lifetime of the chess system only: they are not kept
+ *                              in snapshots, checkpoints or journals, and a restored system starts over from 0.
+ *
+ * @param chess - a chess system.
+ * @param file - the file to write to.
+ * @param since_token - the token returned by the previous delta, or 0 to write all the players with play
+ *                      time, without removals.
+ * @param new_token - where the token to pass to the next delta is stored, if the delta was saved.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess, file or new_token are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if since_token was not returned by this chess system, or a write failed.
+ *     CHESS_SUCCESS - if the delta was saved successfully.
+ */
+ChessResult chessSavePlayersLevelsDelta(ChessSystem chess, FILE *file, long long since_token, long long *new_token);
+
+/**
+ * chessSavePlayersLevelsToBuffer: appends the report chessSavePlayersLevels writes to a memory buffer,
+ *                                 with no file involved. The buffer grows as needed.
+ *
+ * @param chess - a chess system.
+ * @param buffer - the buffer to append to.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or buffer are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed, or the buffer's length is larger than its capacity.
+ *                           The buffer's length is left unchanged.
+ *     CHESS_SUCCESS - if the report was appended successfully.
+ */
+ChessResult chessSavePlayersLevelsToBuffer(ChessSystem chess, ChessReportBuffer *buffer);
+
+/**
+ * chessSavePlayersLevelsToFd: writes the report chessSavePlayersLevels writes to a file descriptor, such as
+ *                             a socket or a pipe, in large writes.
+ *
+ * @param chess - a chess system.
+ * @param fd - the file descriptor to write to. It is not closed.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if fd is negative or a write failed.
+ *     CHESS_SUCCESS - if the report was written successfully.
+ */
+ChessResult chessSavePlayersLevelsToFd(ChessSystem chess, int fd);
+
+/**
+ * chessSaveTournamentStatisticsToBuffer: appends the report chessSaveTournamentStatistics writes to a memory
+ *                                        buffer, with no file involved. The buffer grows as needed.
+ *
+ * @param chess - a chess system.
+ * @param buffer - the buffer to append to.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or buffer are NULL.
+ *     CHESS_NO_TOURNAMENTS_ENDED - if there are no tournaments ended in the system.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed, or the buffer's length is larger than its capacity.
+ *                           The buffer's length is left unchanged.
+ *     CHESS_SUCCESS - if the report was appended successfully.
+ */
+ChessResult chessSaveTournamentStatisticsToBuffer(ChessSystem chess, ChessReportBuffer *buffer);
+
+/**
+ * chessSaveTournamentStatisticsToFd: writes the report chessSaveTournamentStatistics writes to a file
+ *                                    descriptor, such as a socket or a pipe, in large writes.
+ *
+ * @param chess - a chess system.
+ * @param fd - the file descriptor to write to. It is not closed.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_NO_TOURNAMENTS_ENDED - if there are no tournaments ended in the system.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if fd is negative or a write failed.
+ *     CHESS_SUCCESS - if the report was written successfully.
+ */
+ChessResult chessSaveTournamentStatisticsToFd(ChessSystem chess, int fd);
+
+/**
+ * chessExportBegin: starts an export of the players' levels report and the tournament statistics report, which
+ *                   chessExportStep writes in chunks, so a caller serving other requests is never held for
+ *                   long. The reports are identical to the ones chessSavePlayersLevels and
+ *                   chessSaveTournamentStatistics write at the time the export begins: the levels and the
+ *                   statistics are copied, so the chess system may be changed, or even destroyed, while the
+ *                   export is in progress, and the changes don't appear in the reports.
+ *                   Beginning takes a single pass over the players and tournaments, without sorting or writing.
+ *
+ * @param chess - a chess system.
+ * @param levels_file - the file to write the levels report to, or NULL to skip it.
+ * @param statistics_file - the file to write the statistics report to, or NULL to skip it.
+ * @param chess_result - this variable will be set to the result of beginning the export. May be NULL.
+ *                       CHESS_NULL_ARGUMENT - if chess is NULL, or both files are NULL.
+ *                       CHESS_NO_TOURNAMENTS_ENDED - if statistics_file is given, and there are no tournaments
+ *                                                    ended.
+ *                       CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *                       CHESS_SUCCESS - if the export began.
+ *
+ * @return
+ *     NULL - if the export didn't begin.
+ *     the export session in case of success. It must be ended by chessExportEnd.
+ */
+ChessExportSession chessExportBegin(ChessSystem chess, FILE *levels_file, FILE *statistics_file,
+                                    ChessResult *chess_result);
+
+/**
+ * chessExportStep: continues an export, by handling up to max_records records - players whose levels are sorted
+ *                  or written, and tournaments whose statistics are written - and writing them out. Sorting is
+ *                  done in runs of a fixed size, so a step may handle slightly more records than max_records.
+ *                  The levels report is done before the statistics report starts.
+ *
+ * @param session - an export session.
+ * @param max_records - the number of records to handle. Values below 1 are handled as 1.
+ * @param done - output for whether the export is done, or failed and can't continue.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if session or done are NULL.
+ *     CHESS_SAVE_FAILURE - if a write failed, in this step or in an earlier one.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessExportStep(ChessExportSession session, int max_records, bool *done);
+
+/**
+ * chessExportEnd: ends an export and deallocates it. The files are not closed. An export ended before it is done
+ *                 leaves the reports partially written.
+ *
+ * @param session - the export session to end.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if session is NULL.
+ *     CHESS_SAVE_FAILURE - if a write of the export failed.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessExportEnd(ChessExportSession session);
+
+/**
+ * chessDecompressFile: decompresses a file written by chessSaveSnapshotCompressed or
+ *                      chessSavePlayersLevelsCompressed into a plain file, as it is read.
+ *
+ * @param path - the path of the compressed file.
+ * @param output_path - the path of the plain file. An existing file is replaced.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if path or output_path are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if a file couldn't be opened, read or written, or the compressed file is
+ *                          truncated or corrupt. No plain file is left in that case.
+ *     CHESS_SUCCESS - if the file was decompressed successfully.
+ */
+ChessResult chessDecompressFile(const char *path, const char *output_path);
+
+/**
+ * chessOpenReadOnly: opens a snapshot file saved by chessSaveSnapshot for queries only. The file is memory
+ *                    mapped, and queries read its sorted sections in place, so opening it takes the same time
+ *                    whatever its size, and processes which open the same file share its pages in the page cache.
+ *                    The file must not be changed while it is open - chessSaveSnapshot replaces the file
+ *                    instead, which leaves the open one as it was.
+ *
+ * @param path - the path of the snapshot file. Compressed snapshots can't be opened.
+ * @param chess_result - output for the result of the open. May be NULL.
+ *                       CHESS_NULL_ARGUMENT - if path is NULL.
+ *                       CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *                       CHESS_SAVE_FAILURE - if the file couldn't be mapped, or is not an uncompressed snapshot.
+ *                       CHESS_SUCCESS - if the file was opened successfully.
+ *
+ * @return
+ *     NULL - if the open failed.
+ *     the read only chess system in case of success.
+ */
+ChessReadOnly chessOpenReadOnly(const char *path, ChessResult *chess_result);
+
+/**
+ * chessCloseReadOnly: closes a read only chess system, and unmaps its file.
+ *
+ * @param chess - the read only chess system to close. If chess is NULL nothing will be done.
+ */
+void chessCloseReadOnly(ChessReadOnly chess);
+
+/**
+ * chessReadOnlyCalculateAveragePlayTime: calculates a player's average game time as
+ *                                        chessCalculateAveragePlayTime does. The player is found by a binary
+ *                                        search of the snapshot's players.
+ *
+ * @param chess - a read only chess system.
+ * @param player_id - player ID.
+ * @param chess_result - this variable will be set to the result of the calculation, as by
+ *                       chessCalculateAveragePlayTime.
+ *
+ * @return
+ *     See chessCalculateAveragePlayTime.
+ */
+double chessReadOnlyCalculateAveragePlayTime(ChessReadOnly chess, int player_id, ChessResult *chess_result);
+
+/**
+ * chessReadOnlySavePlayersLevels: saves the report chessSavePlayersLevels saves, for the players of a read only
+ *                                 chess system.
+ *
+ * @param chess - a read only chess system.
+ * @param file - the file to write to.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if a write failed.
+ *     CHESS_SUCCESS - if the report was saved successfully.
+ */
+ChessResult chessReadOnlySavePlayersLevels(ChessReadOnly chess, FILE *file);
+
+/**
+ * chessReadOnlySaveTournamentStatistics: saves the report chessSaveTournamentStatistics saves, for the
+ *                                        tournaments of a read only chess system.
+ *
+ * @param chess - a read only chess system.
+ * @param path_file - the path of the file to write to.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_NO_TOURNAMENTS_ENDED - if there are no tournaments ended in the system.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be written, or the snapshot's sections are inconsistent.
+ *     CHESS_SUCCESS - if the report was saved successfully.
+ */
+ChessResult chessReadOnlySaveTournamentStatistics(ChessReadOnly chess, char *path_file);
+
+/**
+ * chessScanGames: counts the games matching a filter and their draws, and sums and takes the maximum of their
+ *                 play times - over all of them, or grouped by player or by tournament. Grouped by player, a game
+ *                 is counted for each of its players, except players removed while the tournament was running.
+ *                 The games are scanned from a columnar copy of all the games of the system, which is built by
+ *                 the first scan and kept in sync by every later change to the games. Scans don't read spilled
+ *                 tournaments back.
+ *
+ * @param chess - chess system to scan the games of.
+ * @param filter - the games to aggregate. May be NULL to aggregate all the games.
+ * @param grouping - how the games are grouped. With CHESS_GROUP_NONE, a single group with the key 0 is
+ *                   returned, even if no game matched.
+ * @param number_of_groups - output for the number of groups.
+ * @param chess_result - this variable will be set to the result of the scan.
+ *
+ * @return
+ *     NULL - in case of an error, which chess_result is set to:
+ *         CHESS_NULL_ARGUMENT - if chess, number_of_groups or chess_result are NULL.
+ *         CHESS_INVALID_ID - if the filter's tournament_id or player_id are negative.
+ *         CHESS_INVALID_PLAY_TIME - if the filter's play times are negative.
+ *         CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     the groups, ordered by key, otherwise, and chess_result is set to CHESS_SUCCESS. The caller frees them
+ *     with free. Locations are valid until their tournament is removed.
+ */
+ChessGameAggregate *chessScanGames(ChessSystem chess, const ChessGameFilter *filter, ChessGameGrouping grouping,
+                                   int *number_of_groups, ChessResult *chess_result);
+
+/**
+ * chessEnableChangeFeed: starts recording every change to the chess system as an event in a ring buffer, numbered
+ *                        by sequence numbers which start from 1 and grow by one with every event. While the feed
+ *                        isn't enabled, changes cost nothing extra. Events are handed to subscribed callbacks in
+ *                        batches, and the waiting events are handed over when the system is destroyed.
+ *
+ * @param chess - a chess system.
+ * @param capacity - the number of latest events kept for chessReadChanges. Ignored if the feed is already enabled.
+ * @param batch_size - the number of waiting events at which they are handed to the callbacks. Values below 1 are
+ *                     handled as 1, and values above the capacity as the capacity. If the feed is already enabled,
+ *                     only the batch size is changed.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SUCCESS - if the feed was enabled.
+ */
+ChessResult chessEnableChangeFeed(ChessSystem chess, int capacity, int batch_size);
+
+/**
+ * chessSubscribeChanges: adds a callback which is handed the change events recorded from now on. Enables the change
+ *                        feed with a default capacity and batch size if it isn't enabled. A callback is never handed
+ *                        an event twice, and never misses one unless an allocation fails - waiting events are
+ *                        queued apart from the ring buffer until they are handed over.
+ *
+ * @param chess - a chess system.
+ * @param callback - the callback.
+ * @param context - passed to the callback with every batch. May be NULL.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or callback are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SUCCESS - if the callback was added.
+ */
+ChessResult chessSubscribeChanges(ChessSystem chess, ChessChangeCallback callback, void *context);
+
+/**
+ * chessUnsubscribeChanges: removes a callback, without handing it the waiting events. Callbacks which were not
+ *                          subscribed with the given context are ignored.
+ *
+ * @param chess - a chess system.
+ * @param callback - the callback.
+ * @param context - the context the callback was subscribed with.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or callback are NULL.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessUnsubscribeChanges(ChessSystem chess, ChessChangeCallback callback, void *context);
+
+/**
+ * chessFlushChanges: hands all the waiting change events to the callbacks, even if a batch isn't complete.
+ *
+ * @param chess - a chess system.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessFlushChanges(ChessSystem chess);
+
+/**
+ * chessReadChanges: copies the change events which follow a sequence number, oldest first. If events the reader
+ *                   didn't read yet were already written over, they are skipped - the first event copied then has
+ *                   a sequence number above since_sequence + 1, and the reader should start over from a full
+ *                   export.
+ *
+ * @param chess - a chess system.
+ * @param since_sequence - the sequence number of the last event the reader read, 0 for none.
+ * @param events - an array to copy the events into. May be NULL if max_events is 0.
+ * @param max_events - the size of the array.
+ * @param number_of_events - output for the number of events copied. 0 if the change feed isn't enabled.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or number_of_events are NULL, or events is NULL while max_events is positive.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessReadChanges(ChessSystem chess, long long since_sequence, ChessChangeEvent *events, int max_events,
+                             int *number_of_events);
+
+/**
+ * chessGetPlayerStats: reads the statistics of a player over all the games the player played. Like
+ *                      chessCalculateAveragePlayTime, it doesn't wait for games being added by other threads, and
+ *                      reads the player as it was before or after each of them.
+ *
+ * @param chess - a chess system.
+ * @param player_id - the ID of the player.
+ * @param stats - output for the statistics of the player.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or stats are NULL.
+ *     CHESS_INVALID_ID - if the player ID is not positive.
+ *     CHESS_PLAYER_NOT_EXIST - if the player is not in the chess system.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessGetPlayerStats(ChessSystem chess, int player_id, ChessPlayerStats *stats);
+
+/**
+ * chessOpenSubmissionQueue: starts a thread which adds games submitted by other threads to the chess system,
+ *                           in batches. Games are submitted into a ring of fixed capacity without locks, so
+ *                           submitting never waits for the chess system or for other submitting threads.
+ *                           Without CHESS_THREAD_SAFE defined, the chess system must not be used by other threads
+ *                           until the queue is closed, except through the queue.
+ *
+ * @param chess - the chess system to add the games to. Must not be destroyed before the queue is closed.
+ * @param capacity - the number of games which may wait in the queue, rounded up to a power of two.
+ * @param batch_size - the number of waiting games added at a time. Values below 1 are handled as 1, and values
+ *                     above the capacity as the capacity.
+ * @param chess_result - this variable will be set to the result of opening the queue. May be NULL.
+ *                       CHESS_NULL_ARGUMENT - if chess is NULL.
+ *                       CHESS_OUT_OF_MEMORY - if an allocation failed, or the thread couldn't be started.
+ *                       CHESS_SUCCESS - if the queue was opened.
+ *
+ * @return
+ *     NULL - if the queue wasn't opened.
+ *     the queue in case of success. It must be closed by chessCloseSubmissionQueue.
+ */
+ChessSubmissionQueue chessOpenSubmissionQueue(ChessSystem chess, int capacity, int batch_size,
+                                              ChessResult *chess_result);
+
+/**
+ * chessSubmitGame: submits a game to be added by the queue's thread, as chessAddGame would add it. Games
+ *                  submitted by a single thread are added in the order they were submitted. May be called by
+ *                  many threads at once.
+ *
+ * @param queue - the submission queue.
+ * @param tournament_id - see chessAddGame.
+ * @param first_player - see chessAddGame.
+ * @param second_player - see chessAddGame.
+ * @param winner - see chessAddGame.
+ * @param play_time - see chessAddGame.
+ * @param ticket - a ticket which is given the result of chessAddGame once the game is added, or NULL if the
+ *                 result isn't needed. Must stay valid until the game is added.
+ *
+ * @return
+ *     false - if queue is NULL, or the queue is full. The game isn't submitted, and the ticket isn't changed.
+ *     true - if the game was submitted.
+ */
+bool chessSubmitGame(ChessSubmissionQueue queue, int tournament_id, int first_player, int second_player,
+                     Winner winner, int play_time, ChessSubmissionTicket *ticket);
+
+/**
+ * chessIsSubmissionDone: checks if the game of a ticket was added, without waiting.
+ *
+ * @param ticket - the ticket the game was submitted with.
+ * @param result - output for the result of adding the game, set only if it was added. May be NULL.
+ *
+ * @return
+ *     false - if ticket is NULL, or the game wasn't added yet.
+ *     true - if the game was added.
+ */
+bool chessIsSubmissionDone(const ChessSubmissionTicket *ticket, ChessResult *result);
+
+/**
+ * chessWaitSubmission: waits for the game of a ticket to be added.
+ *
+ * @param ticket - the ticket the game was submitted with.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if ticket is NULL.
+ *     the result of adding the game otherwise. See chessAddGame.
+ */
+ChessResult chessWaitSubmission(const ChessSubmissionTicket *ticket);
+
+/**
+ * chessCloseSubmissionQueue: adds the games still waiting in the queue, stops its thread, and deallocates it.
+ *                            Threads must not submit to the queue once it is being closed.
+ *
+ * @param queue - the queue to close. If queue is NULL nothing will be done.
+ */
+void chessCloseSubmissionQueue(ChessSubmissionQueue queue);
+
+#endif /* CHESS_SYSTEM_EXTENSIONS_H_ */
@@ -1,9 +1,15 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
+#include <string.h>
 #include "chessSystem.h"
+#include "chessSystemExtensions.h"
 #include "test_utilities.h"
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
 
 /*The number of tests*/
-#define NUMBER_TESTS 4
+#define NUMBER_TESTS 29
 
 
 bool testChessAddTournament() {
@@ -62,13 +68,1647 @@ bool testChessPrintLevelsAndTournamentStatistics(){
 }
 
 
+static void addBulkRemovalGames(ChessSystem chess) {
+    chessAddTournament(chess, 1, 4, "London");
+    chessAddTournament(chess, 2, 4, "Paris");
+    chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 2000);
+    chessAddGame(chess, 1, 2, 3, DRAW, 1000);
+    chessAddGame(chess, 1, 3, 4, SECOND_PLAYER, 1500);
+    chessAddGame(chess, 2, 1, 3, SECOND_PLAYER, 500);
+    chessAddGame(chess, 2, 2, 4, FIRST_PLAYER, 700);
+}
+
+static bool isSameLevels(ChessSystem chess1, ChessSystem chess2) {
+    FILE* file1 = tmpfile();
+    FILE* file2 = tmpfile();
+    chessSavePlayersLevels(chess1, file1);
+    chessSavePlayersLevels(chess2, file2);
+    rewind(file1);
+    rewind(file2);
+    int ch1, ch2;
+    do {
+        ch1 = fgetc(file1);
+        ch2 = fgetc(file2);
+    } while (ch1 == ch2 && ch1 != EOF);
+    fclose(file1);
+    fclose(file2);
+    return ch1 == ch2;
+}
+
+bool testChessBulkRemoval(){
+    ChessSystem sequential = chessCreate();
+    ChessSystem bulk = chessCreate();
+    addBulkRemovalGames(sequential);
+    addBulkRemovalGames(bulk);
+
+    int players[] = {2, 9, 1, 2};
+    ASSERT_TEST(chessRemovePlayer(sequential, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(sequential, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayers(bulk, players, 4) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(isSameLevels(sequential, bulk));
+
+    int tournaments[] = {2, 3};
+    ASSERT_TEST(chessRemoveTournament(sequential, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournaments(bulk, tournaments, 2) == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(isSameLevels(sequential, bulk));
+
+    // A repeated ID fails before a later invalid one, as it would when removed one by one
+    int repeated_players[] = {3, 3, 0, 4};
+    ASSERT_TEST(chessRemovePlayer(sequential, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(sequential, 3) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessRemovePlayer(sequential, 0) == CHESS_INVALID_ID);
+    ASSERT_TEST(chessRemovePlayer(sequential, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayers(bulk, repeated_players, 4) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(isSameLevels(sequential, bulk));
+    int repeated_tournaments[] = {1, 1, -2};
+    ASSERT_TEST(chessRemoveTournaments(bulk, repeated_tournaments, 3) == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(chessRemoveTournament(sequential, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(sequential, bulk));
+
+    chessDestroy(sequential);
+    chessDestroy(bulk);
+    return true;
+}
+
+bool testChessUpdateAndRemoveGame(){
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 2000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, DRAW, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 3, DRAW, 100) == CHESS_INVALID_ID);
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 1, SECOND_PLAYER, -1) == CHESS_INVALID_PLAY_TIME);
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 1, SECOND_PLAYER, 3000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 1, &result) == 2000 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveGame(chess, 1, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveGame(chess, 1, 1) == CHESS_INVALID_ID);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 1, &result) == 1000);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 2, &result) == 0);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, SECOND_PLAYER, 500) == CHESS_SUCCESS);
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 3, FIRST_PLAYER, 700) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveGame(chess, 1, 2) == CHESS_TOURNAMENT_ENDED);
+
+    chessDestroy(chess);
+    return true;
+}
+
+bool testChessMergePlayers(){
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    ChessMergeConflict conflicts[2];
+    int number_of_conflicts = 0;
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, FIRST_PLAYER, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 3000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 2, 4, FIRST_PLAYER, 2000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessMergePlayers(chess, 1, 2, conflicts, 2, &number_of_conflicts) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(number_of_conflicts == 1 && conflicts[0].tournament_id == 1 && conflicts[0].opponent_id == 3);
+    ASSERT_TEST(chessRemoveGame(chess, 1, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessMergePlayers(chess, 1, 2, NULL, 0, &number_of_conflicts) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_conflicts == 0);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 1, &result) == 1500 && result == CHESS_SUCCESS);
+    chessCalculateAveragePlayTime(chess, 2, &result);
+    ASSERT_TEST(result == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 4, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessRemovePlayer(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 4, &result) == 2000);
+
+    ASSERT_TEST(chessAddTournament(chess, 3, 1, "Berlin") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 6, FIRST_PLAYER, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 7, 8, SECOND_PLAYER, 3000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessMergePlayers(chess, 5, 7, conflicts, 2, &number_of_conflicts) == CHESS_EXCEEDED_GAMES);
+    ASSERT_TEST(number_of_conflicts == 0);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 5, &result) == 1000 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 7, &result) == 3000 && result == CHESS_SUCCESS);
+
+    chessDestroy(chess);
+    return true;
+}
+
+bool testChessCreateWithConfig(){
+    ChessConfig config = {1000, 10, 50, 1 << 16, 0};
+    ChessSystem chess = chessCreateWithConfig(&config);
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 2000) == CHESS_SUCCESS);
+    ChessSystem other = chessCreate();
+    ASSERT_TEST(other != NULL);
+    ASSERT_TEST(chessAddTournament(other, 1, 4, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    chessDestroy(chess);
+    ASSERT_TEST(chessAddGame(other, 1, 1, 2, DRAW, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(other, 1) == CHESS_SUCCESS);
+    chessDestroy(other);
+
+    chess = chessCreateWithConfig(NULL);
+    ASSERT_TEST(chess != NULL);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testChessMemoryBudget(){
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chess != NULL);
+    size_t used = 0, budget = 1;
+    ASSERT_TEST(chessGetMemoryUsage(chess, &used, &budget) == CHESS_SUCCESS);
+    ASSERT_TEST(budget == 0);
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 2000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetMemoryUsage(chess, &used, NULL) == CHESS_SUCCESS);
+
+    ASSERT_TEST(chessSetMemoryBudget(chess, used) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, DRAW, 1000) == CHESS_OUT_OF_MEMORY);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_OUT_OF_MEMORY);
+    size_t used_after = 0;
+    ASSERT_TEST(chessGetMemoryUsage(chess, &used_after, &budget) == CHESS_SUCCESS);
+    ASSERT_TEST(used_after == used && budget == used);
+
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 2, DRAW, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSetMemoryBudget(chess, 0) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 4, DRAW, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testChessImportGames(){
+    const char* path = "chessImportGames.tmp";
+    FILE* log = fopen(path, "w");
+    ASSERT_TEST(log != NULL);
+    fprintf(log, "1 1 2 0 2000\n\n1 2 3 2 1000\r\n1 x 4 0 10\n3 1 2 0 10\n1 2 1 1 10\n1 3 4 1 1500");
+    fclose(log);
+
+    ChessSystem sequential = chessCreate();
+    ChessSystem imported = chessCreate();
+    ASSERT_TEST(chessAddTournament(sequential, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(imported, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(sequential, 1, 1, 2, FIRST_PLAYER, 2000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(sequential, 1, 2, 3, DRAW, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(sequential, 1, 3, 4, SECOND_PLAYER, 1500) == CHESS_SUCCESS);
+
+    ChessImportError errors[2];
+    ChessImportStats stats = {errors, 2, 0, 0, 0};
+    ASSERT_TEST(chessImportGames(imported, path, &stats) == CHESS_SUCCESS);
+    remove(path);
+    ASSERT_TEST(stats.lines_read == 6 && stats.games_added == 3 && stats.number_of_errors == 3);
+    ASSERT_TEST(errors[0].line == 4 && errors[0].result == CHESS_INVALID_ID);
+    ASSERT_TEST(errors[1].line == 5 && errors[1].result == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(isSameLevels(sequential, imported));
+    ASSERT_TEST(chessImportGames(imported, path, &stats) == CHESS_SAVE_FAILURE);
+
+    chessDestroy(sequential);
+    chessDestroy(imported);
+    return true;
+}
+
+bool testChessImportGamesParallel(){
+    const char* path = "chessImportGamesParallel.tmp";
+    FILE* log = fopen(path, "w");
+    ASSERT_TEST(log != NULL);
+    for (int game = 0; game < 600; game++) {
+        int tournament = 1 + game % 7;
+        fprintf(log, "%d %d %d %d %d\n", tournament, 1 + game % 13, 1 + (game * 5 + 3) % 17, game % 3,
+                (game % 11 == 0) ? -1 : game);
+    }
+    fprintf(log, "9 1 2 0 10\nbad line\n");
+    fclose(log);
+
+    ChessSystem sequential = chessCreate();
+    ChessSystem parallel = chessCreate();
+    for (int tournament = 1; tournament <= 7; tournament++) {
+        ASSERT_TEST(chessAddTournament(sequential, tournament, 5, "London") == CHESS_SUCCESS);
+        ASSERT_TEST(chessAddTournament(parallel, tournament, 5, "London") == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessAddGame(sequential, 3, 1, 2, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(parallel, 3, 1, 2, DRAW, 100) == CHESS_SUCCESS);
+
+    ChessImportError sequential_errors[600];
+    ChessImportError parallel_errors[600];
+    ChessImportStats sequential_stats = {sequential_errors, 600, 0, 0, 0};
+    ChessImportStats parallel_stats = {parallel_errors, 600, 0, 0, 0};
+    ASSERT_TEST(chessImportGames(sequential, path, &sequential_stats) == CHESS_SUCCESS);
+    ASSERT_TEST(chessImportGamesParallel(parallel, path, &parallel_stats, 4) == CHESS_SUCCESS);
+    remove(path);
+
+    ASSERT_TEST(sequential_stats.lines_read == parallel_stats.lines_read);
+    ASSERT_TEST(sequential_stats.games_added == parallel_stats.games_added);
+    ASSERT_TEST(sequential_stats.number_of_errors == parallel_stats.number_of_errors);
+    for (int error = 0; error < sequential_stats.number_of_errors && error < 600; error++) {
+        ASSERT_TEST(sequential_errors[error].line == parallel_errors[error].line);
+        ASSERT_TEST(sequential_errors[error].result == parallel_errors[error].result);
+    }
+    ASSERT_TEST(isSameLevels(sequential, parallel));
+
+    chessDestroy(sequential);
+    chessDestroy(parallel);
+    return true;
+}
+
+static bool isSameFile(const char* path1, const char* path2) {
+    FILE* file1 = fopen(path1, "r");
+    FILE* file2 = fopen(path2, "r");
+    bool same = (file1 != NULL && file2 != NULL);
+    int ch1 = 0, ch2 = 0;
+    while (same && ch1 != EOF) {
+        ch1 = fgetc(file1);
+        ch2 = fgetc(file2);
+        same = (ch1 == ch2);
+    }
+    if (file1 != NULL) {
+        fclose(file1);
+    }
+    if (file2 != NULL) {
+        fclose(file2);
+    }
+    return same;
+}
+
+bool testChessSnapshot(){
+    const char* path = "chessSnapshot.tmp";
+    ChessSystem chess = chessCreate();
+    addBulkRemovalGames(chess);
+    ASSERT_TEST(chessAddTournament(chess, 3, 2, "Haifa") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 6, DRAW, 300) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, path) == CHESS_SUCCESS);
+
+    ChessResult result = CHESS_ERROR;
+    ChessSystem loaded = chessLoadSnapshot(path, &result);
+    remove(path);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, loaded));
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessSnapshotStats1.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chessSnapshotStats2.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessSnapshotStats1.tmp", "chessSnapshotStats2.tmp"));
+    remove("chessSnapshotStats1.tmp");
+    remove("chessSnapshotStats2.tmp");
+
+    ASSERT_TEST(chessAddGame(loaded, 2, 1, 3, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessAddGame(loaded, 1, 1, 3, DRAW, 100) == CHESS_TOURNAMENT_ENDED);
+    ASSERT_TEST(chessAddGame(loaded, 2, 1, 5, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 5, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, loaded));
+
+    ASSERT_TEST(chessLoadSnapshot(path, &result) == NULL && result == CHESS_SAVE_FAILURE);
+    chessDestroy(chess);
+    chessDestroy(loaded);
+    return true;
+}
+
+bool testChessJournal(){
+    const char* journal_path = "chessJournal.tmp";
+    const char* snapshot_path = "chessJournalSnapshot.tmp";
+    remove(journal_path);
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessSyncJournal(chess) == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessAttachJournal(chess, journal_path, CHESS_JOURNAL_SYNC_GROUP, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAttachJournal(chess, journal_path, CHESS_JOURNAL_SYNC_NONE, 0) == CHESS_SAVE_FAILURE);
+    addBulkRemovalGames(chess);
+    ASSERT_TEST(chessSaveSnapshot(chess, snapshot_path) == CHESS_SUCCESS);
+
+    int players[] = {4, 9};
+    ASSERT_TEST(chessAddTournament(chess, 3, 2, "Haifa") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 6, DRAW, 300) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 7, FIRST_PLAYER, 200) == CHESS_SUCCESS);
+    ASSERT_TEST(chessUpdateGameResult(chess, 3, 1, SECOND_PLAYER, 400) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveGame(chess, 3, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 6, 7, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 6, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessMergePlayers(chess, 1, 7, NULL, 0, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayers(chess, players, 2) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSyncJournal(chess) == CHESS_SUCCESS);
+
+    ChessResult result = CHESS_ERROR;
+    int records_applied = 0;
+    ChessSystem recovered = chessRecover(snapshot_path, journal_path, &result);
+    ASSERT_TEST(recovered != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, recovered));
+    ASSERT_TEST(chessReplayJournal(recovered, journal_path, &records_applied) == CHESS_SUCCESS);
+    ASSERT_TEST(records_applied == 0);
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessJournalStats1.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(recovered, "chessJournalStats2.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessJournalStats1.tmp", "chessJournalStats2.tmp"));
+    remove("chessJournalStats1.tmp");
+    remove("chessJournalStats2.tmp");
+    chessDestroy(recovered);
+
+    // A record torn by a crash ends the journal
+    ASSERT_TEST(chessDetachJournal(chess) == CHESS_SUCCESS);
+    FILE* journal_file = fopen(journal_path, "ab");
+    ASSERT_TEST(journal_file != NULL);
+    fputs("torn", journal_file);
+    fclose(journal_file);
+    recovered = chessRecover(NULL, journal_path, &result);
+    ASSERT_TEST(recovered != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, recovered));
+
+    // Appending continues after the last complete record
+    ASSERT_TEST(chessAttachJournal(recovered, journal_path, CHESS_JOURNAL_SYNC_EVERY_OPERATION, 0) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(recovered, 3, 5, 8, FIRST_PLAYER, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 8, FIRST_PLAYER, 50) == CHESS_SUCCESS);
+    chessDestroy(recovered);
+    recovered = chessRecover(snapshot_path, journal_path, &result);
+    ASSERT_TEST(recovered != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, recovered));
+
+    ASSERT_TEST(chessRecover(snapshot_path, "chessJournalMissing.tmp", &result) == NULL);
+    ASSERT_TEST(result == CHESS_SAVE_FAILURE);
+    remove(journal_path);
+    remove(snapshot_path);
+    chessDestroy(chess);
+    chessDestroy(recovered);
+
+    // A group commit reaches the file once its interval passes, even if nothing is written after it
+    chess = chessCreate();
+    ASSERT_TEST(chessAttachJournal(chess, journal_path, CHESS_JOURNAL_SYNC_GROUP, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 1, 60, "Haifa") == CHESS_SUCCESS);
+    for (int player = 2; player <= 51; player++) {
+        ASSERT_TEST(chessAddGame(chess, 1, 1, player, FIRST_PLAYER, player) == CHESS_SUCCESS);
+    }
+    struct timespec idle = {0, 200000000};
+    nanosleep(&idle, NULL);
+    recovered = chessRecover(NULL, journal_path, &result);
+    ASSERT_TEST(recovered != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, recovered));
+    chessDestroy(recovered);
+    chessDestroy(chess);
+    remove(journal_path);
+    return true;
+}
+
+bool testChessCheckpoint(){
+    const char* paths[] = {"chessCheckpoint1.tmp", "chessCheckpoint2.tmp", "chessCheckpoint3.tmp"};
+    const char* compacted_path = "chessCheckpointCompacted.tmp";
+    ChessSystem chess = chessCreate();
+    addBulkRemovalGames(chess);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    int number_of_files = 0;
+    ASSERT_TEST(chessSaveCheckpoint(chess, paths[0], NULL, &number_of_files) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_files == 1);
+
+    // Only the changed tournament and the players are written, the ended tournament is linked
+    ASSERT_TEST(chessAddGame(chess, 2, 5, 6, DRAW, 300) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveCheckpoint(chess, paths[1], paths[0], &number_of_files) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_files == 2);
+
+    ChessResult result = CHESS_ERROR;
+    ChessSystem loaded = chessLoadCheckpoint(paths[1], &result);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, loaded));
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessCheckpointStats1.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chessCheckpointStats2.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessCheckpointStats1.tmp", "chessCheckpointStats2.tmp"));
+    chessDestroy(loaded);
+
+    // The compacted copy doesn't need the earlier files, and stands for the same checkpoint
+    ASSERT_TEST(chessCompactCheckpoint(paths[1], paths[1]) == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessCompactCheckpoint(paths[1], compacted_path) == CHESS_SUCCESS);
+    remove(paths[0]);
+    ASSERT_TEST(chessLoadCheckpoint(paths[1], &result) == NULL && result == CHESS_SAVE_FAILURE);
+    loaded = chessLoadCheckpoint(compacted_path, &result);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, loaded));
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chessCheckpointStats2.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessCheckpointStats1.tmp", "chessCheckpointStats2.tmp"));
+
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(loaded, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveCheckpoint(chess, paths[2], compacted_path, &number_of_files) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_files == 2);
+    chessDestroy(loaded);
+    loaded = chessLoadCheckpoint(paths[2], &result);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, loaded));
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessCheckpointStats1.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chessCheckpointStats2.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessCheckpointStats1.tmp", "chessCheckpointStats2.tmp"));
+
+    // A checkpoint that is not the system's latest one is not used as the previous checkpoint
+    ASSERT_TEST(chessSaveCheckpoint(loaded, paths[0], compacted_path, &number_of_files) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_files == 1);
+
+    remove("chessCheckpointStats1.tmp");
+    remove("chessCheckpointStats2.tmp");
+    for (int index = 0; index < 3; index++) {
+        remove(paths[index]);
+    }
+    remove(compacted_path);
+    chessDestroy(chess);
+    chessDestroy(loaded);
+    return true;
+}
+
+bool testChessReportFormatting(){
+    // Levels and averages of exactly x.125 and x.375 are rounded to even, as printf does
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 32, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 32, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 5) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 100, 101, FIRST_PLAYER, 6) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 100, 102, FIRST_PLAYER, 6) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 100, 103, FIRST_PLAYER, 6) == CHESS_SUCCESS);
+    for (int opponent = 3; opponent <= 33; opponent++) {
+        ASSERT_TEST(chessAddGame(chess, 1, 1, opponent, DRAW, 1) == CHESS_SUCCESS);
+    }
+    for (int opponent = 104; opponent <= 132; opponent++) {
+        ASSERT_TEST(chessAddGame(chess, 2, 100, opponent, DRAW, 2) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+
+    FILE* file_levels = fopen("chessReportLevels.tmp", "w");
+    ASSERT_TEST(chessSavePlayersLevels(chess, file_levels) == CHESS_SUCCESS);
+    fclose(file_levels);
+    file_levels = fopen("chessReportLevels.tmp", "r");
+    char line[32] = "";
+    ASSERT_TEST(fgets(line, sizeof(line), file_levels) != NULL && strcmp(line, "100 2.38\n") == 0);
+    ASSERT_TEST(fgets(line, sizeof(line), file_levels) != NULL && strcmp(line, "1 2.12\n") == 0);
+    ASSERT_TEST(fgets(line, sizeof(line), file_levels) != NULL && strcmp(line, "3 2.00\n") == 0);
+    fclose(file_levels);
+    remove("chessReportLevels.tmp");
+
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessReportStats.tmp") == CHESS_SUCCESS);
+    FILE* file_expected = fopen("chessReportExpected.tmp", "w");
+    fputs("1\n5\n1.12\nLondon\n32\n33\n100\n6\n2.38\nParis\n32\n33\n", file_expected);
+    fclose(file_expected);
+    ASSERT_TEST(isSameFile("chessReportStats.tmp", "chessReportExpected.tmp"));
+    remove("chessReportStats.tmp");
+    remove("chessReportExpected.tmp");
+    chessDestroy(chess);
+    return true;
+}
+
+/** Checks that the statistics a system saves match those of a fresh copy of it, which renders them anew */
+static bool isSameStatisticsAsLoaded(ChessSystem chess) {
+    ChessResult result = CHESS_ERROR;
+    ASSERT_TEST(chessSaveSnapshot(chess, "chessStatisticsSnapshot.tmp") == CHESS_SUCCESS);
+    ChessSystem loaded = chessLoadSnapshot("chessStatisticsSnapshot.tmp", &result);
+    remove("chessStatisticsSnapshot.tmp");
+    ASSERT_TEST(loaded != NULL);
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessStatistics1.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chessStatistics2.tmp") == CHESS_SUCCESS);
+    bool same = isSameFile("chessStatistics1.tmp", "chessStatistics2.tmp");
+    remove("chessStatistics2.tmp");
+    chessDestroy(loaded);
+    return same;
+}
+
+bool testChessStatisticsCache(){
+    ChessSystem chess = chessCreate();
+    addBulkRemovalGames(chess);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameStatisticsAsLoaded(chess));
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameStatisticsAsLoaded(chess));
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessStatisticsBefore.tmp") == CHESS_SUCCESS);
+
+    // Changes to ended tournaments drop their cached statistics
+    ASSERT_TEST(chessMergePlayers(chess, 4, 1, NULL, 0, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameStatisticsAsLoaded(chess));
+    ASSERT_TEST(isSameFile("chessStatistics1.tmp", "chessStatisticsBefore.tmp") == false);
+    ASSERT_TEST(chessRemovePlayer(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameStatisticsAsLoaded(chess));
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameStatisticsAsLoaded(chess));
+    ASSERT_TEST(chessRemoveTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessStatistics1.tmp") == CHESS_NO_TOURNAMENTS_ENDED);
+
+    remove("chessStatistics1.tmp");
+    remove("chessStatisticsBefore.tmp");
+    chessDestroy(chess);
+    return true;
+}
+
+/** Checks that a file holds exactly the given text */
+static bool isFileContent(FILE* file, const char* text, size_t length) {
+    rewind(file);
+    for (size_t index = 0; index < length; index++) {
+        if (fgetc(file) != (unsigned char) text[index]) {
+            return false;
+        }
+    }
+    return fgetc(file) == EOF;
+}
+
+bool testChessReportSinks(){
+    ChessSystem chess = chessCreate();
+    ChessReportBuffer buffer = {NULL, 0, 0};
+    ASSERT_TEST(chessSaveTournamentStatisticsToBuffer(chess, &buffer) == CHESS_NO_TOURNAMENTS_ENDED);
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(chess, NULL) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessSavePlayersLevelsToFd(chess, -1) == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessAddTournament(chess, 1, 1, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 1, "Paris") == CHESS_SUCCESS);
+    for (int player = 1; player < 600; player += 2) {
+        ASSERT_TEST(chessAddGame(chess, 1 + player / 2 % 2, player, player + 1, player % 3, player % 1000 + 1) ==
+                    CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+
+    FILE* file = tmpfile();
+    ASSERT_TEST(chessSavePlayersLevels(chess, file) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(chess, &buffer) == CHESS_SUCCESS);
+    ASSERT_TEST(buffer.length > 0 && buffer.length <= buffer.capacity);
+    ASSERT_TEST(isFileContent(file, buffer.data, buffer.length));
+    fclose(file);
+
+    file = tmpfile();
+    ASSERT_TEST(chessSavePlayersLevelsToFd(chess, fileno(file)) == CHESS_SUCCESS);
+    ASSERT_TEST(isFileContent(file, buffer.data, buffer.length));
+    fclose(file);
+
+    // Appending reports until the buffer has to grow keeps the earlier text
+    size_t levels_length = buffer.length;
+    while (buffer.length < 4 * 65536) {
+        ASSERT_TEST(chessSavePlayersLevelsToBuffer(chess, &buffer) == CHESS_SUCCESS);
+        ASSERT_TEST(memcmp(buffer.data, buffer.data + buffer.length - levels_length, levels_length) == 0);
+    }
+    buffer.length = levels_length;
+
+    // Reports are appended after the text already in the buffer
+    ASSERT_TEST(chessSaveTournamentStatisticsToBuffer(chess, &buffer) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessReportSinks.tmp") == CHESS_SUCCESS);
+    file = fopen("chessReportSinks.tmp", "r");
+    ASSERT_TEST(isFileContent(file, buffer.data + levels_length, buffer.length - levels_length));
+    fclose(file);
+    file = tmpfile();
+    ASSERT_TEST(chessSaveTournamentStatisticsToFd(chess, fileno(file)) == CHESS_SUCCESS);
+    ASSERT_TEST(isFileContent(file, buffer.data + levels_length, buffer.length - levels_length));
+    fclose(file);
+
+    remove("chessReportSinks.tmp");
+    free(buffer.data);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testChessLevelsFormats(){
+    ChessSystem chess = chessCreate();
+    addBulkRemovalGames(chess);
+    ASSERT_TEST(chessAddGame(chess, 2, 5, 6, DRAW, 300) == CHESS_SUCCESS);
+    FILE* text = tmpfile();
+    FILE* binary = tmpfile();
+    FILE* json = tmpfile();
+    ASSERT_TEST(chessSavePlayersLevelsEx(chess, text, (ChessLevelsFormat) 7) == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessSavePlayersLevelsEx(chess, text, CHESS_LEVELS_TEXT) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSavePlayersLevelsEx(chess, binary, CHESS_LEVELS_BINARY) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSavePlayersLevelsEx(chess, json, CHESS_LEVELS_JSON_LINES) == CHESS_SUCCESS);
+    rewind(text);
+    rewind(binary);
+    rewind(json);
+
+    ChessLevelsHeader header;
+    ASSERT_TEST(fread(&header, sizeof(header), 1, binary) == 1);
+    ASSERT_TEST(memcmp(header.magic, CHESS_LEVELS_BINARY_MAGIC, CHESS_LEVELS_BINARY_MAGIC_SIZE) == 0);
+    ASSERT_TEST(header.version == CHESS_LEVELS_BINARY_VERSION && header.record_size == sizeof(ChessLevelRecord));
+    ASSERT_TEST(header.number_of_records == 6);
+
+    // Every format holds the players of the text report, in its order
+    int player_id = 0, whole = 0, hundredths = 0;
+    char line[64], expected[64];
+    for (uint32_t index = 0; index < header.number_of_records; index++) {
+        ASSERT_TEST(fgets(line, sizeof(line), text) != NULL);
+        ASSERT_TEST(sscanf(line, "%d %d.%d", &player_id, &whole, &hundredths) == 3);
+        int level = (line[strcspn(line, " ") + 1] == '-') ? whole * 100 - hundredths : whole * 100 + hundredths;
+        ChessLevelRecord record;
+        ASSERT_TEST(fread(&record, sizeof(record), 1, binary) == 1);
+        ASSERT_TEST(record.player_id == player_id && record.level == level);
+
+        line[strlen(line) - 1] = '\0';
+        snprintf(expected, sizeof(expected), "{\"id\":%d,\"level\":%s}\n", player_id, line + strcspn(line, " ") + 1);
+        ASSERT_TEST(fgets(line, sizeof(line), json) != NULL && strcmp(line, expected) == 0);
+    }
+    ASSERT_TEST(fgetc(text) == EOF && fgetc(binary) == EOF && fgetc(json) == EOF);
+
+    fclose(text);
+    fclose(binary);
+    fclose(json);
+    chessDestroy(chess);
+    return true;
+}
+
+static long getFileSize(const char* path) {
+    FILE* file = fopen(path, "rb");
+    long size = -1;
+    if (file != NULL && fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+    return size;
+}
+
+bool testChessCompression(){
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 1, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 1, "Paris") == CHESS_SUCCESS);
+    for (int player = 1; player < 600; player += 2) {
+        ASSERT_TEST(chessAddGame(chess, 1 + player / 2 % 2, player, player + 1, player % 3, player % 1000 + 1) ==
+                    CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+
+    // A compressed snapshot loads the same system, and decompresses to the plain snapshot
+    ASSERT_TEST(chessSaveSnapshot(chess, "chessPlain.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshotCompressed(chess, "chessCompressed.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(getFileSize("chessCompressed.tmp") * 3 < getFileSize("chessPlain.tmp"));
+    ChessResult result = CHESS_ERROR;
+    ChessSystem loaded = chessLoadSnapshot("chessCompressed.tmp", &result);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameLevels(chess, loaded));
+    ASSERT_TEST(chessDecompressFile("chessCompressed.tmp", "chessDecompressed.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessPlain.tmp", "chessDecompressed.tmp"));
+    ASSERT_TEST(chessDecompressFile("chessPlain.tmp", "chessDecompressed.tmp") == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(getFileSize("chessDecompressed.tmp") == -1);
+
+    // A truncated compressed snapshot is rejected
+    FILE* compressed = fopen("chessCompressed.tmp", "rb");
+    FILE* truncated = fopen("chessTruncated.tmp", "wb");
+    long truncated_size = getFileSize("chessCompressed.tmp") - 1;
+    for (long index = 0; index < truncated_size; index++) {
+        fputc(fgetc(compressed), truncated);
+    }
+    fclose(compressed);
+    fclose(truncated);
+    ASSERT_TEST(chessLoadSnapshot("chessTruncated.tmp", &result) == NULL && result == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessDecompressFile("chessTruncated.tmp", "chessDecompressed.tmp") == CHESS_SAVE_FAILURE);
+
+    // Reports compressed into the same file decompress one after the other
+    ChessReportBuffer buffer = {NULL, 0, 0};
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(chess, &buffer) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(loaded, &buffer) == CHESS_SUCCESS);
+    compressed = fopen("chessCompressed.tmp", "wb");
+    ASSERT_TEST(chessSavePlayersLevelsCompressed(chess, compressed, CHESS_LEVELS_TEXT) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSavePlayersLevelsCompressed(loaded, compressed, CHESS_LEVELS_TEXT) == CHESS_SUCCESS);
+    fclose(compressed);
+    ASSERT_TEST(getFileSize("chessCompressed.tmp") * 2 < (long) buffer.length);
+    ASSERT_TEST(chessDecompressFile("chessCompressed.tmp", "chessDecompressed.tmp") == CHESS_SUCCESS);
+    FILE* decompressed = fopen("chessDecompressed.tmp", "rb");
+    ASSERT_TEST(isFileContent(decompressed, buffer.data, buffer.length));
+    fclose(decompressed);
+
+    remove("chessPlain.tmp");
+    remove("chessCompressed.tmp");
+    remove("chessTruncated.tmp");
+    remove("chessDecompressed.tmp");
+    free(buffer.data);
+    chessDestroy(chess);
+    chessDestroy(loaded);
+    return true;
+}
+
+bool testChessReadOnly(){
+    const char* path = "chessReadOnly.tmp";
+    ChessSystem chess = chessCreate();
+    addBulkRemovalGames(chess);
+    ASSERT_TEST(chessAddTournament(chess, 3, 2, "Haifa") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 5, 6, DRAW, 300) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, path) == CHESS_SUCCESS);
+
+    ChessResult result = CHESS_ERROR;
+    ChessReadOnly read_only = chessOpenReadOnly(path, &result);
+    ASSERT_TEST(read_only != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessReadOnlySaveTournamentStatistics(read_only, "chessReadOnlyStats1.tmp") ==
+                CHESS_NO_TOURNAMENTS_ENDED);
+    chessCloseReadOnly(read_only);
+
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, path) == CHESS_SUCCESS);
+    read_only = chessOpenReadOnly(path, &result);
+    ASSERT_TEST(read_only != NULL && result == CHESS_SUCCESS);
+
+    // Queries answer as the chess system the snapshot was saved from
+    ChessResult read_only_result = CHESS_ERROR;
+    for (int player_id = -1; player_id <= 8; player_id++) {
+        double average = chessCalculateAveragePlayTime(chess, player_id, &result);
+        ASSERT_TEST(chessReadOnlyCalculateAveragePlayTime(read_only, player_id, &read_only_result) == average);
+        ASSERT_TEST(read_only_result == result);
+    }
+    FILE* levels = fopen("chessReadOnlyLevels1.tmp", "w");
+    ASSERT_TEST(chessSavePlayersLevels(chess, levels) == CHESS_SUCCESS);
+    fclose(levels);
+    levels = fopen("chessReadOnlyLevels2.tmp", "w");
+    ASSERT_TEST(chessReadOnlySavePlayersLevels(read_only, levels) == CHESS_SUCCESS);
+    fclose(levels);
+    ASSERT_TEST(isSameFile("chessReadOnlyLevels1.tmp", "chessReadOnlyLevels2.tmp"));
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chessReadOnlyStats1.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(chessReadOnlySaveTournamentStatistics(read_only, "chessReadOnlyStats2.tmp") == CHESS_SUCCESS);
+    ASSERT_TEST(isSameFile("chessReadOnlyStats1.tmp", "chessReadOnlyStats2.tmp"));
+
+    // Replacing the snapshot leaves the open one as it was
+    double average = chessCalculateAveragePlayTime(chess, 1, &result);
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 5, DRAW, 1000) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, path) == CHESS_SUCCESS);
+    ASSERT_TEST(chessReadOnlyCalculateAveragePlayTime(read_only, 1, &result) == average);
+    chessCloseReadOnly(read_only);
+
+    ASSERT_TEST(chessSaveSnapshotCompressed(chess, path) == CHESS_SUCCESS);
+    ASSERT_TEST(chessOpenReadOnly(path, &result) == NULL && result == CHESS_SAVE_FAILURE);
+    remove(path);
+    ASSERT_TEST(chessOpenReadOnly(path, &result) == NULL && result == CHESS_SAVE_FAILURE);
+    remove("chessReadOnlyLevels1.tmp");
+    remove("chessReadOnlyLevels2.tmp");
+    remove("chessReadOnlyStats1.tmp");
+    remove("chessReadOnlyStats2.tmp");
+    chessDestroy(chess);
+    return true;
+}
+
+static bool isLevelsDelta(ChessSystem chess, long long since_token, const char* expected, long long* new_token) {
+    FILE* file = fopen("chessDelta.tmp", "w+");
+    bool result = file != NULL && chessSavePlayersLevelsDelta(chess, file, since_token, new_token) == CHESS_SUCCESS &&
+                  fflush(file) == 0 && isFileContent(file, expected, strlen(expected));
+    if (file != NULL) {
+        fclose(file);
+    }
+    remove("chessDelta.tmp");
+    return result;
+}
+
+bool testChessLevelsDelta(){
+    ChessSystem chess = chessCreate();
+    long long token = -1;
+    ASSERT_TEST(isLevelsDelta(chess, 0, "", &token) && token == 0);
+    ASSERT_TEST(chessAddTournament(chess, 1, 2, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 2, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 4, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 5, 6, SECOND_PLAYER, 100) == CHESS_SUCCESS);
+
+    // The first delta holds every player, and nothing changed right after it
+    long long full_token = -1;
+    ASSERT_TEST(isLevelsDelta(chess, 0, "1 6.00\n2 -10.00\n3 2.00\n4 2.00\n5 -10.00\n6 6.00\n", &full_token));
+    ASSERT_TEST(full_token > 0);
+    ASSERT_TEST(isLevelsDelta(chess, full_token, "", &token) && token == full_token);
+
+    // Only the players of a new game change
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 3, SECOND_PLAYER, 50) == CHESS_SUCCESS);
+    long long game_token = -1;
+    ASSERT_TEST(isLevelsDelta(chess, full_token, "1 -2.00\n3 4.00\n", &game_token) && game_token > full_token);
+
+    // A removed player is written as removed, and its opponent gets a technical win
+    ASSERT_TEST(chessRemovePlayer(chess, 4) == CHESS_SUCCESS);
+    long long removal_token = -1;
+    ASSERT_TEST(isLevelsDelta(chess, game_token, "3 6.00\n4 -\n", &removal_token));
+
+    // An updated game, and players left without play time
+    ASSERT_TEST(chessUpdateGameResult(chess, 2, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveGame(chess, 2, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(isLevelsDelta(chess, removal_token, "1 6.00\n3 -2.00\n5 -\n6 -\n", &token));
+
+    // A removed player which is added back is written once, and older tokens are still valid
+    ASSERT_TEST(chessAddGame(chess, 1, 4, 2, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(isLevelsDelta(chess, game_token, "1 6.00\n2 -4.00\n3 -2.00\n4 2.00\n5 -\n6 -\n", &token));
+
+    // A merged player is removed, and the player it is merged into changes
+    ASSERT_TEST(chessAddGame(chess, 2, 7, 8, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    long long merge_token = -1;
+    ASSERT_TEST(isLevelsDelta(chess, token, "7 6.00\n8 -10.00\n", &merge_token));
+    ASSERT_TEST(chessMergePlayers(chess, 4, 7, NULL, 0, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(isLevelsDelta(chess, merge_token, "4 4.00\n7 -\n", &token) && token > merge_token);
+
+    // Tokens the system didn't return are refused
+    FILE* file = fopen("chessDelta.tmp", "w");
+    ASSERT_TEST(chessSavePlayersLevelsDelta(chess, file, token + 1, &token) == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessSavePlayersLevelsDelta(chess, file, -1, &token) == CHESS_SAVE_FAILURE);
+    ASSERT_TEST(chessSavePlayersLevelsDelta(chess, file, 0, NULL) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessSavePlayersLevelsDelta(NULL, file, 0, &token) == CHESS_NULL_ARGUMENT);
+    fclose(file);
+    remove("chessDelta.tmp");
+    chessDestroy(chess);
+
+    // Tokens older than the removals which were forgotten get every player again
+    chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 1, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 1, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    long long old_token = -1;
+    ASSERT_TEST(isLevelsDelta(chess, 0, "1 6.00\n2 -10.00\n", &old_token));
+    int removed_players[1200];
+    for (int index = 0; index < 1200; index += 2) {
+        removed_players[index] = index + 10;
+        removed_players[index + 1] = index + 11;
+        ASSERT_TEST(chessAddGame(chess, 2, index + 10, index + 11, DRAW, 100) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessRemovePlayers(chess, removed_players, 1200) == CHESS_SUCCESS);
+    ASSERT_TEST(isLevelsDelta(chess, old_token, "*\n1 6.00\n2 -10.00\n", &token) && token > old_token);
+    ASSERT_TEST(isLevelsDelta(chess, token, "", &token));
+    ASSERT_TEST(chessRemovePlayer(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(isLevelsDelta(chess, token, "1 6.00\n2 -\n", &token));
+    chessDestroy(chess);
+    return true;
+}
+
+bool testChessExportSession(){
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 10, "Paris") == CHESS_SUCCESS);
+    for (int player = 1; player < 3000; player += 2) {
+        ASSERT_TEST(chessAddGame(chess, 1 + player / 2 % 2, player, player + 1, player % 3, player % 100 + 1) ==
+                    CHESS_SUCCESS);
+    }
+    for (int player = 1; player < 3000; player += 7) {
+        ASSERT_TEST(chessAddGame(chess, 2, player, 3000 - player, (player / 7) % 3, 10) == CHESS_SUCCESS);
+    }
+    ChessResult result = CHESS_ERROR;
+    FILE* levels = fopen("chessExportLevels.tmp", "w+");
+    FILE* statistics = fopen("chessExportStats.tmp", "w+");
+    ASSERT_TEST(chessExportBegin(chess, levels, statistics, &result) == NULL && result == CHESS_NO_TOURNAMENTS_ENDED);
+    ASSERT_TEST(chessExportBegin(chess, NULL, NULL, &result) == NULL && result == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+
+    ChessReportBuffer expected_levels = {NULL, 0, 0};
+    ChessReportBuffer expected_statistics = {NULL, 0, 0};
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(chess, &expected_levels) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatisticsToBuffer(chess, &expected_statistics) == CHESS_SUCCESS);
+    ChessExportSession session = chessExportBegin(chess, levels, statistics, &result);
+    ASSERT_TEST(session != NULL && result == CHESS_SUCCESS);
+
+    // Changes made between chunks don't appear in the export, even if the system is destroyed
+    bool done = false;
+    int steps = 0;
+    while (done == false) {
+        ASSERT_TEST(chessExportStep(session, 100, &done) == CHESS_SUCCESS);
+        if (steps == 3) {
+            ASSERT_TEST(chessAddTournament(chess, 3, 1, "Haifa") == CHESS_SUCCESS);
+            ASSERT_TEST(chessAddGame(chess, 3, 1, 2, FIRST_PLAYER, 50) == CHESS_SUCCESS);
+            ASSERT_TEST(chessEndTournament(chess, 3) == CHESS_SUCCESS);
+            ASSERT_TEST(chessRemovePlayer(chess, 7) == CHESS_SUCCESS);
+        }
+        if (steps == 50) {
+            chessDestroy(chess);
+            chess = NULL;
+        }
+        steps++;
+    }
+    ASSERT_TEST(steps > 60);
+    ASSERT_TEST(chessExportStep(session, 100, &done) == CHESS_SUCCESS && done == true);
+    ASSERT_TEST(chessExportEnd(session) == CHESS_SUCCESS);
+    ASSERT_TEST(isFileContent(levels, expected_levels.data, expected_levels.length));
+    ASSERT_TEST(isFileContent(statistics, expected_statistics.data, expected_statistics.length));
+    ASSERT_TEST(chessExportStep(NULL, 1, &done) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessExportEnd(NULL) == CHESS_NULL_ARGUMENT);
+
+    fclose(levels);
+    fclose(statistics);
+    remove("chessExportLevels.tmp");
+    remove("chessExportStats.tmp");
+    free(expected_levels.data);
+    free(expected_statistics.data);
+    chessDestroy(chess);
+    return true;
+}
+
+static bool addSpillGames(ChessSystem chess) {
+    for (int tournament = 1; tournament <= 6; tournament++) {
+        ASSERT_TEST(chessAddTournament(chess, tournament, 10, "Jerusalem") == CHESS_SUCCESS);
+        for (int game = 0; game < 12; game++) {
+            ASSERT_TEST(chessAddGame(chess, tournament, 1 + game, 13 + (game * 5 + tournament) % 12,
+                                     (game + tournament) % 3, 10 + game * 7 + tournament) == CHESS_SUCCESS);
+        }
+        if (tournament < 6) {
+            ASSERT_TEST(chessEndTournament(chess, tournament) == CHESS_SUCCESS);
+        }
+    }
+    return true;
+}
+
+static bool isSameSystem(ChessSystem chess1, ChessSystem chess2) {
+    ChessReportBuffer statistics1 = {NULL, 0, 0}, statistics2 = {NULL, 0, 0};
+    bool same = chessSaveTournamentStatisticsToBuffer(chess1, &statistics1) == CHESS_SUCCESS &&
+                chessSaveTournamentStatisticsToBuffer(chess2, &statistics2) == CHESS_SUCCESS &&
+                statistics1.length == statistics2.length &&
+                memcmp(statistics1.data, statistics2.data, statistics1.length) == 0 &&
+                isSameLevels(chess1, chess2) &&
+                chessSaveSnapshot(chess1, "chessSpillSnapshot1.tmp") == CHESS_SUCCESS &&
+                chessSaveSnapshot(chess2, "chessSpillSnapshot2.tmp") == CHESS_SUCCESS &&
+                isSameFile("chessSpillSnapshot1.tmp", "chessSpillSnapshot2.tmp");
+    free(statistics1.data);
+    free(statistics2.data);
+    remove("chessSpillSnapshot1.tmp");
+    remove("chessSpillSnapshot2.tmp");
+    return same;
+}
+
+bool testChessSpill(){
+    ChessSystem chess = chessCreate();
+    ChessSystem resident = chessCreate();
+    ASSERT_TEST(addSpillGames(chess) && addSpillGames(resident));
+    ASSERT_TEST(chessEnableSpill(chess, NULL, 2) == CHESS_NULL_ARGUMENT);
+
+    // Ended tournaments leave memory, and read back the same
+    size_t memory_before = 0, memory_after = 0;
+    ASSERT_TEST(chessGetMemoryUsage(chess, &memory_before, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEnableSpill(chess, "chessSpill.tmp", 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetMemoryUsage(chess, &memory_after, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(memory_after < memory_before && getFileSize("chessSpill.tmp") > 0);
+    ASSERT_TEST(isSameSystem(chess, resident));
+    ASSERT_TEST(chessGetMemoryUsage(chess, &memory_before, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 6) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(resident, 6) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetMemoryUsage(chess, &memory_after, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(memory_after < memory_before);
+
+    // Spilled tournaments change as resident ones do
+    ASSERT_TEST(chessAddTournament(chess, 7, 1, "Eilat") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(resident, 7, 1, "Eilat") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 7, 50, 51, DRAW, 30) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(resident, 7, 50, 51, DRAW, 30) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 7) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(resident, 7) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(resident, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 13) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(resident, 13) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameSystem(chess, resident));
+
+    // A parallel import refuses the games of spilled tournaments, as a sequential one does
+    FILE* log = fopen("chessSpillImport.tmp", "w");
+    ASSERT_TEST(log != NULL);
+    for (int game = 0; game < 90; game++) {
+        fprintf(log, "%d %d %d %d %d\n", 1 + game % 9, 60 + game % 11, 80 + (game * 3) % 13, game % 3, game);
+    }
+    fclose(log);
+    ASSERT_TEST(chessAddTournament(chess, 8, 10, "Haifa") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(resident, 8, 10, "Haifa") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 9, 10, "Acre") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(resident, 9, 10, "Acre") == CHESS_SUCCESS);
+    ChessImportError spilled_errors[90];
+    ChessImportError resident_errors[90];
+    ChessImportStats spilled_stats = {spilled_errors, 90, 0, 0, 0};
+    ChessImportStats resident_stats = {resident_errors, 90, 0, 0, 0};
+    ASSERT_TEST(chessImportGamesParallel(chess, "chessSpillImport.tmp", &spilled_stats, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessImportGames(resident, "chessSpillImport.tmp", &resident_stats) == CHESS_SUCCESS);
+    remove("chessSpillImport.tmp");
+    ASSERT_TEST(spilled_stats.games_added == resident_stats.games_added && spilled_stats.games_added > 0);
+    ASSERT_TEST(spilled_stats.number_of_errors == resident_stats.number_of_errors);
+    ASSERT_TEST(spilled_errors[0].result == CHESS_TOURNAMENT_ENDED);
+    ASSERT_TEST(resident_errors[0].result == CHESS_TOURNAMENT_ENDED);
+    ASSERT_TEST(isSameSystem(chess, resident));
+    ASSERT_TEST(chessMergePlayers(chess, 1, 2, NULL, 0, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(chessMergePlayers(resident, 1, 2, NULL, 0, NULL) == CHESS_SUCCESS);
+    int player_ids[] = {3, 15, 99};
+    ASSERT_TEST(chessRemovePlayers(chess, player_ids, 3) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessRemovePlayers(resident, player_ids, 3) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessRemoveTournament(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournament(resident, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(isSameSystem(chess, resident));
+    ASSERT_TEST(chessEnableSpill(chess, "chessSpillIgnored.tmp", 1) == CHESS_SUCCESS);
+    ASSERT_TEST(getFileSize("chessSpillIgnored.tmp") == -1);
+    ASSERT_TEST(isSameSystem(chess, resident));
+
+    // A snapshot of a spilled system loads as a resident one
+    ChessResult result = CHESS_ERROR;
+    ASSERT_TEST(chessSaveSnapshot(chess, "chessSpillSnapshot.tmp") == CHESS_SUCCESS);
+    ChessSystem loaded = chessLoadSnapshot("chessSpillSnapshot.tmp", &result);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(isSameSystem(loaded, resident));
+    remove("chessSpillSnapshot.tmp");
+
+    chessDestroy(chess);
+    ASSERT_TEST(getFileSize("chessSpill.tmp") == -1);
+    chessDestroy(resident);
+    chessDestroy(loaded);
+    return true;
+}
+
+static bool isScanTotal(ChessSystem chess, const ChessGameFilter* filter, int games, int draws,
+                        long long total_play_time, int longest_play_time) {
+    int number_of_groups = 0;
+    ChessResult result = CHESS_ERROR;
+    ChessGameAggregate* groups = chessScanGames(chess, filter, CHESS_GROUP_NONE, &number_of_groups, &result);
+    bool is_total = groups != NULL && result == CHESS_SUCCESS && number_of_groups == 1 && groups[0].key == 0 &&
+                    groups[0].games == games && groups[0].draws == draws &&
+                    groups[0].total_play_time == total_play_time && groups[0].longest_play_time == longest_play_time;
+    free(groups);
+    return is_total;
+}
+
+bool testChessScanGames(){
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 200, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, DRAW, 20) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, SECOND_PLAYER, 30) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 4, DRAW, 40) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 4, 5, FIRST_PLAYER, 50) == CHESS_SUCCESS);
+
+    ChessResult result = CHESS_ERROR;
+    int number_of_groups = 0;
+    ChessGameFilter filter = {0, -1, false, DRAW, 0, 0};
+    ASSERT_TEST(chessScanGames(chess, &filter, CHESS_GROUP_NONE, &number_of_groups, &result) == NULL);
+    ASSERT_TEST(result == CHESS_INVALID_ID);
+    ASSERT_TEST(chessScanGames(NULL, NULL, CHESS_GROUP_NONE, &number_of_groups, &result) == NULL);
+    ASSERT_TEST(result == CHESS_NULL_ARGUMENT);
+
+    // The first scan builds the archive
+    size_t memory_before = 0, memory_after = 0;
+    ASSERT_TEST(chessGetMemoryUsage(chess, &memory_before, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(isScanTotal(chess, NULL, 5, 2, 150, 50));
+    ASSERT_TEST(chessGetMemoryUsage(chess, &memory_after, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(memory_after > memory_before);
+
+    ChessGameAggregate* groups = chessScanGames(chess, NULL, CHESS_GROUP_BY_TOURNAMENT, &number_of_groups, &result);
+    ASSERT_TEST(groups != NULL && result == CHESS_SUCCESS && number_of_groups == 2);
+    ASSERT_TEST(groups[0].key == 1 && strcmp(groups[0].location, "London") == 0 && groups[0].games == 3 &&
+                groups[0].draws == 1 && groups[0].total_play_time == 60 && groups[0].longest_play_time == 30);
+    ASSERT_TEST(groups[1].key == 2 && strcmp(groups[1].location, "Paris") == 0 && groups[1].games == 2 &&
+                groups[1].draws == 1 && groups[1].total_play_time == 90 && groups[1].longest_play_time == 50);
+    free(groups);
+
+    ChessGameFilter player_filter = {0, 1, false, DRAW, 0, 0};
+    groups = chessScanGames(chess, &player_filter, CHESS_GROUP_BY_PLAYER, &number_of_groups, &result);
+    ASSERT_TEST(groups != NULL && result == CHESS_SUCCESS && number_of_groups == 4);
+    ASSERT_TEST(groups[0].key == 1 && groups[0].location == NULL && groups[0].games == 3 &&
+                groups[0].total_play_time == 70);
+    ASSERT_TEST(groups[3].key == 4 && groups[3].games == 1 && groups[3].draws == 1);
+    free(groups);
+    ChessGameFilter draw_filter = {0, 0, true, DRAW, 25, 0};
+    ASSERT_TEST(isScanTotal(chess, &draw_filter, 1, 1, 40, 40));
+    ChessGameFilter time_filter = {1, 0, false, DRAW, 15, 30};
+    ASSERT_TEST(isScanTotal(chess, &time_filter, 2, 1, 50, 30));
+
+    // Changes to the games are kept in sync
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 1, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(isScanTotal(chess, NULL, 5, 3, 240, 100));
+    ASSERT_TEST(chessRemoveGame(chess, 2, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(isScanTotal(chess, NULL, 4, 3, 190, 100));
+    ASSERT_TEST(chessRemovePlayer(chess, 3) == CHESS_SUCCESS);
+    ChessGameFilter removed_filter = {0, 3, false, DRAW, 0, 0};
+    ASSERT_TEST(isScanTotal(chess, &removed_filter, 0, 0, 0, 0));
+    ASSERT_TEST(isScanTotal(chess, NULL, 4, 2, 190, 100));
+    ASSERT_TEST(chessAddGame(chess, 1, 6, 5, FIRST_PLAYER, 5) == CHESS_SUCCESS);
+    ASSERT_TEST(chessMergePlayers(chess, 2, 6, NULL, 0, NULL) == CHESS_SUCCESS);
+    ChessGameFilter merged_filter = {0, 2, false, DRAW, 0, 0};
+    ASSERT_TEST(isScanTotal(chess, &merged_filter, 3, 1, 135, 100));
+    ASSERT_TEST(chessRemoveTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(isScanTotal(chess, NULL, 4, 1, 155, 100));
+
+    // Dead rows of removed games are dropped, and games of a tournament added again get rows again
+    ASSERT_TEST(chessAddTournament(chess, 3, 200, "Rome") == CHESS_SUCCESS);
+    for (int player = 101; player <= 200; player++)
+    {
+        ASSERT_TEST(chessAddGame(chess, 3, 100, player, SECOND_PLAYER, 1) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(isScanTotal(chess, NULL, 104, 1, 255, 100));
+    ASSERT_TEST(chessRemoveTournament(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 3, 200, "Rome") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 100, 101, DRAW, 7) == CHESS_SUCCESS);
+    ASSERT_TEST(isScanTotal(chess, NULL, 5, 2, 162, 100));
+    groups = chessScanGames(chess, NULL, CHESS_GROUP_BY_TOURNAMENT, &number_of_groups, &result);
+    ASSERT_TEST(groups != NULL && number_of_groups == 2 && groups[1].key == 3 && groups[1].games == 1);
+    free(groups);
+
+    chessDestroy(chess);
+    return true;
+}
+
+typedef struct change_collector_t {
+    ChessChangeEvent events[64];
+    int number_of_events;
+    int number_of_batches;
+} ChangeCollector;
+
+static void collectChanges(const ChessChangeEvent* events, int number_of_events, void* context) {
+    ChangeCollector* collector = context;
+    for (int index = 0; index < number_of_events && collector->number_of_events < 64; index++) {
+        collector->events[collector->number_of_events++] = events[index];
+    }
+    collector->number_of_batches++;
+}
+
+typedef struct reentrant_subscriber_t {
+    ChessSystem chess;
+    int number_of_events;
+    long long last_sequence_read;
+} ReentrantSubscriber;
+
+/* Adds a tournament for every added game, then reads the latest events - both lock the system */
+static void addTournamentOnChange(const ChessChangeEvent* events, int number_of_events, void* context) {
+    ReentrantSubscriber* subscriber = context;
+    subscriber->number_of_events += number_of_events;
+    for (int index = 0; index < number_of_events; index++) {
+        if (events[index].type == CHESS_CHANGE_GAME_ADDED) {
+            chessAddTournament(subscriber->chess, 100 + events[index].game_id, 4, "Oslo");
+        }
+    }
+    ChessChangeEvent latest[8];
+    int number_of_latest = 0;
+    if (chessReadChanges(subscriber->chess, subscriber->last_sequence_read, latest, 8, &number_of_latest) ==
+        CHESS_SUCCESS && number_of_latest > 0) {
+        subscriber->last_sequence_read = latest[number_of_latest - 1].sequence;
+    }
+}
+
+bool testChessChangeFeed(){
+    ChessSystem chess = chessCreate();
+    ChessChangeEvent events[32];
+    int number_of_events = -1;
+    ASSERT_TEST(chessReadChanges(chess, 0, events, 32, &number_of_events) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_events == 0);
+    ASSERT_TEST(chessReadChanges(chess, 0, NULL, 32, &number_of_events) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessSubscribeChanges(chess, NULL, NULL) == CHESS_NULL_ARGUMENT);
+
+    // Subscribers are handed the events in batches
+    ChangeCollector collector = {.number_of_events = 0, .number_of_batches = 0};
+    ASSERT_TEST(chessEnableChangeFeed(chess, 16, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSubscribeChanges(chess, collectChanges, &collector) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 20) == CHESS_SUCCESS);
+    ASSERT_TEST(collector.number_of_events == 0);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, SECOND_PLAYER, 30) == CHESS_SUCCESS);
+    ASSERT_TEST(collector.number_of_events == 4 && collector.number_of_batches == 1);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 4, DRAW, 5) == CHESS_SUCCESS);
+    ASSERT_TEST(chessFlushChanges(chess) == CHESS_SUCCESS);
+    ASSERT_TEST(collector.number_of_events == 5 && collector.number_of_batches == 2);
+    ChessChangeEvent* added = &collector.events[4];
+    ASSERT_TEST(added->sequence == 5 && added->type == CHESS_CHANGE_GAME_ADDED && added->tournament_id == 1 &&
+                added->game_id == 4 && added->first_player == 3 && added->second_player == 4 &&
+                added->winner == DRAW && added->play_time == 5);
+
+    ASSERT_TEST(chessRemovePlayer(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 4, FIRST_PLAYER, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveGame(chess, 1, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessFlushChanges(chess) == CHESS_SUCCESS);
+    ChessChangeType types[] = {CHESS_CHANGE_TOURNAMENT_ADDED, CHESS_CHANGE_GAME_ADDED, CHESS_CHANGE_GAME_ADDED,
+                               CHESS_CHANGE_GAME_ADDED, CHESS_CHANGE_GAME_ADDED, CHESS_CHANGE_GAME_CHANGED,
+                               CHESS_CHANGE_GAME_CHANGED, CHESS_CHANGE_PLAYER_REMOVED, CHESS_CHANGE_GAME_CHANGED,
+                               CHESS_CHANGE_GAME_REMOVED, CHESS_CHANGE_TOURNAMENT_ENDED,
+                               CHESS_CHANGE_TOURNAMENT_REMOVED};
+    ASSERT_TEST(collector.number_of_events == 12);
+    for (int index = 0; index < 12; index++) {
+        ASSERT_TEST(collector.events[index].sequence == index + 1 && collector.events[index].type == types[index]);
+    }
+    ASSERT_TEST(collector.events[6].game_id == 2 && collector.events[6].first_player == -2 &&
+                collector.events[6].winner == SECOND_PLAYER);
+    ASSERT_TEST(collector.events[7].first_player == 2);
+    ASSERT_TEST(collector.events[10].tournament_id == 1 && collector.events[10].winner == 3);
+
+    // Readers find the latest events, and a gap once they fall behind
+    ASSERT_TEST(chessReadChanges(chess, 10, events, 32, &number_of_events) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_events == 2 && events[0].sequence == 11 && events[1].sequence == 12);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS);
+    for (int player = 20; player < 30; player++) {
+        ASSERT_TEST(chessAddGame(chess, 2, player, player + 20, FIRST_PLAYER, player) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessMergePlayers(chess, 41, 40, NULL, 0, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(chessReadChanges(chess, 0, events, 32, &number_of_events) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_events == 16 && events[0].sequence == 10 && events[15].sequence == 25);
+    ASSERT_TEST(events[14].type == CHESS_CHANGE_GAME_CHANGED && events[14].second_player == 41);
+    ASSERT_TEST(events[15].type == CHESS_CHANGE_PLAYERS_MERGED && events[15].first_player == 41 &&
+                events[15].second_player == 40);
+    ASSERT_TEST(chessFlushChanges(chess) == CHESS_SUCCESS);
+    ASSERT_TEST(collector.number_of_events == 25 && collector.events[24].sequence == 25);
+
+    // Unsubscribed callbacks are no longer handed events, and waiting events are handed over on destroy
+    ASSERT_TEST(chessUnsubscribeChanges(chess, collectChanges, &collector) == CHESS_SUCCESS);
+    int bulk_ids[] = {2, 2, 7};
+    ASSERT_TEST(chessRemoveTournaments(chess, bulk_ids, 3) == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(chessReadChanges(chess, 25, events, 32, &number_of_events) == CHESS_SUCCESS);
+    ASSERT_TEST(number_of_events == 1 && events[0].type == CHESS_CHANGE_TOURNAMENT_REMOVED &&
+                events[0].tournament_id == 2);
+    ChangeCollector last_collector = {.number_of_events = 0, .number_of_batches = 0};
+    ASSERT_TEST(chessSubscribeChanges(chess, collectChanges, &last_collector) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 3, 4, "Rome") == CHESS_SUCCESS);
+    chessDestroy(chess);
+    ASSERT_TEST(collector.number_of_events == 25);
+    ASSERT_TEST(last_collector.number_of_events == 1 && last_collector.events[0].sequence == 27);
+
+    // Callbacks run once the system is unlocked, so they may change it and read it
+    chess = chessCreate();
+    ReentrantSubscriber subscriber = {.chess = chess, .number_of_events = 0, .last_sequence_read = 0};
+    ASSERT_TEST(chessEnableChangeFeed(chess, 16, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSubscribeChanges(chess, addTournamentOnChange, &subscriber) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(subscriber.number_of_events == 1 && subscriber.last_sequence_read == 1);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(subscriber.number_of_events == 3 && subscriber.last_sequence_read == 3);
+    ASSERT_TEST(chessRemoveTournament(chess, 101) == CHESS_SUCCESS);
+    ASSERT_TEST(subscriber.number_of_events == 4 && subscriber.last_sequence_read == 4);
+    chessDestroy(chess);
+    return true;
+}
+
+#define CONCURRENT_TOURNAMENTS 8
+#define CONCURRENT_PLAYERS 12
+
+/* Adds the games of a single tournament, in which every pair of the players shared by all the tournaments plays */
+typedef struct concurrent_adder_t {
+    ChessSystem chess;
+    int tournament_id;
+    int failures;
+} ConcurrentAdder;
+
+static void *addTournamentGames(void *argument) {
+    ConcurrentAdder *adder = argument;
+    for (int first = 1; first <= CONCURRENT_PLAYERS; first++) {
+        for (int second = first + 1; second <= CONCURRENT_PLAYERS; second++) {
+            Winner winner = (Winner) ((first + second + adder->tournament_id) % 3);
+            int play_time = first * second + adder->tournament_id;
+            adder->failures += (chessAddGame(adder->chess, adder->tournament_id, first, second, winner,
+                                             play_time) != CHESS_SUCCESS);
+            adder->failures += (chessAddGame(adder->chess, adder->tournament_id, second, first, winner,
+                                             play_time) != CHESS_GAME_ALREADY_EXISTS);
+        }
+    }
+    return NULL;
+}
+
+bool testChessConcurrentAddGame(){
+    ChessSystem chess = chessCreate();
+    ChessSystem sequential = chessCreate();
+    ConcurrentAdder adders[CONCURRENT_TOURNAMENTS];
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        ASSERT_TEST(chessAddTournament(chess, index + 1, CONCURRENT_PLAYERS, "Tel aviv") == CHESS_SUCCESS);
+        ASSERT_TEST(chessAddTournament(sequential, index + 1, CONCURRENT_PLAYERS, "Tel aviv") == CHESS_SUCCESS);
+        adders[index].chess = chess;
+        adders[index].tournament_id = index + 1;
+        adders[index].failures = 0;
+    }
+
+    // Without the thread safe build the same games are added one tournament after the other
+#ifdef CHESS_THREAD_SAFE
+    pthread_t threads[CONCURRENT_TOURNAMENTS];
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        ASSERT_TEST(pthread_create(&threads[index], NULL, addTournamentGames, &adders[index]) == 0);
+    }
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+#else
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        addTournamentGames(&adders[index]);
+    }
+#endif
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        ASSERT_TEST(adders[index].failures == 0);
+        ConcurrentAdder sequential_adder = {sequential, index + 1, 0};
+        addTournamentGames(&sequential_adder);
+        ASSERT_TEST(sequential_adder.failures == 0);
+    }
+    size_t full_usage = 0;
+    ASSERT_TEST(chessGetMemoryUsage(sequential, &full_usage, NULL) == CHESS_SUCCESS);
+
+    for (int player = 1; player <= CONCURRENT_PLAYERS; player++) {
+        ChessResult result = CHESS_ERROR;
+        ChessResult sequential_result = CHESS_ERROR;
+        ASSERT_TEST(chessCalculateAveragePlayTime(chess, player, &result) ==
+                    chessCalculateAveragePlayTime(sequential, player, &sequential_result));
+        ASSERT_TEST(result == CHESS_SUCCESS && sequential_result == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessRemovePlayer(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(sequential, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, DRAW, 10) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 4, DRAW, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(sequential, 1, 3, 4, DRAW, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 100, 2, "Eilat") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(sequential, 100, 2, "Eilat") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 100, 3, 4, DRAW, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(sequential, 100, 3, 4, DRAW, 10) == CHESS_SUCCESS);
+    for (int index = 1; index <= CONCURRENT_TOURNAMENTS; index++) {
+        ASSERT_TEST(chessEndTournament(chess, index) == CHESS_SUCCESS);
+        ASSERT_TEST(chessEndTournament(sequential, index) == CHESS_SUCCESS);
+    }
+
+    ChessReportBuffer levels = {NULL, 0, 0};
+    ChessReportBuffer sequential_levels = {NULL, 0, 0};
+    ChessReportBuffer statistics = {NULL, 0, 0};
+    ChessReportBuffer sequential_statistics = {NULL, 0, 0};
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(chess, &levels) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSavePlayersLevelsToBuffer(sequential, &sequential_levels) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatisticsToBuffer(chess, &statistics) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveTournamentStatisticsToBuffer(sequential, &sequential_statistics) == CHESS_SUCCESS);
+    ASSERT_TEST(levels.length > 0 && levels.length == sequential_levels.length &&
+                memcmp(levels.data, sequential_levels.data, levels.length) == 0);
+    ASSERT_TEST(statistics.length > 0 && statistics.length == sequential_statistics.length &&
+                memcmp(statistics.data, sequential_statistics.data, statistics.length) == 0);
+
+    free(levels.data);
+    free(sequential_levels.data);
+    free(statistics.data);
+    free(sequential_statistics.data);
+    chessDestroy(chess);
+    chessDestroy(sequential);
+
+    // Games added at once fit in the memory budget together
+    ChessSystem budgeted = chessCreate();
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        ASSERT_TEST(chessAddTournament(budgeted, index + 1, CONCURRENT_PLAYERS, "Tel aviv") == CHESS_SUCCESS);
+        adders[index].chess = budgeted;
+        adders[index].failures = 0;
+    }
+    size_t base_usage = 0, usage = 0, budget = 0;
+    ASSERT_TEST(chessGetMemoryUsage(budgeted, &base_usage, NULL) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSetMemoryBudget(budgeted, base_usage + (full_usage - base_usage) / 2) == CHESS_SUCCESS);
+#ifdef CHESS_THREAD_SAFE
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        ASSERT_TEST(pthread_create(&threads[index], NULL, addTournamentGames, &adders[index]) == 0);
+    }
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+#else
+    for (int index = 0; index < CONCURRENT_TOURNAMENTS; index++) {
+        addTournamentGames(&adders[index]);
+    }
+#endif
+    ASSERT_TEST(chessGetMemoryUsage(budgeted, &usage, &budget) == CHESS_SUCCESS);
+    ASSERT_TEST(usage > base_usage && usage <= budget);
+    ChessResult result = chessAddGame(budgeted, 8, 1, 2, DRAW, 10);
+    ASSERT_TEST(result == CHESS_OUT_OF_MEMORY || result == CHESS_GAME_ALREADY_EXISTS);
+    chessDestroy(budgeted);
+    return true;
+}
+
+#define READER_TOURNAMENTS 4
+#define READER_OPPONENTS 40
+#define READER_PLAY_TIME 10
+#define READER_READS 2000
+
+/* Adds the games of player 1 against every opponent in a single tournament */
+static void *addPlayerOneGames(void *argument) {
+    ConcurrentAdder *adder = argument;
+    for (int opponent = 2; opponent <= READER_OPPONENTS + 1; opponent++) {
+        Winner winner = (Winner) (opponent % 3);
+        adder->failures += (chessAddGame(adder->chess, adder->tournament_id, 1, opponent, winner,
+                                         READER_PLAY_TIME) != CHESS_SUCCESS);
+    }
+    return NULL;
+}
+
+/* Reads the statistics of player 1 while games are added, which must never be torn or go back */
+static void *readPlayerOneStats(void *argument) {
+    ConcurrentAdder *reader = argument;
+    int last_games = 0;
+    for (int read = 0; read < READER_READS; read++) {
+        ChessPlayerStats stats;
+        ChessResult result = chessGetPlayerStats(reader->chess, 1, &stats);
+        if (result == CHESS_PLAYER_NOT_EXIST && last_games == 0) {
+            continue;
+        }
+        int games = stats.wins + stats.losses + stats.draws;
+        reader->failures += (result != CHESS_SUCCESS || games < last_games ||
+                             stats.total_play_time != games * READER_PLAY_TIME);
+        last_games = games;
+    }
+    return NULL;
+}
+
+bool testChessPlayerStatsReaders(){
+    ChessSystem chess = chessCreate();
+    ConcurrentAdder adders[READER_TOURNAMENTS];
+    ConcurrentAdder reader = {chess, 0, 0};
+    for (int index = 0; index < READER_TOURNAMENTS; index++) {
+        ASSERT_TEST(chessAddTournament(chess, index + 1, READER_OPPONENTS, "Haifa") == CHESS_SUCCESS);
+        adders[index].chess = chess;
+        adders[index].tournament_id = index + 1;
+        adders[index].failures = 0;
+    }
+
+#ifdef CHESS_THREAD_SAFE
+    pthread_t threads[READER_TOURNAMENTS];
+    pthread_t reader_thread;
+    ASSERT_TEST(pthread_create(&reader_thread, NULL, readPlayerOneStats, &reader) == 0);
+    for (int index = 0; index < READER_TOURNAMENTS; index++) {
+        ASSERT_TEST(pthread_create(&threads[index], NULL, addPlayerOneGames, &adders[index]) == 0);
+    }
+    for (int index = 0; index < READER_TOURNAMENTS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+    pthread_join(reader_thread, NULL);
+#else
+    for (int index = 0; index < READER_TOURNAMENTS; index++) {
+        addPlayerOneGames(&adders[index]);
+        readPlayerOneStats(&reader);
+    }
+#endif
+    ASSERT_TEST(reader.failures == 0);
+    for (int index = 0; index < READER_TOURNAMENTS; index++) {
+        ASSERT_TEST(adders[index].failures == 0);
+    }
+
+    ChessPlayerStats stats;
+    ChessResult result = CHESS_ERROR;
+    ASSERT_TEST(chessGetPlayerStats(chess, 1, &stats) == CHESS_SUCCESS);
+    ASSERT_TEST(stats.wins + stats.losses + stats.draws == READER_TOURNAMENTS * READER_OPPONENTS);
+    ASSERT_TEST(stats.total_play_time == READER_TOURNAMENTS * READER_OPPONENTS * READER_PLAY_TIME);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 1, &result) == READER_PLAY_TIME && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetPlayerStats(chess, 2, &stats) == CHESS_SUCCESS);
+    ASSERT_TEST(stats.wins == 0 && stats.losses == 0 && stats.draws == READER_TOURNAMENTS);
+    ASSERT_TEST(stats.level == 2);
+
+    // Changes which hold the whole system are seen by the next read
+    ASSERT_TEST(chessUpdateGameResult(chess, 1, 1, SECOND_PLAYER, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetPlayerStats(chess, 2, &stats) == CHESS_SUCCESS);
+    ASSERT_TEST(stats.losses == 0 && stats.wins == 1 && stats.draws == READER_TOURNAMENTS - 1);
+    ASSERT_TEST(stats.total_play_time == (READER_TOURNAMENTS - 1) * READER_PLAY_TIME + 50);
+    ASSERT_TEST(chessRemovePlayer(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetPlayerStats(chess, 2, &stats) == CHESS_PLAYER_NOT_EXIST);
+    chessCalculateAveragePlayTime(chess, 2, &result);
+    ASSERT_TEST(result == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessGetPlayerStats(chess, 0, &stats) == CHESS_INVALID_ID);
+    ASSERT_TEST(chessGetPlayerStats(chess, 1, NULL) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessGetPlayerStats(NULL, 1, &stats) == CHESS_NULL_ARGUMENT);
+
+    chessDestroy(chess);
+    return true;
+}
+
+#define ENDING_TOURNAMENTS 24
+
+static bool addEndingGames(ChessSystem chess) {
+    for (int tournament = 1; tournament <= ENDING_TOURNAMENTS; tournament++) {
+        ASSERT_TEST(chessAddTournament(chess, tournament, 10, "Netanya") == CHESS_SUCCESS);
+        for (int game = 0; game < 15 && tournament < ENDING_TOURNAMENTS; game++) {
+            ASSERT_TEST(chessAddGame(chess, tournament, 1 + (game + tournament) % 9, 10 + game,
+                                     (game * tournament) % 3, 5 + game * tournament) == CHESS_SUCCESS);
+        }
+    }
+    return chessEndTournament(chess, 2) == CHESS_SUCCESS;
+}
+
+bool testChessEndTournaments(){
+    ChessSystem chess = chessCreate();
+    ChessSystem sequential = chessCreate();
+    ASSERT_TEST(addEndingGames(chess) && addEndingGames(sequential));
+    ASSERT_TEST(chessEnableSpill(chess, "chessEndSpill1.tmp", 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEnableSpill(sequential, "chessEndSpill2.tmp", 3) == CHESS_SUCCESS);
+
+    // Every tournament, then a repeated one, an ended one, a missing one, an invalid one and one with no games
+    int tournament_ids[ENDING_TOURNAMENTS + 4];
+    ChessResult results[ENDING_TOURNAMENTS + 4];
+    for (int index = 0; index < ENDING_TOURNAMENTS; index++) {
+        tournament_ids[index] = index + 1;
+    }
+    tournament_ids[ENDING_TOURNAMENTS] = 7;
+    tournament_ids[ENDING_TOURNAMENTS + 1] = 999;
+    tournament_ids[ENDING_TOURNAMENTS + 2] = 0;
+    tournament_ids[ENDING_TOURNAMENTS + 3] = ENDING_TOURNAMENTS;
+    ASSERT_TEST(chessEndTournaments(chess, tournament_ids, ENDING_TOURNAMENTS + 4, results, 4) == CHESS_SUCCESS);
+    for (int index = 0; index < ENDING_TOURNAMENTS + 4; index++) {
+        ASSERT_TEST(results[index] == chessEndTournament(sequential, tournament_ids[index]));
+    }
+    ASSERT_TEST(results[1] == CHESS_TOURNAMENT_ENDED && results[6] == CHESS_SUCCESS);
+    ASSERT_TEST(results[ENDING_TOURNAMENTS] == CHESS_TOURNAMENT_ENDED);
+    ASSERT_TEST(results[ENDING_TOURNAMENTS + 1] == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(results[ENDING_TOURNAMENTS + 2] == CHESS_INVALID_ID);
+    ASSERT_TEST(results[ENDING_TOURNAMENTS + 3] == CHESS_NO_GAMES);
+    ASSERT_TEST(isSameSystem(chess, sequential));
+
+    ASSERT_TEST(chessEndTournaments(chess, tournament_ids, 3, results, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(results[0] == CHESS_TOURNAMENT_ENDED && results[2] == CHESS_TOURNAMENT_ENDED);
+    ASSERT_TEST(chessEndTournaments(chess, NULL, 0, NULL, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournaments(chess, tournament_ids, 1, NULL, 4) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessEndTournaments(NULL, tournament_ids, 1, results, 4) == CHESS_NULL_ARGUMENT);
+
+    chessDestroy(chess);
+    chessDestroy(sequential);
+    remove("chessEndSpill1.tmp");
+    remove("chessEndSpill2.tmp");
+    return true;
+}
+
+#define SUBMITTING_PRODUCERS 6
+#define SUBMITTED_PLAYERS 10
+
+/* Submits the games of a single tournament to a submission queue, and checks the result of each */
+typedef struct submitting_producer_t {
+    ChessSubmissionQueue queue;
+    int tournament_id;
+    int failures;
+} SubmittingProducer;
+
+static void submitUntilAccepted(ChessSubmissionQueue queue, int tournament_id, int first_player, int second_player,
+                                Winner winner, int play_time, ChessSubmissionTicket *ticket) {
+    while (chessSubmitGame(queue, tournament_id, first_player, second_player, winner, play_time, ticket) == false) {
+        sched_yield();
+    }
+}
+
+static void *submitTournamentGames(void *argument) {
+    SubmittingProducer *producer = argument;
+    ChessSubmissionTicket tickets[SUBMITTED_PLAYERS * SUBMITTED_PLAYERS];
+    int number_of_tickets = 0;
+    for (int first = 1; first <= SUBMITTED_PLAYERS; first++) {
+        for (int second = first + 1; second <= SUBMITTED_PLAYERS; second++) {
+            submitUntilAccepted(producer->queue, producer->tournament_id, first, second,
+                                (Winner) ((first * second + producer->tournament_id) % 3), first + second,
+                                &tickets[number_of_tickets++]);
+        }
+    }
+    ChessSubmissionTicket repeated, missing;
+    submitUntilAccepted(producer->queue, producer->tournament_id, 2, 1, DRAW, 1, &repeated);
+    submitUntilAccepted(producer->queue, 999, 1, 2, DRAW, 1, &missing);
+    submitUntilAccepted(producer->queue, producer->tournament_id, 11, 12, FIRST_PLAYER, 7, NULL);
+
+    for (int index = 0; index < number_of_tickets; index++) {
+        producer->failures += (chessWaitSubmission(&tickets[index]) != CHESS_SUCCESS);
+    }
+    ChessResult result = CHESS_ERROR;
+    producer->failures += (chessWaitSubmission(&missing) != CHESS_TOURNAMENT_NOT_EXIST);
+    producer->failures += (chessIsSubmissionDone(&repeated, &result) == false ||
+                           result != CHESS_GAME_ALREADY_EXISTS);
+    return NULL;
+}
+
+static void addSubmittedGames(ChessSystem chess, int tournament_id) {
+    for (int first = 1; first <= SUBMITTED_PLAYERS; first++) {
+        for (int second = first + 1; second <= SUBMITTED_PLAYERS; second++) {
+            chessAddGame(chess, tournament_id, first, second, (Winner) ((first * second + tournament_id) % 3),
+                         first + second);
+        }
+    }
+    chessAddGame(chess, tournament_id, 11, 12, FIRST_PLAYER, 7);
+}
+
+bool testChessSubmissionQueue(){
+    ChessSystem chess = chessCreate();
+    ChessSystem sequential = chessCreate();
+    ChessResult result = CHESS_ERROR;
+    ASSERT_TEST(chessOpenSubmissionQueue(NULL, 16, 4, &result) == NULL && result == CHESS_NULL_ARGUMENT);
+    ChessSubmissionQueue queue = chessOpenSubmissionQueue(chess, 16, 4, &result);
+    ASSERT_TEST(queue != NULL && result == CHESS_SUCCESS);
+
+    SubmittingProducer producers[SUBMITTING_PRODUCERS];
+    pthread_t threads[SUBMITTING_PRODUCERS];
+    for (int index = 0; index < SUBMITTING_PRODUCERS; index++) {
+        ASSERT_TEST(chessAddTournament(sequential, index + 1, SUBMITTED_PLAYERS, "Acre") == CHESS_SUCCESS);
+        ASSERT_TEST(chessAddTournament(chess, index + 1, SUBMITTED_PLAYERS, "Acre") == CHESS_SUCCESS);
+        addSubmittedGames(sequential, index + 1);
+        SubmittingProducer producer = {queue, index + 1, 0};
+        producers[index] = producer;
+    }
+    // Only the queue's thread adds the games, so the producers may run without the thread safe build
+    for (int index = 0; index < SUBMITTING_PRODUCERS; index++) {
+        ASSERT_TEST(pthread_create(&threads[index], NULL, submitTournamentGames, &producers[index]) == 0);
+    }
+    for (int index = 0; index < SUBMITTING_PRODUCERS; index++) {
+        pthread_join(threads[index], NULL);
+        ASSERT_TEST(producers[index].failures == 0);
+    }
+    chessCloseSubmissionQueue(queue);
+
+    for (int index = 1; index <= SUBMITTING_PRODUCERS; index++) {
+        ASSERT_TEST(chessEndTournament(chess, index) == CHESS_SUCCESS);
+        ASSERT_TEST(chessEndTournament(sequential, index) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(isSameSystem(chess, sequential));
+
+    ASSERT_TEST(chessSubmitGame(NULL, 1, 1, 2, DRAW, 1, NULL) == false);
+    ASSERT_TEST(chessIsSubmissionDone(NULL, &result) == false);
+    ASSERT_TEST(chessWaitSubmission(NULL) == CHESS_NULL_ARGUMENT);
+    chessCloseSubmissionQueue(NULL);
+    chessDestroy(chess);
+    chessDestroy(sequential);
+    return true;
+}
 
 /*The functions for the tests should be added here*/
 bool (*tests[]) (void) = {
         testChessAddTournament,
         testChessRemoveTournament,
         testChessAddGame,
-        testChessPrintLevelsAndTournamentStatistics
+        testChessPrintLevelsAndTournamentStatistics,
+        testChessBulkRemoval,
+        testChessUpdateAndRemoveGame,
+        testChessMergePlayers,
+        testChessCreateWithConfig,
+        testChessMemoryBudget,
+        testChessImportGames,
+        testChessImportGamesParallel,
+        testChessSnapshot,
+        testChessJournal,
+        testChessCheckpoint,
+        testChessReportFormatting,
+        testChessStatisticsCache,
+        testChessReportSinks,
+        testChessLevelsFormats,
+        testChessCompression,
+        testChessReadOnly,
+        testChessLevelsDelta,
+        testChessExportSession,
+        testChessSpill,
+        testChessScanGames,
+        testChessChangeFeed,
+        testChessConcurrentAddGame,
+        testChessPlayerStatsReaders,
+        testChessEndTournaments,
+        testChessSubmissionQueue
 };
 
 /*The names of the test functions should be added here*/
@@ -76,7 +1716,32 @@ const char* testNames[] = {
         "testChessAddTournament",
         "testChessRemoveTournament",
         "testChessAddGame",
-        "testChessPrintLevelsAndTournamentStatistics"
+        "testChessPrintLevelsAndTournamentStatistics",
+        "testChessBulkRemoval",
+        "testChessUpdateAndRemoveGame",
+        "testChessMergePlayers",
+        "testChessCreateWithConfig",
+        "testChessMemoryBudget",
+        "testChessImportGames",
+        "testChessImportGamesParallel",
+        "testChessSnapshot",
+        "testChessJournal",
+        "testChessCheckpoint",
+        "testChessReportFormatting",
+        "testChessStatisticsCache",
+        "testChessReportSinks",
+        "testChessLevelsFormats",
+        "testChessCompression",
+        "testChessReadOnly",
+        "testChessLevelsDelta",
+        "testChessExportSession",
+        "testChessSpill",
+        "testChessScanGames",
+        "testChessChangeFeed",
+        "testChessConcurrentAddGame",
+        "testChessPlayerStatsReaders",
+        "testChessEndTournaments",
+        "testChessSubmissionQueue"
 };
 
 int main(int argc, char *argv[]) {
@@ -0,0 +1,309 @@
+#include "exportSession.h"
+#include "reportWriter.h"
+#include "map.h"
+#include "player.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Type for the stage an export session is at */
+typedef enum
+{
+    EXPORT_SORTING_RUNS,
+    EXPORT_MERGING_RUNS,
+    EXPORT_WRITING_LEVELS,
+    EXPORT_WRITING_STATISTICS,
+    EXPORT_DONE
+} ExportStage;
+
+/** Type for the level of a player, as an export session copied it */
+typedef struct export_level_t
+{
+    int player_id;
+    double level;
+} ExportLevel;
+
+/** Type for an export of the chess system's reports, written in chunks */
+struct chess_export_session_t
+{
+    ExportStage stage;
+    ChessResult result;
+    ReportWriter levels_writer;
+    ReportWriter statistics_writer;
+    ExportLevel *levels;
+    ExportLevel *merged_levels;
+    int number_of_levels;
+    int position;
+    int merge_width;
+    int merge_first;
+    int merge_second;
+    char *statistics;
+    int *statistics_offsets;
+    int number_of_statistics;
+};
+
+/**
+*	compareExportLevels: Compares two levels in the order of the levels report - from the highest level to the
+*                        lowest, and by ID for equal levels.
+*
+* @param element1 - The first level.
+* @param element2 - The second level.
+*
+* @return
+* 	A negative number if the first level comes first, a positive number if the second does, 0 otherwise.
+*/
+static int compareExportLevels(const void *element1, const void *element2)
+{
+    const ExportLevel *level1 = element1;
+    const ExportLevel *level2 = element2;
+    return playerCompareLevels(level1->level, level1->player_id, level2->level, level2->player_id);
+}
+
+ChessExportSession exportSessionCreate(FILE *levels_file, FILE *statistics_file)
+{
+    ChessExportSession session = malloc(sizeof(*session));
+    if (session == NULL)
+    {
+        return NULL;
+    }
+    session->stage = (levels_file != NULL) ? EXPORT_SORTING_RUNS : EXPORT_WRITING_STATISTICS;
+    session->result = CHESS_SUCCESS;
+    session->levels_writer = NULL;
+    session->statistics_writer = NULL;
+    session->levels = NULL;
+    session->merged_levels = NULL;
+    session->number_of_levels = 0;
+    session->position = 0;
+    session->merge_width = EXPORT_SORT_RUN_SIZE;
+    session->merge_first = 0;
+    session->merge_second = 0;
+    session->statistics = NULL;
+    session->statistics_offsets = NULL;
+    session->number_of_statistics = 0;
+
+    if ((levels_file != NULL && (session->levels_writer = reportWriterCreate(levels_file)) == NULL) ||
+        (statistics_file != NULL && (session->statistics_writer = reportWriterCreate(statistics_file)) == NULL))
+    {
+        exportSessionDestroy(session);
+        return NULL;
+    }
+    return session;
+}
+
+bool exportSessionReserveLevels(ChessExportSession session, int capacity)
+{
+    session->levels = malloc((capacity > 0 ? capacity : 1) * sizeof(*session->levels));
+    session->merged_levels = malloc((capacity > 0 ? capacity : 1) * sizeof(*session->merged_levels));
+    return session->levels != NULL && session->merged_levels != NULL;
+}
+
+void exportSessionAddLevel(ChessExportSession session, int player_id, double level)
+{
+    session->levels[session->number_of_levels].player_id = player_id;
+    session->levels[session->number_of_levels].level = level;
+    session->number_of_levels++;
+}
+
+bool exportSessionReserveStatistics(ChessExportSession session, int number_of_blocks, int total_length)
+{
+    session->statistics = malloc(total_length > 0 ? total_length : 1);
+    session->statistics_offsets = malloc((number_of_blocks + 1) * sizeof(*session->statistics_offsets));
+    if (session->statistics == NULL || session->statistics_offsets == NULL)
+    {
+        return false;
+    }
+    session->statistics_offsets[0] = 0;
+    return true;
+}
+
+void exportSessionAddStatistics(ChessExportSession session, const char *statistics, int length)
+{
+    int offset = session->statistics_offsets[session->number_of_statistics];
+    memcpy(session->statistics + offset, statistics, length);
+    session->number_of_statistics++;
+    session->statistics_offsets[session->number_of_statistics] = offset + length;
+}
+
+/**
+*	exportSortRun: sorts the next run of up to EXPORT_SORT_RUN_SIZE levels of an export session.
+*
+* @param session - The export session.
+*
+* @return
+* 	The number of levels sorted.
+*/
+static int exportSortRun(ChessExportSession session)
+{
+    int run_size = session->number_of_levels - session->position;
+    run_size = (run_size < EXPORT_SORT_RUN_SIZE) ? run_size : EXPORT_SORT_RUN_SIZE;
+    qsort(session->levels + session->position, run_size, sizeof(*session->levels), compareExportLevels);
+    session->position += run_size;
+    if (session->position >= session->number_of_levels)
+    {
+        session->stage = EXPORT_MERGING_RUNS;
+        session->position = 0;
+        session->merge_first = 0;
+        session->merge_second = (EXPORT_SORT_RUN_SIZE < session->number_of_levels) ?
+                                EXPORT_SORT_RUN_SIZE : session->number_of_levels;
+    }
+    return run_size;
+}
+
+/**
+*	exportMergeRuns: merges pairs of sorted runs of an export session into the merge buffer, up to a given number
+*                    of levels. A merge pass can stop at any level, and continues from it on the next call. When a
+*                    pass is done, the runs are twice as long, and the merge buffer holds them.
+*
+* @param session - The export session.
+* @param budget - The largest number of levels to merge.
+*
+* @return
+* 	The number of levels merged.
+*/
+static int exportMergeRuns(ChessExportSession session, int budget)
+{
+    int size = session->number_of_levels;
+    int width = session->merge_width;
+    int merged = 0;
+    while (merged < budget && width < size)
+    {
+        int run_start = session->position - (session->position % (2 * width));
+        int middle = (run_start + width < size) ? run_start + width : size;
+        int run_end = (run_start + 2 * width < size) ? run_start + 2 * width : size;
+        for (; session->position < run_end && merged < budget; session->position++, merged++)
+        {
+            bool take_first = session->merge_first < middle &&
+                              (session->merge_second >= run_end ||
+                               compareExportLevels(&session->levels[session->merge_first],
+                                                   &session->levels[session->merge_second]) <= 0);
+            int source = take_first ? session->merge_first++ : session->merge_second++;
+            session->merged_levels[session->position] = session->levels[source];
+        }
+        if (session->position == size)
+        {
+            ExportLevel *sorted = session->merged_levels;
+            session->merged_levels = session->levels;
+            session->levels = sorted;
+            width *= 2;
+            session->position = 0;
+        }
+        if (session->position == run_end || session->position == 0)
+        {
+            session->merge_first = session->position;
+            session->merge_second = (session->position + width < size) ? session->position + width : size;
+        }
+    }
+    session->merge_width = width;
+    if (width >= size)
+    {
+        session->stage = EXPORT_WRITING_LEVELS;
+        session->position = 0;
+    }
+    return merged;
+}
+
+/**
+*	exportWriteLevels: writes the next sorted levels of an export session, as chessSavePlayersLevels does.
+*
+* @param session - The export session.
+* @param budget - The largest number of levels to write.
+*
+* @return
+* 	The number of levels written.
+*/
+static int exportWriteLevels(ChessExportSession session, int budget)
+{
+    int written = 0;
+    for (; session->position < session->number_of_levels && written < budget; session->position++, written++)
+    {
+        if (reportWriterPutLevel(session->levels_writer, session->levels[session->position].player_id,
+                                 session->levels[session->position].level) == false)
+        {
+            session->result = CHESS_SAVE_FAILURE;
+            return written;
+        }
+    }
+    if (session->position >= session->number_of_levels)
+    {
+        session->stage = (session->statistics_writer != NULL) ? EXPORT_WRITING_STATISTICS : EXPORT_DONE;
+        session->position = 0;
+    }
+    return written;
+}
+
+/**
+*	exportWriteStatistics: writes the next statistics blocks of an export session, as
+*                          chessSaveTournamentStatistics does.
+*
+* @param session - The export session.
+* @param budget - The largest number of blocks to write.
+*
+* @return
+* 	The number of blocks written.
+*/
+static int exportWriteStatistics(ChessExportSession session, int budget)
+{
+    int written = 0;
+    for (; session->position < session->number_of_statistics && written < budget; session->position++, written++)
+    {
+        int offset = session->statistics_offsets[session->position];
+        if (reportWriterPutBytes(session->statistics_writer, session->statistics + offset,
+                                 session->statistics_offsets[session->position + 1] - offset) == false)
+        {
+            session->result = CHESS_SAVE_FAILURE;
+            return written;
+        }
+    }
+    if (session->position >= session->number_of_statistics)
+    {
+        session->stage = EXPORT_DONE;
+    }
+    return written;
+}
+
+ChessResult exportSessionStep(ChessExportSession session, int max_records, bool *done)
+{
+    int budget = (max_records > 0) ? max_records : 1;
+    while (budget > 0 && session->result == CHESS_SUCCESS && session->stage != EXPORT_DONE)
+    {
+        switch (session->stage)
+        {
+            case EXPORT_SORTING_RUNS:
+                budget -= exportSortRun(session);
+                break;
+            case EXPORT_MERGING_RUNS:
+                budget -= exportMergeRuns(session, budget);
+                break;
+            case EXPORT_WRITING_LEVELS:
+                budget -= exportWriteLevels(session, budget);
+                break;
+            default:
+                budget -= exportWriteStatistics(session, budget);
+                break;
+        }
+    }
+
+    if ((session->levels_writer != NULL && reportWriterFlush(session->levels_writer) == false) ||
+        (session->statistics_writer != NULL && reportWriterFlush(session->statistics_writer) == false))
+    {
+        session->result = CHESS_SAVE_FAILURE;
+    }
+    *done = (session->stage == EXPORT_DONE || session->result != CHESS_SUCCESS);
+    return session->result;
+}
+
+ChessResult exportSessionDestroy(ChessExportSession session)
+{
+    if (session == NULL)
+    {
+        return CHESS_SUCCESS;
+    }
+    ChessResult result = session->result;
+    reportWriterDestroy(session->levels_writer);
+    reportWriterDestroy(session->statistics_writer);
+    free(session->levels);
+    free(session->merged_levels);
+    free(session->statistics);
+    free(session->statistics_offsets);
+    free(session);
+    return result;
+}
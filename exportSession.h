@@ -0,0 +1,105 @@
+#ifndef EXPORT_SESSION_H_
+#define EXPORT_SESSION_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "chessSystemExtensions.h"
+
+/**
+* Export Session
+*
+* Writes the players' levels report and the tournament statistics report of the chess system in chunks. The
+* levels and the statistics blocks are copied into the session when it begins, so changes made to the system
+* afterwards don't appear in the export, and each step then handles a bounded number of records: the levels are
+* sorted in runs of EXPORT_SORT_RUN_SIZE, the runs are merged pairwise in passes that may stop at any level, and
+* the sorted levels and the statistics blocks are written in order.
+*
+* The following functions are available:
+*   exportSessionCreate		- Creates an empty export session for the given files
+*   exportSessionReserveLevels	- Allocates room for the levels of an export session
+*   exportSessionAddLevel	- Copies a player's level into an export session
+*   exportSessionReserveStatistics	- Allocates room for the statistics blocks of an export session
+*   exportSessionAddStatistics	- Copies a statistics block into an export session
+*   exportSessionStep		- Handles the next records of an export session
+*   exportSessionDestroy	- Deallocates an export session
+*/
+
+/** The number of players whose levels an export session sorts at once, before merging the sorted runs */
+#define EXPORT_SORT_RUN_SIZE 1024
+
+/**
+* exportSessionCreate: Creates an empty export session, which writes the reports of the given files.
+*
+* @param levels_file - The file of the levels report. NULL if it isn't exported.
+* @param statistics_file - The file of the statistics report. NULL if it isn't exported.
+* @return
+* 	NULL - in case of memory error.
+* 	The new export session otherwise.
+*/
+ChessExportSession exportSessionCreate(FILE *levels_file, FILE *statistics_file);
+
+/**
+* exportSessionReserveLevels: Allocates room for the levels of an export session.
+*
+* @param session - The export session.
+* @param capacity - The largest number of levels which will be added.
+* @return
+* 	false - in case of memory error.
+* 	true - otherwise.
+*/
+bool exportSessionReserveLevels(ChessExportSession session, int capacity);
+
+/**
+* exportSessionAddLevel: Copies a player's level into an export session. Room for it must have been reserved.
+*
+* @param session - The export session.
+* @param player_id - The ID of the player.
+* @param level - The level of the player.
+*/
+void exportSessionAddLevel(ChessExportSession session, int player_id, double level);
+
+/**
+* exportSessionReserveStatistics: Allocates room for the statistics blocks of an export session.
+*
+* @param session - The export session.
+* @param number_of_blocks - The number of blocks which will be added.
+* @param total_length - The total length of the blocks.
+* @return
+* 	false - in case of memory error.
+* 	true - otherwise.
+*/
+bool exportSessionReserveStatistics(ChessExportSession session, int number_of_blocks, int total_length);
+
+/**
+* exportSessionAddStatistics: Copies the statistics block of an ended tournament into an export session, after
+* 	the blocks of the tournaments with lower IDs. Room for it must have been reserved.
+*
+* @param session - The export session.
+* @param statistics - The statistics block.
+* @param length - The length of the block.
+*/
+void exportSessionAddStatistics(ChessExportSession session, const char *statistics, int length);
+
+/**
+* exportSessionStep: Handles up to max_records records of an export session, and flushes its files.
+*
+* @param session - The export session.
+* @param max_records - See chessExportStep.
+* @param done - Output which is set to true once the export is done or failed.
+* @return
+* 	CHESS_SAVE_FAILURE - if writing failed.
+* 	CHESS_SUCCESS - otherwise.
+*/
+ChessResult exportSessionStep(ChessExportSession session, int max_records, bool *done);
+
+/**
+* exportSessionDestroy: Deallocates an export session. Its files are not closed.
+*
+* @param session - The export session. If session is NULL nothing will be done.
+* @return
+* 	CHESS_SAVE_FAILURE - if writing failed.
+* 	CHESS_SUCCESS - otherwise.
+*/
+ChessResult exportSessionDestroy(ChessExportSession session);
+
+#endif /* EXPORT_SESSION_H_ */
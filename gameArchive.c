@@ -0,0 +1,674 @@
+#include "chessSystem.h"
+#include "gameArchive.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#define GAME_ARCHIVE_MIN_CAPACITY 64
+#define GAME_ARCHIVE_SCAN_CHUNK 1024
+#define GAME_ARCHIVE_NO_ROW (-1)
+#define GROUP_TABLE_INITIAL_CAPACITY 16
+
+struct game_archive_t {
+    int *tournament_ids;
+    int *game_ids;
+    int *first_players;
+    int *second_players;
+    int *winners;
+    int *play_times;
+    unsigned char *live;
+    int number_of_rows;
+    int number_of_live;
+    int capacity;
+    int *index;
+    int index_capacity;
+};
+
+/** Type for the groups of a scan, and a hash table from their keys to their position */
+typedef struct group_table_t {
+    GameArchiveAggregate *groups;
+    int size;
+    int groups_capacity;
+    int *slots;
+    int capacity;
+    int last_group;
+} GroupTable;
+
+/**
+*	gameArchiveMix: mixes the bits of a value, so that close values hash to distant slots.
+*
+* @param value - The value to mix.
+* @return
+* 	The mixed value.
+*/
+static uint32_t gameArchiveMix(uint32_t value)
+{
+    value = (value ^ (value >> 16)) * 0x45D9F3BU;
+    value = (value ^ (value >> 16)) * 0x45D9F3BU;
+    return value ^ (value >> 16);
+}
+
+/**
+*	gameArchiveFindSlot: finds the slot of a game in an index of the archive's rows - the slot holding the
+*                        game's latest row, or the empty slot the game belongs in.
+*
+* @param archive - The archive whose rows are indexed.
+* @param index - The slots of the index, each holding a row or GAME_ARCHIVE_NO_ROW.
+* @param index_capacity - The number of slots. Must be a power of two.
+* @param tournament_id - The ID of the game's tournament.
+* @param game_id - The ID of the game in its tournament.
+* @return
+* 	The position of the slot.
+*/
+static int gameArchiveFindSlot(GameArchive archive, const int *index, int index_capacity, int tournament_id,
+                               int game_id)
+{
+    uint32_t hash = gameArchiveMix((uint32_t) tournament_id * 0x9E3779B1U ^ (uint32_t) game_id);
+    int position = (int) (hash & (uint32_t) (index_capacity - 1));
+    while (index[position] != GAME_ARCHIVE_NO_ROW &&
+           (archive->tournament_ids[index[position]] != tournament_id ||
+            archive->game_ids[index[position]] != game_id))
+    {
+        position = (position + 1) & (index_capacity - 1);
+    }
+    return position;
+}
+
+/**
+*	gameArchiveFillIndex: indexes all the rows of the archive in the given slots. A game which has several
+*                         rows is indexed by its latest one.
+*
+* @param archive - The archive whose rows are indexed.
+* @param index - The slots to fill.
+* @param index_capacity - The number of slots. Must be a power of two, larger than the number of rows.
+* @return
+* 	None
+*/
+static void gameArchiveFillIndex(GameArchive archive, int *index, int index_capacity)
+{
+    for (int position = 0; position < index_capacity; position++)
+    {
+        index[position] = GAME_ARCHIVE_NO_ROW;
+    }
+    for (int row = 0; row < archive->number_of_rows; row++)
+    {
+        index[gameArchiveFindSlot(archive, index, index_capacity, archive->tournament_ids[row],
+                                  archive->game_ids[row])] = row;
+    }
+}
+
+/**
+*	gameArchiveResizeIndex: moves the index of the archive to a new array of slots.
+*
+* @param archive - The archive whose index is resized.
+* @param index_capacity - The new number of slots. Must be a power of two, larger than the number of rows.
+* @return
+* 	false - In case of memory error. The archive is unchanged.
+* 	true - If the index was resized.
+*/
+static bool gameArchiveResizeIndex(GameArchive archive, int index_capacity)
+{
+    int *index = malloc(sizeof(*index) * index_capacity);
+    if (index == NULL)
+    {
+        return false;
+    }
+    gameArchiveFillIndex(archive, index, index_capacity);
+    free(archive->index);
+    archive->index = index;
+    archive->index_capacity = index_capacity;
+    return true;
+}
+
+/**
+*	gameArchiveGrowColumn: reallocates a column of the archive with room for more rows.
+*
+* @param column - The column to grow. Unchanged in case of memory error.
+* @param element_size - The size of a single element of the column.
+* @param capacity - The new number of rows.
+* @return
+* 	false - In case of memory error.
+* 	true - If the column was reallocated.
+*/
+static bool gameArchiveGrowColumn(void **column, size_t element_size, int capacity)
+{
+    void *grown = realloc(*column, element_size * capacity);
+    if (grown == NULL)
+    {
+        return false;
+    }
+    *column = grown;
+    return true;
+}
+
+/**
+*	gameArchiveGrow: doubles the number of rows which the columns of the archive have room for. The capacity
+*                    is only raised once all the columns were grown.
+*
+* @param archive - The archive to grow.
+* @return
+* 	false - In case of memory error.
+* 	true - If the archive was grown.
+*/
+static bool gameArchiveGrow(GameArchive archive)
+{
+    if (archive->capacity > INT_MAX / 2)
+    {
+        return false;
+    }
+    int capacity = archive->capacity * 2;
+    if (gameArchiveGrowColumn((void**) &archive->tournament_ids, sizeof(int), capacity) == false ||
+        gameArchiveGrowColumn((void**) &archive->game_ids, sizeof(int), capacity) == false ||
+        gameArchiveGrowColumn((void**) &archive->first_players, sizeof(int), capacity) == false ||
+        gameArchiveGrowColumn((void**) &archive->second_players, sizeof(int), capacity) == false ||
+        gameArchiveGrowColumn((void**) &archive->winners, sizeof(int), capacity) == false ||
+        gameArchiveGrowColumn((void**) &archive->play_times, sizeof(int), capacity) == false ||
+        gameArchiveGrowColumn((void**) &archive->live, sizeof(unsigned char), capacity) == false)
+    {
+        return false;
+    }
+    archive->capacity = capacity;
+    return true;
+}
+
+/**
+*	gameArchiveCompact: drops the dead rows of the archive, keeping the order of the live rows, and indexes
+*                       the remaining rows again. Doesn't allocate memory.
+*
+* @param archive - The archive to compact.
+* @return
+* 	None
+*/
+static void gameArchiveCompact(GameArchive archive)
+{
+    int number_of_rows = 0;
+    for (int row = 0; row < archive->number_of_rows; row++)
+    {
+        if (archive->live[row] == 0)
+        {
+            continue;
+        }
+        archive->tournament_ids[number_of_rows] = archive->tournament_ids[row];
+        archive->game_ids[number_of_rows] = archive->game_ids[row];
+        archive->first_players[number_of_rows] = archive->first_players[row];
+        archive->second_players[number_of_rows] = archive->second_players[row];
+        archive->winners[number_of_rows] = archive->winners[row];
+        archive->play_times[number_of_rows] = archive->play_times[row];
+        archive->live[number_of_rows] = 1;
+        number_of_rows++;
+    }
+    archive->number_of_rows = number_of_rows;
+    gameArchiveFillIndex(archive, archive->index, archive->index_capacity);
+}
+
+GameArchive gameArchiveCreate(int initial_capacity)
+{
+    GameArchive archive = calloc(1, sizeof(*archive));
+    if (archive == NULL)
+    {
+        return NULL;
+    }
+
+    int capacity = GAME_ARCHIVE_MIN_CAPACITY;
+    while (capacity < initial_capacity && capacity < (1 << 29))
+    {
+        capacity = capacity * 2;
+    }
+    archive->capacity = capacity;
+    archive->tournament_ids = malloc(sizeof(int) * capacity);
+    archive->game_ids = malloc(sizeof(int) * capacity);
+    archive->first_players = malloc(sizeof(int) * capacity);
+    archive->second_players = malloc(sizeof(int) * capacity);
+    archive->winners = malloc(sizeof(int) * capacity);
+    archive->play_times = malloc(sizeof(int) * capacity);
+    archive->live = malloc(sizeof(unsigned char) * capacity);
+    if (archive->tournament_ids == NULL || archive->game_ids == NULL || archive->first_players == NULL ||
+        archive->second_players == NULL || archive->winners == NULL || archive->play_times == NULL ||
+        archive->live == NULL || gameArchiveResizeIndex(archive, capacity * 2) == false)
+    {
+        gameArchiveDestroy(archive);
+        return NULL;
+    }
+    return archive;
+}
+
+void gameArchiveDestroy(GameArchive archive)
+{
+    if (archive == NULL)
+    {
+        return;
+    }
+    free(archive->tournament_ids);
+    free(archive->game_ids);
+    free(archive->first_players);
+    free(archive->second_players);
+    free(archive->winners);
+    free(archive->play_times);
+    free(archive->live);
+    free(archive->index);
+    free(archive);
+}
+
+bool gameArchivePut(GameArchive archive, int tournament_id, int game_id, int first_player, int second_player,
+                    int winner, int play_time)
+{
+    if (archive == NULL)
+    {
+        return false;
+    }
+
+    int slot = gameArchiveFindSlot(archive, archive->index, archive->index_capacity, tournament_id, game_id);
+    int row = archive->index[slot];
+    if (row == GAME_ARCHIVE_NO_ROW || archive->live[row] == 0)
+    {
+        if (archive->number_of_rows == archive->capacity && gameArchiveGrow(archive) == false)
+        {
+            return false;
+        }
+        if (archive->number_of_rows + 1 > archive->index_capacity / 2)
+        {
+            if (gameArchiveResizeIndex(archive, archive->index_capacity * 2) == false)
+            {
+                return false;
+            }
+            slot = gameArchiveFindSlot(archive, archive->index, archive->index_capacity, tournament_id, game_id);
+        }
+        row = archive->number_of_rows++;
+        archive->tournament_ids[row] = tournament_id;
+        archive->game_ids[row] = game_id;
+        archive->live[row] = 1;
+        archive->index[slot] = row;
+        archive->number_of_live++;
+    }
+    archive->first_players[row] = first_player;
+    archive->second_players[row] = second_player;
+    archive->winners[row] = winner;
+    archive->play_times[row] = play_time;
+    return true;
+}
+
+void gameArchiveRemove(GameArchive archive, int tournament_id, int game_id)
+{
+    if (archive == NULL)
+    {
+        return;
+    }
+
+    int row = archive->index[gameArchiveFindSlot(archive, archive->index, archive->index_capacity,
+                                                 tournament_id, game_id)];
+    if (row == GAME_ARCHIVE_NO_ROW || archive->live[row] == 0)
+    {
+        return;
+    }
+    archive->live[row] = 0;
+    archive->number_of_live--;
+    if (archive->number_of_rows >= GAME_ARCHIVE_MIN_CAPACITY && archive->number_of_live * 2 < archive->number_of_rows)
+    {
+        gameArchiveCompact(archive);
+    }
+}
+
+int gameArchiveGetSize(GameArchive archive)
+{
+    if (archive == NULL)
+    {
+        return 0;
+    }
+    return archive->number_of_live;
+}
+
+size_t gameArchiveGetMemoryFootprint(GameArchive archive)
+{
+    if (archive == NULL)
+    {
+        return 0;
+    }
+    return sizeof(*archive) + (size_t) archive->capacity * (6 * sizeof(int) + sizeof(unsigned char)) +
+           (size_t) archive->index_capacity * sizeof(int);
+}
+
+/**
+*	gameArchiveSelect: marks which rows of a chunk of the archive are live and match a filter. Every
+*                      condition is a separate branch free pass over a single column.
+*
+* @param archive - The archive.
+* @param filter - The filter.
+* @param start - The first row of the chunk.
+* @param count - The number of rows in the chunk.
+* @param selected - Output for a 1 for each selected row of the chunk, and a 0 for each other row.
+* @return
+* 	None
+*/
+static void gameArchiveSelect(GameArchive archive, const GameArchiveFilter *filter, int start, int count,
+                              unsigned char *selected)
+{
+    const unsigned char *live = archive->live + start;
+    for (int index = 0; index < count; index++)
+    {
+        selected[index] = live[index];
+    }
+
+    if (filter->tournament_id != GAME_ARCHIVE_ANY_ID)
+    {
+        const int *tournament_ids = archive->tournament_ids + start;
+        int tournament_id = filter->tournament_id;
+        for (int index = 0; index < count; index++)
+        {
+            selected[index] &= (tournament_ids[index] == tournament_id);
+        }
+    }
+    if (filter->player_id != GAME_ARCHIVE_ANY_ID)
+    {
+        const int *first_players = archive->first_players + start;
+        const int *second_players = archive->second_players + start;
+        int player_id = filter->player_id;
+        for (int index = 0; index < count; index++)
+        {
+            selected[index] &= (first_players[index] == player_id) | (second_players[index] == player_id);
+        }
+    }
+    if (filter->winner != GAME_ARCHIVE_ANY_WINNER)
+    {
+        const int *winners = archive->winners + start;
+        int winner = filter->winner;
+        for (int index = 0; index < count; index++)
+        {
+            selected[index] &= (winners[index] == winner);
+        }
+    }
+
+    const int *play_times = archive->play_times + start;
+    int min_play_time = filter->min_play_time, max_play_time = filter->max_play_time;
+    for (int index = 0; index < count; index++)
+    {
+        selected[index] &= (play_times[index] >= min_play_time) & (play_times[index] <= max_play_time);
+    }
+}
+
+/**
+*	gameArchiveAggregateChunk: adds the selected rows of a chunk of the archive to a single group, masking the
+*                              rows out instead of branching on them.
+*
+* @param archive - The archive.
+* @param start - The first row of the chunk.
+* @param count - The number of rows in the chunk.
+* @param selected - A 1 for each selected row of the chunk, and a 0 for each other row.
+* @param group - The group to add the rows to.
+* @return
+* 	None
+*/
+static void gameArchiveAggregateChunk(GameArchive archive, int start, int count, const unsigned char *selected,
+                                      GameArchiveAggregate *group)
+{
+    const int *winners = archive->winners + start;
+    const int *play_times = archive->play_times + start;
+    int games = 0, draws = 0, longest_play_time = group->longest_play_time;
+    long long total_play_time = 0;
+    for (int index = 0; index < count; index++)
+    {
+        int play_time = play_times[index] & -(int) selected[index];
+        games += selected[index];
+        draws += selected[index] & (winners[index] == DRAW);
+        total_play_time += play_time;
+        longest_play_time = (play_time > longest_play_time) ? play_time : longest_play_time;
+    }
+    group->games += games;
+    group->draws += draws;
+    group->total_play_time += total_play_time;
+    group->longest_play_time = longest_play_time;
+}
+
+/**
+*	groupTableInit: initializes an empty table of groups.
+*
+* @param table - The table to initialize.
+* @return
+* 	false - In case of memory error. Nothing is left to free in that case.
+* 	true - If the table was initialized.
+*/
+static bool groupTableInit(GroupTable *table)
+{
+    table->size = 0;
+    table->groups_capacity = GROUP_TABLE_INITIAL_CAPACITY;
+    table->capacity = GROUP_TABLE_INITIAL_CAPACITY * 2;
+    table->last_group = GAME_ARCHIVE_NO_ROW;
+    table->groups = malloc(sizeof(*table->groups) * table->groups_capacity);
+    table->slots = malloc(sizeof(*table->slots) * table->capacity);
+    if (table->groups == NULL || table->slots == NULL)
+    {
+        free(table->groups);
+        free(table->slots);
+        return false;
+    }
+    for (int position = 0; position < table->capacity; position++)
+    {
+        table->slots[position] = GAME_ARCHIVE_NO_ROW;
+    }
+    return true;
+}
+
+/**
+*	groupTableFindSlot: finds the slot of a key in the table - the slot holding its group, or the empty slot
+*                       it belongs in.
+*
+* @param table - The table.
+* @param slots - The slots to search, each holding a group or GAME_ARCHIVE_NO_ROW.
+* @param capacity - The number of slots. Must be a power of two.
+* @param key - The key to find.
+* @return
+* 	The position of the slot.
+*/
+static int groupTableFindSlot(const GroupTable *table, const int *slots, int capacity, int key)
+{
+    int position = (int) (gameArchiveMix((uint32_t) key) & (uint32_t) (capacity - 1));
+    while (slots[position] != GAME_ARCHIVE_NO_ROW && table->groups[slots[position]].key != key)
+    {
+        position = (position + 1) & (capacity - 1);
+    }
+    return position;
+}
+
+/**
+*	groupTableGrow: doubles the room of the table, for both its groups and its slots.
+*
+* @param table - The table to grow.
+* @return
+* 	false - In case of memory error. The table stays usable.
+* 	true - If the table was grown.
+*/
+static bool groupTableGrow(GroupTable *table)
+{
+    if (table->groups_capacity > INT_MAX / 4)
+    {
+        return false;
+    }
+    GameArchiveAggregate *groups = realloc(table->groups, sizeof(*groups) * table->groups_capacity * 2);
+    if (groups == NULL)
+    {
+        return false;
+    }
+    table->groups = groups;
+    table->groups_capacity = table->groups_capacity * 2;
+
+    int capacity = table->capacity * 2;
+    int *slots = malloc(sizeof(*slots) * capacity);
+    if (slots == NULL)
+    {
+        return false;
+    }
+    for (int position = 0; position < capacity; position++)
+    {
+        slots[position] = GAME_ARCHIVE_NO_ROW;
+    }
+    for (int group = 0; group < table->size; group++)
+    {
+        slots[groupTableFindSlot(table, slots, capacity, table->groups[group].key)] = group;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    return true;
+}
+
+/**
+*	groupTableGet: gets the group of a key, adding an empty group for it if it has none. The group of the
+*                  previous key is checked first, as consecutive rows often share their key.
+*
+* @param table - The table.
+* @param key - The key of the group.
+* @return
+* 	NULL - In case of memory error.
+* 	The group otherwise, valid until the next call.
+*/
+static GameArchiveAggregate *groupTableGet(GroupTable *table, int key)
+{
+    if (table->last_group != GAME_ARCHIVE_NO_ROW && table->groups[table->last_group].key == key)
+    {
+        return &table->groups[table->last_group];
+    }
+
+    int slot = groupTableFindSlot(table, table->slots, table->capacity, key);
+    if (table->slots[slot] == GAME_ARCHIVE_NO_ROW)
+    {
+        if (table->size == table->groups_capacity)
+        {
+            if (groupTableGrow(table) == false)
+            {
+                return NULL;
+            }
+            slot = groupTableFindSlot(table, table->slots, table->capacity, key);
+        }
+        GameArchiveAggregate empty_group = {key, 0, 0, 0, 0};
+        table->groups[table->size] = empty_group;
+        table->slots[slot] = table->size++;
+    }
+    table->last_group = table->slots[slot];
+    return &table->groups[table->last_group];
+}
+
+/**
+*	groupTableAdd: adds a game to the group of a key.
+*
+* @param table - The table.
+* @param key - The key of the group.
+* @param winner - The winner of the game.
+* @param play_time - The play time of the game.
+* @return
+* 	false - In case of memory error.
+* 	true - If the game was added.
+*/
+static bool groupTableAdd(GroupTable *table, int key, int winner, int play_time)
+{
+    GameArchiveAggregate *group = groupTableGet(table, key);
+    if (group == NULL)
+    {
+        return false;
+    }
+    group->games++;
+    group->draws += (winner == DRAW);
+    group->total_play_time += play_time;
+    group->longest_play_time = (play_time > group->longest_play_time) ? play_time : group->longest_play_time;
+    return true;
+}
+
+/**
+*	compareAggregateKey: compares the keys of two groups.
+*
+* @param element1 - The first group.
+* @param element2 - The second group.
+* @return
+* 	A negative number if the first key is lower, a positive number if it is higher, 0 if they are equal.
+*/
+static int compareAggregateKey(const void *element1, const void *element2)
+{
+    int key1 = ((const GameArchiveAggregate*) element1)->key;
+    int key2 = ((const GameArchiveAggregate*) element2)->key;
+    return (key1 > key2) - (key1 < key2);
+}
+
+/**
+*	gameArchiveGroupChunk: adds the selected rows of a chunk of the archive to the groups of their keys. The
+*                          selected rows are gathered first, so only they are visited.
+*
+* @param archive - The archive.
+* @param start - The first row of the chunk.
+* @param count - The number of rows in the chunk.
+* @param selected - A 1 for each selected row of the chunk, and a 0 for each other row.
+* @param grouping - Whether rows are grouped by player or by tournament.
+* @param table - The groups.
+* @return
+* 	false - In case of memory error.
+* 	true - If the rows were added.
+*/
+static bool gameArchiveGroupChunk(GameArchive archive, int start, int count, const unsigned char *selected,
+                                  GameArchiveGrouping grouping, GroupTable *table)
+{
+    int rows[GAME_ARCHIVE_SCAN_CHUNK];
+    int number_of_selected = 0;
+    for (int index = 0; index < count; index++)
+    {
+        rows[number_of_selected] = start + index;
+        number_of_selected += selected[index];
+    }
+
+    for (int index = 0; index < number_of_selected; index++)
+    {
+        int row = rows[index];
+        int winner = archive->winners[row], play_time = archive->play_times[row];
+        if (grouping == GAME_ARCHIVE_GROUP_BY_TOURNAMENT)
+        {
+            if (groupTableAdd(table, archive->tournament_ids[row], winner, play_time) == false)
+            {
+                return false;
+            }
+            continue;
+        }
+        if ((archive->first_players[row] > 0 &&
+             groupTableAdd(table, archive->first_players[row], winner, play_time) == false) ||
+            (archive->second_players[row] > 0 &&
+             groupTableAdd(table, archive->second_players[row], winner, play_time) == false))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+GameArchiveAggregate *gameArchiveScan(GameArchive archive, const GameArchiveFilter *filter,
+                                      GameArchiveGrouping grouping, int *number_of_groups)
+{
+    if (archive == NULL || filter == NULL || number_of_groups == NULL)
+    {
+        return NULL;
+    }
+
+    GroupTable table;
+    if (groupTableInit(&table) == false)
+    {
+        return NULL;
+    }
+    GameArchiveAggregate *total = (grouping == GAME_ARCHIVE_GROUP_NONE) ? groupTableGet(&table, 0) : NULL;
+
+    unsigned char selected[GAME_ARCHIVE_SCAN_CHUNK];
+    for (int start = 0; start < archive->number_of_rows; start += GAME_ARCHIVE_SCAN_CHUNK)
+    {
+        int count = archive->number_of_rows - start;
+        count = (count < GAME_ARCHIVE_SCAN_CHUNK) ? count : GAME_ARCHIVE_SCAN_CHUNK;
+        gameArchiveSelect(archive, filter, start, count, selected);
+        if (total != NULL)
+        {
+            gameArchiveAggregateChunk(archive, start, count, selected, total);
+        }
+        else if (gameArchiveGroupChunk(archive, start, count, selected, grouping, &table) == false)
+        {
+            free(table.groups);
+            free(table.slots);
+            return NULL;
+        }
+    }
+
+    free(table.slots);
+    qsort(table.groups, table.size, sizeof(*table.groups), compareAggregateKey);
+    *number_of_groups = table.size;
+    return table.groups;
+}
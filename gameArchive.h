@@ -0,0 +1,142 @@
+#ifndef GAME_ARCHIVE_H_
+#define GAME_ARCHIVE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* Game Archive
+*
+* Keeps a copy of every game of the chess system in columns - one array per field of the games - so questions
+* about all the games can be answered by scanning a few plain arrays instead of walking the games map of every
+* tournament. Games are appended as rows, and a game that changes is written over its row. A removed game only
+* marks its row as dead, and the dead rows are dropped once they are the majority of the archive.
+*
+* Scans select the rows matching a filter a chunk at a time, with branch free loops over the columns that the
+* compiler can vectorize, and then sum, count and take the maximum of the selected rows, either over all of them
+* or grouped by player or by tournament.
+*
+* The following functions are available:
+*   gameArchiveCreate	- Creates a new empty archive
+*   gameArchiveDestroy	- Deletes an existing archive and frees all resources
+*   gameArchivePut	- Adds a game to the archive, or writes over its row if it is already there
+*   gameArchiveRemove	- Removes a game from the archive
+*   gameArchiveGetSize	- Gets the number of games in the archive
+*   gameArchiveGetMemoryFootprint	- Gets the size in bytes of the archive
+*   gameArchiveScan	- Aggregates the games matching a filter, optionally grouped by player or tournament
+*/
+
+/** Type for defining the game archive */
+typedef struct game_archive_t *GameArchive;
+
+/** Value of a filter's ID which matches any ID */
+#define GAME_ARCHIVE_ANY_ID 0
+/** Value of a filter's winner which matches any winner */
+#define GAME_ARCHIVE_ANY_WINNER (-1)
+
+/** Type for selecting games in a scan. Play times are matched inclusively. */
+typedef struct game_archive_filter_t {
+    int tournament_id;
+    int player_id;
+    int winner;
+    int min_play_time;
+    int max_play_time;
+} GameArchiveFilter;
+
+/** Type for the grouping of a scan's games */
+typedef enum {
+    GAME_ARCHIVE_GROUP_NONE,
+    GAME_ARCHIVE_GROUP_BY_PLAYER,
+    GAME_ARCHIVE_GROUP_BY_TOURNAMENT
+} GameArchiveGrouping;
+
+/** Type for the aggregates of a group of games */
+typedef struct game_archive_aggregate_t {
+    int key;
+    int games;
+    int draws;
+    long long total_play_time;
+    int longest_play_time;
+} GameArchiveAggregate;
+
+/**
+* gameArchiveCreate: Allocates a new empty archive.
+*
+* @param initial_capacity - The number of games to allocate room for in advance.
+* @return
+* 	NULL - if allocations failed.
+* 	A new GameArchive in case of success.
+*/
+GameArchive gameArchiveCreate(int initial_capacity);
+
+/**
+* gameArchiveDestroy: Deallocates an existing archive.
+*
+* @param archive - Target archive to be deallocated. If archive is NULL nothing will be done.
+*/
+void gameArchiveDestroy(GameArchive archive);
+
+/**
+* gameArchivePut: Adds a game to the archive, or writes the given fields over its row if it is already there.
+*
+* @param archive - The archive.
+* @param tournament_id - The ID of the game's tournament.
+* @param game_id - The ID of the game in its tournament.
+* @param first_player - The ID of the first player, negative if the player was removed.
+* @param second_player - The ID of the second player, negative if the player was removed.
+* @param winner - The winner of the game.
+* @param play_time - The play time of the game.
+* @return
+* 	false - if archive is NULL or an allocation failed. The archive is unchanged in that case.
+* 	true - if the game was written.
+*/
+bool gameArchivePut(GameArchive archive, int tournament_id, int game_id, int first_player, int second_player,
+                    int winner, int play_time);
+
+/**
+* gameArchiveRemove: Removes a game from the archive. Games which are not in the archive are ignored.
+*
+* @param archive - The archive.
+* @param tournament_id - The ID of the game's tournament.
+* @param game_id - The ID of the game in its tournament.
+*/
+void gameArchiveRemove(GameArchive archive, int tournament_id, int game_id);
+
+/**
+* gameArchiveGetSize: Gets the number of games in the archive.
+*
+* @param archive - The archive.
+* @return
+* 	0 - if archive is NULL.
+* 	The number of games otherwise.
+*/
+int gameArchiveGetSize(GameArchive archive);
+
+/**
+* gameArchiveGetMemoryFootprint: Gets the size of the archive, including the room allocated for future games.
+*
+* @param archive - The archive.
+* @return
+* 	0 - if archive is NULL.
+* 	The size in bytes otherwise.
+*/
+size_t gameArchiveGetMemoryFootprint(GameArchive archive);
+
+/**
+* gameArchiveScan: Aggregates the games matching a filter. Grouped by player, a game is counted for each of
+* its players who was not removed. Grouped by nothing, a single group with the key 0 is returned, even if no
+* game matched.
+*
+* @param archive - The archive.
+* @param filter - The filter, with GAME_ARCHIVE_ANY_ID and GAME_ARCHIVE_ANY_WINNER for fields that match any
+* 	game.
+* @param grouping - How the matching games are grouped.
+* @param number_of_groups - Output for the number of groups.
+* @return
+* 	NULL - if a parameter is NULL or an allocation failed.
+* 	The groups, ordered by key, otherwise. The caller frees them.
+*/
+GameArchiveAggregate *gameArchiveScan(GameArchive archive, const GameArchiveFilter *filter,
+                                      GameArchiveGrouping grouping, int *number_of_groups);
+
+#endif /* GAME_ARCHIVE_H_ */
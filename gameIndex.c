@@ -0,0 +1,164 @@
+#include "gameIndex.h"
+#include "chessSystem.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Type for a reference to a game by its tournament and its ID in the tournament */
+typedef struct game_reference_t {
+    int tournament_id;
+    int game_id;
+} GameReference;
+
+struct game_index_t {
+    GameReference *games;
+    int size;
+    int capacity;
+};
+
+GameIndex gameIndexCreate(int initial_capacity)
+{
+    GameIndex new_index = malloc(sizeof(*new_index));
+    if (new_index == NULL)
+    {
+        return NULL;
+    }
+
+    new_index->capacity = (initial_capacity > 0) ? initial_capacity : GAME_INDEX_INITIAL_CAPACITY;
+    new_index->size = 0;
+    new_index->games = malloc(sizeof(*new_index->games) * new_index->capacity);
+    if (new_index->games == NULL)
+    {
+        free(new_index);
+        return NULL;
+    }
+    return new_index;
+}
+
+GameIndex gameIndexCopy(GameIndex index)
+{
+    if (index == NULL)
+    {
+        return NULL;
+    }
+
+    GameIndex index_cpy = gameIndexCreate(index->capacity);
+    if (index_cpy == NULL)
+    {
+        return NULL;
+    }
+    memcpy(index_cpy->games, index->games, sizeof(*index->games) * index->size);
+    index_cpy->size = index->size;
+    return index_cpy;
+}
+
+void gameIndexDestroy(GameIndex index)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+    free(index->games);
+    free(index);
+}
+
+/**
+*	gameIndexReserve: makes sure a given game index has room for at least the given number of games.
+*
+* @param index - The game index to grow.
+* @param capacity - The number of games the index needs to have room for.
+*
+* @return
+* 	false - In case of memory error.
+*   true - If the index has enough room.
+*/
+static bool gameIndexReserve(GameIndex index, int capacity)
+{
+    if (index->capacity >= capacity)
+    {
+        return true;
+    }
+
+    int new_capacity = index->capacity * 2;
+    if (new_capacity < capacity)
+    {
+        new_capacity = capacity;
+    }
+    GameReference *new_games = realloc(index->games, sizeof(*new_games) * new_capacity);
+    if (new_games == NULL)
+    {
+        return false;
+    }
+    index->games = new_games;
+    index->capacity = new_capacity;
+    return true;
+}
+
+bool gameIndexAdd(GameIndex index, int tournament_id, int game_id)
+{
+    if (index == NULL || gameIndexReserve(index, index->size + 1) == false)
+    {
+        return false;
+    }
+    index->games[index->size].tournament_id = tournament_id;
+    index->games[index->size].game_id = game_id;
+    index->size++;
+    return true;
+}
+
+bool gameIndexAppend(GameIndex destination, GameIndex source)
+{
+    if (destination == NULL || source == NULL ||
+        gameIndexReserve(destination, destination->size + source->size) == false)
+    {
+        return false;
+    }
+    memcpy(destination->games + destination->size, source->games, sizeof(*source->games) * source->size);
+    destination->size = destination->size + source->size;
+    return true;
+}
+
+void gameIndexRemoveLast(GameIndex index)
+{
+    if (index == NULL || index->size == 0)
+    {
+        return;
+    }
+    index->size--;
+}
+
+void gameIndexRemoveTournament(GameIndex index, int tournament_id)
+{
+    if (index == NULL)
+    {
+        return;
+    }
+
+    int new_size = 0;
+    for (int position = 0; position < index->size; position++)
+    {
+        if (index->games[position].tournament_id != tournament_id)
+        {
+            index->games[new_size++] = index->games[position];
+        }
+    }
+    index->size = new_size;
+}
+
+int gameIndexGetSize(GameIndex index)
+{
+    if (index == NULL)
+    {
+        return 0;
+    }
+    return index->size;
+}
+
+int gameIndexGetTournamentID(GameIndex index, int position)
+{
+    return index->games[position].tournament_id;
+}
+
+int gameIndexGetGameID(GameIndex index, int position)
+{
+    return index->games[position].game_id;
+}
@@ -0,0 +1,122 @@
+#ifndef GAME_INDEX_H_
+#define GAME_INDEX_H_
+
+#include <stdbool.h>
+
+#define GAME_INDEX_INITIAL_CAPACITY 4
+
+/** Type for representing the list of games a player participated in */
+typedef struct game_index_t *GameIndex;
+
+/**
+ * gameIndexCreate: creates an empty game index.
+ *
+ * @param initial_capacity - The number of games to allocate room for in advance.
+ * 
+ * @return
+ *     A new game index if success.
+ *     NULL - In case of memory error.
+ */
+GameIndex gameIndexCreate(int initial_capacity);
+
+/**
+ * gameIndexCopy: copies a given game index.
+ *
+ * @param index - The game index to copy.
+ * 
+ * @return
+ *     A new copy of the given game index if success.
+ *     NULL - In case of null argument or memory error.
+ */
+GameIndex gameIndexCopy(GameIndex index);
+
+/**
+ * gameIndexDestroy: Deletes a given game index.
+ *
+ * @param index - The game index to delete.
+ * 
+ * @return
+ *     None
+ */
+void gameIndexDestroy(GameIndex index);
+
+/**
+ * gameIndexAdd: adds a game to the end of a given game index.
+ *
+ * @param index - The game index to add the game to.
+ * @param tournament_id - The ID of the game's tournament.
+ * @param game_id - The ID of the game in its tournament.
+ * 
+ * @return
+ *     false - In case of null argument or memory error.
+ *     true - If the game was added successfully.
+ */
+bool gameIndexAdd(GameIndex index, int tournament_id, int game_id);
+
+/**
+ * gameIndexAppend: adds all the games of a source game index to the end of a destination game index.
+ *
+ * @param destination - The game index to add the games to.
+ * @param source - The game index whose games are added.
+ * 
+ * @return
+ *     false - In case of null argument or memory error.
+ *     true - If the games were added successfully.
+ */
+bool gameIndexAppend(GameIndex destination, GameIndex source);
+
+/**
+ * gameIndexRemoveLast: removes the last game added to a given game index.
+ *
+ * @param index - The game index to remove the game from.
+ * 
+ * @return
+ *     None
+ */
+void gameIndexRemoveLast(GameIndex index);
+
+/**
+ * gameIndexRemoveTournament: removes all the games of a given tournament from a given game index.
+ *
+ * @param index - The game index to remove the games from.
+ * @param tournament_id - The ID of the tournament whose games are removed.
+ * 
+ * @return
+ *     None
+ */
+void gameIndexRemoveTournament(GameIndex index, int tournament_id);
+
+/**
+ * gameIndexGetSize: Gets the number of games in a given game index.
+ *
+ * @param index - The game index which is being checked.
+ * 
+ * @return
+ *     The number of games in the index.
+ *     0 - In case of a NULL argument.
+ */
+int gameIndexGetSize(GameIndex index);
+
+/**
+ * gameIndexGetTournamentID: Gets the tournament ID of the game in a given position of a game index.
+ *
+ * @param index - The game index which is being checked.
+ * @param position - The position of the game in the index. Must be smaller than the index size.
+ * 
+ * @return
+ *     The tournament ID of the game.
+ */
+int gameIndexGetTournamentID(GameIndex index, int position);
+
+/**
+ * gameIndexGetGameID: Gets the game ID of the game in a given position of a game index.
+ *
+ * @param index - The game index which is being checked.
+ * @param position - The position of the game in the index. Must be smaller than the index size.
+ * 
+ * @return
+ *     The ID of the game in its tournament.
+ */
+int gameIndexGetGameID(GameIndex index, int position);
+
+#endif /* GAME_INDEX_H_ */
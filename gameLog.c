@@ -0,0 +1,215 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "gameLog.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GAME_LOG_FIELDS 5
+
+struct game_log_reader_t {
+    const char *data;
+    size_t size;
+    size_t position;
+    int line;
+};
+
+GameLogReader gameLogReaderCreate(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    GameLogReader reader = malloc(sizeof(*reader));
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+    reader->data = NULL;
+    reader->size = 0;
+    reader->position = 0;
+    reader->line = 0;
+
+    int file_descriptor = open(path, O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor < 0 || fstat(file_descriptor, &file_status) != 0)
+    {
+        if (file_descriptor >= 0)
+        {
+            close(file_descriptor);
+        }
+        free(reader);
+        return NULL;
+    }
+
+    // An empty file can't be mapped, and is read as a log without records
+    if (file_status.st_size > 0)
+    {
+        void *data = mmap(NULL, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file_descriptor);
+            free(reader);
+            return NULL;
+        }
+        posix_madvise(data, file_status.st_size, POSIX_MADV_SEQUENTIAL);
+        reader->data = data;
+        reader->size = file_status.st_size;
+    }
+    close(file_descriptor);
+    return reader;
+}
+
+void gameLogReaderDestroy(GameLogReader reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    if (reader->data != NULL)
+    {
+        munmap((void*) reader->data, reader->size);
+    }
+    free(reader);
+}
+
+/**
+*	isBlank: checks if a given character separates the fields of a line.
+*
+* @param character - The character to check.
+* @return
+* 	true - If the character is a space, a tab or a carriage return.
+*   false - Otherwise.
+*/
+static bool isBlank(char character)
+{
+    return character == ' ' || character == '\t' || character == '\r';
+}
+
+/**
+*	parseInt: parses a decimal integer, skipping the blanks before it.
+*
+* @param cursor - The position to parse from. Advanced past the integer on success.
+* @param end - The end of the line.
+* @param value - Output for the parsed integer.
+* @return
+* 	true - If an integer which fits in an int was parsed, and is followed by a blank or the end of the line.
+*   false - Otherwise.
+*/
+static bool parseInt(const char **cursor, const char *end, int *value)
+{
+    const char *current = *cursor;
+    while (current < end && isBlank(*current))
+    {
+        current++;
+    }
+
+    bool negative = false;
+    if (current < end && *current == '-')
+    {
+        negative = true;
+        current++;
+    }
+
+    const char *digits = current;
+    long long number = 0;
+    while (current < end && *current >= '0' && *current <= '9')
+    {
+        number = number * 10 + (*current - '0');
+        if (number > (long long) INT_MAX + 1)
+        {
+            return false;
+        }
+        current++;
+    }
+    if (current == digits || (current < end && isBlank(*current) == false))
+    {
+        return false;
+    }
+
+    number = negative ? -number : number;
+    if (number > INT_MAX)
+    {
+        return false;
+    }
+    *value = (int) number;
+    *cursor = current;
+    return true;
+}
+
+/**
+*	parseRecord: parses a single line of the game log into a record.
+*
+* @param start - The start of the line.
+* @param end - The end of the line, without the line feed.
+* @param record - The record to fill. Its valid field is set according to the line.
+*/
+static void parseRecord(const char *start, const char *end, GameLogRecord *record)
+{
+    int fields[GAME_LOG_FIELDS];
+    const char *cursor = start;
+    record->valid = false;
+
+    for (int index = 0; index < GAME_LOG_FIELDS; index++)
+    {
+        if (parseInt(&cursor, end, &fields[index]) == false)
+        {
+            return;
+        }
+    }
+    while (cursor < end && isBlank(*cursor))
+    {
+        cursor++;
+    }
+    if (cursor != end || fields[3] < FIRST_PLAYER || fields[3] > DRAW)
+    {
+        return;
+    }
+
+    record->tournament_id = fields[0];
+    record->first_player = fields[1];
+    record->second_player = fields[2];
+    record->winner = (Winner) fields[3];
+    record->play_time = fields[4];
+    record->valid = true;
+}
+
+int gameLogReaderRead(GameLogReader reader, GameLogRecord *records, int max_records)
+{
+    if (reader == NULL || records == NULL)
+    {
+        return 0;
+    }
+
+    int number_of_records = 0;
+    while (number_of_records < max_records && reader->position < reader->size)
+    {
+        const char *start = reader->data + reader->position;
+        size_t remaining = reader->size - reader->position;
+        const char *line_feed = memchr(start, '\n', remaining);
+        const char *end = (line_feed != NULL) ? line_feed : start + remaining;
+
+        reader->position += (end - start) + (line_feed != NULL ? 1 : 0);
+        reader->line++;
+
+        const char *cursor = start;
+        while (cursor < end && isBlank(*cursor))
+        {
+            cursor++;
+        }
+        if (cursor == end)
+        {
+            continue;
+        }
+
+        records[number_of_records].line = reader->line;
+        parseRecord(cursor, end, &records[number_of_records]);
+        number_of_records++;
+    }
+    return number_of_records;
+}
@@ -0,0 +1,65 @@
+#ifndef GAME_LOG_H_
+#define GAME_LOG_H_
+
+#include <stdbool.h>
+#include "chessSystem.h"
+
+/**
+* Game Log Reader
+*
+* Reads a text log of games, one game per line in the format
+* "tournament_id first_player second_player winner play_time", where winner is the numeric value
+* of the Winner enum. Fields are separated by spaces or tabs, and blank lines are skipped.
+* The log file is memory mapped and parsed in place, and records are handed out in batches.
+*
+* The following functions are available:
+*   gameLogReaderCreate		- Opens a game log for reading
+*   gameLogReaderDestroy	- Closes a game log
+*   gameLogReaderRead		- Reads the next batch of records from a game log
+*/
+
+/** Type for defining the game log reader */
+typedef struct game_log_reader_t *GameLogReader;
+
+/** Type for a single game read from a game log */
+typedef struct game_log_record_t {
+    int line;
+    bool valid;
+    int tournament_id;
+    int first_player;
+    int second_player;
+    Winner winner;
+    int play_time;
+} GameLogRecord;
+
+/**
+* gameLogReaderCreate: Opens the game log in the given path for reading.
+*
+* @param path - The path of the game log file.
+* @return
+* 	NULL - if the file couldn't be opened or mapped, or allocations failed.
+* 	A new GameLogReader in case of success.
+*/
+GameLogReader gameLogReaderCreate(const char *path);
+
+/**
+* gameLogReaderDestroy: Closes the game log and deallocates the reader.
+*
+* @param reader - Target reader to be deallocated. If reader is NULL nothing will be done.
+*/
+void gameLogReaderDestroy(GameLogReader reader);
+
+/**
+* gameLogReaderRead: Reads the next records from the game log, in the order of the file.
+* 	A line that isn't made of exactly five integers, or whose winner is not a Winner value, is returned
+* 	as a record that is not valid. Integers are not range checked beyond fitting in an int.
+*
+* @param reader - The reader of the game log.
+* @param records - Array to fill with the records read.
+* @param max_records - The size of the records array.
+* @return
+* 	The number of records read - 0 once the whole log was read.
+*/
+int gameLogReaderRead(GameLogReader reader, GameLogRecord *records, int max_records);
+
+#endif /* GAME_LOG_H_ */
@@ -0,0 +1,172 @@
+#include "gamePairSet.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+#define GAME_PAIR_SET_MIN_CAPACITY 16
+#define GAME_PAIR_SET_MAX_LOAD_PERCENT 50
+
+/** Type for a pair of players in a tournament, with the lower ID first */
+typedef struct game_pair_t {
+    int tournament_id;
+    int low_player;
+    int high_player;
+    bool used;
+} GamePair;
+
+struct game_pair_set_t {
+    GamePair *pairs;
+    int size;
+    int capacity;
+};
+
+/**
+*	gamePairMake: creates the pair of the given players in the given tournament.
+*
+* @param tournament_id - The ID of the tournament the players played in.
+* @param player1 - First player's ID.
+* @param player2 - Second player's ID.
+* @return
+* 	The pair, with the lower ID first.
+*/
+static GamePair gamePairMake(int tournament_id, int player1, int player2)
+{
+    GamePair pair = {tournament_id, player1 < player2 ? player1 : player2, player1 < player2 ? player2 : player1,
+                     true};
+    return pair;
+}
+
+/**
+*	gamePairHash: hashes a pair of players in a tournament.
+*
+* @param pair - The pair to hash.
+* @return
+* 	The hash of the pair.
+*/
+static uint64_t gamePairHash(const GamePair *pair)
+{
+    uint64_t hash = (uint32_t) pair->tournament_id;
+    hash = (hash * 0x9E3779B97F4A7C15ULL) ^ (uint32_t) pair->low_player;
+    hash = (hash * 0x9E3779B97F4A7C15ULL) ^ (uint32_t) pair->high_player;
+    hash = hash ^ (hash >> 29);
+    return hash * 0xBF58476D1CE4E5B9ULL;
+}
+
+/**
+*	gamePairSetFind: finds the slot of a pair in the set - the slot holding it, or the empty slot it belongs in.
+*
+* @param pairs - The slots of the set.
+* @param capacity - The number of slots. Must be a power of two.
+* @param pair - The pair to find.
+* @return
+* 	The position of the slot.
+*/
+static int gamePairSetFind(const GamePair *pairs, int capacity, const GamePair *pair)
+{
+    int position = (int) (gamePairHash(pair) & (uint64_t) (capacity - 1));
+    while (pairs[position].used == true &&
+           (pairs[position].tournament_id != pair->tournament_id ||
+            pairs[position].low_player != pair->low_player ||
+            pairs[position].high_player != pair->high_player))
+    {
+        position = (position + 1) & (capacity - 1);
+    }
+    return position;
+}
+
+/**
+*	gamePairSetResize: moves the pairs of the set to a new array of slots.
+*
+* @param set - The set to resize.
+* @param capacity - The new number of slots. Must be a power of two, larger than the size of the set.
+* @return
+* 	false - In case of memory error. The set is unchanged.
+* 	true - If the set was resized.
+*/
+static bool gamePairSetResize(GamePairSet set, int capacity)
+{
+    GamePair *pairs = calloc(capacity, sizeof(*pairs));
+    if (pairs == NULL)
+    {
+        return false;
+    }
+
+    for (int position = 0; position < set->capacity; position++)
+    {
+        if (set->pairs[position].used == true)
+        {
+            pairs[gamePairSetFind(pairs, capacity, &set->pairs[position])] = set->pairs[position];
+        }
+    }
+    free(set->pairs);
+    set->pairs = pairs;
+    set->capacity = capacity;
+    return true;
+}
+
+GamePairSet gamePairSetCreate(int initial_capacity)
+{
+    GamePairSet new_set = malloc(sizeof(*new_set));
+    if (new_set == NULL)
+    {
+        return NULL;
+    }
+
+    int capacity = GAME_PAIR_SET_MIN_CAPACITY;
+    while (capacity / 100 * GAME_PAIR_SET_MAX_LOAD_PERCENT < initial_capacity && capacity < (1 << 30))
+    {
+        capacity = capacity * 2;
+    }
+    new_set->size = 0;
+    new_set->capacity = capacity;
+    new_set->pairs = calloc(capacity, sizeof(*new_set->pairs));
+    if (new_set->pairs == NULL)
+    {
+        free(new_set);
+        return NULL;
+    }
+    return new_set;
+}
+
+void gamePairSetDestroy(GamePairSet set)
+{
+    if (set == NULL)
+    {
+        return;
+    }
+    free(set->pairs);
+    free(set);
+}
+
+bool gamePairSetAdd(GamePairSet set, int tournament_id, int player1, int player2)
+{
+    if (set == NULL)
+    {
+        return false;
+    }
+
+    if ((long long) (set->size + 1) * 100 > (long long) set->capacity * GAME_PAIR_SET_MAX_LOAD_PERCENT &&
+        gamePairSetResize(set, set->capacity * 2) == false)
+    {
+        return false;
+    }
+
+    GamePair pair = gamePairMake(tournament_id, player1, player2);
+    int position = gamePairSetFind(set->pairs, set->capacity, &pair);
+    if (set->pairs[position].used == false)
+    {
+        set->pairs[position] = pair;
+        set->size++;
+    }
+    return true;
+}
+
+bool gamePairSetContains(GamePairSet set, int tournament_id, int player1, int player2)
+{
+    if (set == NULL)
+    {
+        return false;
+    }
+
+    GamePair pair = gamePairMake(tournament_id, player1, player2);
+    return set->pairs[gamePairSetFind(set->pairs, set->capacity, &pair)].used;
+}
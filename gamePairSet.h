@@ -0,0 +1,60 @@
+#ifndef GAME_PAIR_SET_H_
+#define GAME_PAIR_SET_H_
+
+#include <stdbool.h>
+
+/** Type for representing a set of the pairs of players who played each other, per tournament */
+typedef struct game_pair_set_t *GamePairSet;
+
+/**
+ * gamePairSetCreate: creates an empty game pair set.
+ *
+ * @param initial_capacity - The number of pairs to allocate room for in advance.
+ * 
+ * @return
+ *     A new game pair set if success.
+ *     NULL - In case of memory error.
+ */
+GamePairSet gamePairSetCreate(int initial_capacity);
+
+/**
+ * gamePairSetDestroy: frees a given game pair set.
+ *
+ * @param set - The game pair set to free. If set is NULL nothing will be done.
+ * 
+ * @return
+ *     None
+ */
+void gamePairSetDestroy(GamePairSet set);
+
+/**
+ * gamePairSetAdd: adds the pair of the given players in the given tournament to the set.
+ *                 The order of the players doesn't matter.
+ *
+ * @param set - The game pair set to add to.
+ * @param tournament_id - The ID of the tournament the players played in.
+ * @param player1 - First player's ID.
+ * @param player2 - Second player's ID.
+ * 
+ * @return
+ *     false - In case of null argument or memory error.
+ *     true - If the pair was added, or was already in the set.
+ */
+bool gamePairSetAdd(GamePairSet set, int tournament_id, int player1, int player2);
+
+/**
+ * gamePairSetContains: checks if the pair of the given players in the given tournament is in the set.
+ *                      The order of the players doesn't matter.
+ *
+ * @param set - The game pair set to check.
+ * @param tournament_id - The ID of the tournament the players played in.
+ * @param player1 - First player's ID.
+ * @param player2 - Second player's ID.
+ * 
+ * @return
+ *     true - If the pair is in the set.
+ *     false - Otherwise, or in case of null argument.
+ */
+bool gamePairSetContains(GamePairSet set, int tournament_id, int player1, int player2);
+
+#endif /* GAME_PAIR_SET_H_ */
@@ -0,0 +1,501 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "journal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define JOURNAL_MAGIC "CHSJ"
+#define JOURNAL_MAGIC_SIZE 4
+#define JOURNAL_BYTE_ORDER 0x01020304u
+#define JOURNAL_FILE_HEADER_SIZE (JOURNAL_MAGIC_SIZE + 2 * sizeof(uint32_t))
+#define JOURNAL_RECORD_HEADER_SIZE (2 * sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint32_t))
+#define JOURNAL_MAX_TEXT_LENGTH (1 << 20)
+#define JOURNAL_BUFFER_SIZE (1 << 16)
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+#define MILLISECONDS_PER_SECOND 1000
+#define NANOSECONDS_PER_MILLISECOND 1000000
+
+/** The number of integer arguments of each record type */
+static const int journal_record_arguments[JOURNAL_NUMBER_OF_RECORD_TYPES] = {2, 5, 1, 1, 1, 4, 2, 2};
+
+/** The flusher thread of a group commit journal waits on the wake condition, under the journal's lock */
+struct journal_t {
+    FILE *file;
+    JournalSyncPolicy policy;
+    long long group_commit_ms;
+    long long first_pending_ms;
+    bool pending;
+    bool failed;
+    bool closing;
+    bool flusher_started;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_t flusher;
+};
+
+struct journal_reader_t {
+    FILE *file;
+    char *text;
+    int text_capacity;
+    long valid_size;
+};
+
+/**
+*	currentTimeMs: gets the time of a monotonic clock.
+*
+* @return
+* 	The time in milliseconds.
+*/
+static long long currentTimeMs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * MILLISECONDS_PER_SECOND + now.tv_nsec / NANOSECONDS_PER_MILLISECOND;
+}
+
+/**
+*	checksumUpdate: adds bytes to an FNV-1a checksum.
+*
+* @param checksum - The checksum so far.
+* @param bytes - The bytes to add.
+* @param size - The number of bytes.
+* @return
+* 	The updated checksum.
+*/
+static uint32_t checksumUpdate(uint32_t checksum, const void *bytes, size_t size)
+{
+    const unsigned char *current = bytes;
+    for (size_t index = 0; index < size; index++)
+    {
+        checksum = (checksum ^ current[index]) * FNV_PRIME;
+    }
+    return checksum;
+}
+
+/**
+*	isValidRecordType: checks if a given value is a record type.
+*
+* @param type - The value to check.
+* @return
+* 	true - If the value is a record type.
+*   false - Otherwise.
+*/
+static bool isValidRecordType(uint32_t type)
+{
+    return type < JOURNAL_NUMBER_OF_RECORD_TYPES;
+}
+
+/**
+*	readFileHeader: reads and checks the header of a journal file.
+*
+* @param file - The file, positioned at its start.
+* @return
+* 	true - If the file starts with a supported journal header.
+*   false - Otherwise.
+*/
+static bool readFileHeader(FILE *file)
+{
+    char magic[JOURNAL_MAGIC_SIZE];
+    uint32_t version = 0, byte_order = 0;
+    return fread(magic, 1, JOURNAL_MAGIC_SIZE, file) == JOURNAL_MAGIC_SIZE &&
+           fread(&version, sizeof(version), 1, file) == 1 && fread(&byte_order, sizeof(byte_order), 1, file) == 1 &&
+           memcmp(magic, JOURNAL_MAGIC, JOURNAL_MAGIC_SIZE) == 0 && version == JOURNAL_VERSION &&
+           byte_order == JOURNAL_BYTE_ORDER;
+}
+
+/**
+*	writeFileHeader: writes the header of a new journal file.
+*
+* @param file - The file, positioned at its start.
+* @return
+* 	false - If writing failed.
+*   true - Otherwise.
+*/
+static bool writeFileHeader(FILE *file)
+{
+    uint32_t version = JOURNAL_VERSION, byte_order = JOURNAL_BYTE_ORDER;
+    return fwrite(JOURNAL_MAGIC, 1, JOURNAL_MAGIC_SIZE, file) == JOURNAL_MAGIC_SIZE &&
+           fwrite(&version, sizeof(version), 1, file) == 1 && fwrite(&byte_order, sizeof(byte_order), 1, file) == 1;
+}
+
+JournalReader journalReaderCreate(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    JournalReader reader = malloc(sizeof(*reader));
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+    reader->text = NULL;
+    reader->text_capacity = 0;
+    reader->valid_size = JOURNAL_FILE_HEADER_SIZE;
+    reader->file = fopen(path, "rb");
+    if (reader->file == NULL || readFileHeader(reader->file) == false)
+    {
+        journalReaderDestroy(reader);
+        return NULL;
+    }
+    setvbuf(reader->file, NULL, _IOFBF, JOURNAL_BUFFER_SIZE);
+    return reader;
+}
+
+void journalReaderDestroy(JournalReader reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    if (reader->file != NULL)
+    {
+        fclose(reader->file);
+    }
+    free(reader->text);
+    free(reader);
+}
+
+/**
+*	readerReserveText: makes sure the reader's text buffer can hold a text of the given length.
+*
+* @param reader - The journal reader.
+* @param length - The length of the text, without its terminator.
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool readerReserveText(JournalReader reader, int length)
+{
+    if (length < reader->text_capacity)
+    {
+        return true;
+    }
+    char *text = realloc(reader->text, length + 1);
+    if (text == NULL)
+    {
+        return false;
+    }
+    reader->text = text;
+    reader->text_capacity = length + 1;
+    return true;
+}
+
+bool journalReaderNext(JournalReader reader, JournalRecord *record)
+{
+    if (reader == NULL || record == NULL)
+    {
+        return false;
+    }
+
+    uint32_t payload_size = 0, checksum = 0, type = 0;
+    int64_t sequence = 0;
+    if (fread(&payload_size, sizeof(payload_size), 1, reader->file) != 1 ||
+        fread(&checksum, sizeof(checksum), 1, reader->file) != 1 ||
+        fread(&sequence, sizeof(sequence), 1, reader->file) != 1 ||
+        fread(&type, sizeof(type), 1, reader->file) != 1 || isValidRecordType(type) == false)
+    {
+        return false;
+    }
+
+    uint32_t arguments_size = journal_record_arguments[type] * sizeof(int32_t);
+    if (payload_size < arguments_size || payload_size - arguments_size > JOURNAL_MAX_TEXT_LENGTH ||
+        (type != JOURNAL_ADD_TOURNAMENT && payload_size != arguments_size))
+    {
+        return false;
+    }
+    int text_length = (int) (payload_size - arguments_size);
+    int32_t arguments[JOURNAL_MAX_ARGUMENTS] = {0};
+    if (fread(arguments, sizeof(int32_t), journal_record_arguments[type], reader->file) !=
+        (size_t) journal_record_arguments[type] || readerReserveText(reader, text_length) == false ||
+        fread(reader->text, 1, text_length, reader->file) != (size_t) text_length)
+    {
+        return false;
+    }
+    reader->text[text_length] = '\0';
+
+    uint32_t expected_checksum = checksumUpdate(FNV_OFFSET_BASIS, &sequence, sizeof(sequence));
+    expected_checksum = checksumUpdate(expected_checksum, &type, sizeof(type));
+    expected_checksum = checksumUpdate(expected_checksum, arguments, arguments_size);
+    expected_checksum = checksumUpdate(expected_checksum, reader->text, text_length);
+    if (expected_checksum != checksum)
+    {
+        return false;
+    }
+
+    record->type = (JournalRecordType) type;
+    record->sequence = sequence;
+    for (int index = 0; index < JOURNAL_MAX_ARGUMENTS; index++)
+    {
+        record->arguments[index] = arguments[index];
+    }
+    record->text = (type == JOURNAL_ADD_TOURNAMENT) ? reader->text : NULL;
+    reader->valid_size += JOURNAL_RECORD_HEADER_SIZE + payload_size;
+    return true;
+}
+
+/**
+*	journalFindValidSize: finds the size of the complete records of an existing journal file.
+*
+* @param path - The path of the journal file.
+* @param valid_size - Output for the size of the file's header and complete records.
+* @return
+* 	false - If the file is not a journal, or allocations failed.
+*   true - Otherwise.
+*/
+static bool journalFindValidSize(const char *path, long *valid_size)
+{
+    JournalReader reader = journalReaderCreate(path);
+    if (reader == NULL)
+    {
+        return false;
+    }
+    JournalRecord record;
+    while (journalReaderNext(reader, &record) == true)
+    {
+    }
+    *valid_size = reader->valid_size;
+    journalReaderDestroy(reader);
+    return true;
+}
+
+/**
+*	journalSyncLocked: flushes and syncs the records appended to a journal. Must be called with the journal's
+*	lock held.
+*
+* @param journal - The journal.
+* @return
+* 	false - If flushing or syncing failed. The journal is marked as failed.
+*   true - Otherwise.
+*/
+static bool journalSyncLocked(Journal journal)
+{
+    journal->pending = false;
+    bool synced = fflush(journal->file) == 0 && fsync(fileno(journal->file)) == 0;
+    if (synced == false)
+    {
+        journal->failed = true;
+    }
+    return synced;
+}
+
+/**
+*	journalFlusherRun: syncs the pending records of a group commit journal once the group commit interval passed
+*	since the first of them was appended, even if no record is appended after them. Runs until the journal is
+*	closed.
+*
+* @param argument - The journal.
+* @return
+* 	NULL
+*/
+static void *journalFlusherRun(void *argument)
+{
+    Journal journal = argument;
+    pthread_mutex_lock(&journal->lock);
+    while (journal->closing == false)
+    {
+        if (journal->pending == false)
+        {
+            pthread_cond_wait(&journal->wake, &journal->lock);
+            continue;
+        }
+        long long deadline_ms = journal->first_pending_ms + journal->group_commit_ms;
+        if (currentTimeMs() >= deadline_ms)
+        {
+            journalSyncLocked(journal);
+            continue;
+        }
+        struct timespec deadline = {deadline_ms / MILLISECONDS_PER_SECOND,
+                                    (deadline_ms % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND};
+        pthread_cond_timedwait(&journal->wake, &journal->lock, &deadline);
+    }
+    pthread_mutex_unlock(&journal->lock);
+    return NULL;
+}
+
+/**
+*	journalInitLocks: initializes the lock of a journal, and the condition its flusher thread waits on, which
+*	times out by the same monotonic clock as currentTimeMs.
+*
+* @param journal - The journal.
+* @return
+* 	false - If initialization failed. Nothing is left initialized.
+*   true - Otherwise.
+*/
+static bool journalInitLocks(Journal journal)
+{
+    pthread_condattr_t attributes;
+    if (pthread_condattr_init(&attributes) != 0)
+    {
+        return false;
+    }
+    bool initialized = pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC) == 0 &&
+                       pthread_cond_init(&journal->wake, &attributes) == 0;
+    pthread_condattr_destroy(&attributes);
+    if (initialized == true && pthread_mutex_init(&journal->lock, NULL) != 0)
+    {
+        pthread_cond_destroy(&journal->wake);
+        initialized = false;
+    }
+    return initialized;
+}
+
+Journal journalOpen(const char *path, JournalSyncPolicy policy, int group_commit_ms)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    Journal journal = malloc(sizeof(*journal));
+    if (journal == NULL)
+    {
+        return NULL;
+    }
+    if (journalInitLocks(journal) == false)
+    {
+        free(journal);
+        return NULL;
+    }
+    journal->policy = policy;
+    journal->group_commit_ms = (group_commit_ms > 0) ? group_commit_ms : 0;
+    journal->first_pending_ms = 0;
+    journal->pending = false;
+    journal->failed = false;
+    journal->closing = false;
+    journal->flusher_started = false;
+
+    journal->file = fopen(path, "r+b");
+    long valid_size = 0;
+    if (journal->file == NULL)
+    {
+        journal->file = fopen(path, "w+b");
+        if (journal->file == NULL || writeFileHeader(journal->file) == false || journalSync(journal) == false)
+        {
+            journalClose(journal);
+            remove(path);
+            return NULL;
+        }
+    }
+    else if (journalFindValidSize(path, &valid_size) == false ||
+             ftruncate(fileno(journal->file), valid_size) != 0 || fseek(journal->file, valid_size, SEEK_SET) != 0)
+    {
+        journalClose(journal);
+        return NULL;
+    }
+    setvbuf(journal->file, NULL, _IOFBF, JOURNAL_BUFFER_SIZE);
+
+    if (policy == JOURNAL_SYNC_GROUP)
+    {
+        journal->flusher_started = (pthread_create(&journal->flusher, NULL, journalFlusherRun, journal) == 0);
+        if (journal->flusher_started == false)
+        {
+            journalClose(journal);
+            return NULL;
+        }
+    }
+    return journal;
+}
+
+bool journalClose(Journal journal)
+{
+    if (journal == NULL)
+    {
+        return true;
+    }
+    if (journal->flusher_started == true)
+    {
+        pthread_mutex_lock(&journal->lock);
+        journal->closing = true;
+        pthread_cond_signal(&journal->wake);
+        pthread_mutex_unlock(&journal->lock);
+        pthread_join(journal->flusher, NULL);
+    }
+    bool synced = true;
+    if (journal->file != NULL)
+    {
+        synced = journalSync(journal);
+        synced = (fclose(journal->file) == 0) && synced;
+    }
+    pthread_mutex_destroy(&journal->lock);
+    pthread_cond_destroy(&journal->wake);
+    free(journal);
+    return synced;
+}
+
+bool journalSync(Journal journal)
+{
+    if (journal == NULL || journal->file == NULL)
+    {
+        return false;
+    }
+    pthread_mutex_lock(&journal->lock);
+    bool synced = journalSyncLocked(journal) == true && journal->failed == false;
+    pthread_mutex_unlock(&journal->lock);
+    return synced;
+}
+
+bool journalAppend(Journal journal, const JournalRecord *record)
+{
+    if (journal == NULL || record == NULL || isValidRecordType(record->type) == false ||
+        (record->type == JOURNAL_ADD_TOURNAMENT && record->text == NULL))
+    {
+        return false;
+    }
+
+    uint32_t type = record->type;
+    int64_t sequence = record->sequence;
+    int32_t arguments[JOURNAL_MAX_ARGUMENTS];
+    for (int index = 0; index < JOURNAL_MAX_ARGUMENTS; index++)
+    {
+        arguments[index] = record->arguments[index];
+    }
+    uint32_t arguments_size = journal_record_arguments[type] * sizeof(int32_t);
+    size_t text_length = (type == JOURNAL_ADD_TOURNAMENT) ? strlen(record->text) : 0;
+    if (text_length > JOURNAL_MAX_TEXT_LENGTH)
+    {
+        return false;
+    }
+    uint32_t payload_size = arguments_size + (uint32_t) text_length;
+
+    uint32_t checksum = checksumUpdate(FNV_OFFSET_BASIS, &sequence, sizeof(sequence));
+    checksum = checksumUpdate(checksum, &type, sizeof(type));
+    checksum = checksumUpdate(checksum, arguments, arguments_size);
+    checksum = checksumUpdate(checksum, record->text, text_length);
+
+    pthread_mutex_lock(&journal->lock);
+    if (fwrite(&payload_size, sizeof(payload_size), 1, journal->file) != 1 ||
+        fwrite(&checksum, sizeof(checksum), 1, journal->file) != 1 ||
+        fwrite(&sequence, sizeof(sequence), 1, journal->file) != 1 ||
+        fwrite(&type, sizeof(type), 1, journal->file) != 1 ||
+        fwrite(arguments, 1, arguments_size, journal->file) != arguments_size ||
+        (text_length > 0 && fwrite(record->text, 1, text_length, journal->file) != text_length))
+    {
+        pthread_mutex_unlock(&journal->lock);
+        return false;
+    }
+    if (journal->pending == false)
+    {
+        journal->pending = true;
+        journal->first_pending_ms = currentTimeMs();
+        pthread_cond_signal(&journal->wake);
+    }
+
+    bool appended = true;
+    if (journal->policy == JOURNAL_SYNC_EVERY_RECORD ||
+        (journal->policy == JOURNAL_SYNC_GROUP &&
+         currentTimeMs() - journal->first_pending_ms >= journal->group_commit_ms))
+    {
+        appended = journalSyncLocked(journal);
+    }
+    appended = appended == true && journal->failed == false;
+    pthread_mutex_unlock(&journal->lock);
+    return appended;
+}
@@ -0,0 +1,142 @@
+#ifndef JOURNAL_H_
+#define JOURNAL_H_
+
+#include <stdbool.h>
+
+/**
+* Chess System Journal
+*
+* Appends compact binary records of the chess system's mutations to a journal file, and reads them back
+* for replay. The file starts with a versioned header, followed by records of the form
+* [payload size][checksum][sequence number][type][payload], where the payload holds the record's integer
+* arguments and, for new tournaments, the location. A record which was only partly written, or whose checksum
+* doesn't match, ends the journal - it is the tail of a write that was cut short by a crash.
+*
+* Records are written through a buffer. How often the journal is flushed to the disk is set by its sync policy:
+*   JOURNAL_SYNC_EVERY_RECORD   - Every record is flushed and synced before journalAppend returns.
+*   JOURNAL_SYNC_GROUP          - Records are synced together, once the group commit interval passed since the
+*                                 first of them was appended. A flusher thread syncs them when the interval ends,
+*                                 even if no more records are appended, and journalSync syncs them at any time.
+*                                 A sync which failed on the flusher thread fails the next journalAppend.
+*   JOURNAL_SYNC_NONE           - Records are only synced by journalSync and journalClose.
+*
+* The following functions are available:
+*   journalOpen			- Opens a journal for appending records
+*   journalClose		- Syncs and closes a journal
+*   journalAppend		- Appends a record to a journal
+*   journalSync			- Syncs the records appended to a journal
+*   journalReaderCreate	- Opens a journal for reading records
+*   journalReaderDestroy	- Closes a journal reader
+*   journalReaderNext	- Reads the next record of a journal
+*/
+
+#define JOURNAL_VERSION 1
+#define JOURNAL_MAX_ARGUMENTS 5
+
+/** Type for defining the journal */
+typedef struct journal_t *Journal;
+
+/** Type for defining the journal reader */
+typedef struct journal_reader_t *JournalReader;
+
+/** Type for the sync policy of a journal */
+typedef enum JournalSyncPolicy_t {
+    JOURNAL_SYNC_EVERY_RECORD,
+    JOURNAL_SYNC_GROUP,
+    JOURNAL_SYNC_NONE
+} JournalSyncPolicy;
+
+/** Type for the mutations recorded in a journal */
+typedef enum JournalRecordType_t {
+    JOURNAL_ADD_TOURNAMENT,
+    JOURNAL_ADD_GAME,
+    JOURNAL_REMOVE_TOURNAMENT,
+    JOURNAL_REMOVE_PLAYER,
+    JOURNAL_END_TOURNAMENT,
+    JOURNAL_UPDATE_GAME_RESULT,
+    JOURNAL_REMOVE_GAME,
+    JOURNAL_MERGE_PLAYERS,
+    JOURNAL_NUMBER_OF_RECORD_TYPES
+} JournalRecordType;
+
+/** Type for a single journal record. The number of arguments is fixed by the record's type. */
+typedef struct journal_record_t {
+    JournalRecordType type;
+    long long sequence;
+    int arguments[JOURNAL_MAX_ARGUMENTS];
+    const char *text;
+} JournalRecord;
+
+/**
+* journalOpen: Opens the journal in the given path for appending records, creating it if it doesn't exist.
+* 	A torn record at the end of an existing journal is cut off, so new records follow the last complete one.
+*
+* @param path - The path of the journal file.
+* @param policy - The sync policy of the journal.
+* @param group_commit_ms - The group commit interval in milliseconds, for JOURNAL_SYNC_GROUP.
+* @return
+* 	NULL - if the file couldn't be opened, is not a journal, or allocations failed.
+* 	A new Journal in case of success.
+*/
+Journal journalOpen(const char *path, JournalSyncPolicy policy, int group_commit_ms);
+
+/**
+* journalClose: Syncs the journal and closes it.
+*
+* @param journal - Target journal to be closed. If journal is NULL nothing will be done.
+* @return
+* 	false - if the pending records couldn't be synced.
+* 	true - otherwise.
+*/
+bool journalClose(Journal journal);
+
+/**
+* journalAppend: Appends a record to the journal, and syncs it according to the journal's sync policy.
+*
+* @param journal - The journal to append to.
+* @param record - The record to append. text is only written for JOURNAL_ADD_TOURNAMENT, and must not be NULL.
+* @return
+* 	false - if the record couldn't be written or synced.
+* 	true - otherwise.
+*/
+bool journalAppend(Journal journal, const JournalRecord *record);
+
+/**
+* journalSync: Flushes the records appended to the journal and syncs them to the disk.
+*
+* @param journal - The journal to sync.
+* @return
+* 	false - if the records couldn't be written or synced.
+* 	true - otherwise.
+*/
+bool journalSync(Journal journal);
+
+/**
+* journalReaderCreate: Opens the journal in the given path for reading records.
+*
+* @param path - The path of the journal file.
+* @return
+* 	NULL - if the file couldn't be opened, is not a journal, or allocations failed.
+* 	A new JournalReader in case of success.
+*/
+JournalReader journalReaderCreate(const char *path);
+
+/**
+* journalReaderDestroy: Closes the journal and deallocates the reader.
+*
+* @param reader - Target reader to be deallocated. If reader is NULL nothing will be done.
+*/
+void journalReaderDestroy(JournalReader reader);
+
+/**
+* journalReaderNext: Reads the next record of the journal.
+*
+* @param reader - The reader of the journal.
+* @param record - The record to fill. Its text stays valid until the next record is read.
+* @return
+* 	false - if there are no more complete records.
+* 	true - if a record was read.
+*/
+bool journalReaderNext(JournalReader reader, JournalRecord *record);
+
+#endif /* JOURNAL_H_ */
@@ -0,0 +1,670 @@
+#include "lzBlock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define LZ_HASH_BITS 14
+#define LZ_HASH_SIZE (1 << LZ_HASH_BITS)
+#define LZ_HASH_MULTIPLIER 2654435761u
+#define LZ_MAX_OFFSET 65535
+#define LZ_TOKEN_LENGTH_BITS 4
+#define LZ_TOKEN_LENGTH_MAX 15
+#define LZ_LENGTH_BYTE_MAX 255
+#define LZ_SKIP_SHIFT 6
+#define LZ_BLOCK_HEADER_SIZE 8
+#define LZ_STREAM_HEADER_SIZE 8
+#define LZ_BLOCK_SHUFFLED 0x80000000u
+#define LZ_SHUFFLE_WIDTH 4
+
+struct lz_writer_t {
+    FILE *file;
+    char *block;
+    int length;
+    char *compressed;
+    char *shuffled;
+    char *compressed_shuffled;
+    bool started;
+    bool failed;
+};
+
+struct lz_reader_t {
+    FILE *file;
+    char *block;
+    int length;
+    int position;
+    char *compressed;
+    char *shuffled;
+    bool started;
+    bool in_stream;
+    bool ended;
+    bool failed;
+};
+
+/**
+*	readUint32: Reads 4 bytes of memory as an integer, in the byte order of the machine.
+*
+* @param data - The memory to read. Doesn't need to be aligned.
+* @return
+* 	The integer.
+*/
+static uint32_t readUint32(const unsigned char *data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/**
+*	hashSequence: Gets the hash table slot of 4 bytes of input.
+*
+* @param sequence - The 4 bytes, read as an integer.
+* @return
+* 	The slot.
+*/
+static uint32_t hashSequence(uint32_t sequence)
+{
+    return (sequence * LZ_HASH_MULTIPLIER) >> (32 - LZ_HASH_BITS);
+}
+
+/**
+*	putLength: Writes the extra length bytes of a literals or match length.
+*
+* @param output - Where to write the bytes.
+* @param output_end - The end of the output buffer.
+* @param length - The length left after the 15 the token holds.
+* @return
+* 	NULL - If the bytes don't fit in the output buffer.
+* 	The position after the bytes otherwise.
+*/
+static unsigned char *putLength(unsigned char *output, const unsigned char *output_end, int length)
+{
+    for (; length >= LZ_LENGTH_BYTE_MAX; length -= LZ_LENGTH_BYTE_MAX)
+    {
+        if (output == output_end)
+        {
+            return NULL;
+        }
+        *output++ = LZ_LENGTH_BYTE_MAX;
+    }
+    if (output == output_end)
+    {
+        return NULL;
+    }
+    *output++ = (unsigned char) length;
+    return output;
+}
+
+/**
+*	putSequence: Writes a sequence of a compressed block.
+*
+* @param output - Where to write the sequence.
+* @param output_end - The end of the output buffer.
+* @param literals - The literals of the sequence.
+* @param literals_length - The number of literals.
+* @param offset - How far back the match starts.
+* @param match_length - The length of the match, or 0 for the last sequence of the block, which has no match.
+* @return
+* 	NULL - If the sequence doesn't fit in the output buffer.
+* 	The position after the sequence otherwise.
+*/
+static unsigned char *putSequence(unsigned char *output, const unsigned char *output_end,
+                                  const unsigned char *literals, int literals_length, int offset, int match_length)
+{
+    int match_code = (match_length > 0) ? match_length - LZ_MIN_MATCH : 0;
+    if (output == output_end)
+    {
+        return NULL;
+    }
+    unsigned char *token = output++;
+    *token = (unsigned char) (((literals_length < LZ_TOKEN_LENGTH_MAX) ? literals_length : LZ_TOKEN_LENGTH_MAX)
+                              << LZ_TOKEN_LENGTH_BITS);
+    *token |= (unsigned char) ((match_code < LZ_TOKEN_LENGTH_MAX) ? match_code : LZ_TOKEN_LENGTH_MAX);
+
+    if (literals_length >= LZ_TOKEN_LENGTH_MAX &&
+        (output = putLength(output, output_end, literals_length - LZ_TOKEN_LENGTH_MAX)) == NULL)
+    {
+        return NULL;
+    }
+    if (output_end - output < literals_length)
+    {
+        return NULL;
+    }
+    memcpy(output, literals, literals_length);
+    output += literals_length;
+    if (match_length == 0)
+    {
+        return output;
+    }
+
+    if (output_end - output < 2)
+    {
+        return NULL;
+    }
+    *output++ = (unsigned char) (offset & 0xFF);
+    *output++ = (unsigned char) (offset >> 8);
+    if (match_code >= LZ_TOKEN_LENGTH_MAX)
+    {
+        output = putLength(output, output_end, match_code - LZ_TOKEN_LENGTH_MAX);
+    }
+    return output;
+}
+
+int lzBlockBound(int size)
+{
+    return size + size / LZ_LENGTH_BYTE_MAX + 16;
+}
+
+int lzBlockCompress(const char *input, int input_size, char *output, int output_capacity)
+{
+    if (input == NULL || output == NULL || input_size < 0 || input_size > LZ_BLOCK_SIZE || output_capacity < 0)
+    {
+        return 0;
+    }
+
+    const unsigned char *in = (const unsigned char *) input;
+    unsigned char *out = (unsigned char *) output;
+    const unsigned char *out_end = out + output_capacity;
+    int table[LZ_HASH_SIZE];
+    for (int index = 0; index < LZ_HASH_SIZE; index++)
+    {
+        table[index] = -1;
+    }
+
+    int position = 0, anchor = 0;
+    while (position + LZ_MIN_MATCH <= input_size)
+    {
+        uint32_t sequence = readUint32(in + position);
+        uint32_t slot = hashSequence(sequence);
+        int candidate = table[slot];
+        table[slot] = position;
+        if (candidate < 0 || position - candidate > LZ_MAX_OFFSET || readUint32(in + candidate) != sequence)
+        {
+            // Data which doesn't match is skipped faster the longer it goes on, as it is unlikely to compress
+            position += 1 + ((position - anchor) >> LZ_SKIP_SHIFT);
+            continue;
+        }
+
+        int length = LZ_MIN_MATCH;
+        while (position + length < input_size && in[candidate + length] == in[position + length])
+        {
+            length++;
+        }
+        out = putSequence(out, out_end, in + anchor, position - anchor, position - candidate, length);
+        if (out == NULL)
+        {
+            return 0;
+        }
+        position += length;
+        anchor = position;
+        if (position + LZ_MIN_MATCH <= input_size)
+        {
+            table[hashSequence(readUint32(in + position - 2))] = position - 2;
+        }
+    }
+
+    out = putSequence(out, out_end, in + anchor, input_size - anchor, 0, 0);
+    return (out == NULL) ? 0 : (int) (out - (unsigned char *) output);
+}
+
+/**
+*	readLength: Reads the extra length bytes of a literals or match length.
+*
+* @param input - The position of the bytes. Moved past them.
+* @param input_end - The end of the compressed block.
+* @param length - The length to add the bytes to.
+* @return
+* 	false - If the block ended before the last byte, or the length is too large.
+* 	true - Otherwise.
+*/
+static bool readLength(const unsigned char **input, const unsigned char *input_end, int *length)
+{
+    unsigned char byte;
+    do
+    {
+        if (*input == input_end || *length > INT_MAX - LZ_LENGTH_BYTE_MAX)
+        {
+            return false;
+        }
+        byte = *(*input)++;
+        *length += byte;
+    } while (byte == LZ_LENGTH_BYTE_MAX);
+    return true;
+}
+
+int lzBlockDecompress(const char *input, int input_size, char *output, int output_capacity)
+{
+    if (input == NULL || output == NULL || input_size < 0 || output_capacity < 0)
+    {
+        return -1;
+    }
+
+    const unsigned char *in = (const unsigned char *) input;
+    const unsigned char *in_end = in + input_size;
+    unsigned char *out = (unsigned char *) output;
+    unsigned char *out_end = out + output_capacity;
+    while (in < in_end)
+    {
+        int token = *in++;
+        int literals_length = token >> LZ_TOKEN_LENGTH_BITS;
+        if ((literals_length == LZ_TOKEN_LENGTH_MAX && readLength(&in, in_end, &literals_length) == false) ||
+            in_end - in < literals_length || out_end - out < literals_length)
+        {
+            return -1;
+        }
+        memcpy(out, in, literals_length);
+        in += literals_length;
+        out += literals_length;
+        if (in == in_end)
+        {
+            break;
+        }
+
+        if (in_end - in < 2)
+        {
+            return -1;
+        }
+        int offset = in[0] | (in[1] << 8);
+        in += 2;
+        int match_length = token & LZ_TOKEN_LENGTH_MAX;
+        if ((match_length == LZ_TOKEN_LENGTH_MAX && readLength(&in, in_end, &match_length) == false) ||
+            offset == 0 || offset > out - (unsigned char *) output || out_end - out < match_length + LZ_MIN_MATCH)
+        {
+            return -1;
+        }
+        // The match may overlap the bytes it produces, which repeats its start, so it is copied byte by byte
+        const unsigned char *match = out - offset;
+        for (int index = 0; index < match_length + LZ_MIN_MATCH; index++)
+        {
+            out[index] = match[index];
+        }
+        out += match_length + LZ_MIN_MATCH;
+    }
+    return (int) (out - (unsigned char *) output);
+}
+
+/**
+*	putUint32: Writes an integer into memory as 4 bytes, least significant first.
+*
+* @param data - The memory to write to.
+* @param value - The integer.
+* @return
+* 	None
+*/
+static void putUint32(unsigned char *data, uint32_t value)
+{
+    for (int index = 0; index < 4; index++)
+    {
+        data[index] = (unsigned char) (value >> (8 * index));
+    }
+}
+
+/**
+*	getUint32: Reads an integer written by putUint32.
+*
+* @param data - The memory to read.
+* @return
+* 	The integer.
+*/
+static uint32_t getUint32(const unsigned char *data)
+{
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+/**
+*	shuffleBlock: Groups the bytes of a block by their position in 4-byte integers - all the first bytes, then
+*                 all the second bytes, and so on. The high bytes of small integers are then long runs of zeros,
+*                 which compress far better. Bytes after the last whole integer are copied as is.
+*
+* @param output - The buffer for the shuffled block.
+* @param input - The block.
+* @param size - The size of the block.
+* @return
+* 	None
+*/
+static void shuffleBlock(char *output, const char *input, int size)
+{
+    int count = size / LZ_SHUFFLE_WIDTH;
+    for (int index = 0; index < count; index++)
+    {
+        for (int byte = 0; byte < LZ_SHUFFLE_WIDTH; byte++)
+        {
+            output[byte * count + index] = input[index * LZ_SHUFFLE_WIDTH + byte];
+        }
+    }
+    memcpy(output + count * LZ_SHUFFLE_WIDTH, input + count * LZ_SHUFFLE_WIDTH, size - count * LZ_SHUFFLE_WIDTH);
+}
+
+/**
+*	unshuffleBlock: Restores a block shuffled by shuffleBlock.
+*
+* @param output - The buffer for the block.
+* @param input - The shuffled block.
+* @param size - The size of the block.
+* @return
+* 	None
+*/
+static void unshuffleBlock(char *output, const char *input, int size)
+{
+    int count = size / LZ_SHUFFLE_WIDTH;
+    for (int index = 0; index < count; index++)
+    {
+        for (int byte = 0; byte < LZ_SHUFFLE_WIDTH; byte++)
+        {
+            output[index * LZ_SHUFFLE_WIDTH + byte] = input[byte * count + index];
+        }
+    }
+    memcpy(output + count * LZ_SHUFFLE_WIDTH, input + count * LZ_SHUFFLE_WIDTH, size - count * LZ_SHUFFLE_WIDTH);
+}
+
+bool lzIsCompressed(FILE *file)
+{
+    if (file == NULL)
+    {
+        return false;
+    }
+    long position = ftell(file);
+    char magic[LZ_STREAM_MAGIC_SIZE];
+    bool compressed = position >= 0 && fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                      memcmp(magic, LZ_STREAM_MAGIC, LZ_STREAM_MAGIC_SIZE) == 0;
+    return fseek(file, position, SEEK_SET) == 0 && compressed;
+}
+
+LzWriter lzWriterCreate(FILE *file)
+{
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    LzWriter writer = malloc(sizeof(*writer));
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+    writer->block = malloc(LZ_BLOCK_SIZE);
+    writer->compressed = malloc(LZ_BLOCK_SIZE);
+    writer->shuffled = malloc(LZ_BLOCK_SIZE);
+    writer->compressed_shuffled = malloc(LZ_BLOCK_SIZE);
+    if (writer->block == NULL || writer->compressed == NULL || writer->shuffled == NULL ||
+        writer->compressed_shuffled == NULL)
+    {
+        lzWriterDestroy(writer);
+        return NULL;
+    }
+    writer->file = file;
+    writer->length = 0;
+    writer->started = false;
+    writer->failed = false;
+    return writer;
+}
+
+void lzWriterDestroy(LzWriter writer)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+    free(writer->block);
+    free(writer->compressed);
+    free(writer->shuffled);
+    free(writer->compressed_shuffled);
+    free(writer);
+}
+
+/**
+*	writeBlock: Writes a block to the writer's file, preceded by its sizes, and remembers if that failed.
+*
+* @param writer - The writer.
+* @param data - The data of the block.
+* @param size - The uncompressed size of the block. 0 ends the stream.
+* @param stored_size - The size of the data.
+* @param shuffled - Whether the block was shuffled before it was compressed.
+* @return
+* 	None
+*/
+static void writeBlock(LzWriter writer, const char *data, int size, int stored_size, bool shuffled)
+{
+    unsigned char header[LZ_STREAM_HEADER_SIZE + LZ_BLOCK_HEADER_SIZE];
+    size_t header_size = 0;
+    if (writer->started == false)
+    {
+        memcpy(header, LZ_STREAM_MAGIC, LZ_STREAM_MAGIC_SIZE);
+        putUint32(header + LZ_STREAM_MAGIC_SIZE, LZ_STREAM_VERSION);
+        header_size = LZ_STREAM_HEADER_SIZE;
+        writer->started = true;
+    }
+    putUint32(header + header_size, (uint32_t) size);
+    putUint32(header + header_size + 4, (uint32_t) stored_size | (shuffled == true ? LZ_BLOCK_SHUFFLED : 0));
+    header_size += LZ_BLOCK_HEADER_SIZE;
+
+    if (writer->failed == false)
+    {
+        writer->failed = fwrite(header, 1, header_size, writer->file) != header_size ||
+                         (stored_size > 0 && fwrite(data, 1, stored_size, writer->file) != (size_t) stored_size);
+    }
+}
+
+/**
+*	compressBlock: Compresses the writer's buffered data into a block, either as is or shuffled, whichever is
+*                  smaller. The data is stored as is if it doesn't shrink.
+*
+* @param writer - The writer.
+* @return
+* 	None
+*/
+static void compressBlock(LzWriter writer)
+{
+    if (writer->length == 0)
+    {
+        return;
+    }
+    int compressed_size = lzBlockCompress(writer->block, writer->length, writer->compressed, writer->length - 1);
+    shuffleBlock(writer->shuffled, writer->block, writer->length);
+    // Only a shuffled block smaller than the plain one is of use
+    int shuffled_capacity = (compressed_size > 0) ? compressed_size - 1 : writer->length - 1;
+    int shuffled_size = lzBlockCompress(writer->shuffled, writer->length, writer->compressed_shuffled,
+                                        shuffled_capacity);
+    if (shuffled_size > 0)
+    {
+        writeBlock(writer, writer->compressed_shuffled, writer->length, shuffled_size, true);
+    }
+    else if (compressed_size > 0)
+    {
+        writeBlock(writer, writer->compressed, writer->length, compressed_size, false);
+    }
+    else
+    {
+        writeBlock(writer, writer->block, writer->length, writer->length, false);
+    }
+    writer->length = 0;
+}
+
+bool lzWriterWrite(LzWriter writer, const void *data, size_t length)
+{
+    if (writer == NULL || data == NULL)
+    {
+        return false;
+    }
+    const char *bytes = data;
+    while (length > 0 && writer->failed == false)
+    {
+        size_t chunk = LZ_BLOCK_SIZE - writer->length;
+        chunk = (chunk < length) ? chunk : length;
+        memcpy(writer->block + writer->length, bytes, chunk);
+        writer->length += (int) chunk;
+        bytes += chunk;
+        length -= chunk;
+        if (writer->length == LZ_BLOCK_SIZE)
+        {
+            compressBlock(writer);
+        }
+    }
+    return writer->failed == false;
+}
+
+bool lzWriterFinish(LzWriter writer)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+    compressBlock(writer);
+    writeBlock(writer, NULL, 0, 0, false);
+    writer->started = false;
+    return writer->failed == false;
+}
+
+LzReader lzReaderCreate(FILE *file)
+{
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    LzReader reader = malloc(sizeof(*reader));
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+    reader->block = malloc(LZ_BLOCK_SIZE);
+    reader->compressed = malloc(LZ_BLOCK_SIZE);
+    reader->shuffled = malloc(LZ_BLOCK_SIZE);
+    if (reader->block == NULL || reader->compressed == NULL || reader->shuffled == NULL)
+    {
+        lzReaderDestroy(reader);
+        return NULL;
+    }
+    reader->file = file;
+    reader->length = 0;
+    reader->position = 0;
+    reader->started = false;
+    reader->in_stream = false;
+    reader->ended = false;
+    reader->failed = false;
+    return reader;
+}
+
+void lzReaderDestroy(LzReader reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    free(reader->block);
+    free(reader->compressed);
+    free(reader->shuffled);
+    free(reader);
+}
+
+/**
+*	readStreamHeader: Reads the header of a stream. At the end of a stream, the file may either end or continue
+*                     with another stream.
+*
+* @param reader - The reader.
+* @return
+* 	false - If the file ended, or doesn't continue with a stream. The reader is marked as failed in the latter case.
+* 	true - If a stream header was read.
+*/
+static bool readStreamHeader(LzReader reader)
+{
+    unsigned char header[LZ_STREAM_HEADER_SIZE];
+    size_t read = fread(header, 1, sizeof(header), reader->file);
+    if (read == 0 && reader->started == true && ferror(reader->file) == 0)
+    {
+        reader->ended = true;
+        return false;
+    }
+    if (read != sizeof(header) || memcmp(header, LZ_STREAM_MAGIC, LZ_STREAM_MAGIC_SIZE) != 0 ||
+        getUint32(header + LZ_STREAM_MAGIC_SIZE) != LZ_STREAM_VERSION)
+    {
+        reader->failed = true;
+        return false;
+    }
+    reader->started = true;
+    reader->in_stream = true;
+    return true;
+}
+
+/**
+*	readBlock: Reads and decompresses the next block of the stream into the reader's block buffer.
+*
+* @param reader - The reader.
+* @return
+* 	false - If the stream ended or reading failed.
+* 	true - If a block was read.
+*/
+static bool readBlock(LzReader reader)
+{
+    unsigned char header[LZ_BLOCK_HEADER_SIZE];
+    uint32_t size = 0;
+    while (size == 0)
+    {
+        // A stream header comes before the first block, and after each end of stream
+        if (reader->in_stream == false && readStreamHeader(reader) == false)
+        {
+            return false;
+        }
+        if (fread(header, 1, sizeof(header), reader->file) != sizeof(header))
+        {
+            reader->failed = true;
+            return false;
+        }
+        size = getUint32(header);
+        reader->in_stream = (size != 0);
+    }
+
+    uint32_t stored_size = getUint32(header + 4);
+    bool shuffled = (stored_size & LZ_BLOCK_SHUFFLED) != 0;
+    stored_size &= ~LZ_BLOCK_SHUFFLED;
+    if (size > LZ_BLOCK_SIZE || stored_size > size || stored_size == 0 || (shuffled == true && stored_size == size))
+    {
+        reader->failed = true;
+        return false;
+    }
+    char *stored = (stored_size == size) ? reader->block : reader->compressed;
+    char *decompressed = (shuffled == true) ? reader->shuffled : reader->block;
+    if (fread(stored, 1, stored_size, reader->file) != stored_size ||
+        (stored_size != size &&
+         lzBlockDecompress(reader->compressed, (int) stored_size, decompressed, LZ_BLOCK_SIZE) != (int) size))
+    {
+        reader->failed = true;
+        return false;
+    }
+    if (shuffled == true)
+    {
+        unshuffleBlock(reader->block, reader->shuffled, (int) size);
+    }
+    reader->length = (int) size;
+    reader->position = 0;
+    return true;
+}
+
+size_t lzReaderRead(LzReader reader, void *data, size_t length)
+{
+    if (reader == NULL || data == NULL)
+    {
+        return 0;
+    }
+    char *bytes = data;
+    size_t read = 0;
+    while (read < length)
+    {
+        if (reader->position == reader->length &&
+            (reader->ended == true || reader->failed == true || readBlock(reader) == false))
+        {
+            break;
+        }
+        size_t chunk = (size_t) (reader->length - reader->position);
+        chunk = (chunk < length - read) ? chunk : length - read;
+        memcpy(bytes + read, reader->block + reader->position, chunk);
+        reader->position += (int) chunk;
+        read += chunk;
+    }
+    return read;
+}
+
+bool lzReaderFailed(LzReader reader)
+{
+    return reader == NULL || reader->failed == true;
+}
@@ -0,0 +1,190 @@
+#ifndef LZ_BLOCK_H_
+#define LZ_BLOCK_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* LZ Block Compression
+*
+* A small LZ77 compressor, for files such as snapshots and reports, which are mostly small integers and
+* repeated digits. Data is compressed in independent blocks of up to LZ_BLOCK_SIZE bytes. A compressed block
+* is a list of sequences, each made of a token byte, literal bytes copied as is, and a match which repeats
+* earlier output:
+*   token           - The number of literals in the high 4 bits, and the match length minus LZ_MIN_MATCH in
+*                     the low 4 bits. A value of 15 continues in extra length bytes, which are added up until
+*                     a byte below 255.
+*   literals        - The literals, preceded by their extra length bytes.
+*   match offset    - How far back the match starts in the output, 2 bytes, least significant first.
+*   match length    - The extra length bytes of the match.
+* The last sequence of a block holds only literals, and ends with the block.
+*
+* A compressed stream starts with LZ_STREAM_MAGIC and a version, followed by blocks, each preceded by its
+* uncompressed size and stored size, 4 bytes each, least significant first. Before a block is compressed, its
+* bytes may be shuffled - grouped by their position in 4-byte integers, so the high bytes of small integers form
+* long runs of zeros - which the top bit of the stored size marks. Each block is shuffled only if that makes it
+* smaller. A block which doesn't shrink is stored uncompressed, with both sizes equal. A block with an
+* uncompressed size of 0 ends the stream.
+* Streams may be concatenated, and are read back as a single stream.
+*
+* The following functions are available:
+*   lzBlockBound		- Gets the largest size a block may be compressed to
+*   lzBlockCompress		- Compresses a block
+*   lzBlockDecompress	- Decompresses a block
+*   lzIsCompressed		- Checks if a file continues with a compressed stream
+*   lzWriterCreate		- Creates a writer which compresses into a file
+*   lzWriterDestroy		- Deallocates a writer
+*   lzWriterWrite		- Compresses data into the stream
+*   lzWriterFinish		- Writes the buffered data and ends the stream
+*   lzReaderCreate		- Creates a reader which decompresses from a file
+*   lzReaderDestroy		- Deallocates a reader
+*   lzReaderRead		- Reads decompressed data
+*   lzReaderFailed		- Checks if the stream was truncated or corrupt
+*/
+
+/** The largest number of bytes compressed in a single block */
+#define LZ_BLOCK_SIZE (1 << 16)
+
+/** The shortest match a compressed block holds */
+#define LZ_MIN_MATCH 4
+
+/** The first bytes of a compressed stream */
+#define LZ_STREAM_MAGIC "CHLZ"
+#define LZ_STREAM_MAGIC_SIZE 4
+#define LZ_STREAM_VERSION 1
+
+/** Type for defining the stream compressor */
+typedef struct lz_writer_t *LzWriter;
+
+/** Type for defining the stream decompressor */
+typedef struct lz_reader_t *LzReader;
+
+/**
+* lzBlockBound: Gets the largest size a block may be compressed to, when its data doesn't compress at all.
+*
+* @param size - The size of the block.
+* @return
+* 	The size of an output buffer which any block of the given size fits in.
+*/
+int lzBlockBound(int size);
+
+/**
+* lzBlockCompress: Compresses a block.
+*
+* @param input - The data to compress.
+* @param input_size - The size of the data, up to LZ_BLOCK_SIZE.
+* @param output - The buffer to compress into.
+* @param output_capacity - The size of the output buffer.
+* @return
+* 	0 - if a parameter is invalid, or the compressed block doesn't fit in the output buffer.
+* 	The size of the compressed block otherwise.
+*/
+int lzBlockCompress(const char *input, int input_size, char *output, int output_capacity);
+
+/**
+* lzBlockDecompress: Decompresses a block compressed by lzBlockCompress.
+*
+* @param input - The compressed block.
+* @param input_size - The size of the compressed block.
+* @param output - The buffer to decompress into.
+* @param output_capacity - The size of the output buffer.
+* @return
+* 	-1 - if a parameter is invalid, the block is corrupt, or its data doesn't fit in the output buffer.
+* 	The size of the decompressed data otherwise.
+*/
+int lzBlockDecompress(const char *input, int input_size, char *output, int output_capacity);
+
+/**
+* lzIsCompressed: Checks if a file continues with a compressed stream, without moving its position.
+*
+* @param file - The file to check. Must be seekable.
+* @return
+* 	true - if the next bytes of the file are LZ_STREAM_MAGIC.
+* 	false - otherwise, or if file is NULL.
+*/
+bool lzIsCompressed(FILE *file);
+
+/**
+* lzWriterCreate: Creates a writer which compresses data into a file, from its current position.
+* 	The file is not closed by the writer.
+*
+* @param file - The file to write to.
+* @return
+* 	NULL - if file is NULL or allocations failed.
+* 	A new LzWriter in case of success.
+*/
+LzWriter lzWriterCreate(FILE *file);
+
+/**
+* lzWriterDestroy: Deallocates the writer. Data which wasn't written by lzWriterFinish is discarded.
+*
+* @param writer - Target writer to be deallocated. If writer is NULL nothing will be done.
+*/
+void lzWriterDestroy(LzWriter writer);
+
+/**
+* lzWriterWrite: Compresses data into the stream. Data is buffered until a whole block is collected.
+*
+* @param writer - The writer.
+* @param data - The data to write.
+* @param length - The size of the data.
+* @return
+* 	false - if writer or data are NULL, or a write to the file failed so far.
+* 	true - otherwise.
+*/
+bool lzWriterWrite(LzWriter writer, const void *data, size_t length);
+
+/**
+* lzWriterFinish: Compresses the buffered data and ends the stream. Data written afterwards starts a new
+* 	stream, which is read back as the continuation of this one.
+*
+* @param writer - The writer.
+* @return
+* 	false - if writer is NULL, or any write to the file failed.
+* 	true - otherwise.
+*/
+bool lzWriterFinish(LzWriter writer);
+
+/**
+* lzReaderCreate: Creates a reader which decompresses a stream from a file, from its current position.
+* 	The file is not closed by the reader.
+*
+* @param file - The file to read from.
+* @return
+* 	NULL - if file is NULL or allocations failed.
+* 	A new LzReader in case of success.
+*/
+LzReader lzReaderCreate(FILE *file);
+
+/**
+* lzReaderDestroy: Deallocates the reader.
+*
+* @param reader - Target reader to be deallocated. If reader is NULL nothing will be done.
+*/
+void lzReaderDestroy(LzReader reader);
+
+/**
+* lzReaderRead: Reads decompressed data from the stream.
+*
+* @param reader - The reader.
+* @param data - The buffer to read into.
+* @param length - The size of the data to read.
+* @return
+* 	The size of the data read. It is smaller than length only if the stream ended, or reading failed -
+* 	which lzReaderFailed tells apart.
+*/
+size_t lzReaderRead(LzReader reader, void *data, size_t length);
+
+/**
+* lzReaderFailed: Checks if reading the stream failed: the file is not a compressed stream, couldn't be read,
+* 	ended before the end of the stream, or holds a corrupt block.
+*
+* @param reader - The reader.
+* @return
+* 	true - if reading failed, or reader is NULL.
+* 	false - otherwise.
+*/
+bool lzReaderFailed(LzReader reader);
+
+#endif /* LZ_BLOCK_H_ */
@@ -1,341 +1,442 @@
-#include "map.h"
-#include "chessSystem.h"
-#include "player.h"
-#include <stdlib.h>
-
-struct player_t {
-    int id;
-    int wins;
-    int loses;
-    int draws;
-    int total_play_time;
-};
-
-struct rank_t {
-        double level;
-        int id;
-}; 
-
-MapDataElement copyDataPlayer(MapDataElement element)
-{
-    if (element == NULL)
-    {
-        return NULL;
-    }
-
-    Player new_player = playerCopy((Player)element);
-    if (new_player == NULL)
-    {
-        return NULL;
-    }
-    return new_player;
-}
-
-MapKeyElement copyKeyPlayerID(MapKeyElement element)
-{
-    if (element == NULL)
-    {
-        return NULL;
-    }
-
-    int* new_int = malloc(sizeof(*new_int));
-    if (new_int == NULL){
-        return NULL;
-    }
-    *new_int = *(int*) element;
-    return new_int;
-}
-
-MapKeyElement copyKeyRank(MapKeyElement element)
-{
-    if (element == NULL)
-    {
-        return NULL;
-    }
-
-    Rank new_rank = malloc(sizeof(*new_rank));
-    if (new_rank == NULL){
-        return NULL;
-    }
-    new_rank->level = ((Rank) element)->level;
-    new_rank->id = ((Rank) element)->id;
-    return new_rank;
-}
-
-void freeDataPlayer(MapDataElement element)
-{
-    playerDestroy((Player)element);
-}
-
-void freeKeyPlayerID(MapKeyElement element)
-{
-    free(element);
-}
-
-void freeKeyRank(MapKeyElement element)
-{
-    free(element);
-}
-
-int compareKeyPlayerID(MapKeyElement element1, MapKeyElement element2)
-{
-    return *(int*) element1 - *(int*) element2;
-}
-
-//gets num sign - positive or negative
-int sign(double num)
-{
-    return (num < 0) - (num > 0);
-}
-
-int compareKeyRank(MapKeyElement element1, MapKeyElement element2)
-{
-    Rank rank_element1 = (Rank) element1;
-    Rank rank_element2 = (Rank) element2;
-    double level_difference = rank_element1->level - rank_element2->level;
-
-    if (level_difference != 0)
-    {
-        return sign(level_difference); //use sign function because of double to int cast (for example 0.1 would be round to 0 and function will return 0)
-    }
-    else
-    {
-        return rank_element1->id - rank_element2->id;
-    }
-}
-
-Map playerMapFactory()
-{
-    Map player_map = mapCreate(copyDataPlayer, copyKeyPlayerID, freeDataPlayer, freeKeyPlayerID, compareKeyPlayerID);
-    if (player_map == NULL)
-    {
-        return NULL;
-    }
-    return player_map;
-}
-
-Map playersRankMapFactory()
-{
-    Map tournament_map = mapCreate(copyDataPlayer, copyKeyRank, freeDataPlayer, freeKeyRank, compareKeyRank);
-    if (tournament_map == NULL)
-    {
-        return NULL;
-    }
-    return tournament_map;
-}
-
-Player playerCreate(int id)
-{
-    Player new_player = malloc(sizeof(*new_player));
-    if (new_player == NULL)
-    {
-        return NULL;
-    }
-    
-    new_player->id = id;
-    new_player->wins = 0;
-    new_player->loses = 0;
-    new_player->draws = 0;
-    new_player->total_play_time = 0;
-
-    return new_player;
-}
-
-Player playerCopy(Player player)
-{
-    if (player == NULL)
-    {
-        return NULL;
-    }
-
-    Player player_cpy = playerCreate(player->id);
-    if (player_cpy == NULL)
-    {
-        return NULL;
-    }
-
-    player_cpy->wins = player->wins;
-    player_cpy->loses = player->loses;
-    player_cpy->draws = player->draws;
-    player_cpy->total_play_time = player->total_play_time;
-    return player_cpy;
-}
-void playerDestroy(Player player)
-{
-    if (player == NULL)
-    {
-        return;
-    }
-    free(player);
-}
-
-Rank playerRankCreate(double level, int id)
-{
-    Rank new_rank = malloc(sizeof(*new_rank));
-    if (new_rank == NULL)
-    {
-        return NULL;
-    }
-
-    new_rank->level = level;
-    new_rank->id = id;
-    return new_rank;
-}
-
-void playerRankDestroy(Rank rank)
-{
-    if (rank == NULL)
-    {
-        return;
-    }
-    free(rank);
-}
-
-int playerRankGetID(Rank rank)
-{
-    return rank->id;
-}
-
-double playerRankGetLevel(Rank rank)
-{
-    return rank->level;
-}
-
-int playerGetID(Player player)
-{
-    if (player == NULL)
-    {
-        return PLAYER_NOT_EXIST;
-    }
-    return player->id;
-}
-
-void playerSetID(Player player, int id)
-{
-    if (player == NULL)
-    {
-        return;
-    }
-    player->id = id;
-}
-
-int playerGetWins(Player player)
-{
-    if (player == NULL)
-    {
-        return PLAYER_NOT_EXIST;
-    }
-    return player->wins;
-}
-
-int playerGetLoses(Player player)
-{
-    if (player == NULL)
-    {
-        return PLAYER_NOT_EXIST;
-    }
-    return player->loses;
-}
-
-int playerGetDraws(Player player)
-{
-    if (player == NULL)
-    {
-        return PLAYER_NOT_EXIST;
-    }
-    return player->draws;
-}
-
-int playerGetTotalPlayTime(Player player)
-{
-    if (player == NULL)
-    {
-        return PLAYER_NOT_EXIST;
-    }
-    return player->total_play_time;
-}
-
-int playerGetScore(Player player)
-{
-    int wins = player->wins;
-    int draws = player->draws;
-    return (2 * wins + draws);
-}
-
-void playersAddScore(Player players[], Winner score)
-{
-    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
-    {
-        return;
-    }
-    else if (score == DRAW)
-    {
-        players[FIRST_PLAYER]->draws++;
-        players[SECOND_PLAYER]->draws++;
-    }
-    else
-    {
-        players[score]->wins++;
-        players[(score + 1) % 2]->loses++;
-    }
-}
-
-double playerGetLevel(Player player)
-{
-    double wins = playerGetWins(player);
-    double loses = playerGetLoses(player);
-    double draws = playerGetDraws(player);
-    double n = wins + loses + draws; // n is the total number of games played by the player
-    if (n == 0)
-    {
-        return n;
-    }
-    return (6 * wins - 10 * loses + 2 *draws) / n;
-}
-
-void playersRemoveScore(Player players[], Winner score)
-{
-    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
-    {
-        int not_null_player = (players[FIRST_PLAYER] == NULL) ? SECOND_PLAYER : FIRST_PLAYER;
-        players[not_null_player]->wins--;
-    }
-    else if (score == DRAW)
-    {
-        players[FIRST_PLAYER]->draws--;
-        players[SECOND_PLAYER]->draws--;
-    }
-    else
-    {
-        players[score]->wins--;
-        players[(score + 1) % 2]->loses--;
-    }
-}
-
-void playersAddPlayTime(Player players[], int play_time)
-{
-    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
-    {
-        int not_null_player = (players[FIRST_PLAYER] == NULL) ? SECOND_PLAYER : FIRST_PLAYER;
-        players[not_null_player]->total_play_time = players[not_null_player]->total_play_time + play_time;
-    }
-    else
-    {
-        players[FIRST_PLAYER]->total_play_time = players[FIRST_PLAYER]->total_play_time + play_time;
-        players[SECOND_PLAYER]->total_play_time = players[SECOND_PLAYER]->total_play_time + play_time;
-    }    
-}
-
-void playersRemovePlayTime(Player players[], int play_time)
-{
-    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
-    {
-        int not_null_player = (players[FIRST_PLAYER] == NULL) ? SECOND_PLAYER : FIRST_PLAYER;
-        players[not_null_player]->total_play_time = players[not_null_player]->total_play_time - play_time;
-    }
-    else
-    {
-        players[FIRST_PLAYER]->total_play_time = players[FIRST_PLAYER]->total_play_time - play_time;
-        players[SECOND_PLAYER]->total_play_time = players[SECOND_PLAYER]->total_play_time - play_time;
-    }
-}
\ No newline at end of file
+#include "map.h"
+#include "chessSystem.h"
+#include "player.h"
+#include "gameIndex.h"
+#include "pool.h"
+#include <stdlib.h>
+
+#define PLAYER_POOL_BLOCK_SIZE 4096
+
+struct player_t {
+    int id;
+    int wins;
+    int loses;
+    int draws;
+    int total_play_time;
+    long long version;
+    GameIndex games;
+};
+
+struct rank_t {
+        double level;
+        int id;
+}; 
+
+/** Pool which all the players are allocated from, shared by all the chess systems */
+static Pool player_pool = NULL;
+
+bool playerPoolAcquire()
+{
+    return poolAcquireShared(&player_pool, sizeof(struct player_t), PLAYER_POOL_BLOCK_SIZE);
+}
+
+void playerPoolRelease()
+{
+    poolReleaseShared(&player_pool);
+}
+
+bool playerPoolReserve(int number_of_players)
+{
+    return poolReserve(player_pool, number_of_players);
+}
+
+MapDataElement copyDataPlayer(MapDataElement element)
+{
+    if (element == NULL)
+    {
+        return NULL;
+    }
+
+    Player new_player = playerCopy((Player)element);
+    if (new_player == NULL)
+    {
+        return NULL;
+    }
+    return new_player;
+}
+
+MapKeyElement copyKeyPlayerID(MapKeyElement element)
+{
+    if (element == NULL)
+    {
+        return NULL;
+    }
+
+    int* new_int = malloc(sizeof(*new_int));
+    if (new_int == NULL){
+        return NULL;
+    }
+    *new_int = *(int*) element;
+    return new_int;
+}
+
+MapKeyElement copyKeyRank(MapKeyElement element)
+{
+    if (element == NULL)
+    {
+        return NULL;
+    }
+
+    Rank new_rank = malloc(sizeof(*new_rank));
+    if (new_rank == NULL){
+        return NULL;
+    }
+    new_rank->level = ((Rank) element)->level;
+    new_rank->id = ((Rank) element)->id;
+    return new_rank;
+}
+
+void freeDataPlayer(MapDataElement element)
+{
+    playerDestroy((Player)element);
+}
+
+void freeKeyPlayerID(MapKeyElement element)
+{
+    free(element);
+}
+
+void freeKeyRank(MapKeyElement element)
+{
+    free(element);
+}
+
+int compareKeyPlayerID(MapKeyElement element1, MapKeyElement element2)
+{
+    return *(int*) element1 - *(int*) element2;
+}
+
+//gets num sign - positive or negative
+int sign(double num)
+{
+    return (num < 0) - (num > 0);
+}
+
+int compareKeyRank(MapKeyElement element1, MapKeyElement element2)
+{
+    Rank rank_element1 = (Rank) element1;
+    Rank rank_element2 = (Rank) element2;
+    return playerCompareLevels(rank_element1->level, rank_element1->id, rank_element2->level, rank_element2->id);
+}
+
+int playerCompareLevels(double level1, int id1, double level2, int id2)
+{
+    double level_difference = level1 - level2;
+
+    if (level_difference != 0)
+    {
+        return sign(level_difference); //use sign function because of double to int cast (for example 0.1 would be round to 0 and function will return 0)
+    }
+    else
+    {
+        return id1 - id2;
+    }
+}
+
+Map playerMapFactory()
+{
+    Map player_map = mapCreate(copyDataPlayer, copyKeyPlayerID, freeDataPlayer, freeKeyPlayerID, compareKeyPlayerID);
+    if (player_map == NULL)
+    {
+        return NULL;
+    }
+    return player_map;
+}
+
+Map playersRankMapFactory()
+{
+    Map tournament_map = mapCreate(copyDataPlayer, copyKeyRank, freeDataPlayer, freeKeyRank, compareKeyRank);
+    if (tournament_map == NULL)
+    {
+        return NULL;
+    }
+    return tournament_map;
+}
+
+int playerGetMemoryFootprint()
+{
+    return sizeof(struct player_t);
+}
+
+Player playerCreate(int id)
+{
+    Player new_player = poolAllocate(player_pool);
+    if (new_player == NULL)
+    {
+        return NULL;
+    }
+    
+    new_player->id = id;
+    new_player->wins = 0;
+    new_player->loses = 0;
+    new_player->draws = 0;
+    new_player->total_play_time = 0;
+    new_player->version = 0;
+    new_player->games = NULL;
+
+    return new_player;
+}
+
+Player playerCopy(Player player)
+{
+    if (player == NULL)
+    {
+        return NULL;
+    }
+
+    Player player_cpy = playerCreate(player->id);
+    if (player_cpy == NULL)
+    {
+        return NULL;
+    }
+
+    player_cpy->wins = player->wins;
+    player_cpy->loses = player->loses;
+    player_cpy->draws = player->draws;
+    player_cpy->total_play_time = player->total_play_time;
+    player_cpy->version = player->version;
+    return player_cpy;
+}
+void playerDestroy(Player player)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+    gameIndexDestroy(player->games);
+    poolFree(player_pool, player);
+}
+
+Rank playerRankCreate(double level, int id)
+{
+    Rank new_rank = malloc(sizeof(*new_rank));
+    if (new_rank == NULL)
+    {
+        return NULL;
+    }
+
+    new_rank->level = level;
+    new_rank->id = id;
+    return new_rank;
+}
+
+void playerRankDestroy(Rank rank)
+{
+    if (rank == NULL)
+    {
+        return;
+    }
+    free(rank);
+}
+
+int playerRankGetID(Rank rank)
+{
+    return rank->id;
+}
+
+double playerRankGetLevel(Rank rank)
+{
+    return rank->level;
+}
+
+int playerGetID(Player player)
+{
+    if (player == NULL)
+    {
+        return PLAYER_NOT_EXIST;
+    }
+    return player->id;
+}
+
+void playerSetID(Player player, int id)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+    player->id = id;
+}
+
+int playerGetWins(Player player)
+{
+    if (player == NULL)
+    {
+        return PLAYER_NOT_EXIST;
+    }
+    return player->wins;
+}
+
+int playerGetLoses(Player player)
+{
+    if (player == NULL)
+    {
+        return PLAYER_NOT_EXIST;
+    }
+    return player->loses;
+}
+
+int playerGetDraws(Player player)
+{
+    if (player == NULL)
+    {
+        return PLAYER_NOT_EXIST;
+    }
+    return player->draws;
+}
+
+int playerGetTotalPlayTime(Player player)
+{
+    if (player == NULL)
+    {
+        return PLAYER_NOT_EXIST;
+    }
+    return player->total_play_time;
+}
+
+int playerGetScore(Player player)
+{
+    int wins = player->wins;
+    int draws = player->draws;
+    return (2 * wins + draws);
+}
+
+void playersAddScore(Player players[], Winner score)
+{
+    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
+    {
+        return;
+    }
+    else if (score == DRAW)
+    {
+        players[FIRST_PLAYER]->draws++;
+        players[SECOND_PLAYER]->draws++;
+    }
+    else
+    {
+        players[score]->wins++;
+        players[(score + 1) % 2]->loses++;
+    }
+}
+
+double playerGetLevel(Player player)
+{
+    return playerCalculateLevel(playerGetWins(player), playerGetLoses(player), playerGetDraws(player));
+}
+
+double playerCalculateLevel(int wins, int loses, int draws)
+{
+    double n = (double) wins + loses + draws; // n is the total number of games played by the player
+    if (n == 0)
+    {
+        return n;
+    }
+    return (6.0 * wins - 10.0 * loses + 2.0 * draws) / n;
+}
+
+void playersRemoveScore(Player players[], Winner score)
+{
+    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
+    {
+        int not_null_player = (players[FIRST_PLAYER] == NULL) ? SECOND_PLAYER : FIRST_PLAYER;
+        players[not_null_player]->wins--;
+    }
+    else if (score == DRAW)
+    {
+        players[FIRST_PLAYER]->draws--;
+        players[SECOND_PLAYER]->draws--;
+    }
+    else
+    {
+        players[score]->wins--;
+        players[(score + 1) % 2]->loses--;
+    }
+}
+
+void playersAddPlayTime(Player players[], int play_time)
+{
+    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
+    {
+        int not_null_player = (players[FIRST_PLAYER] == NULL) ? SECOND_PLAYER : FIRST_PLAYER;
+        players[not_null_player]->total_play_time = players[not_null_player]->total_play_time + play_time;
+    }
+    else
+    {
+        players[FIRST_PLAYER]->total_play_time = players[FIRST_PLAYER]->total_play_time + play_time;
+        players[SECOND_PLAYER]->total_play_time = players[SECOND_PLAYER]->total_play_time + play_time;
+    }    
+}
+
+void playersRemovePlayTime(Player players[], int play_time)
+{
+    if (players[FIRST_PLAYER] == NULL || players[SECOND_PLAYER] == NULL)
+    {
+        int not_null_player = (players[FIRST_PLAYER] == NULL) ? SECOND_PLAYER : FIRST_PLAYER;
+        players[not_null_player]->total_play_time = players[not_null_player]->total_play_time - play_time;
+    }
+    else
+    {
+        players[FIRST_PLAYER]->total_play_time = players[FIRST_PLAYER]->total_play_time - play_time;
+        players[SECOND_PLAYER]->total_play_time = players[SECOND_PLAYER]->total_play_time - play_time;
+    }
+}
+
+void playerAddStats(Player destination, Player source)
+{
+    if (destination == NULL || source == NULL)
+    {
+        return;
+    }
+    destination->wins = destination->wins + source->wins;
+    destination->loses = destination->loses + source->loses;
+    destination->draws = destination->draws + source->draws;
+    destination->total_play_time = destination->total_play_time + source->total_play_time;
+}
+
+void playerSetStats(Player player, int wins, int loses, int draws, int total_play_time)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+    player->wins = wins;
+    player->loses = loses;
+    player->draws = draws;
+    player->total_play_time = total_play_time;
+}
+
+long long playerGetVersion(Player player)
+{
+    if (player == NULL)
+    {
+        return 0;
+    }
+    return player->version;
+}
+
+void playerSetVersion(Player player, long long version)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+    player->version = version;
+}
+
+GameIndex playerGetGames(Player player)
+{
+    if (player == NULL)
+    {
+        return NULL;
+    }
+    return player->games;
+}
+
+void playerSetGames(Player player, GameIndex games)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+    gameIndexDestroy(player->games);
+    player->games = games;
+}
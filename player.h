@@ -1,6 +1,8 @@
 #ifndef PLAYER_H_
 #define PLAYER_H_
 
+#include "gameIndex.h"
+
 #define PLAYER_NOT_EXIST 0
 
 /* type for representing a player */
@@ -110,6 +112,20 @@ int compareKeyPlayerID(MapKeyElement element1, MapKeyElement element2);
  */
 int compareKeyRank(MapKeyElement element1, MapKeyElement element2);
 
+/**
+ * playerCompareLevels: compares two players by level and id, in the order compareKeyRank compares their ranks -
+ *                      from the highest level to the lowest, and by id for equal levels.
+ *
+ * @param level1 - the first player's level.
+ * @param id1 - the first player's id.
+ * @param level2 - the second player's level.
+ * @param id2 - the second player's id.
+ *
+ * @return
+ *      See compareKeyRank.
+ */
+int playerCompareLevels(double level1, int id1, double level2, int id2);
+
 /**
  * playerMapFactory: Creates a new player map, using the mapCreate function.
  *
@@ -134,6 +150,44 @@ Map playerMapFactory();
  */
 Map playersRankMapFactory();
 
+/**
+ * playerPoolAcquire: registers a user of the pool players are allocated from, which is shared by all the chess
+ *                    systems. Players can only be created while the pool has users.
+ *
+ * @return
+ *     false - in case of an allocation error.
+ *     true - if the user was registered.
+ */
+bool playerPoolAcquire();
+
+/**
+ * playerPoolRelease: unregisters a user of the players pool. The pool is deallocated after its last user is
+ *                    unregistered, so all the players must be destroyed by then.
+ */
+void playerPoolRelease();
+
+/**
+ * playerPoolReserve: makes sure the given number of players can be created without allocating more memory.
+ *
+ * @param number_of_players - the number of players to reserve room for.
+ *
+ * @return
+ *     false - in case of an allocation error.
+ *     true - if the players were reserved.
+ */
+bool playerPoolReserve(int number_of_players);
+
+/**
+ * playerGetMemoryFootprint: gets the size in bytes of a single player.
+ *
+ * @param
+ *     none
+ *
+ * @return
+ *      the size of a player.
+ */
+int playerGetMemoryFootprint();
+
 /**
  * playerCreate: creates a new player.
  *
@@ -146,7 +200,7 @@ Map playersRankMapFactory();
 Player playerCreate(int id);
 
 /**
- * PlayerCopy: copies a given player.
+ * PlayerCopy: copies a given player. The copy doesn't take the player's game index.
  *
  * @param player - the source player which would be copied.
  *
@@ -307,6 +361,18 @@ void playersAddScore(Player players[], Winner score);
 */
 double playerGetLevel(Player player);
 
+/**
+ * playerCalculateLevel: calculates a level the way playerGetLevel does, from the numbers of wins, losses and draws.
+ *
+ * @param wins - the number of wins.
+ * @param loses - the number of losses.
+ * @param draws - the number of draws.
+ *
+ * @return
+ *      The level, or 0 if no games were played.
+*/
+double playerCalculateLevel(int wins, int loses, int draws);
+
 /**
  * playersRemoveScore: removes players' wins, losses, or draws from their scores.
  *                     this function is used in removing a tournament from the chess sysytem,
@@ -345,4 +411,78 @@ void playersAddPlayTime(Player players[], int play_time);
 void playersRemovePlayTime(Player players[], int play_time);
 
 
+/**
+ * playerAddStats: adds the wins, losses, draws and total play time of one player to another player.
+ *                 this function is used when merging two players into one.
+ *
+ * @param destination - the player whose stats are increased.
+ * @param source - the player whose stats are added.
+ *
+ * @return
+ *      none
+ */
+void playerAddStats(Player destination, Player source);
+
+/**
+ * playerSetStats: sets the wins, losses, draws and total play time of a given player.
+ *                 this function is used when a player is loaded from a snapshot.
+ *
+ * @param player - the player whose stats are set.
+ * @param wins - the number of wins of the player.
+ * @param loses - the number of losses of the player.
+ * @param draws - the number of draws of the player.
+ * @param total_play_time - the total play time of the player.
+ *
+ * @return
+ *      none
+ */
+void playerSetStats(Player player, int wins, int loses, int draws, int total_play_time);
+
+/**
+ * playerGetVersion: gets the version of a given player - the value of the system's levels clock when
+ *                   the player's level last changed.
+ *
+ * @param player - the player whose version is returned.
+ *
+ * @return
+ *      0 - if player is NULL or was never changed since it was created.
+ *      the version of the player otherwise.
+ */
+long long playerGetVersion(Player player);
+
+/**
+ * playerSetVersion: sets the version of a given player.
+ *
+ * @param player - the player whose version is set.
+ * @param version - the new version of the player.
+ *
+ * @return
+ *      none
+ */
+void playerSetVersion(Player player, long long version);
+
+/**
+ * playerGetGames: gets the index of the games a given player participated in. Only the players of the system's
+ *                 players map keep one, created with their first game.
+ *
+ * @param player - the player whose game index is returned.
+ *
+ * @return
+ *      NULL - if player is NULL or has no game index.
+ *      the game index of the player otherwise.
+ */
+GameIndex playerGetGames(Player player);
+
+/**
+ * playerSetGames: gives a game index to a given player, which destroys it with the player. The player's previous
+ *                 game index is destroyed.
+ *
+ * @param player - the player whose game index is set.
+ * @param games - the new game index of the player.
+ *
+ * @return
+ *      none
+ */
+void playerSetGames(Player player, GameIndex games);
+
 #endif /* PLAYER_H_ */
\ No newline at end of file
@@ -0,0 +1,407 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "playerDirectory.h"
+#include "chessLock.h"
+#include <stdlib.h>
+
+#define PLAYER_DIRECTORY_STRIPE_BITS 6
+#define PLAYER_DIRECTORY_NUMBER_OF_STRIPES (1 << PLAYER_DIRECTORY_STRIPE_BITS)
+#define PLAYER_DIRECTORY_INITIAL_CAPACITY 16
+#define PLAYER_DIRECTORY_HASH_MULTIPLIER 2654435761u
+#define PLAYER_DIRECTORY_EMPTY_ID 0
+#define PLAYER_DIRECTORY_NO_GENERATION (-1)
+
+/**
+* Type for a player ID of the directory, where its player and game index are, and the statistics published for
+* it. The statistics are guarded by a sequence number which is odd while they are written, so a reader which saw
+* the same even number before and after reading them knows they were not torn. A removed ID keeps its slot, with
+* no player, until the table of its stripe is replaced.
+*/
+typedef struct player_directory_entry_t {
+    int player_id;
+    Player player;
+    GameIndex games;
+    unsigned int sequence;
+    long long generation;
+    int wins;
+    int loses;
+    int draws;
+    int total_play_time;
+} PlayerDirectoryEntry;
+
+/** Type for the hash table of a stripe, with linear probing. A table is replaced by a bigger one when full. */
+typedef struct player_directory_table_t {
+    int capacity;
+    int used;
+    PlayerDirectoryEntry entries[];
+} PlayerDirectoryTable;
+
+/** Type for a stripe of the directory, whose table is allocated on its first insert */
+typedef struct player_directory_stripe_t {
+    ChessMutex lock;
+    PlayerDirectoryTable *table;
+} PlayerDirectoryStripe;
+
+/**
+* Tables are read without locks, so a replaced table is freed only once no reader may still be in it. Readers
+* count themselves in one of two counters, by the parity of the epoch they entered at. The writer which replaced
+* a table moves the epoch on, so new readers count themselves in the other counter, and waits for the counter of
+* the old epoch to drain before freeing the table.
+*/
+struct player_directory_t {
+    PlayerDirectoryStripe stripes[PLAYER_DIRECTORY_NUMBER_OF_STRIPES];
+    long long generation;
+    unsigned long epoch;
+    long readers[2];
+    ChessMutex reclaim_lock;
+};
+
+/**
+*	playerDirectoryHash: mixes the bits of a player ID, so consecutive IDs spread over the stripes and slots.
+*
+* @param player_id - The player ID.
+* @return
+* 	The hash of the ID.
+*/
+static unsigned int playerDirectoryHash(int player_id)
+{
+    return (unsigned int) player_id * PLAYER_DIRECTORY_HASH_MULTIPLIER;
+}
+
+/**
+*	playerDirectoryGetStripe: finds the stripe of a player ID, by the high bits of its hash.
+*
+* @param player_id - The player ID.
+* @return
+* 	The index of the stripe.
+*/
+static int playerDirectoryGetStripe(int player_id)
+{
+    return (int) (playerDirectoryHash(player_id) >> (32 - PLAYER_DIRECTORY_STRIPE_BITS));
+}
+
+/**
+*	tableFindSlot: finds the slot of a player ID in a table, or the empty slot it would be inserted at.
+*
+* @param table - The table.
+* @param player_id - The player ID.
+* @return
+* 	The index of the slot.
+*/
+static int tableFindSlot(PlayerDirectoryTable *table, int player_id)
+{
+    int mask = table->capacity - 1;
+    int slot = (int) (playerDirectoryHash(player_id) & (unsigned int) mask);
+    int current_id = chessAtomicLoad(&table->entries[slot].player_id);
+    while (current_id != PLAYER_DIRECTORY_EMPTY_ID && current_id != player_id)
+    {
+        slot = (slot + 1) & mask;
+        current_id = chessAtomicLoad(&table->entries[slot].player_id);
+    }
+    return slot;
+}
+
+/**
+*	tableCreate: allocates a table holding the entries of another table, without its removed IDs.
+*
+* @param table - The table to copy, or NULL for none.
+* @return
+* 	NULL - if the allocation failed.
+* 	The new table otherwise, with room for at least as many entries again.
+*/
+static PlayerDirectoryTable *tableCreate(PlayerDirectoryTable *table)
+{
+    int live = 0;
+    for (int slot = 0; table != NULL && slot < table->capacity; slot++)
+    {
+        live += (table->entries[slot].player != NULL);
+    }
+    int capacity = PLAYER_DIRECTORY_INITIAL_CAPACITY;
+    while (capacity < (live + 1) * 4)
+    {
+        capacity = capacity * 2;
+    }
+
+    PlayerDirectoryTable *new_table = calloc(1, sizeof(*new_table) + sizeof(*new_table->entries) * capacity);
+    if (new_table == NULL)
+    {
+        return NULL;
+    }
+    new_table->capacity = capacity;
+    new_table->used = live;
+    for (int slot = 0; table != NULL && slot < table->capacity; slot++)
+    {
+        if (table->entries[slot].player != NULL)
+        {
+            new_table->entries[tableFindSlot(new_table, table->entries[slot].player_id)] = table->entries[slot];
+        }
+    }
+    return new_table;
+}
+
+/**
+*	playerDirectoryEnter: counts a reader in the current epoch, so no table it may read is freed until it leaves.
+*
+* @param directory - The directory.
+* @return
+* 	The parity of the epoch the reader is counted in, to pass to playerDirectoryLeave.
+*/
+static int playerDirectoryEnter(PlayerDirectory directory)
+{
+    while (true)
+    {
+        unsigned long epoch = chessAtomicLoadOrdered(&directory->epoch);
+        chessAtomicAdd(&directory->readers[epoch & 1], 1);
+        // A writer which moved the epoch on meanwhile may have missed the reader, so it counts itself again
+        if (chessAtomicLoadOrdered(&directory->epoch) == epoch)
+        {
+            return (int) (epoch & 1);
+        }
+        chessAtomicAdd(&directory->readers[epoch & 1], -1);
+    }
+}
+
+/**
+*	playerDirectoryLeave: stops counting a reader counted by playerDirectoryEnter.
+*
+* @param directory - The directory.
+* @param parity - The parity returned by playerDirectoryEnter.
+* @return
+* 	None
+*/
+static void playerDirectoryLeave(PlayerDirectory directory, int parity)
+{
+    chessAtomicAdd(&directory->readers[parity], -1);
+}
+
+/**
+*	playerDirectoryRetire: frees a replaced table, once the readers which may still be in it left.
+*
+* @param directory - The directory.
+* @param table - The replaced table, which new readers can't reach anymore.
+* @return
+* 	None
+*/
+static void playerDirectoryRetire(PlayerDirectory directory, PlayerDirectoryTable *table)
+{
+    chessMutexLock(&directory->reclaim_lock);
+    unsigned long epoch = chessAtomicAdd(&directory->epoch, 1) - 1;
+    while (chessAtomicLoadOrdered(&directory->readers[epoch & 1]) != 0)
+    {
+        chessYield();
+    }
+    chessMutexUnlock(&directory->reclaim_lock);
+    free(table);
+}
+
+PlayerDirectory playerDirectoryCreate()
+{
+    PlayerDirectory directory = malloc(sizeof(*directory));
+    if (directory == NULL)
+    {
+        return NULL;
+    }
+    if (chessMutexInit(&directory->reclaim_lock) == false)
+    {
+        free(directory);
+        return NULL;
+    }
+
+    for (int index = 0; index < PLAYER_DIRECTORY_NUMBER_OF_STRIPES; index++)
+    {
+        if (chessMutexInit(&directory->stripes[index].lock) == false)
+        {
+            while (index-- > 0)
+            {
+                chessMutexDestroy(&directory->stripes[index].lock);
+            }
+            chessMutexDestroy(&directory->reclaim_lock);
+            free(directory);
+            return NULL;
+        }
+        directory->stripes[index].table = NULL;
+    }
+    directory->generation = 0;
+    directory->epoch = 0;
+    directory->readers[0] = 0;
+    directory->readers[1] = 0;
+    return directory;
+}
+
+void playerDirectoryDestroy(PlayerDirectory directory)
+{
+    if (directory == NULL)
+    {
+        return;
+    }
+
+    for (int index = 0; index < PLAYER_DIRECTORY_NUMBER_OF_STRIPES; index++)
+    {
+        chessMutexDestroy(&directory->stripes[index].lock);
+        free(directory->stripes[index].table);
+    }
+    chessMutexDestroy(&directory->reclaim_lock);
+    free(directory);
+}
+
+void playerDirectoryLock(PlayerDirectory directory, int first_player, int second_player)
+{
+    int first_stripe = playerDirectoryGetStripe(first_player);
+    int second_stripe = playerDirectoryGetStripe(second_player);
+    chessMutexLock(&directory->stripes[first_stripe < second_stripe ? first_stripe : second_stripe].lock);
+    if (first_stripe != second_stripe)
+    {
+        chessMutexLock(&directory->stripes[first_stripe < second_stripe ? second_stripe : first_stripe].lock);
+    }
+}
+
+void playerDirectoryUnlock(PlayerDirectory directory, int first_player, int second_player)
+{
+    int first_stripe = playerDirectoryGetStripe(first_player);
+    int second_stripe = playerDirectoryGetStripe(second_player);
+    if (first_stripe != second_stripe)
+    {
+        chessMutexUnlock(&directory->stripes[second_stripe].lock);
+    }
+    chessMutexUnlock(&directory->stripes[first_stripe].lock);
+}
+
+/**
+*	playerDirectoryFindEntry: finds the entry of a player ID which was not removed. The stripe of the ID must be
+*                             locked.
+*
+* @param directory - The directory.
+* @param player_id - The player ID.
+* @return
+* 	NULL - if the ID is not in the directory.
+* 	The entry otherwise.
+*/
+static PlayerDirectoryEntry *playerDirectoryFindEntry(PlayerDirectory directory, int player_id)
+{
+    PlayerDirectoryTable *table = directory->stripes[playerDirectoryGetStripe(player_id)].table;
+    if (table == NULL)
+    {
+        return NULL;
+    }
+    PlayerDirectoryEntry *entry = &table->entries[tableFindSlot(table, player_id)];
+    return (entry->player_id == player_id && entry->player != NULL) ? entry : NULL;
+}
+
+bool playerDirectoryFind(PlayerDirectory directory, int player_id, Player *player, GameIndex *games)
+{
+    PlayerDirectoryEntry *entry = playerDirectoryFindEntry(directory, player_id);
+    if (entry == NULL)
+    {
+        return false;
+    }
+    *player = entry->player;
+    *games = entry->games;
+    return true;
+}
+
+bool playerDirectoryInsert(PlayerDirectory directory, int player_id, Player player, GameIndex games)
+{
+    PlayerDirectoryStripe *stripe = &directory->stripes[playerDirectoryGetStripe(player_id)];
+    PlayerDirectoryTable *table = stripe->table;
+    if (table == NULL || (table->used + 1) * 2 > table->capacity)
+    {
+        PlayerDirectoryTable *new_table = tableCreate(table);
+        if (new_table == NULL)
+        {
+            return false;
+        }
+        chessAtomicStore(&stripe->table, new_table);
+        if (table != NULL)
+        {
+            playerDirectoryRetire(directory, table);
+        }
+        table = new_table;
+    }
+
+    PlayerDirectoryEntry *entry = &table->entries[tableFindSlot(table, player_id)];
+    // The statistics of a new or updated ID are published again before readers may use them
+    chessAtomicStore(&entry->generation, PLAYER_DIRECTORY_NO_GENERATION);
+    entry->player = player;
+    entry->games = games;
+    if (entry->player_id == PLAYER_DIRECTORY_EMPTY_ID)
+    {
+        table->used++;
+        chessAtomicStore(&entry->player_id, player_id);
+    }
+    return true;
+}
+
+void playerDirectoryRemove(PlayerDirectory directory, int player_id)
+{
+    PlayerDirectoryEntry *entry = playerDirectoryFindEntry(directory, player_id);
+    if (entry != NULL)
+    {
+        chessAtomicStore(&entry->generation, PLAYER_DIRECTORY_NO_GENERATION);
+        entry->player = NULL;
+        entry->games = NULL;
+    }
+}
+
+void playerDirectoryPublish(PlayerDirectory directory, int player_id, const PlayerDirectoryStats *stats)
+{
+    PlayerDirectoryEntry *entry = playerDirectoryFindEntry(directory, player_id);
+    if (entry == NULL)
+    {
+        return;
+    }
+
+    unsigned int sequence = entry->sequence;
+    chessAtomicStoreRelaxed(&entry->sequence, sequence + 1);
+    chessAtomicStore(&entry->wins, stats->wins);
+    chessAtomicStore(&entry->loses, stats->loses);
+    chessAtomicStore(&entry->draws, stats->draws);
+    chessAtomicStore(&entry->total_play_time, stats->total_play_time);
+    chessAtomicStore(&entry->generation, chessAtomicLoad(&directory->generation));
+    chessAtomicStore(&entry->sequence, sequence + 2);
+}
+
+/**
+*	entryRead: reads the statistics published for an entry, again while a writer is in the middle of publishing.
+*
+* @param entry - The entry.
+* @param stats - Output for the statistics.
+* @return
+* 	The generation the statistics were published at.
+*/
+static long long entryRead(PlayerDirectoryEntry *entry, PlayerDirectoryStats *stats)
+{
+    while (true)
+    {
+        unsigned int sequence = chessAtomicLoad(&entry->sequence);
+        stats->wins = chessAtomicLoad(&entry->wins);
+        stats->loses = chessAtomicLoad(&entry->loses);
+        stats->draws = chessAtomicLoad(&entry->draws);
+        stats->total_play_time = chessAtomicLoad(&entry->total_play_time);
+        long long generation = chessAtomicLoad(&entry->generation);
+        if ((sequence & 1) == 0 && chessAtomicLoad(&entry->sequence) == sequence)
+        {
+            return generation;
+        }
+        chessYield();
+    }
+}
+
+bool playerDirectoryRead(PlayerDirectory directory, int player_id, PlayerDirectoryStats *stats)
+{
+    int parity = playerDirectoryEnter(directory);
+    PlayerDirectoryTable *table = chessAtomicLoad(&directory->stripes[playerDirectoryGetStripe(player_id)].table);
+    bool found = false;
+    if (table != NULL)
+    {
+        PlayerDirectoryEntry *entry = &table->entries[tableFindSlot(table, player_id)];
+        found = (chessAtomicLoad(&entry->player_id) == player_id &&
+                 entryRead(entry, stats) == chessAtomicLoad(&directory->generation));
+    }
+    playerDirectoryLeave(directory, parity);
+    return found;
+}
+
+void playerDirectoryInvalidate(PlayerDirectory directory)
+{
+    chessAtomicAdd(&directory->generation, 1);
+}
@@ -0,0 +1,152 @@
+#ifndef PLAYER_DIRECTORY_H_
+#define PLAYER_DIRECTORY_H_
+
+#include <stdbool.h>
+#include "chessSystem.h"
+#include "map.h"
+#include "player.h"
+#include "gameIndex.h"
+
+/**
+* Player Directory
+*
+* Finds the player and the game index of a player ID of the chess system in constant time, instead of walking
+* the players map and the game indexes map. The directory is split into stripes by player ID, each a small
+* hash table with its own lock, so threads adding games of different players don't wait for each other. The
+* directory only points at the entries of the maps, which stay the owners of the players and the game indexes,
+* and an ID which is not in the directory may still be in the maps.
+*
+* The directory also holds statistics published for each player, which playerDirectoryRead reads without any
+* lock while other threads add games. Statistics are trusted only if they were published since the directory was
+* last invalidated, so a change which updates players without publishing them invalidates the directory instead.
+* The tables of the stripes are replaced as they grow, and a replaced table is freed only once every reader which
+* may still be reading it is done.
+*
+* The stripe of a player ID must be locked with playerDirectoryLock while it is found, inserted, removed or
+* published.
+*
+* The following functions are available:
+*   playerDirectoryCreate	- Creates a new empty directory
+*   playerDirectoryDestroy	- Deletes an existing directory and frees all resources
+*   playerDirectoryLock	- Locks the stripes of two player IDs
+*   playerDirectoryUnlock	- Unlocks the stripes of two player IDs
+*   playerDirectoryFind	- Finds the player and the game index of a player ID
+*   playerDirectoryInsert	- Adds a player ID, or updates it if it is already there
+*   playerDirectoryRemove	- Removes a player ID
+*   playerDirectoryPublish	- Publishes the statistics of a player ID for readers
+*   playerDirectoryRead	- Reads the published statistics of a player ID, without locking
+*   playerDirectoryInvalidate	- Stops trusting all the statistics published so far
+*/
+
+/** Type for defining the player directory */
+typedef struct player_directory_t *PlayerDirectory;
+
+/** Type for the statistics of a player published in the directory */
+typedef struct player_directory_stats_t {
+    int wins;
+    int loses;
+    int draws;
+    int total_play_time;
+} PlayerDirectoryStats;
+
+/**
+* playerDirectoryCreate: Allocates a new empty directory.
+*
+* @return
+* 	NULL - if allocations failed.
+* 	A new PlayerDirectory in case of success.
+*/
+PlayerDirectory playerDirectoryCreate();
+
+/**
+* playerDirectoryDestroy: Deallocates an existing directory. The players and game indexes are not touched.
+*
+* @param directory - Target directory to be deallocated. If directory is NULL nothing will be done.
+*/
+void playerDirectoryDestroy(PlayerDirectory directory);
+
+/**
+* playerDirectoryLock: Locks the stripes of two player IDs, in the order of the stripes. The IDs may share a
+* stripe, or be equal.
+*
+* @param directory - The directory.
+* @param first_player - The first player ID.
+* @param second_player - The second player ID.
+*/
+void playerDirectoryLock(PlayerDirectory directory, int first_player, int second_player);
+
+/**
+* playerDirectoryUnlock: Unlocks the stripes locked by playerDirectoryLock with the same IDs.
+*
+* @param directory - The directory.
+* @param first_player - The first player ID.
+* @param second_player - The second player ID.
+*/
+void playerDirectoryUnlock(PlayerDirectory directory, int first_player, int second_player);
+
+/**
+* playerDirectoryFind: Finds the player and the game index of a player ID.
+*
+* @param directory - The directory.
+* @param player_id - The player ID. Must be positive.
+* @param player - Output for the player.
+* @param games - Output for the game index.
+* @return
+* 	false - if the ID is not in the directory. The outputs are unchanged in that case.
+* 	true - if the ID was found.
+*/
+bool playerDirectoryFind(PlayerDirectory directory, int player_id, Player *player, GameIndex *games);
+
+/**
+* playerDirectoryInsert: Adds a player ID with its player and game index, or updates them if the ID is already
+* in the directory.
+*
+* @param directory - The directory.
+* @param player_id - The player ID. Must be positive.
+* @param player - The player.
+* @param games - The game index of the player.
+* @return
+* 	false - if an allocation failed. The directory is unchanged in that case.
+* 	true - if the ID was added or updated.
+*/
+bool playerDirectoryInsert(PlayerDirectory directory, int player_id, Player player, GameIndex games);
+
+/**
+* playerDirectoryRemove: Removes a player ID. IDs which are not in the directory are ignored.
+*
+* @param directory - The directory.
+* @param player_id - The player ID.
+*/
+void playerDirectoryRemove(PlayerDirectory directory, int player_id);
+
+/**
+* playerDirectoryPublish: Publishes the statistics of a player ID, so playerDirectoryRead finds them until the
+* directory is invalidated. IDs which are not in the directory are ignored.
+*
+* @param directory - The directory.
+* @param player_id - The player ID.
+* @param stats - The statistics of the player.
+*/
+void playerDirectoryPublish(PlayerDirectory directory, int player_id, const PlayerDirectoryStats *stats);
+
+/**
+* playerDirectoryRead: Reads the statistics published for a player ID. Needs no lock, and may run while other
+* threads insert, remove and publish.
+*
+* @param directory - The directory.
+* @param player_id - The player ID. Must be positive.
+* @param stats - Output for the statistics.
+* @return
+* 	false - if no statistics were published for the ID since it was inserted or the directory was invalidated.
+* 	true - if the statistics were read.
+*/
+bool playerDirectoryRead(PlayerDirectory directory, int player_id, PlayerDirectoryStats *stats);
+
+/**
+* playerDirectoryInvalidate: Stops trusting all the statistics published so far, until they are published again.
+*
+* @param directory - The directory.
+*/
+void playerDirectoryInvalidate(PlayerDirectory directory);
+
+#endif /* PLAYER_DIRECTORY_H_ */
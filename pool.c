@@ -0,0 +1,205 @@
+#include "pool.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+#define POOL_ALIGNMENT sizeof(void*)
+
+/** Type for defining the free objects of the pool, which are linked through their own memory */
+typedef struct free_object_t {
+    struct free_object_t *next;
+} *FreeObject;
+
+/** Type for defining the blocks the pool hands objects out of */
+typedef struct block_t {
+    struct block_t *next;
+} *Block;
+
+struct pool_t {
+    int object_size;
+    int block_size;
+    Block blocks;
+    FreeObject free_objects;
+    int number_of_free_objects;
+    pthread_mutex_t lock;
+    int number_of_users;
+};
+
+/** Guards the creation, user counts and deletion of every shared pool */
+static pthread_mutex_t shared_pools_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+*	alignSize: Rounds a given size up to the pool's alignment.
+*
+* @param size - The size to align.
+* @return
+* 	The aligned size.
+*/
+static int alignSize(int size)
+{
+    return (int) (((size + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT) * POOL_ALIGNMENT);
+}
+
+Pool poolCreate(int object_size, int block_size)
+{
+    if (object_size <= 0)
+    {
+        return NULL;
+    }
+
+    Pool pool = malloc(sizeof(*pool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    pool->object_size = alignSize(object_size < (int) sizeof(struct free_object_t) ?
+                                  (int) sizeof(struct free_object_t) : object_size);
+    pool->blocks = NULL;
+    pool->free_objects = NULL;
+    pool->number_of_free_objects = 0;
+    pool->number_of_users = 0;
+    if (pthread_mutex_init(&pool->lock, NULL) != 0)
+    {
+        free(pool);
+        return NULL;
+    }
+    poolSetBlockSize(pool, block_size);
+    return pool;
+}
+
+void poolDestroy(Pool pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    while (pool->blocks != NULL)
+    {
+        Block next = pool->blocks->next;
+        free(pool->blocks);
+        pool->blocks = next;
+    }
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+void poolSetBlockSize(Pool pool, int block_size)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->block_size = (block_size < pool->object_size) ? pool->object_size : block_size;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+*	poolAddBlock: Allocates a new block for the given number of objects and adds its objects
+*	to the pool's free list.
+*
+* @param pool - The pool to grow.
+* @param number_of_objects - The number of objects in the new block. Must be positive.
+* @return
+* 	false - If the allocation failed.
+* 	true - If the block was added.
+*/
+static bool poolAddBlock(Pool pool, int number_of_objects)
+{
+    int header_size = alignSize(sizeof(struct block_t));
+    Block block = malloc(header_size + (size_t) pool->object_size * number_of_objects);
+    if (block == NULL)
+    {
+        return false;
+    }
+    block->next = pool->blocks;
+    pool->blocks = block;
+
+    char *objects = (char*) block + header_size;
+    for (int index = number_of_objects - 1; index >= 0; index--)
+    {
+        FreeObject object = (FreeObject) (objects + (size_t) pool->object_size * index);
+        object->next = pool->free_objects;
+        pool->free_objects = object;
+    }
+    pool->number_of_free_objects = pool->number_of_free_objects + number_of_objects;
+    return true;
+}
+
+bool poolReserve(Pool pool, int number_of_objects)
+{
+    if (pool == NULL)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    bool reserved = (pool->number_of_free_objects >= number_of_objects ||
+                     poolAddBlock(pool, number_of_objects - pool->number_of_free_objects) == true);
+    pthread_mutex_unlock(&pool->lock);
+    return reserved;
+}
+
+void *poolAllocate(Pool pool)
+{
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->free_objects == NULL && poolAddBlock(pool, pool->block_size / pool->object_size) == false)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+
+    FreeObject object = pool->free_objects;
+    pool->free_objects = object->next;
+    pool->number_of_free_objects--;
+    pthread_mutex_unlock(&pool->lock);
+    return object;
+}
+
+void poolFree(Pool pool, void *object)
+{
+    if (pool == NULL || object == NULL)
+    {
+        return;
+    }
+
+    FreeObject free_object = object;
+    pthread_mutex_lock(&pool->lock);
+    free_object->next = pool->free_objects;
+    pool->free_objects = free_object;
+    pool->number_of_free_objects++;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+bool poolAcquireShared(Pool *shared_pool, int object_size, int block_size)
+{
+    pthread_mutex_lock(&shared_pools_lock);
+    if (*shared_pool == NULL)
+    {
+        *shared_pool = poolCreate(object_size, block_size);
+    }
+    bool acquired = (*shared_pool != NULL);
+    if (acquired == true)
+    {
+        (*shared_pool)->number_of_users++;
+    }
+    pthread_mutex_unlock(&shared_pools_lock);
+    return acquired;
+}
+
+void poolReleaseShared(Pool *shared_pool)
+{
+    pthread_mutex_lock(&shared_pools_lock);
+    if (*shared_pool != NULL && --(*shared_pool)->number_of_users == 0)
+    {
+        poolDestroy(*shared_pool);
+        *shared_pool = NULL;
+    }
+    pthread_mutex_unlock(&shared_pools_lock);
+}
@@ -0,0 +1,105 @@
+#ifndef POOL_H_
+#define POOL_H_
+
+#include <stdbool.h>
+
+/**
+* Fixed Size Object Pool
+*
+* Hands out objects of a single size from large blocks, instead of allocating each object separately.
+* Freed objects are kept in a free list and reused by later allocations. Blocks are only released
+* when the pool is destroyed.
+* Allocating and freeing objects is thread safe, so pools may be shared by worker threads.
+*
+* The following functions are available:
+*   poolCreate		- Creates a new empty pool
+*   poolDestroy		- Deletes an existing pool and all the blocks it allocated
+*   poolReserve		- Makes sure a number of objects can be allocated without growing
+*   poolSetBlockSize	- Sets the size of the blocks the pool grows by
+*   poolAllocate		- Allocates an object from the pool
+*   poolFree		- Returns an object to the pool
+*   poolAcquireShared	- Creates a pool shared by several users, or registers another user of it
+*   poolReleaseShared	- Unregisters a user of a shared pool, deleting the pool after its last user
+*/
+
+/** Type for defining the pool */
+typedef struct pool_t *Pool;
+
+/**
+* poolCreate: Allocates a new empty pool.
+*
+* @param object_size - The size in bytes of the objects the pool hands out.
+* @param block_size - The size in bytes of the blocks the pool grows by.
+* @return
+* 	NULL - if object_size is not positive or allocations failed.
+* 	A new Pool in case of success.
+*/
+Pool poolCreate(int object_size, int block_size);
+
+/**
+* poolDestroy: Deallocates an existing pool, including all the objects allocated from it.
+*
+* @param pool - Target pool to be deallocated. If pool is NULL nothing will be done.
+*/
+void poolDestroy(Pool pool);
+
+/**
+* poolReserve: Makes sure the given number of objects can be allocated from the pool without
+* allocating more memory.
+*
+* @param pool - The pool to reserve objects in.
+* @param number_of_objects - The number of objects to reserve.
+* @return
+* 	false - if a NULL was sent or the allocation failed.
+* 	true - if the objects were reserved.
+*/
+bool poolReserve(Pool pool, int number_of_objects);
+
+/**
+* poolSetBlockSize: Sets the size of the blocks the pool allocates when it runs out of objects.
+*
+* @param pool - The pool to update.
+* @param block_size - The size in bytes of the blocks. Blocks always hold at least one object.
+*/
+void poolSetBlockSize(Pool pool, int block_size);
+
+/**
+* poolAllocate: Allocates an object from the pool.
+*
+* @param pool - The pool to allocate from.
+* @return
+* 	NULL - if a NULL was sent or the allocation failed.
+* 	An uninitialized object of the pool's object size otherwise.
+*/
+void *poolAllocate(Pool pool);
+
+/**
+* poolFree: Returns an object allocated from the pool, so it can be reused.
+*
+* @param pool - The pool the object was allocated from.
+* @param object - The object to return. If NULL nothing will be done.
+*/
+void poolFree(Pool pool, void *object);
+
+/**
+* poolAcquireShared: Registers a user of a pool shared by several users. The first user creates the pool.
+* Users may acquire and release the pool from several threads at once.
+*
+* @param shared_pool - The variable holding the shared pool, NULL while the pool has no users.
+* @param object_size - The size in bytes of the objects the pool hands out, used if the pool is created.
+* @param block_size - The size in bytes of the blocks the pool grows by, used if the pool is created.
+* @return
+* 	false - if the pool had to be created and the allocation failed.
+* 	true - if the user was registered.
+*/
+bool poolAcquireShared(Pool *shared_pool, int object_size, int block_size);
+
+/**
+* poolReleaseShared: Unregisters a user of a shared pool. Once the last user releases it, the pool and all the
+* objects allocated from it are deallocated, and the variable holding it is set to NULL.
+*
+* @param shared_pool - The variable holding the shared pool. Must have been acquired by the caller.
+*/
+void poolReleaseShared(Pool *shared_pool);
+
+#endif /* POOL_H_ */
@@ -0,0 +1,184 @@
+#include "readOnly.h"
+#include "map.h"
+#include "player.h"
+#include <stdlib.h>
+
+/** Type for a chess system read in place from a mapped snapshot */
+struct chess_read_only_t {
+    SnapshotMapping mapping;
+};
+
+/** Type for the level of a player of a read only chess system, which the levels report is sorted by */
+typedef struct read_only_level_t {
+    double level;
+    int player_id;
+} ReadOnlyLevel;
+
+/**
+*	readOnlyHasEnded: checks if a tournament of a snapshot ended - ended tournaments hold their winner's ID.
+*
+* @param tournament - The tournament's record.
+*
+* @return
+* 	true - If the tournament ended.
+*   false - Otherwise.
+*/
+static bool readOnlyHasEnded(const SnapshotTournament *tournament)
+{
+    return tournament->winner > 0;
+}
+
+ChessReadOnly readOnlyOpen(const char *path, ChessResult *result)
+{
+    ChessReadOnly chess = malloc(sizeof(*chess));
+    if (chess == NULL)
+    {
+        *result = CHESS_OUT_OF_MEMORY;
+        return NULL;
+    }
+    if (snapshotMap(path, &chess->mapping) != SNAPSHOT_SUCCESS)
+    {
+        free(chess);
+        *result = CHESS_SAVE_FAILURE;
+        return NULL;
+    }
+    *result = CHESS_SUCCESS;
+    return chess;
+}
+
+void readOnlyClose(ChessReadOnly chess)
+{
+    if (chess == NULL)
+    {
+        return;
+    }
+    snapshotUnmap(&chess->mapping);
+    free(chess);
+}
+
+bool readOnlyFindPlayer(ChessReadOnly chess, int player_id, SnapshotPlayer *player)
+{
+    int low = 0, high = chess->mapping.number_of_players - 1;
+    while (low <= high)
+    {
+        int middle = low + (high - low) / 2;
+        *player = snapshotMappedPlayer(&chess->mapping, middle);
+        if (player->player_id == player_id)
+        {
+            return true;
+        }
+        if (player->player_id < player_id)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return false;
+}
+
+bool readOnlyHasEndedTournaments(ChessReadOnly chess)
+{
+    for (int index = 0; index < chess->mapping.number_of_tournaments; index++)
+    {
+        SnapshotTournament tournament = snapshotMappedTournament(&chess->mapping, index);
+        if (readOnlyHasEnded(&tournament) == true)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+*	compareReadOnlyLevels: compares the levels of two players, in the order of the levels report.
+*
+* @param element1 - The first ReadOnlyLevel.
+* @param element2 - The second ReadOnlyLevel.
+*
+* @return
+*   See playerCompareLevels.
+*/
+static int compareReadOnlyLevels(const void *element1, const void *element2)
+{
+    const ReadOnlyLevel *level1 = element1;
+    const ReadOnlyLevel *level2 = element2;
+    return playerCompareLevels(level1->level, level1->player_id, level2->level, level2->player_id);
+}
+
+ChessResult readOnlyWritePlayersLevels(ChessReadOnly chess, ReportWriter writer)
+{
+    ReadOnlyLevel *levels = malloc(sizeof(*levels) * (chess->mapping.number_of_players + 1));
+    if (levels == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    int number_of_levels = 0;
+    for (int index = 0; index < chess->mapping.number_of_players; index++)
+    {
+        SnapshotPlayer player = snapshotMappedPlayer(&chess->mapping, index);
+        if (player.total_play_time != 0)
+        {
+            levels[number_of_levels].level = playerCalculateLevel(player.wins, player.loses, player.draws);
+            levels[number_of_levels++].player_id = player.player_id;
+        }
+    }
+    qsort(levels, number_of_levels, sizeof(*levels), compareReadOnlyLevels);
+
+    bool written = true;
+    for (int index = 0; index < number_of_levels && written == true; index++)
+    {
+        written = reportWriterPutLevel(writer, levels[index].player_id, levels[index].level);
+    }
+    free(levels);
+    return (written == true) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+ChessResult readOnlyWriteTournamentStatistics(ChessReadOnly chess, ReportWriter writer)
+{
+    const SnapshotMapping *mapping = &chess->mapping;
+    long long location_offset = 0, games_offset = 0;
+    for (int index = 0; index < mapping->number_of_tournaments; index++)
+    {
+        SnapshotTournament tournament = snapshotMappedTournament(mapping, index);
+        if (tournament.location_length < 0 || tournament.games_count < 0 ||
+            location_offset + tournament.location_length > mapping->locations_size ||
+            games_offset + tournament.games_count > mapping->number_of_games)
+        {
+            return CHESS_SAVE_FAILURE;
+        }
+
+        if (readOnlyHasEnded(&tournament) == true)
+        {
+            int longest_game_time = 0;
+            for (int game = 0; game < tournament.games_count; game++)
+            {
+                int play_time = snapshotMappedGame(mapping, (int) games_offset + game).play_time;
+                longest_game_time = (play_time > longest_game_time) ? play_time : longest_game_time;
+            }
+            int length = 0;
+            char *statistics = reportRenderTournamentStatistics(tournament.winner, longest_game_time,
+                                                                tournament.total_play_time,
+                                                                tournament.number_of_games,
+                                                                tournament.number_of_players,
+                                                                mapping->locations + location_offset,
+                                                                tournament.location_length, &length);
+            if (statistics == NULL)
+            {
+                return CHESS_OUT_OF_MEMORY;
+            }
+            bool written = reportWriterPutBytes(writer, statistics, length);
+            free(statistics);
+            if (written == false)
+            {
+                return CHESS_SAVE_FAILURE;
+            }
+        }
+        location_offset += tournament.location_length;
+        games_offset += tournament.games_count;
+    }
+    return CHESS_SUCCESS;
+}
@@ -0,0 +1,96 @@
+#ifndef READ_ONLY_H_
+#define READ_ONLY_H_
+
+#include <stdbool.h>
+#include "chessSystemExtensions.h"
+#include "snapshot.h"
+#include "reportWriter.h"
+
+/**
+* Read Only Chess System
+*
+* Answers queries on a snapshot file saved by chessSaveSnapshot, read in place from its memory-mapped pages
+* instead of being loaded into a chess system (see snapshotMap). Players are found by a binary search of the
+* players section, which the snapshot keeps sorted by ID, and the reports are written from the mapped sections in
+* the same bytes the chess system writes them.
+*
+* The following functions are available:
+*   readOnlyOpen			- Maps a snapshot file
+*   readOnlyClose			- Unmaps a snapshot file
+*   readOnlyFindPlayer		- Finds a player by ID
+*   readOnlyHasEndedTournaments	- Checks if any tournament of the snapshot ended
+*   readOnlyWritePlayersLevels	- Writes the players' levels report
+*   readOnlyWriteTournamentStatistics	- Writes the tournament statistics report
+*/
+
+/**
+* readOnlyOpen: Maps a snapshot file for queries.
+*
+* @param path - The path of the snapshot file. Must not be NULL.
+* @param result - Output for the result.
+* 	CHESS_OUT_OF_MEMORY - in case of memory error.
+* 	CHESS_SAVE_FAILURE - if the file couldn't be mapped, or is not a valid snapshot.
+* 	CHESS_SUCCESS - otherwise.
+* @return
+* 	NULL - in case of failure.
+* 	The read only chess system otherwise.
+*/
+ChessReadOnly readOnlyOpen(const char *path, ChessResult *result);
+
+/**
+* readOnlyClose: Unmaps the snapshot file of a read only chess system, and deallocates it.
+*
+* @param chess - The read only chess system. If chess is NULL nothing will be done.
+*/
+void readOnlyClose(ChessReadOnly chess);
+
+/**
+* readOnlyFindPlayer: Finds a player of a read only chess system.
+*
+* @param chess - The read only chess system.
+* @param player_id - The ID of the player.
+* @param player - Output for the player's record.
+* @return
+* 	false - if there is no such player.
+* 	true - otherwise.
+*/
+bool readOnlyFindPlayer(ChessReadOnly chess, int player_id, SnapshotPlayer *player);
+
+/**
+* readOnlyHasEndedTournaments: Checks if any tournament of a read only chess system ended.
+*
+* @param chess - The read only chess system.
+* @return
+* 	true - if a tournament ended.
+* 	false - otherwise.
+*/
+bool readOnlyHasEndedTournaments(ChessReadOnly chess);
+
+/**
+* readOnlyWritePlayersLevels: Writes the levels report of the players of a read only chess system, sorted as
+* 	chessSavePlayersLevels sorts them. The writer is not flushed.
+*
+* @param chess - The read only chess system.
+* @param writer - The writer of the report.
+* @return
+* 	CHESS_OUT_OF_MEMORY - in case of memory error.
+* 	CHESS_SAVE_FAILURE - if writing failed.
+* 	CHESS_SUCCESS - otherwise.
+*/
+ChessResult readOnlyWritePlayersLevels(ChessReadOnly chess, ReportWriter writer);
+
+/**
+* readOnlyWriteTournamentStatistics: Writes the statistics of the ended tournaments of a read only chess system,
+* 	by tournament ID. The sections of the tournaments are found by adding up the sizes of the tournaments before
+* 	them, and are checked to be within the mapped snapshot. The writer is not flushed.
+*
+* @param chess - The read only chess system.
+* @param writer - The writer of the report.
+* @return
+* 	CHESS_OUT_OF_MEMORY - in case of memory error.
+* 	CHESS_SAVE_FAILURE - if writing failed, or the snapshot's sections are inconsistent.
+* 	CHESS_SUCCESS - otherwise.
+*/
+ChessResult readOnlyWriteTournamentStatistics(ChessReadOnly chess, ReportWriter writer);
+
+#endif /* READ_ONLY_H_ */
@@ -0,0 +1,167 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "reportWriter.h"
+
+/**
+* Report Writer Benchmark
+*
+* Writes the same levels export - "%d %.2lf" lines of player IDs and levels - once with fprintf and once with
+* the report writer, times both, and checks that the two files are identical.
+*
+* Usage: reportBenchmark [number_of_lines] [directory]
+*/
+
+#define DEFAULT_NUMBER_OF_LINES 10000000
+#define COMPARE_BUFFER_SIZE (1 << 16)
+#define MAX_PATH_LENGTH 4096
+
+/**
+*	levelOf: Gets the level of the player in a given line, spread like real levels, with many exact ties.
+*
+* @param line - The index of the line.
+* @return
+* 	The level.
+*/
+static double levelOf(int line)
+{
+    int wins = line % 7, losses = line % 5, draws = line % 11;
+    int games = wins + losses + draws + 1;
+    return (double) (6 * wins - 10 * losses + 2 * draws) / (double) games;
+}
+
+/**
+*	secondsSince: Gets the time passed since a given time.
+*
+* @param start - The start time.
+* @return
+* 	The seconds passed.
+*/
+static double secondsSince(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+*	writeWithPrintf: Writes the export with fprintf.
+*
+* @param path - The path of the export.
+* @param number_of_lines - The number of lines to write.
+* @return
+* 	The seconds writing took, or a negative number if writing failed.
+*/
+static double writeWithPrintf(const char *path, int number_of_lines)
+{
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    for (int line = 0; line < number_of_lines; line++)
+    {
+        if (fprintf(file, "%d %.2lf\n", line + 1, levelOf(line)) < 0)
+        {
+            fclose(file);
+            return -1;
+        }
+    }
+    return (fclose(file) == 0) ? secondsSince(&start) : -1;
+}
+
+/**
+*	writeWithReportWriter: Writes the export with the report writer.
+*
+* @param path - The path of the export.
+* @param number_of_lines - The number of lines to write.
+* @return
+* 	The seconds writing took, or a negative number if writing failed.
+*/
+static double writeWithReportWriter(const char *path, int number_of_lines)
+{
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    ReportWriter writer = reportWriterCreate(file);
+    bool written = (writer != NULL);
+    for (int line = 0; line < number_of_lines && written; line++)
+    {
+        written = reportWriterPutInt(writer, line + 1) && reportWriterPutChar(writer, ' ') &&
+                  reportWriterPutFixed2(writer, levelOf(line)) && reportWriterPutChar(writer, '\n');
+    }
+    written = reportWriterFlush(writer) && written;
+    reportWriterDestroy(writer);
+    written = (fclose(file) == 0) && written;
+    return (written == true) ? secondsSince(&start) : -1;
+}
+
+/**
+*	isSameFile: Checks if two files have the same content.
+*
+* @param path1 - The path of the first file.
+* @param path2 - The path of the second file.
+* @return
+* 	true - If both files could be read and are identical.
+* 	false - Otherwise.
+*/
+static bool isSameFile(const char *path1, const char *path2)
+{
+    FILE *file1 = fopen(path1, "rb");
+    FILE *file2 = fopen(path2, "rb");
+    char *buffer1 = malloc(COMPARE_BUFFER_SIZE);
+    char *buffer2 = malloc(COMPARE_BUFFER_SIZE);
+    bool same = (file1 != NULL && file2 != NULL && buffer1 != NULL && buffer2 != NULL);
+    size_t length1 = 1;
+    while (same == true && length1 > 0)
+    {
+        length1 = fread(buffer1, 1, COMPARE_BUFFER_SIZE, file1);
+        size_t length2 = fread(buffer2, 1, COMPARE_BUFFER_SIZE, file2);
+        same = (length1 == length2 && memcmp(buffer1, buffer2, length1) == 0);
+    }
+    if (file1 != NULL)
+    {
+        fclose(file1);
+    }
+    if (file2 != NULL)
+    {
+        fclose(file2);
+    }
+    free(buffer1);
+    free(buffer2);
+    return same;
+}
+
+int main(int argc, char *argv[])
+{
+    int number_of_lines = (argc > 1) ? atoi(argv[1]) : DEFAULT_NUMBER_OF_LINES;
+    const char *directory = (argc > 2) ? argv[2] : ".";
+    char printf_path[MAX_PATH_LENGTH], writer_path[MAX_PATH_LENGTH];
+    snprintf(printf_path, sizeof(printf_path), "%s/reportBenchmarkPrintf.tmp", directory);
+    snprintf(writer_path, sizeof(writer_path), "%s/reportBenchmarkWriter.tmp", directory);
+
+    double printf_seconds = writeWithPrintf(printf_path, number_of_lines);
+    double writer_seconds = writeWithReportWriter(writer_path, number_of_lines);
+    bool same = isSameFile(printf_path, writer_path);
+    remove(printf_path);
+    remove(writer_path);
+    if (printf_seconds < 0 || writer_seconds < 0)
+    {
+        fprintf(stderr, "writing the export failed\n");
+        return 1;
+    }
+
+    printf("lines:         %d\n", number_of_lines);
+    printf("fprintf:       %.3lf s\n", printf_seconds);
+    printf("report writer: %.3lf s (%.1lfx)\n", writer_seconds, printf_seconds / writer_seconds);
+    printf("output:        %s\n", (same == true) ? "identical" : "DIFFERENT");
+    return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,582 @@
+#define _POSIX_C_SOURCE 200809L
+#include "reportWriter.h"
+#include "lzBlock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define DIGITS_BUFFER_SIZE 24
+#define DOUBLE_MANTISSA_BITS 52
+#define DOUBLE_EXPONENT_MASK 0x7FF
+#define DOUBLE_SIGN_BIT 63
+#define DOUBLE_EXPONENT_BIAS 1075
+#define FIXED2_SCALE 100
+
+/** Type for the kinds of outputs a report writer writes to */
+typedef enum {
+    REPORT_SINK_FILE,
+    REPORT_SINK_FD,
+    REPORT_SINK_MEMORY
+} ReportSink;
+
+/**
+* The writer formats into buffer. For files and file descriptors it is the writer's own buffer, which is
+* written out whenever it fills. For memory it is the caller's buffer, which is grown in place instead.
+*/
+struct report_writer_t {
+    ReportSink sink;
+    FILE *file;
+    LzWriter compressor;
+    int fd;
+    char **memory;
+    size_t *memory_length;
+    size_t *memory_capacity;
+    char *buffer;
+    size_t length;
+    size_t capacity;
+    bool failed;
+};
+
+/**
+*	writerCreate: Allocates a writer for a given output.
+*
+* @param sink - The kind of output.
+* @param buffer - The buffer to format into, or NULL to allocate the writer's own buffer.
+* @param length - The length of the text already in the buffer.
+* @param capacity - The size of the buffer.
+* @return
+* 	NULL - If allocations failed.
+* 	The new writer otherwise.
+*/
+static ReportWriter writerCreate(ReportSink sink, char *buffer, size_t length, size_t capacity)
+{
+    ReportWriter writer = malloc(sizeof(*writer));
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+    if (sink != REPORT_SINK_MEMORY)
+    {
+        buffer = malloc(REPORT_WRITER_BUFFER_SIZE);
+        if (buffer == NULL)
+        {
+            free(writer);
+            return NULL;
+        }
+        capacity = REPORT_WRITER_BUFFER_SIZE;
+    }
+    writer->sink = sink;
+    writer->file = NULL;
+    writer->compressor = NULL;
+    writer->fd = -1;
+    writer->memory = NULL;
+    writer->memory_length = NULL;
+    writer->memory_capacity = NULL;
+    writer->buffer = buffer;
+    writer->length = length;
+    writer->capacity = capacity;
+    writer->failed = false;
+    return writer;
+}
+
+ReportWriter reportWriterCreate(FILE *file)
+{
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    ReportWriter writer = writerCreate(REPORT_SINK_FILE, NULL, 0, 0);
+    if (writer != NULL)
+    {
+        writer->file = file;
+    }
+    return writer;
+}
+
+ReportWriter reportWriterCreateCompressed(FILE *file)
+{
+    ReportWriter writer = reportWriterCreate(file);
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+    writer->compressor = lzWriterCreate(file);
+    if (writer->compressor == NULL)
+    {
+        reportWriterDestroy(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+ReportWriter reportWriterCreateForFd(int fd)
+{
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    ReportWriter writer = writerCreate(REPORT_SINK_FD, NULL, 0, 0);
+    if (writer != NULL)
+    {
+        writer->fd = fd;
+    }
+    return writer;
+}
+
+ReportWriter reportWriterCreateForMemory(char **data, size_t *length, size_t *capacity)
+{
+    if (data == NULL || length == NULL || capacity == NULL || *length > *capacity ||
+        (*data == NULL && *capacity != 0))
+    {
+        return NULL;
+    }
+
+    ReportWriter writer = writerCreate(REPORT_SINK_MEMORY, *data, *length, *capacity);
+    if (writer != NULL)
+    {
+        writer->memory = data;
+        writer->memory_length = length;
+        writer->memory_capacity = capacity;
+    }
+    return writer;
+}
+
+void reportWriterDestroy(ReportWriter writer)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+    if (writer->sink != REPORT_SINK_MEMORY)
+    {
+        free(writer->buffer);
+    }
+    lzWriterDestroy(writer->compressor);
+    free(writer);
+}
+
+/**
+*	writeToFd: Writes characters to a file descriptor, continuing after partial and interrupted writes.
+*
+* @param fd - The file descriptor.
+* @param data - The characters to write.
+* @param length - The number of characters.
+* @return
+* 	false - If writing failed.
+* 	true - Otherwise.
+*/
+static bool writeToFd(int fd, const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        data += written;
+        length -= (size_t) written;
+    }
+    return true;
+}
+
+/**
+*	writeOut: Writes characters to the writer's file or file descriptor, and remembers if that failed.
+*
+* @param writer - The writer.
+* @param data - The characters to write.
+* @param length - The number of characters.
+* @return
+* 	None
+*/
+static void writeOut(ReportWriter writer, const char *data, size_t length)
+{
+    if (writer->failed == true || length == 0)
+    {
+        return;
+    }
+    if (writer->compressor != NULL)
+    {
+        writer->failed = (lzWriterWrite(writer->compressor, data, length) == false);
+    }
+    else if (writer->sink == REPORT_SINK_FILE)
+    {
+        writer->failed = (fwrite(data, 1, length, writer->file) != length);
+    }
+    else
+    {
+        writer->failed = (writeToFd(writer->fd, data, length) == false);
+    }
+}
+
+/**
+*	makeRoom: Makes room in the writer's buffer. Files and file descriptors are written the buffered text,
+*             and memory is grown.
+*
+* @param writer - The writer.
+* @param needed - The number of characters that should fit in the buffer.
+* @return
+* 	false - If the characters don't fit: the buffer of a file or file descriptor is smaller, or growing memory
+*           failed.
+* 	true - Otherwise.
+*/
+static bool makeRoom(ReportWriter writer, size_t needed)
+{
+    if (writer->sink != REPORT_SINK_MEMORY)
+    {
+        writeOut(writer, writer->buffer, writer->length);
+        writer->length = 0;
+        return needed <= writer->capacity;
+    }
+
+    size_t capacity = (writer->capacity > REPORT_WRITER_BUFFER_SIZE / 2) ?
+                      writer->capacity * 2 : REPORT_WRITER_BUFFER_SIZE;
+    if (capacity < writer->length + needed)
+    {
+        capacity = writer->length + needed;
+    }
+    char *buffer = realloc(writer->buffer, capacity);
+    if (buffer == NULL)
+    {
+        writer->failed = true;
+        return false;
+    }
+    // The caller's buffer is updated at once, so it stays theirs to free even if writing fails later
+    writer->buffer = *writer->memory = buffer;
+    writer->capacity = *writer->memory_capacity = capacity;
+    return true;
+}
+
+/**
+*	putBytes: Appends characters to the writer's buffer, making room for them when it fills.
+*
+* @param writer - The writer.
+* @param data - The characters to write.
+* @param length - The number of characters.
+* @return
+* 	false - If a write failed so far.
+* 	true - Otherwise.
+*/
+static bool putBytes(ReportWriter writer, const char *data, size_t length)
+{
+    if (writer->capacity - writer->length < length && makeRoom(writer, length) == false)
+    {
+        // A block larger than the buffer of a file or file descriptor is written as is
+        writeOut(writer, data, length);
+        return writer->failed == false;
+    }
+    memcpy(writer->buffer + writer->length, data, length);
+    writer->length += length;
+    return writer->failed == false;
+}
+
+/**
+*	formatUnsigned: Formats an unsigned integer in decimal, at the end of a digits buffer.
+*
+* @param value - The integer to format.
+* @param digits_end - The end of the buffer. The digits are written right before it.
+* @return
+* 	The first digit written.
+*/
+static char *formatUnsigned(unsigned long long value, char *digits_end)
+{
+    char *digit = digits_end;
+    do
+    {
+        *--digit = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return digit;
+}
+
+/**
+*	copyDigits: Copies formatted digits to a buffer.
+*
+* @param buffer - The buffer to copy to.
+* @param first - The first formatted character.
+* @param end - The end of the formatted characters.
+* @return
+* 	The number of characters copied.
+*/
+static int copyDigits(char *buffer, const char *first, const char *end)
+{
+    int length = (int) (end - first);
+    memcpy(buffer, first, length);
+    return length;
+}
+
+int reportFormatInt(char *buffer, int value)
+{
+    char digits[DIGITS_BUFFER_SIZE];
+    char *digits_end = digits + DIGITS_BUFFER_SIZE;
+    // Negated as unsigned, so INT_MIN doesn't overflow
+    unsigned long long magnitude = (value < 0) ? 0ULL - (unsigned long long) value : (unsigned long long) value;
+    char *first = formatUnsigned(magnitude, digits_end);
+    if (value < 0)
+    {
+        *--first = '-';
+    }
+    return copyDigits(buffer, first, digits_end);
+}
+
+/**
+*	roundToHundredths: Rounds mantissa * 2^exponent, multiplied by 100, to an integer, with ties to even.
+*                      The product is computed exactly, so the result matches printf's rounding of the double.
+*
+* @param mantissa - The mantissa of the number, below 2^53.
+* @param exponent - The binary exponent of the number. Must not be positive.
+* @return
+* 	The number of hundredths.
+*/
+static unsigned long long roundToHundredths(uint64_t mantissa, int exponent)
+{
+    // Below 2^60, so the product doesn't overflow
+    uint64_t scaled = mantissa * FIXED2_SCALE;
+    int shift = -exponent;
+    if (shift == 0)
+    {
+        return scaled;
+    }
+    if (shift >= 64)
+    {
+        // Less than half a hundredth
+        return 0;
+    }
+    uint64_t hundredths = scaled >> shift;
+    uint64_t remainder = scaled & ((UINT64_C(1) << shift) - 1);
+    uint64_t half = UINT64_C(1) << (shift - 1);
+    if (remainder > half || (remainder == half && (hundredths & 1) != 0))
+    {
+        hundredths++;
+    }
+    return hundredths;
+}
+
+/**
+*	decomposeDouble: Splits a double into its sign, and a mantissa and binary exponent which it equals exactly.
+*
+* @param value - The double.
+* @param mantissa - Output for the mantissa, below 2^53.
+* @param exponent - Output for the binary exponent.
+* @return
+* 	true - If the double is negative, or negative zero.
+* 	false - Otherwise.
+*/
+static bool decomposeDouble(double value, uint64_t *mantissa, int *exponent)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_exponent = (int) ((bits >> DOUBLE_MANTISSA_BITS) & DOUBLE_EXPONENT_MASK);
+    *mantissa = bits & ((UINT64_C(1) << DOUBLE_MANTISSA_BITS) - 1);
+    *exponent = 1 - DOUBLE_EXPONENT_BIAS;
+    if (biased_exponent != 0)
+    {
+        *mantissa |= UINT64_C(1) << DOUBLE_MANTISSA_BITS;
+        *exponent = biased_exponent - DOUBLE_EXPONENT_BIAS;
+    }
+    return (bits >> DOUBLE_SIGN_BIT) != 0;
+}
+
+int reportFormatFixed2(char *buffer, double value)
+{
+    uint64_t mantissa;
+    int exponent;
+    bool negative = decomposeDouble(value, &mantissa, &exponent);
+    if (exponent > 0)
+    {
+        // Infinities, NaNs and numbers from 2^53 up are rare enough for printf
+        int length = snprintf(buffer, REPORT_NUMBER_MAX_LENGTH, "%.2lf", value);
+        return (length > 0) ? length : 0;
+    }
+
+    unsigned long long hundredths = roundToHundredths(mantissa, exponent);
+    char digits[DIGITS_BUFFER_SIZE];
+    char *digits_end = digits + DIGITS_BUFFER_SIZE;
+    char *first = digits_end;
+    *--first = (char) ('0' + hundredths % 10);
+    *--first = (char) ('0' + hundredths / 10 % 10);
+    *--first = '.';
+    first = formatUnsigned(hundredths / FIXED2_SCALE, first);
+    if (negative == true)
+    {
+        *--first = '-';
+    }
+    return copyDigits(buffer, first, digits_end);
+}
+
+long long reportRoundFixed2(double value)
+{
+    uint64_t mantissa;
+    int exponent;
+    bool negative = decomposeDouble(value, &mantissa, &exponent);
+    if (exponent > 0)
+    {
+        return 0;
+    }
+    long long hundredths = (long long) roundToHundredths(mantissa, exponent);
+    return (negative == true) ? -hundredths : hundredths;
+}
+
+/**
+*	reserveNumber: Makes room in the writer's buffer for a formatted number.
+*
+* @param writer - The writer.
+* @return
+* 	NULL - If memory couldn't be grown.
+* 	Where the number should be formatted otherwise.
+*/
+static char *reserveNumber(ReportWriter writer)
+{
+    if (writer->capacity - writer->length < REPORT_NUMBER_MAX_LENGTH &&
+        makeRoom(writer, REPORT_NUMBER_MAX_LENGTH) == false)
+    {
+        return NULL;
+    }
+    return writer->buffer + writer->length;
+}
+
+bool reportWriterPutInt(ReportWriter writer, int value)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+    char *number = reserveNumber(writer);
+    if (number != NULL)
+    {
+        writer->length += reportFormatInt(number, value);
+    }
+    return writer->failed == false;
+}
+
+bool reportWriterPutFixed2(ReportWriter writer, double value)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+    char *number = reserveNumber(writer);
+    if (number != NULL)
+    {
+        writer->length += reportFormatFixed2(number, value);
+    }
+    return writer->failed == false;
+}
+
+bool reportWriterPutString(ReportWriter writer, const char *string)
+{
+    if (writer == NULL || string == NULL)
+    {
+        return false;
+    }
+    return putBytes(writer, string, strlen(string));
+}
+
+bool reportWriterPutChar(ReportWriter writer, char character)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+    if (writer->length == writer->capacity && makeRoom(writer, 1) == false)
+    {
+        return false;
+    }
+    writer->buffer[writer->length++] = character;
+    return writer->failed == false;
+}
+
+bool reportWriterPutUint32(ReportWriter writer, uint32_t value)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+    char bytes[sizeof(value)];
+    for (size_t index = 0; index < sizeof(value); index++)
+    {
+        bytes[index] = (char) ((value >> (8 * index)) & 0xFF);
+    }
+    return putBytes(writer, bytes, sizeof(bytes));
+}
+
+bool reportWriterPutBytes(ReportWriter writer, const char *data, int length)
+{
+    if (writer == NULL || data == NULL || length < 0)
+    {
+        return false;
+    }
+    return putBytes(writer, data, (size_t) length);
+}
+
+bool reportWriterFlush(ReportWriter writer)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+    if (writer->sink == REPORT_SINK_MEMORY)
+    {
+        if (writer->failed == false)
+        {
+            *writer->memory_length = writer->length;
+        }
+        return writer->failed == false;
+    }
+    writeOut(writer, writer->buffer, writer->length);
+    writer->length = 0;
+    if (writer->compressor != NULL && writer->failed == false)
+    {
+        writer->failed = (lzWriterFinish(writer->compressor) == false);
+    }
+    return writer->failed == false;
+}
+
+bool reportWriterPutLevel(ReportWriter writer, int player_id, double level)
+{
+    return reportWriterPutInt(writer, player_id) && reportWriterPutChar(writer, ' ') &&
+           reportWriterPutFixed2(writer, level) && reportWriterPutChar(writer, '\n');
+}
+
+char *reportRenderTournamentStatistics(int winner, int longest_game_time, int total_play_time, int number_of_games,
+                                       int number_of_players, const char *location, int location_length,
+                                       int *length)
+{
+    double average_game_time = 0;
+    if (number_of_games != 0)
+    {
+        average_game_time = (double) total_play_time / (double) number_of_games;
+    }
+
+    char head[3 * (REPORT_NUMBER_MAX_LENGTH + 1)], tail[2 * (REPORT_NUMBER_MAX_LENGTH + 1)];
+    int head_length = reportFormatInt(head, winner);
+    head[head_length++] = '\n';
+    head_length += reportFormatInt(head + head_length, longest_game_time);
+    head[head_length++] = '\n';
+    head_length += reportFormatFixed2(head + head_length, average_game_time);
+    head[head_length++] = '\n';
+    int tail_length = reportFormatInt(tail, number_of_games);
+    tail[tail_length++] = '\n';
+    tail_length += reportFormatInt(tail + tail_length, number_of_players);
+    tail[tail_length++] = '\n';
+
+    char *statistics = malloc(head_length + location_length + 1 + tail_length);
+    if (statistics == NULL)
+    {
+        return NULL;
+    }
+    memcpy(statistics, head, head_length);
+    memcpy(statistics + head_length, location, location_length);
+    statistics[head_length + location_length] = '\n';
+    memcpy(statistics + head_length + location_length + 1, tail, tail_length);
+    *length = head_length + location_length + 1 + tail_length;
+    return statistics;
+}
@@ -0,0 +1,246 @@
+#ifndef REPORT_WRITER_H_
+#define REPORT_WRITER_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+* Report Writer
+*
+* Writes the text reports of the chess system through a large buffer, which is handed to the output in big
+* writes. The output may be a FILE, a file descriptor, or a growable memory buffer, which is formatted into
+* directly. Integers and two-decimal numbers are formatted by hand instead of by printf, and produce the
+* same bytes as the "%d" and "%.2lf" formats of the C locale.
+* A failed write is remembered, so the writes of a report may be checked once, when it is flushed.
+* A file may also be written through the LZ stream compressor of lzBlock.h.
+*
+* The following functions are available:
+*   reportWriterCreate		- Creates a writer for a file
+*   reportWriterCreateCompressed	- Creates a writer which compresses into a file
+*   reportWriterCreateForFd	- Creates a writer for a file descriptor
+*   reportWriterCreateForMemory	- Creates a writer which appends to a memory buffer
+*   reportWriterDestroy		- Deallocates a writer
+*   reportWriterPutInt		- Writes an integer
+*   reportWriterPutFixed2	- Writes a number with two decimal digits
+*   reportWriterPutString	- Writes a string
+*   reportWriterPutChar		- Writes a character
+*   reportWriterPutBytes	- Writes a block of characters
+*   reportWriterPutUint32	- Writes a 32-bit integer in binary, little-endian
+*   reportWriterFlush		- Writes the buffered text to the output
+*   reportFormatInt			- Formats an integer into memory
+*   reportFormatFixed2		- Formats a number with two decimal digits into memory
+*   reportRoundFixed2		- Rounds a number to hundredths, as it is formatted
+*   reportWriterPutLevel	- Writes a player's level as a line of the levels report
+*   reportRenderTournamentStatistics	- Formats the statistics block of an ended tournament into memory
+*/
+
+/** The number of characters buffered before they are written to a file or file descriptor */
+#define REPORT_WRITER_BUFFER_SIZE (1 << 16)
+
+/** The size of a buffer which any formatted number fits in */
+#define REPORT_NUMBER_MAX_LENGTH 512
+
+/** Type for defining the report writer */
+typedef struct report_writer_t *ReportWriter;
+
+/**
+* reportWriterCreate: Creates a writer for the given file. The file is not closed by the writer.
+*
+* @param file - The file to write to.
+* @return
+* 	NULL - if file is NULL or allocations failed.
+* 	A new ReportWriter in case of success.
+*/
+ReportWriter reportWriterCreate(FILE *file);
+
+/**
+* reportWriterCreateCompressed: Creates a writer which compresses the text into an LZ stream in the given file.
+* 	Each flush ends the stream, and text written afterwards continues in a new stream, so the file is read
+* 	back by lzReaderRead as a single text. The file is not closed by the writer.
+*
+* @param file - The file to write to.
+* @return
+* 	NULL - if file is NULL or allocations failed.
+* 	A new ReportWriter in case of success.
+*/
+ReportWriter reportWriterCreateCompressed(FILE *file);
+
+/**
+* reportWriterCreateForFd: Creates a writer for the given file descriptor, which it writes to with write().
+* 	The file descriptor is not closed by the writer.
+*
+* @param fd - The file descriptor to write to.
+* @return
+* 	NULL - if fd is negative or allocations failed.
+* 	A new ReportWriter in case of success.
+*/
+ReportWriter reportWriterCreateForFd(int fd);
+
+/**
+* reportWriterCreateForMemory: Creates a writer which appends to a memory buffer allocated with malloc.
+* 	The text is formatted into the buffer directly, and the buffer is grown with realloc when it fills.
+* 	The buffer's data and capacity are updated whenever it grows, so it stays the caller's to free even if
+* 	writing fails. Its length is updated by a successful flush.
+*
+* @param data - The buffer. May point to NULL, if the capacity is 0.
+* @param length - The length of the text in the buffer, which the writer appends to.
+* @param capacity - The size of the buffer.
+* @return
+* 	NULL - if a parameter is NULL, the length is larger than the capacity, or allocations failed.
+* 	A new ReportWriter in case of success.
+*/
+ReportWriter reportWriterCreateForMemory(char **data, size_t *length, size_t *capacity);
+
+/**
+* reportWriterDestroy: Deallocates the writer. Text which wasn't flushed is discarded.
+*
+* @param writer - Target writer to be deallocated. If writer is NULL nothing will be done.
+*/
+void reportWriterDestroy(ReportWriter writer);
+
+/**
+* reportWriterPutInt: Writes an integer, as "%d" does.
+*
+* @param writer - The writer.
+* @param value - The integer to write.
+* @return
+* 	false - if writer is NULL, or a write to the output failed so far.
+* 	true - otherwise.
+*/
+bool reportWriterPutInt(ReportWriter writer, int value);
+
+/**
+* reportWriterPutFixed2: Writes a number rounded to two decimal digits, as "%.2lf" does - the exact value of
+* 	the double is rounded, with ties to even.
+*
+* @param writer - The writer.
+* @param value - The number to write.
+* @return
+* 	false - if writer is NULL, or a write to the output failed so far.
+* 	true - otherwise.
+*/
+bool reportWriterPutFixed2(ReportWriter writer, double value);
+
+/**
+* reportWriterPutString: Writes a string, as "%s" does.
+*
+* @param writer - The writer.
+* @param string - The string to write.
+* @return
+* 	false - if writer or string are NULL, or a write to the output failed so far.
+* 	true - otherwise.
+*/
+bool reportWriterPutString(ReportWriter writer, const char *string);
+
+/**
+* reportWriterPutChar: Writes a single character.
+*
+* @param writer - The writer.
+* @param character - The character to write.
+* @return
+* 	false - if writer is NULL, or a write to the output failed so far.
+* 	true - otherwise.
+*/
+bool reportWriterPutChar(ReportWriter writer, char character);
+
+/**
+* reportWriterPutBytes: Writes a block of characters, such as text formatted in advance.
+*
+* @param writer - The writer.
+* @param data - The characters to write.
+* @param length - The number of characters.
+* @return
+* 	false - if writer or data are NULL, length is negative, or a write to the output failed so far.
+* 	true - otherwise.
+*/
+bool reportWriterPutBytes(ReportWriter writer, const char *data, int length);
+
+/**
+* reportWriterPutUint32: Writes a 32-bit integer as 4 bytes, least significant first, whatever the byte order
+* 	of the host. Signed integers are written in two's complement when cast to uint32_t.
+*
+* @param writer - The writer.
+* @param value - The integer to write.
+* @return
+* 	false - if writer is NULL, or a write to the output failed so far.
+* 	true - otherwise.
+*/
+bool reportWriterPutUint32(ReportWriter writer, uint32_t value);
+
+/**
+* reportWriterFlush: Hands the buffered text to the file or file descriptor, or sets the length of the
+* 	memory buffer. The stream of a compressed writer is ended.
+*
+* @param writer - The writer.
+* @return
+* 	false - if writer is NULL, or any write to the output failed.
+* 	true - otherwise.
+*/
+bool reportWriterFlush(ReportWriter writer);
+
+/**
+* reportFormatInt: Formats an integer into memory, as "%d" does. No terminating null character is written.
+*
+* @param buffer - The memory to format into, of at least REPORT_NUMBER_MAX_LENGTH characters.
+* @param value - The integer to format.
+* @return
+* 	The number of characters written.
+*/
+int reportFormatInt(char *buffer, int value);
+
+/**
+* reportFormatFixed2: Formats a number into memory, as reportWriterPutFixed2 writes it.
+* 	No terminating null character is written.
+*
+* @param buffer - The memory to format into, of at least REPORT_NUMBER_MAX_LENGTH characters.
+* @param value - The number to format.
+* @return
+* 	The number of characters written.
+*/
+int reportFormatFixed2(char *buffer, double value);
+
+/**
+* reportRoundFixed2: Rounds a number to a whole number of hundredths, the same way reportFormatFixed2 rounds it,
+* 	so the result matches the formatted digits.
+*
+* @param value - The number to round. Must be below 2^53 in magnitude.
+* @return
+* 	0 - if the number is not below 2^53 in magnitude, or not a number.
+* 	The number of hundredths otherwise.
+*/
+long long reportRoundFixed2(double value);
+
+/**
+* reportWriterPutLevel: Writes a player's level as a line of the levels report, as "%d %.2lf\n" does.
+*
+* @param writer - The writer.
+* @param player_id - The ID of the player.
+* @param level - The level of the player.
+* @return
+* 	false - if writer is NULL or writing failed.
+* 	true - otherwise.
+*/
+bool reportWriterPutLevel(ReportWriter writer, int player_id, double level);
+
+/**
+* reportRenderTournamentStatistics: Formats the statistics block of an ended tournament into memory, as the
+* 	tournament statistics report holds it. Both the chess system and its read only form render it here.
+*
+* @param winner - The ID of the tournament's winner.
+* @param longest_game_time - The play time of the tournament's longest game.
+* @param total_play_time - The total play time of the tournament's games.
+* @param number_of_games - The number of games of the tournament.
+* @param number_of_players - The number of players of the tournament.
+* @param location - The location of the tournament. Need not be null terminated.
+* @param location_length - The length of the location.
+* @param length - Output for the length of the block.
+* @return
+* 	NULL - in case of memory error.
+* 	The block otherwise, which the caller frees. It is not null terminated.
+*/
+char *reportRenderTournamentStatistics(int winner, int longest_game_time, int total_play_time, int number_of_games,
+                                       int number_of_players, const char *location, int location_length,
+                                       int *length);
+
+#endif /* REPORT_WRITER_H_ */
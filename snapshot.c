@@ -0,0 +1,497 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "snapshot.h"
+#include "lzBlock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SNAPSHOT_MAGIC "CHSS"
+#define SNAPSHOT_MAGIC_SIZE 4
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+#define SNAPSHOT_TEMPORARY_SUFFIX ".tmp"
+#define SNAPSHOT_BUFFER_SIZE (1 << 20)
+
+/** Type for the sizes of the sections of a snapshot */
+typedef struct snapshot_sizes_t {
+    int32_t number_of_tournaments;
+    int32_t locations_size;
+    int32_t number_of_games;
+    int32_t number_of_tournament_players;
+    int32_t number_of_players;
+} SnapshotSizes;
+
+/** Type for the header of a snapshot file */
+typedef struct snapshot_header_t {
+    char magic[SNAPSHOT_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t byte_order;
+    SnapshotSizes sizes;
+    int64_t journal_sequence;
+} SnapshotHeader;
+
+/** Type for the file a snapshot is written to or read from, through a compressor if it is compressed */
+typedef struct snapshot_stream_t {
+    FILE *file;
+    LzWriter writer;
+    LzReader reader;
+} SnapshotStream;
+
+/**
+*	streamWrite: Writes data to a snapshot stream.
+*
+* @param stream - The stream to write to.
+* @param data - The data to write.
+* @param size - The size of the data.
+* @return
+* 	false - If writing failed.
+* 	true - Otherwise.
+*/
+static bool streamWrite(SnapshotStream *stream, const void *data, size_t size)
+{
+    if (stream->writer != NULL)
+    {
+        return lzWriterWrite(stream->writer, data, size);
+    }
+    return fwrite(data, 1, size, stream->file) == size;
+}
+
+/**
+*	streamRead: Reads data from a snapshot stream.
+*
+* @param stream - The stream to read from.
+* @param data - The buffer to read into.
+* @param size - The size of the data.
+* @return
+* 	false - If the stream ended early, or reading failed.
+* 	true - Otherwise.
+*/
+static bool streamRead(SnapshotStream *stream, void *data, size_t size)
+{
+    if (stream->reader != NULL)
+    {
+        return lzReaderRead(stream->reader, data, size) == size;
+    }
+    return fread(data, 1, size, stream->file) == size;
+}
+
+/**
+*	writeSection: Writes a section of records to a stream.
+*
+* @param stream - The stream to write to.
+* @param records - The records of the section. May be NULL if there are no records.
+* @param record_size - The size of a single record.
+* @param number_of_records - The number of records.
+* @return
+* 	false - If writing failed.
+* 	true - Otherwise.
+*/
+static bool writeSection(SnapshotStream *stream, const void *records, size_t record_size, int number_of_records)
+{
+    return number_of_records == 0 || streamWrite(stream, records, record_size * number_of_records);
+}
+
+/**
+*	readSection: Allocates a section of records and reads it from a stream.
+*
+* @param stream - The stream to read from.
+* @param record_size - The size of a single record.
+* @param number_of_records - The number of records.
+* @param result - Output for the error, if reading failed.
+* @return
+* 	NULL - If reading failed. result is set in that case.
+* 	The records otherwise.
+*/
+static void *readSection(SnapshotStream *stream, size_t record_size, int number_of_records, SnapshotResult *result)
+{
+    void *records = malloc(record_size * number_of_records + 1);
+    if (records == NULL)
+    {
+        *result = SNAPSHOT_OUT_OF_MEMORY;
+        return NULL;
+    }
+    if (number_of_records > 0 && streamRead(stream, records, record_size * number_of_records) == false)
+    {
+        free(records);
+        *result = SNAPSHOT_INVALID_FORMAT;
+        return NULL;
+    }
+    return records;
+}
+
+/**
+*	snapshotGetSizes: Gets the sizes of the sections of a snapshot.
+*
+* @param snapshot - The snapshot.
+* @return
+* 	The sizes of the snapshot's sections.
+*/
+static SnapshotSizes snapshotGetSizes(const Snapshot *snapshot)
+{
+    SnapshotSizes sizes = {snapshot->number_of_tournaments, snapshot->locations_size, snapshot->number_of_games,
+                           snapshot->number_of_tournament_players, snapshot->number_of_players};
+    return sizes;
+}
+
+/**
+*	writeSections: Writes the sections of a snapshot to a stream, one after the other.
+*
+* @param stream - The stream to write to.
+* @param snapshot - The snapshot to write.
+* @return
+* 	false - If writing failed.
+* 	true - Otherwise.
+*/
+static bool writeSections(SnapshotStream *stream, const Snapshot *snapshot)
+{
+    return writeSection(stream, snapshot->tournaments, sizeof(*snapshot->tournaments),
+                        snapshot->number_of_tournaments) &&
+           writeSection(stream, snapshot->locations, 1, snapshot->locations_size) &&
+           writeSection(stream, snapshot->games, sizeof(*snapshot->games), snapshot->number_of_games) &&
+           writeSection(stream, snapshot->tournament_players, sizeof(*snapshot->tournament_players),
+                        snapshot->number_of_tournament_players) &&
+           writeSection(stream, snapshot->players, sizeof(*snapshot->players), snapshot->number_of_players);
+}
+
+bool snapshotWriteSections(FILE *file, const Snapshot *snapshot)
+{
+    if (file == NULL || snapshot == NULL)
+    {
+        return false;
+    }
+    SnapshotStream stream = {file, NULL, NULL};
+    SnapshotSizes sizes = snapshotGetSizes(snapshot);
+    return streamWrite(&stream, &sizes, sizeof(sizes)) && writeSections(&stream, snapshot);
+}
+
+bool snapshotWrite(const char *path, const Snapshot *snapshot, bool compressed)
+{
+    if (path == NULL || snapshot == NULL)
+    {
+        return false;
+    }
+
+    char *temporary_path = malloc(strlen(path) + strlen(SNAPSHOT_TEMPORARY_SUFFIX) + 1);
+    if (temporary_path == NULL)
+    {
+        return false;
+    }
+    strcpy(temporary_path, path);
+    strcat(temporary_path, SNAPSHOT_TEMPORARY_SUFFIX);
+
+    FILE *file = fopen(temporary_path, "wb");
+    if (file == NULL)
+    {
+        free(temporary_path);
+        return false;
+    }
+    setvbuf(file, NULL, _IOFBF, SNAPSHOT_BUFFER_SIZE);
+
+    SnapshotStream stream = {file, NULL, NULL};
+    if (compressed == true && (stream.writer = lzWriterCreate(file)) == NULL)
+    {
+        fclose(file);
+        remove(temporary_path);
+        free(temporary_path);
+        return false;
+    }
+    SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, SNAPSHOT_BYTE_ORDER, snapshotGetSizes(snapshot),
+                             snapshot->journal_sequence};
+    bool written = streamWrite(&stream, &header, sizeof(header)) && writeSections(&stream, snapshot);
+    written = (stream.writer == NULL || lzWriterFinish(stream.writer) == true) && written;
+    lzWriterDestroy(stream.writer);
+    written = (fclose(file) == 0) && written;
+    written = written && rename(temporary_path, path) == 0;
+    if (written == false)
+    {
+        remove(temporary_path);
+    }
+    free(temporary_path);
+    return written;
+}
+
+/**
+*	isSnapshotConsistent: Checks that the tournaments of a snapshot account exactly for its other sections.
+*
+* @param snapshot - The snapshot to check.
+* @return
+* 	true - If the snapshot is consistent.
+* 	false - Otherwise.
+*/
+static bool isSnapshotConsistent(const Snapshot *snapshot)
+{
+    long long locations_size = 0, number_of_games = 0, number_of_tournament_players = 0;
+    for (int index = 0; index < snapshot->number_of_tournaments; index++)
+    {
+        const SnapshotTournament *tournament = &snapshot->tournaments[index];
+        if (tournament->location_length < 0 || tournament->games_count < 0 || tournament->players_count < 0 ||
+            (index > 0 && snapshot->tournaments[index - 1].tournament_id >= tournament->tournament_id))
+        {
+            return false;
+        }
+        locations_size += tournament->location_length;
+        number_of_games += tournament->games_count;
+        number_of_tournament_players += tournament->players_count;
+    }
+    return locations_size == snapshot->locations_size && number_of_games == snapshot->number_of_games &&
+           number_of_tournament_players == snapshot->number_of_tournament_players;
+}
+
+/**
+*	readSections: Reads the sections of a snapshot from a stream, and checks that they are consistent.
+*
+* @param stream - The stream to read from.
+* @param sizes - The sizes of the sections.
+* @param snapshot - The snapshot to fill. Left empty if reading failed.
+* @return
+* 	SNAPSHOT_INVALID_FORMAT - If the sizes are negative, the file ended early, or the sections are inconsistent.
+* 	SNAPSHOT_OUT_OF_MEMORY - If an allocation failed.
+* 	SNAPSHOT_SUCCESS - Otherwise.
+*/
+static SnapshotResult readSections(SnapshotStream *stream, const SnapshotSizes *sizes, Snapshot *snapshot)
+{
+    if (sizes->number_of_tournaments < 0 || sizes->locations_size < 0 || sizes->number_of_games < 0 ||
+        sizes->number_of_tournament_players < 0 || sizes->number_of_players < 0)
+    {
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+
+    SnapshotResult result = SNAPSHOT_SUCCESS;
+    snapshot->number_of_tournaments = sizes->number_of_tournaments;
+    snapshot->locations_size = sizes->locations_size;
+    snapshot->number_of_games = sizes->number_of_games;
+    snapshot->number_of_tournament_players = sizes->number_of_tournament_players;
+    snapshot->number_of_players = sizes->number_of_players;
+    if ((snapshot->tournaments = readSection(stream, sizeof(*snapshot->tournaments),
+                                             snapshot->number_of_tournaments, &result)) == NULL ||
+        (snapshot->locations = readSection(stream, 1, snapshot->locations_size, &result)) == NULL ||
+        (snapshot->games = readSection(stream, sizeof(*snapshot->games), snapshot->number_of_games, &result)) == NULL ||
+        (snapshot->tournament_players = readSection(stream, sizeof(*snapshot->tournament_players),
+                                                    snapshot->number_of_tournament_players, &result)) == NULL ||
+        (snapshot->players = readSection(stream, sizeof(*snapshot->players), snapshot->number_of_players,
+                                         &result)) == NULL)
+    {
+        snapshotClear(snapshot);
+        return result;
+    }
+
+    if (isSnapshotConsistent(snapshot) == false)
+    {
+        snapshotClear(snapshot);
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+    return SNAPSHOT_SUCCESS;
+}
+
+SnapshotResult snapshotReadSections(FILE *file, Snapshot *snapshot)
+{
+    if (file == NULL || snapshot == NULL)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    SnapshotStream stream = {file, NULL, NULL};
+    SnapshotSizes sizes;
+    if (streamRead(&stream, &sizes, sizeof(sizes)) == false)
+    {
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+    return readSections(&stream, &sizes, snapshot);
+}
+
+SnapshotResult snapshotRead(const char *path, Snapshot *snapshot)
+{
+    if (path == NULL || snapshot == NULL)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    setvbuf(file, NULL, _IOFBF, SNAPSHOT_BUFFER_SIZE);
+
+    SnapshotStream stream = {file, NULL, NULL};
+    if (lzIsCompressed(file) == true && (stream.reader = lzReaderCreate(file)) == NULL)
+    {
+        fclose(file);
+        return SNAPSHOT_OUT_OF_MEMORY;
+    }
+    SnapshotHeader header;
+    if (streamRead(&stream, &header, sizeof(header)) == false ||
+        memcmp(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0 || header.version != SNAPSHOT_VERSION ||
+        header.byte_order != SNAPSHOT_BYTE_ORDER || header.journal_sequence < 0)
+    {
+        lzReaderDestroy(stream.reader);
+        fclose(file);
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+
+    SnapshotResult result = readSections(&stream, &header.sizes, snapshot);
+    char extra;
+    // A compressed snapshot must end with its stream, so a truncated file isn't taken for a whole one
+    if (result == SNAPSHOT_SUCCESS && stream.reader != NULL &&
+        (lzReaderRead(stream.reader, &extra, 1) != 0 || lzReaderFailed(stream.reader) == true))
+    {
+        snapshotClear(snapshot);
+        result = SNAPSHOT_INVALID_FORMAT;
+    }
+    lzReaderDestroy(stream.reader);
+    fclose(file);
+    snapshot->journal_sequence = (result == SNAPSHOT_SUCCESS) ? header.journal_sequence : 0;
+    return result;
+}
+
+void snapshotClear(Snapshot *snapshot)
+{
+    if (snapshot == NULL)
+    {
+        return;
+    }
+    free(snapshot->tournaments);
+    free(snapshot->locations);
+    free(snapshot->games);
+    free(snapshot->tournament_players);
+    free(snapshot->players);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+/**
+*	mappedSize: Gets the size of a snapshot file, from the sizes of its sections.
+*
+* @param sizes - The sizes of the sections. Must not be negative.
+* @return
+* 	The size of the file.
+*/
+static uint64_t mappedSize(const SnapshotSizes *sizes)
+{
+    return sizeof(SnapshotHeader) + (uint64_t) sizes->number_of_tournaments * sizeof(SnapshotTournament) +
+           (uint64_t) sizes->locations_size + (uint64_t) sizes->number_of_games * sizeof(SnapshotGame) +
+           (uint64_t) sizes->number_of_tournament_players * sizeof(SnapshotPlayer) +
+           (uint64_t) sizes->number_of_players * sizeof(SnapshotPlayer);
+}
+
+/**
+*	mapSections: Points the sections of a mapping into its mapped file, after checking the file's header.
+*
+* @param mapping - The mapping, whose data and size are set.
+* @return
+* 	false - If the file is not a supported snapshot, or its size doesn't match its sections.
+* 	true - Otherwise.
+*/
+static bool mapSections(SnapshotMapping *mapping)
+{
+    SnapshotHeader header;
+    if (mapping->size < sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&header, mapping->data, sizeof(header));
+    const SnapshotSizes *sizes = &header.sizes;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0 || header.version != SNAPSHOT_VERSION ||
+        header.byte_order != SNAPSHOT_BYTE_ORDER || header.journal_sequence < 0 ||
+        sizes->number_of_tournaments < 0 || sizes->locations_size < 0 || sizes->number_of_games < 0 ||
+        sizes->number_of_tournament_players < 0 || sizes->number_of_players < 0 ||
+        mappedSize(sizes) != mapping->size)
+    {
+        return false;
+    }
+
+    mapping->tournaments = mapping->data + sizeof(header);
+    mapping->number_of_tournaments = sizes->number_of_tournaments;
+    mapping->locations = mapping->tournaments + (size_t) sizes->number_of_tournaments * sizeof(SnapshotTournament);
+    mapping->locations_size = sizes->locations_size;
+    mapping->games = mapping->locations + sizes->locations_size;
+    mapping->number_of_games = sizes->number_of_games;
+    mapping->tournament_players = mapping->games + (size_t) sizes->number_of_games * sizeof(SnapshotGame);
+    mapping->number_of_tournament_players = sizes->number_of_tournament_players;
+    mapping->players = mapping->tournament_players +
+                       (size_t) sizes->number_of_tournament_players * sizeof(SnapshotPlayer);
+    mapping->number_of_players = sizes->number_of_players;
+    mapping->journal_sequence = header.journal_sequence;
+    return true;
+}
+
+SnapshotResult snapshotMap(const char *path, SnapshotMapping *mapping)
+{
+    if (path == NULL || mapping == NULL)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    memset(mapping, 0, sizeof(*mapping));
+
+    int file_descriptor = open(path, O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor < 0 || fstat(file_descriptor, &file_status) != 0)
+    {
+        if (file_descriptor >= 0)
+        {
+            close(file_descriptor);
+        }
+        return SNAPSHOT_FILE_ERROR;
+    }
+    if ((size_t) file_status.st_size < sizeof(SnapshotHeader))
+    {
+        close(file_descriptor);
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+
+    // A shared read only mapping reads the file straight from the page cache, which other processes share
+    void *data = mmap(NULL, file_status.st_size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+    if (data == MAP_FAILED)
+    {
+        return SNAPSHOT_FILE_ERROR;
+    }
+    mapping->data = data;
+    mapping->size = file_status.st_size;
+    if (mapSections(mapping) == false)
+    {
+        snapshotUnmap(mapping);
+        return SNAPSHOT_INVALID_FORMAT;
+    }
+    return SNAPSHOT_SUCCESS;
+}
+
+void snapshotUnmap(SnapshotMapping *mapping)
+{
+    if (mapping == NULL)
+    {
+        return;
+    }
+    if (mapping->data != NULL)
+    {
+        munmap((void*) mapping->data, mapping->size);
+    }
+    memset(mapping, 0, sizeof(*mapping));
+}
+
+SnapshotTournament snapshotMappedTournament(const SnapshotMapping *mapping, int index)
+{
+    SnapshotTournament record;
+    memcpy(&record, mapping->tournaments + (size_t) index * sizeof(record), sizeof(record));
+    return record;
+}
+
+SnapshotGame snapshotMappedGame(const SnapshotMapping *mapping, int index)
+{
+    SnapshotGame record;
+    memcpy(&record, mapping->games + (size_t) index * sizeof(record), sizeof(record));
+    return record;
+}
+
+SnapshotPlayer snapshotMappedPlayer(const SnapshotMapping *mapping, int index)
+{
+    SnapshotPlayer record;
+    memcpy(&record, mapping->players + (size_t) index * sizeof(record), sizeof(record));
+    return record;
+}
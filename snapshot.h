@@ -0,0 +1,223 @@
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+* Chess System Snapshot File
+*
+* Reads and writes the binary snapshot file of a chess system. The file starts with a versioned header, which
+* also holds the sequence number of the last journal record the snapshot includes, followed by contiguous sections of fixed size records:
+*   tournaments         - One record per tournament, sorted by tournament ID.
+*   locations           - The tournaments' locations, concatenated without terminators.
+*   games               - The games of every tournament, grouped in the order of the tournaments.
+*   tournament players  - The players of every tournament, grouped in the order of the tournaments.
+*   players             - The players of the whole system.
+* Each section is written and read with a single call, so no per-record parsing is needed.
+* Records are stored in the byte order of the machine which wrote them, and files written on a machine with
+* a different byte order are rejected.
+* A snapshot file may be compressed as a whole into an LZ stream (see lzBlock.h), which is detected when it is read.
+*
+* The following functions are available:
+*   snapshotWrite		- Writes a snapshot to a file
+*   snapshotRead		- Reads a snapshot from a file
+*   snapshotClear		- Frees the sections of a snapshot that was read
+*   snapshotWriteSections	- Writes the sections of a snapshot into an open file
+*   snapshotReadSections	- Reads the sections of a snapshot from an open file
+*   snapshotMap			- Maps a snapshot file into memory, to read its sections in place
+*   snapshotUnmap		- Unmaps a mapped snapshot
+*   snapshotMappedTournament	- Gets a tournament record of a mapped snapshot
+*   snapshotMappedGame		- Gets a game record of a mapped snapshot
+*   snapshotMappedPlayer	- Gets a player record of a mapped snapshot
+*/
+
+#define SNAPSHOT_VERSION 2
+
+/** Type for a tournament in a snapshot */
+typedef struct snapshot_tournament_t {
+    int tournament_id;
+    int max_games_per_player;
+    int winner;
+    int number_of_games;
+    int number_of_players;
+    int total_play_time;
+    int last_game_id;
+    int location_length;
+    int games_count;
+    int players_count;
+} SnapshotTournament;
+
+/** Type for a game in a snapshot */
+typedef struct snapshot_game_t {
+    int game_id;
+    int first_player;
+    int second_player;
+    int winner;
+    int play_time;
+} SnapshotGame;
+
+/** Type for a player in a snapshot */
+typedef struct snapshot_player_t {
+    int player_id;
+    int wins;
+    int loses;
+    int draws;
+    int total_play_time;
+} SnapshotPlayer;
+
+/** Type for the sections of a snapshot */
+typedef struct snapshot_t {
+    SnapshotTournament *tournaments;
+    int number_of_tournaments;
+    char *locations;
+    int locations_size;
+    SnapshotGame *games;
+    int number_of_games;
+    SnapshotPlayer *tournament_players;
+    int number_of_tournament_players;
+    SnapshotPlayer *players;
+    int number_of_players;
+    long long journal_sequence;
+} Snapshot;
+
+/**
+* Type for a snapshot file mapped into memory. The sections point into the mapped file, which is shared with
+* other processes mapping it. Sections after the locations are not aligned, so their records are read with
+* the snapshotMapped functions.
+*/
+typedef struct snapshot_mapping_t {
+    const char *data;
+    size_t size;
+    const char *tournaments;
+    int number_of_tournaments;
+    const char *locations;
+    int locations_size;
+    const char *games;
+    int number_of_games;
+    const char *tournament_players;
+    int number_of_tournament_players;
+    const char *players;
+    int number_of_players;
+    long long journal_sequence;
+} SnapshotMapping;
+
+/** Type used for returning error codes from snapshot functions */
+typedef enum SnapshotResult_t {
+    SNAPSHOT_SUCCESS,
+    SNAPSHOT_OUT_OF_MEMORY,
+    SNAPSHOT_FILE_ERROR,
+    SNAPSHOT_INVALID_FORMAT
+} SnapshotResult;
+
+/**
+* snapshotWrite: Writes a snapshot to the given path. The snapshot is written to a temporary file first,
+* 	which then replaces the file in the given path, so an existing snapshot is never left half written.
+*
+* @param path - The path of the snapshot file.
+* @param snapshot - The snapshot to write.
+* @param compressed - Whether to compress the file.
+* @return
+* 	false - if the file couldn't be written.
+* 	true - if the snapshot was written.
+*/
+bool snapshotWrite(const char *path, const Snapshot *snapshot, bool compressed);
+
+/**
+* snapshotRead: Reads a snapshot from the given path.
+*
+* @param path - The path of the snapshot file, compressed or not.
+* @param snapshot - The snapshot to fill. Its sections must be freed with snapshotClear.
+* @return
+* 	SNAPSHOT_FILE_ERROR - if the file couldn't be opened or read.
+* 	SNAPSHOT_INVALID_FORMAT - if the file is not a snapshot, its version or byte order is not supported,
+* 	                          or its sections are inconsistent.
+* 	SNAPSHOT_OUT_OF_MEMORY - if an allocation failed.
+* 	SNAPSHOT_SUCCESS - if the snapshot was read.
+* 	The snapshot is left empty if reading failed.
+*/
+SnapshotResult snapshotRead(const char *path, Snapshot *snapshot);
+
+/**
+* snapshotClear: Frees the sections of a snapshot, and leaves it empty.
+*
+* @param snapshot - The snapshot to clear. If snapshot is NULL nothing will be done.
+*/
+void snapshotClear(Snapshot *snapshot);
+
+/**
+* snapshotWriteSections: Writes the sections of a snapshot, preceded by their sizes, at the current position
+* 	of an open file. Used for files that hold several snapshots' sections, such as checkpoints.
+*
+* @param file - The file to write to.
+* @param snapshot - The snapshot whose sections to write. Its journal sequence is not written.
+* @return
+* 	false - if writing failed.
+* 	true - if the sections were written.
+*/
+bool snapshotWriteSections(FILE *file, const Snapshot *snapshot);
+
+/**
+* snapshotReadSections: Reads sections written by snapshotWriteSections from the current position of an open file.
+*
+* @param file - The file to read from.
+* @param snapshot - The snapshot to fill. Its sections must be freed with snapshotClear.
+* @return
+* 	See snapshotRead. The snapshot is left empty if reading failed.
+*/
+SnapshotResult snapshotReadSections(FILE *file, Snapshot *snapshot);
+
+/**
+* snapshotMap: Maps an uncompressed snapshot file into memory. Only the header is read, and the file's size is
+* 	checked against it, so mapping takes the same time whatever the size of the snapshot. The sections are not
+* 	checked to be consistent, so their readers must check the bounds of what they read.
+*
+* @param path - The path of the snapshot file.
+* @param mapping - The mapping to fill. Must be unmapped with snapshotUnmap.
+* @return
+* 	SNAPSHOT_FILE_ERROR - if the file couldn't be opened or mapped.
+* 	SNAPSHOT_INVALID_FORMAT - if the file is not an uncompressed snapshot, its version or byte order is not
+* 	                          supported, or its size doesn't match its sections.
+* 	SNAPSHOT_SUCCESS - if the snapshot was mapped.
+* 	The mapping is left empty if mapping failed.
+*/
+SnapshotResult snapshotMap(const char *path, SnapshotMapping *mapping);
+
+/**
+* snapshotUnmap: Unmaps a mapped snapshot, and leaves the mapping empty.
+*
+* @param mapping - The mapping. If mapping is NULL nothing will be done.
+*/
+void snapshotUnmap(SnapshotMapping *mapping);
+
+/**
+* snapshotMappedTournament: Gets a tournament record of a mapped snapshot.
+*
+* @param mapping - The mapping.
+* @param index - The index of the record, which must be below the number of tournaments.
+* @return
+* 	A copy of the record.
+*/
+SnapshotTournament snapshotMappedTournament(const SnapshotMapping *mapping, int index);
+
+/**
+* snapshotMappedGame: Gets a game record of a mapped snapshot.
+*
+* @param mapping - The mapping.
+* @param index - The index of the record, which must be below the number of games.
+* @return
+* 	A copy of the record.
+*/
+SnapshotGame snapshotMappedGame(const SnapshotMapping *mapping, int index);
+
+/**
+* snapshotMappedPlayer: Gets a player record of the players section of a mapped snapshot.
+*
+* @param mapping - The mapping.
+* @param index - The index of the record, which must be below the number of players.
+* @return
+* 	A copy of the record.
+*/
+SnapshotPlayer snapshotMappedPlayer(const SnapshotMapping *mapping, int index);
+
+#endif /* SNAPSHOT_H_ */
@@ -0,0 +1,96 @@
+#include "spillStore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct spill_store_t {
+    FILE *file;
+    char *path;
+    long size;
+};
+
+SpillStore spillStoreCreate(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    SpillStore store = malloc(sizeof(*store));
+    if (store == NULL)
+    {
+        return NULL;
+    }
+    store->path = malloc(strlen(path) + 1);
+    if (store->path == NULL)
+    {
+        free(store);
+        return NULL;
+    }
+    strcpy(store->path, path);
+    store->file = fopen(path, "w+b");
+    if (store->file == NULL)
+    {
+        free(store->path);
+        free(store);
+        return NULL;
+    }
+    store->size = 0;
+    return store;
+}
+
+void spillStoreDestroy(SpillStore store)
+{
+    if (store == NULL)
+    {
+        return;
+    }
+    fclose(store->file);
+    remove(store->path);
+    free(store->path);
+    free(store);
+}
+
+bool spillStoreWrite(SpillStore store, SpillSlot *slot, const void *data, int size)
+{
+    if (store == NULL || slot == NULL || (data == NULL && size > 0) || size < 0)
+    {
+        return false;
+    }
+
+    bool fits = (slot->offset >= 0 && size <= slot->capacity);
+    long offset = (fits == true) ? slot->offset : store->size;
+    if (fseek(store->file, offset, SEEK_SET) != 0 || fwrite(data, 1, size, store->file) != (size_t) size ||
+        fflush(store->file) != 0)
+    {
+        return false;
+    }
+
+    if (fits == false)
+    {
+        slot->offset = offset;
+        slot->capacity = size;
+        store->size += size;
+    }
+    slot->size = size;
+    return true;
+}
+
+bool spillStoreRead(SpillStore store, const SpillSlot *slot, void *data)
+{
+    if (store == NULL || slot == NULL || slot->offset < 0 || (data == NULL && slot->size > 0))
+    {
+        return false;
+    }
+    return fseek(store->file, slot->offset, SEEK_SET) == 0 &&
+           fread(data, 1, slot->size, store->file) == (size_t) slot->size;
+}
+
+long spillStoreGetSize(SpillStore store)
+{
+    if (store == NULL)
+    {
+        return -1;
+    }
+    return store->size;
+}
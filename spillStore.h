@@ -0,0 +1,90 @@
+#ifndef SPILL_STORE_H_
+#define SPILL_STORE_H_
+
+#include <stdbool.h>
+
+/**
+* Spill Store
+*
+* Keeps records which were moved out of memory in a local file, the spill file, so they can be read back when
+* they are needed again. Each record is kept in a slot of the file - a position and a size. A record written
+* again is written over its slot if it still fits, and is moved to a new slot at the end of the file otherwise.
+* Slots are not reused by other records, so the file only grows until the store is destroyed, which removes it.
+* The spill file only lives as long as the store, so records are kept in the byte order of the machine.
+*
+* The following functions are available:
+*   spillStoreCreate	- Creates a new store with an empty spill file
+*   spillStoreDestroy	- Deletes a store and removes its spill file
+*   spillStoreWrite	- Writes a record into its slot, or into a new slot
+*   spillStoreRead	- Reads a record back from its slot
+*   spillStoreGetSize	- Gets the size of the spill file
+*/
+
+/** Type for defining the spill store */
+typedef struct spill_store_t *SpillStore;
+
+/** Type for the place of a record in the spill file */
+typedef struct spill_slot_t {
+    long offset;
+    int capacity;
+    int size;
+} SpillSlot;
+
+/** A slot that holds no record yet */
+#define SPILL_SLOT_EMPTY {-1, 0, 0}
+
+/**
+* spillStoreCreate: Creates a new store, whose spill file is created in the given path, replacing any file in it.
+*
+* @param path - The path of the spill file.
+* @return
+* 	NULL - if path is NULL, the file couldn't be created or allocations failed.
+* 	A new SpillStore in case of success.
+*/
+SpillStore spillStoreCreate(const char *path);
+
+/**
+* spillStoreDestroy: Deallocates an existing store, and removes its spill file.
+*
+* @param store - Target store to be deallocated. If store is NULL nothing will be done.
+*/
+void spillStoreDestroy(SpillStore store);
+
+/**
+* spillStoreWrite: Writes a record into its slot, if it fits there, or into a new slot at the end of the file.
+*
+* @param store - The store.
+* @param slot - The slot of the record, or SPILL_SLOT_EMPTY for a new record. Updated to the slot it was
+* 	written to.
+* @param data - The record.
+* @param size - The size of the record.
+* @return
+* 	false - if a parameter is invalid or writing failed. The slot is unchanged in that case, but its old
+* 	record may have been partly written over.
+* 	true - if the record was written.
+*/
+bool spillStoreWrite(SpillStore store, SpillSlot *slot, const void *data, int size);
+
+/**
+* spillStoreRead: Reads a record back from its slot.
+*
+* @param store - The store.
+* @param slot - The slot the record was written to.
+* @param data - A buffer to read into, of slot->size bytes.
+* @return
+* 	false - if a parameter is invalid or reading failed.
+* 	true - if the record was read.
+*/
+bool spillStoreRead(SpillStore store, const SpillSlot *slot, void *data);
+
+/**
+* spillStoreGetSize: Gets the size of the spill file, including slots of records which were moved.
+*
+* @param store - The store.
+* @return
+* 	-1 - if store is NULL.
+* 	The size in bytes of the spill file otherwise.
+*/
+long spillStoreGetSize(SpillStore store);
+
+#endif /* SPILL_STORE_H_ */
@@ -0,0 +1,114 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "submissionQueue.h"
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+/** Number of times the applier of a submission queue finds it empty before it starts to sleep between looks */
+#define SUBMISSION_IDLE_SPINS 64
+/** Time in nanoseconds the applier of an idle submission queue sleeps between looks */
+#define SUBMISSION_IDLE_SLEEP_NS 100000
+
+struct chess_submission_queue_t {
+    SubmissionRing ring;
+    SubmissionRecord *batch;
+    int batch_size;
+    SubmissionApplyFunc apply;
+    void *context;
+    pthread_t applier;
+};
+
+/**
+*	submissionQueueRun: adds the games submitted to a queue in batches, until the queue is closed and empty.
+*
+* @param argument - The submission queue.
+*
+* @return
+* 	NULL
+*/
+static void *submissionQueueRun(void *argument)
+{
+    ChessSubmissionQueue queue = argument;
+    int idle_rounds = 0;
+    while (true)
+    {
+        // Games submitted before the close are popped after it is seen, so none is left behind
+        bool closed = submissionRingIsClosed(queue->ring);
+        int number_of_records = submissionRingPop(queue->ring, queue->batch, queue->batch_size);
+        if (number_of_records > 0)
+        {
+            queue->apply(queue->batch, number_of_records, queue->context);
+            idle_rounds = 0;
+            continue;
+        }
+        if (closed == true)
+        {
+            return NULL;
+        }
+        if (++idle_rounds > SUBMISSION_IDLE_SPINS)
+        {
+            struct timespec idle_sleep = {0, SUBMISSION_IDLE_SLEEP_NS};
+            nanosleep(&idle_sleep, NULL);
+        }
+    }
+}
+
+ChessSubmissionQueue submissionQueueCreate(int capacity, int batch_size, SubmissionApplyFunc apply, void *context)
+{
+    ChessSubmissionQueue queue = malloc(sizeof(*queue));
+    SubmissionRing ring = submissionRingCreate(capacity);
+    if (queue == NULL || ring == NULL)
+    {
+        free(queue);
+        submissionRingDestroy(ring);
+        return NULL;
+    }
+    queue->ring = ring;
+    queue->apply = apply;
+    queue->context = context;
+    int ring_capacity = submissionRingGetCapacity(ring);
+    queue->batch_size = (batch_size < 1) ? 1 : (batch_size > ring_capacity) ? ring_capacity : batch_size;
+    queue->batch = malloc(sizeof(*queue->batch) * queue->batch_size);
+    if (queue->batch == NULL || pthread_create(&queue->applier, NULL, submissionQueueRun, queue) != 0)
+    {
+        free(queue->batch);
+        submissionRingDestroy(ring);
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+bool submissionQueuePush(ChessSubmissionQueue queue, const SubmissionRecord *record)
+{
+    return submissionRingPush(queue->ring, record);
+}
+
+ChessResult submissionQueueWait(const ChessSubmissionTicket *ticket)
+{
+    ChessResult result = CHESS_SUCCESS;
+    for (int idle_rounds = 1; submissionTicketIsComplete(ticket, &result) == false; idle_rounds++)
+    {
+        if (idle_rounds > SUBMISSION_IDLE_SPINS)
+        {
+            struct timespec idle_sleep = {0, SUBMISSION_IDLE_SLEEP_NS};
+            nanosleep(&idle_sleep, NULL);
+        }
+    }
+    return result;
+}
+
+void submissionQueueClose(ChessSubmissionQueue queue)
+{
+    if (queue == NULL)
+    {
+        return;
+    }
+
+    submissionRingClose(queue->ring);
+    pthread_join(queue->applier, NULL);
+    submissionRingDestroy(queue->ring);
+    free(queue->batch);
+    free(queue);
+}
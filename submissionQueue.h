@@ -0,0 +1,70 @@
+#ifndef SUBMISSION_QUEUE_H_
+#define SUBMISSION_QUEUE_H_
+
+#include <stdbool.h>
+#include "chessSystemExtensions.h"
+#include "submissionRing.h"
+
+/**
+* Submission Queue
+*
+* Hands the games submitted by many threads to a single applier thread, through a submission ring (see
+* submissionRing.h). The applier pops the games in batches and hands each batch to the apply function the queue
+* was created with, which adds the games and completes their tickets. An empty queue is looked at again right
+* away for a while, and then after short sleeps, and waiting for a ticket does the same.
+*
+* The following functions are available:
+*   submissionQueueCreate	- Creates a new queue, and starts its applier thread
+*   submissionQueuePush		- Submits a game to the queue, from any thread
+*   submissionQueueWait		- Waits until a ticket is given the result of its game
+*   submissionQueueClose	- Applies the games left in the queue, stops its applier and deallocates it
+*/
+
+/**
+* Type for a function which adds a batch of submitted games, and completes their tickets with
+* submissionTicketComplete. It is called from the applier thread only.
+*/
+typedef void (*SubmissionApplyFunc)(const SubmissionRecord *records, int number_of_records, void *context);
+
+/**
+* submissionQueueCreate: Creates a new empty queue, and starts its applier thread.
+*
+* @param capacity - The number of games the queue holds, rounded up to a power of two.
+* @param batch_size - The largest number of games handed to apply at once. Clamped to between 1 and the
+* 	capacity of the queue.
+* @param apply - The function which adds the submitted games.
+* @param context - The pointer passed to apply.
+* @return
+* 	NULL - if allocations failed, or the thread couldn't be started.
+* 	A new queue in case of success.
+*/
+ChessSubmissionQueue submissionQueueCreate(int capacity, int batch_size, SubmissionApplyFunc apply, void *context);
+
+/**
+* submissionQueuePush: Submits a game to the queue. May be called from any thread.
+*
+* @param queue - The queue.
+* @param record - The game, and the ticket which is given its result.
+* @return
+* 	false - if the queue is full.
+* 	true - otherwise.
+*/
+bool submissionQueuePush(ChessSubmissionQueue queue, const SubmissionRecord *record);
+
+/**
+* submissionQueueWait: Waits until a ticket is given the result of its game.
+*
+* @param ticket - The ticket.
+* @return
+* 	The result of the ticket's game.
+*/
+ChessResult submissionQueueWait(const ChessSubmissionTicket *ticket);
+
+/**
+* submissionQueueClose: Applies the games left in the queue, stops its applier thread and deallocates it.
+*
+* @param queue - The queue. If queue is NULL nothing will be done.
+*/
+void submissionQueueClose(ChessSubmissionQueue queue);
+
+#endif /* SUBMISSION_QUEUE_H_ */
@@ -0,0 +1,165 @@
+#include "submissionRing.h"
+#include <stdlib.h>
+
+#define SUBMISSION_RING_MIN_CAPACITY 16
+#define SUBMISSION_RING_MAX_CAPACITY (1 << 24)
+#define SUBMISSION_RING_CACHE_LINE 64
+
+/**
+* Type for a slot of the ring. A slot whose sequence number equals a position of the tail is free for the game
+* pushed at that position, and one whose sequence number is one past a position of the head holds the game to pop
+* at that position.
+*/
+typedef struct submission_slot_t {
+    unsigned long sequence;
+    SubmissionRecord record;
+} SubmissionSlot;
+
+/** The tail is moved by the pushing threads and the head by the popping one, so they sit on separate lines */
+struct submission_ring_t {
+    SubmissionSlot *slots;
+    int capacity;
+    int closed;
+    char tail_padding[SUBMISSION_RING_CACHE_LINE];
+    unsigned long tail;
+    char head_padding[SUBMISSION_RING_CACHE_LINE];
+    unsigned long head;
+};
+
+SubmissionRing submissionRingCreate(int capacity)
+{
+    SubmissionRing ring = malloc(sizeof(*ring));
+    if (ring == NULL)
+    {
+        return NULL;
+    }
+
+    ring->capacity = SUBMISSION_RING_MIN_CAPACITY;
+    while (ring->capacity < capacity && ring->capacity < SUBMISSION_RING_MAX_CAPACITY)
+    {
+        ring->capacity = ring->capacity * 2;
+    }
+    ring->slots = malloc(sizeof(*ring->slots) * ring->capacity);
+    if (ring->slots == NULL)
+    {
+        free(ring);
+        return NULL;
+    }
+    for (int index = 0; index < ring->capacity; index++)
+    {
+        ring->slots[index].sequence = (unsigned long) index;
+    }
+    ring->closed = false;
+    ring->tail = 0;
+    ring->head = 0;
+    return ring;
+}
+
+void submissionRingDestroy(SubmissionRing ring)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+    free(ring->slots);
+    free(ring);
+}
+
+int submissionRingGetCapacity(SubmissionRing ring)
+{
+    return ring->capacity;
+}
+
+/**
+*	submissionTicketReset: marks a ticket as waiting for the result of its game, before the game is pushed.
+*
+* @param ticket - The ticket. If ticket is NULL nothing will be done.
+* @return
+* 	None
+*/
+static void submissionTicketReset(ChessSubmissionTicket *ticket)
+{
+    if (ticket != NULL)
+    {
+        __atomic_store_n(&ticket->done, false, __ATOMIC_RELAXED);
+    }
+}
+
+bool submissionRingPush(SubmissionRing ring, const SubmissionRecord *record)
+{
+    unsigned long position = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    while (true)
+    {
+        SubmissionSlot *slot = &ring->slots[position & (unsigned long) (ring->capacity - 1)];
+        long difference = (long) (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - position);
+        if (difference < 0)
+        {
+            // The slot still holds the game pushed a whole ring earlier
+            return false;
+        }
+        if (difference > 0)
+        {
+            position = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+            continue;
+        }
+        // A failed claim means another thread took the position, and reloads it for the next attempt
+        if (__atomic_compare_exchange_n(&ring->tail, &position, position + 1, true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED) == true)
+        {
+            submissionTicketReset(record->ticket);
+            slot->record = *record;
+            __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+    }
+}
+
+int submissionRingPop(SubmissionRing ring, SubmissionRecord *records, int max_records)
+{
+    int number_of_records = 0;
+    while (number_of_records < max_records)
+    {
+        SubmissionSlot *slot = &ring->slots[ring->head & (unsigned long) (ring->capacity - 1)];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != ring->head + 1)
+        {
+            break;
+        }
+        records[number_of_records++] = slot->record;
+        __atomic_store_n(&slot->sequence, ring->head + (unsigned long) ring->capacity, __ATOMIC_RELEASE);
+        ring->head++;
+    }
+    return number_of_records;
+}
+
+void submissionRingClose(SubmissionRing ring)
+{
+    __atomic_store_n(&ring->closed, true, __ATOMIC_RELEASE);
+}
+
+bool submissionRingIsClosed(SubmissionRing ring)
+{
+    return __atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE) == true;
+}
+
+void submissionTicketComplete(ChessSubmissionTicket *ticket, ChessResult result)
+{
+    if (ticket == NULL)
+    {
+        return;
+    }
+    ticket->result = result;
+    __atomic_store_n(&ticket->done, true, __ATOMIC_RELEASE);
+}
+
+bool submissionTicketIsComplete(const ChessSubmissionTicket *ticket, ChessResult *result)
+{
+    if (__atomic_load_n(&ticket->done, __ATOMIC_ACQUIRE) == false)
+    {
+        return false;
+    }
+    if (result != NULL)
+    {
+        *result = ticket->result;
+    }
+    return true;
+}
@@ -0,0 +1,128 @@
+#ifndef SUBMISSION_RING_H_
+#define SUBMISSION_RING_H_
+
+#include "chessSystemExtensions.h"
+#include <stdbool.h>
+
+/**
+* Submission Ring
+*
+* A ring of fixed capacity which many threads push submitted games into, and a single thread pops them from,
+* without locks. Each slot carries a sequence number which tells whose turn it is: a pusher claims the next slot
+* by advancing the tail, and hands it to the popper by moving the slot's sequence number on, so a pusher never
+* waits for other pushers or for the popper. The ring is shared by threads in every build, so it uses atomic
+* operations even where the locks of the chess system are compiled out.
+*
+* The following functions are available:
+*   submissionRingCreate	- Creates a new empty ring
+*   submissionRingDestroy	- Deletes an existing ring and frees all resources
+*   submissionRingGetCapacity	- Gets the number of games the ring holds
+*   submissionRingPush	- Adds a game to the ring, from any thread
+*   submissionRingPop	- Takes the oldest games out of the ring, from the popping thread only
+*   submissionRingClose	- Tells the popping thread no more games will be pushed
+*   submissionRingIsClosed	- Checks if the ring was closed
+*   submissionTicketComplete	- Gives a ticket the result of its game
+*   submissionTicketIsComplete	- Checks if a ticket was given the result of its game
+*/
+
+/** Type for defining the submission ring */
+typedef struct submission_ring_t *SubmissionRing;
+
+/** Type for a game submitted to the ring, and the ticket waiting for its result */
+typedef struct submission_record_t {
+    int tournament_id;
+    int first_player;
+    int second_player;
+    Winner winner;
+    int play_time;
+    ChessSubmissionTicket *ticket;
+} SubmissionRecord;
+
+/**
+* submissionRingCreate: Allocates a new empty ring.
+*
+* @param capacity - The number of games the ring holds, rounded up to a power of two.
+* @return
+* 	NULL - if allocations failed.
+* 	A new SubmissionRing in case of success.
+*/
+SubmissionRing submissionRingCreate(int capacity);
+
+/**
+* submissionRingDestroy: Deallocates an existing ring. Games still in the ring are dropped.
+*
+* @param ring - Target ring to be deallocated. If ring is NULL nothing will be done.
+*/
+void submissionRingDestroy(SubmissionRing ring);
+
+/**
+* submissionRingGetCapacity: Gets the number of games the ring holds.
+*
+* @param ring - The ring.
+* @return
+* 	The capacity of the ring.
+*/
+int submissionRingGetCapacity(SubmissionRing ring);
+
+/**
+* submissionRingPush: Adds a game to the ring, and marks its ticket as waiting for the result. May be called by
+* many threads at once, and never waits for them.
+*
+* @param ring - The ring.
+* @param record - The game.
+* @return
+* 	false - if the ring is full. The ring is unchanged in that case.
+* 	true - if the game was added.
+*/
+bool submissionRingPush(SubmissionRing ring, const SubmissionRecord *record);
+
+/**
+* submissionRingPop: Takes the oldest games out of the ring. Must be called by a single thread only.
+*
+* @param ring - The ring.
+* @param records - Output array for the games.
+* @param max_records - The size of the array.
+* @return
+* 	The number of games taken, 0 if the ring is empty.
+*/
+int submissionRingPop(SubmissionRing ring, SubmissionRecord *records, int max_records);
+
+/**
+* submissionRingClose: Tells the popping thread that no more games will be pushed, once the games in the ring are
+* popped.
+*
+* @param ring - The ring.
+*/
+void submissionRingClose(SubmissionRing ring);
+
+/**
+* submissionRingIsClosed: Checks if the ring was closed. Games pushed before it was closed are seen by the next
+* pop.
+*
+* @param ring - The ring.
+* @return
+* 	true - if the ring was closed.
+* 	false - otherwise.
+*/
+bool submissionRingIsClosed(SubmissionRing ring);
+
+/**
+* submissionTicketComplete: Gives a ticket the result of its game, for the thread which waits for it.
+*
+* @param ticket - The ticket. If ticket is NULL nothing will be done.
+* @param result - The result of the game.
+*/
+void submissionTicketComplete(ChessSubmissionTicket *ticket, ChessResult result);
+
+/**
+* submissionTicketIsComplete: Checks if a ticket was given the result of its game.
+*
+* @param ticket - The ticket.
+* @param result - Output for the result, set only if the ticket was given it. May be NULL.
+* @return
+* 	true - if the ticket was given the result.
+* 	false - otherwise.
+*/
+bool submissionTicketIsComplete(const ChessSubmissionTicket *ticket, ChessResult *result);
+
+#endif /* SUBMISSION_RING_H_ */
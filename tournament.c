@@ -1,342 +1,998 @@
-#include <stdlib.h>
-#include <stdbool.h>
-#include "tournament.h"
-#include "game.h"
-#include "player.h"
-#include "map.h"
-
-struct tournament_t {
-    Map games;
-    Map players;
-    int winner;
-    int max_games_per_player;
-    const char* location;
-    int number_of_games;
-    int number_of_players;
-    int longest_game_time;
-    int total_play_time;
-
-};
-
-MapDataElement copyDataTournament(MapDataElement element)
-{
-    if (element == NULL)
-    {
-        return NULL;
-    }
-    Tournament new_tournament = tournamentCopy((Tournament)element);
-    if (new_tournament == NULL)
-    {
-        return NULL;
-    }
-    return new_tournament;
-}
-
-MapKeyElement copyKeyTournamentID(MapKeyElement element)
-{
-    if (element == NULL)
-    {
-        return NULL;
-    }
-
-    int* new_int = malloc(sizeof(*new_int));
-    if (new_int == NULL){
-        return NULL;
-    }
-    *new_int = *(int*) element;
-    return new_int;
-}
-
-void freeDataTournament(MapDataElement element)
-{
-    tournamentDestroy((Tournament)element);
-}
-
-void freeKeyTournamentID(MapKeyElement element)
-{
-    free(element);
-}
-
-int compareKeyTournamentID(MapKeyElement element1, MapKeyElement element2)
-{
-    return *(int*) element1 - *(int*) element2;
-}
-
-Map tournamentMapFactory()
-{
-    Map tournament_map = mapCreate(copyDataTournament, copyKeyTournamentID, freeDataTournament, freeKeyTournamentID, compareKeyTournamentID);
-    if (tournament_map == NULL)
-    {
-        return NULL;
-    }
-    return tournament_map;
-}
-
-Tournament tournamentCreate(int max_games_per_player, const char* location)
-{
-    Tournament new_tournament = malloc(sizeof(*new_tournament));
-    if (new_tournament == NULL)
-    {
-        return NULL;
-    }
-
-    new_tournament->games = gameMapFactory();
-    if (new_tournament->games == NULL)
-    {
-        free(new_tournament);
-        return NULL;
-    }
-
-    new_tournament->players = playerMapFactory();
-    if (new_tournament->players == NULL)
-    {
-        mapDestroy(new_tournament->games);
-        free(new_tournament);
-        return NULL;
-    }
-
-    new_tournament->winner = TOURNAMENT_NOT_ENDED;
-    new_tournament->max_games_per_player = max_games_per_player;
-    new_tournament->location = location;
-    new_tournament->number_of_games = 0;
-    new_tournament->number_of_players = 0;
-    new_tournament->longest_game_time = 0;
-    new_tournament->total_play_time = 0;
-
-    return new_tournament;
-}
-
-void tournamentDestroy(Tournament tournament)
-{
-    if (tournament == NULL)
-    {
-        return;
-    }
-
-    mapDestroy(tournament->games); 
-    mapDestroy(tournament->players);
-    tournament->location = NULL;
-    tournament->longest_game_time = 0;
-    tournament->max_games_per_player = 0;
-    tournament->number_of_games = 0;
-    tournament->total_play_time = 0;
-    tournament->winner = 0;
-    free(tournament);
-}
-
-Tournament tournamentCopy(Tournament tournament)
-{
-    if (tournament == NULL)
-    {
-        return NULL;
-    }
-
-    Tournament tournament_cpy = malloc(sizeof(*tournament_cpy));
-    if (tournament_cpy == NULL)
-    {
-        return NULL;
-    }
-
-    tournament_cpy->games = mapCopy(tournament->games);
-    if (tournament_cpy->games == NULL)
-    {
-        tournamentDestroy(tournament_cpy);
-        return NULL;
-    }
-
-    tournament_cpy->players = mapCopy(tournament->players);
-    if (tournament_cpy->players == NULL)
-    {
-        tournamentDestroy(tournament_cpy);
-        return NULL;
-    }
-
-    tournament_cpy->winner = tournament->winner;
-    tournament_cpy->max_games_per_player = tournament->max_games_per_player;
-    tournament_cpy->location = tournament->location;
-    tournament_cpy->number_of_games = tournament->number_of_games;
-    tournament_cpy->number_of_players = tournament->number_of_players;
-    tournament_cpy->longest_game_time = tournament->longest_game_time;
-    tournament_cpy->total_play_time = tournament->total_play_time;
-    
-    return tournament_cpy;
-}
-
-int tournamentGetWinner(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST;
-    }
-    return tournament->winner;
-}
-
-void tournamentSetWinner(Tournament tournament, int winner_id)
-{
-    if(tournament == NULL)
-    {
-        return;
-    }
-    tournament->winner = winner_id;
-}
-
-Map tournamentGetGamesMap(Tournament tournament)
-{
-    if (tournament == NULL)
-    {
-        return NULL;
-    }
-    return tournament->games;
-}
-
-Map tournamentGetPlayersMap(Tournament tournament)
-{
-    if (tournament == NULL)
-    {
-        return NULL;
-    }
-    return tournament->players;
-}
-
-int tournamentGetMaxGamesPerPlayer(Tournament tournament)
-{
-    if (tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST;
-    }
-    return tournament->max_games_per_player;
-}
-
-void tournamentSetMaxGamesPerPlayer(Tournament tournament, int max)
-{
-    if (tournament == NULL)
-    {
-        return;
-    }
-    tournament->max_games_per_player = max;
-}
-
-const char* tournamentGetLocation(Tournament tournament)
-{
-    if (tournament == NULL)
-    {
-        return INVALID_LOCATION;
-    }
-    return tournament->location;
-}
-
-void tournamentSetLocation(Tournament tournament, const char *location)
-{
-    if (tournament == NULL)
-    {
-        return;
-    }
-    tournament->location = location;
-}
-
-int countGamesPlayerPlayedInTournament(Tournament tournament, int player_id)
-{
-    if (tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST; 
-    }
-    int count = 0;
-
-    MAP_FOREACH (Game, current_game_id, tournament->games)
-    {
-        Game current_game = mapGet(tournament->games, current_game_id);
-        if (isPlayerInCurrentGame(current_game, player_id))
-        {
-            count++;
-        }
-        free(current_game_id);
-    }
-    return count;
-}
-
-bool isMaxGamesPerPlayerExceeded(Tournament tournament, int player_id)
-{
-    return (tournament->max_games_per_player <= countGamesPlayerPlayedInTournament(tournament, player_id));
-}
-
-int tournamentGetNumberOfGames(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST;
-    }
-    return tournament->number_of_games;
-}
-
-void tournamentUpdateNumberOfGames(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return;
-    }
-    tournament->number_of_games++;
-}
-
-void tournamentUpdateNumberOfPlayers(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return;
-    }
-    tournament->number_of_players++;
-}
-
-int tournamentGetNumberOfPlayers(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST;
-    }
-    return tournament->number_of_players;
-}
-
-int tournamentGetLongestGameTime(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST;
-    }
-    return tournament->longest_game_time;
-}
-
-void tournamentUpdateLongestGameTime(Tournament tournament, int game_play_time)
-{
-    if(tournament == NULL)
-    {
-        return;
-    }
-    if (tournament->longest_game_time < game_play_time)
-    {
-        tournament->longest_game_time = game_play_time;
-    }
-}
-
-int tournamentGetTotalPlayTime(Tournament tournament)
-{
-    if(tournament == NULL)
-    {
-        return TOURNAMENT_NOT_EXIST;
-    }
-    return tournament->total_play_time;
-}
-
-void tournamentUpdateTotalPlayTime(Tournament tournament, int game_play_time)
-{
-    if(tournament == NULL)
-    {
-        return;
-    }
-    tournament->total_play_time = tournament->total_play_time + game_play_time;
-}
-
-void tournamentUpdateStats(Tournament tournament, int play_time)
-{
-    tournamentUpdateNumberOfGames(tournament);
-    tournamentUpdateLongestGameTime(tournament, play_time);
-    tournamentUpdateTotalPlayTime(tournament, play_time);
-}
\ No newline at end of file
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "tournament.h"
+#include "game.h"
+#include "player.h"
+#include "map.h"
+#include "snapshot.h"
+#include "spillStore.h"
+#include "chessLock.h"
+
+struct tournament_t {
+    Map games;
+    Map players;
+    TournamentCache cache;
+    SpillSlot spill_slot;
+    bool evicted;
+    int evicted_games;
+    int evicted_players;
+    Tournament newer;
+    Tournament older;
+    int winner;
+    int max_games_per_player;
+    char* location;
+    int number_of_games;
+    int number_of_players;
+    int longest_game_time;
+    int longest_game_count;
+    bool longest_game_stale;
+    int total_play_time;
+    int last_game_id;
+    bool dirty;
+    char* statistics;
+    int statistics_length;
+    ChessMutex lock;
+};
+
+/** Type for the cache of spilled tournaments, which are kept in memory from the most recently used */
+struct tournament_cache_t {
+    SpillStore store;
+    int capacity;
+    int number_of_resident;
+    Tournament most_recent;
+    Tournament least_recent;
+    int evicted_games;
+    int evicted_players;
+};
+
+/** Type for the header of a spilled tournament's record, which is followed by its games and players */
+typedef struct spill_record_header_t {
+    int number_of_games;
+    int number_of_players;
+} SpillRecordHeader;
+
+MapDataElement copyDataTournament(MapDataElement element)
+{
+    if (element == NULL)
+    {
+        return NULL;
+    }
+    Tournament new_tournament = tournamentCopy((Tournament)element);
+    if (new_tournament == NULL)
+    {
+        return NULL;
+    }
+    return new_tournament;
+}
+
+MapKeyElement copyKeyTournamentID(MapKeyElement element)
+{
+    if (element == NULL)
+    {
+        return NULL;
+    }
+
+    int* new_int = malloc(sizeof(*new_int));
+    if (new_int == NULL){
+        return NULL;
+    }
+    *new_int = *(int*) element;
+    return new_int;
+}
+
+void freeDataTournament(MapDataElement element)
+{
+    tournamentDestroy((Tournament)element);
+}
+
+void freeKeyTournamentID(MapKeyElement element)
+{
+    free(element);
+}
+
+int compareKeyTournamentID(MapKeyElement element1, MapKeyElement element2)
+{
+    return *(int*) element1 - *(int*) element2;
+}
+
+Map tournamentMapFactory()
+{
+    Map tournament_map = mapCreate(copyDataTournament, copyKeyTournamentID, freeDataTournament, freeKeyTournamentID, compareKeyTournamentID);
+    if (tournament_map == NULL)
+    {
+        return NULL;
+    }
+    return tournament_map;
+}
+
+/**
+*	tournamentDropStatistics: frees a tournament's cached statistics.
+*
+* @param tournament - The tournament whose statistics are dropped.
+*
+* @return
+* 	None
+*/
+static void tournamentDropStatistics(Tournament tournament)
+{
+    free(tournament->statistics);
+    tournament->statistics = NULL;
+    tournament->statistics_length = 0;
+}
+
+/**
+*	copyLocation: copies a tournament's location string.
+*
+* @param location - The location to copy.
+*
+* @return
+* 	NULL - If location is NULL or there was a memory allocation error.
+*   A copy of the location otherwise.
+*/
+static char* copyLocation(const char* location)
+{
+    if (location == NULL)
+    {
+        return NULL;
+    }
+
+    char* location_cpy = malloc(strlen(location) + 1);
+    if (location_cpy == NULL)
+    {
+        return NULL;
+    }
+    strcpy(location_cpy, location);
+    return location_cpy;
+}
+
+/**
+*	tournamentInitSpill: initializes a new tournament as one which isn't spilled.
+*
+* @param tournament - The new tournament.
+*
+* @return
+* 	None
+*/
+static void tournamentInitSpill(Tournament tournament)
+{
+    SpillSlot empty_slot = SPILL_SLOT_EMPTY;
+    tournament->cache = NULL;
+    tournament->spill_slot = empty_slot;
+    tournament->evicted = false;
+    tournament->evicted_games = 0;
+    tournament->evicted_players = 0;
+    tournament->newer = NULL;
+    tournament->older = NULL;
+}
+
+/**
+*	cacheUnlink: removes a resident tournament from the cache's recently used list.
+*
+* @param cache - The cache.
+* @param tournament - The resident tournament.
+*
+* @return
+* 	None
+*/
+static void cacheUnlink(TournamentCache cache, Tournament tournament)
+{
+    if (tournament->newer != NULL)
+    {
+        tournament->newer->older = tournament->older;
+    }
+    else
+    {
+        cache->most_recent = tournament->older;
+    }
+    if (tournament->older != NULL)
+    {
+        tournament->older->newer = tournament->newer;
+    }
+    else
+    {
+        cache->least_recent = tournament->newer;
+    }
+    tournament->newer = NULL;
+    tournament->older = NULL;
+    cache->number_of_resident--;
+}
+
+/**
+*	cacheLinkMostRecent: adds a resident tournament to the cache's recently used list, as the most recent.
+*
+* @param cache - The cache.
+* @param tournament - The resident tournament, which isn't in the list.
+*
+* @return
+* 	None
+*/
+static void cacheLinkMostRecent(TournamentCache cache, Tournament tournament)
+{
+    tournament->newer = NULL;
+    tournament->older = cache->most_recent;
+    if (cache->most_recent != NULL)
+    {
+        cache->most_recent->newer = tournament;
+    }
+    else
+    {
+        cache->least_recent = tournament;
+    }
+    cache->most_recent = tournament;
+    cache->number_of_resident++;
+}
+
+/**
+*	tournamentEvict: writes the games and players of a resident spilled tournament to the spill file, and frees
+*                    them. They are written even if they didn't change since they were read, as their maps were
+*                    handed out.
+*
+* @param tournament - The resident spilled tournament.
+*
+* @return
+* 	false - If there was a memory allocation or write error. The tournament is left resident.
+*   true - Otherwise.
+*/
+static bool tournamentEvict(Tournament tournament)
+{
+    SpillRecordHeader header = {mapGetSize(tournament->games), mapGetSize(tournament->players)};
+    int size = (int) (sizeof(header) + header.number_of_games * sizeof(SnapshotGame) +
+                      header.number_of_players * sizeof(SnapshotPlayer));
+    char *record = malloc(size);
+    if (record == NULL)
+    {
+        return false;
+    }
+
+    memcpy(record, &header, sizeof(header));
+    SnapshotGame *games = (SnapshotGame*) (record + sizeof(header));
+    int index = 0;
+    MAP_FOREACH(int*, current_game_id, tournament->games)
+    {
+        Game current_game = mapGet(tournament->games, current_game_id);
+        SnapshotGame game_record = {*current_game_id, gameGetFirstPlayer(current_game),
+                                    gameGetSecondPlayer(current_game), gameGetWinner(current_game),
+                                    gameGetPlayTime(current_game)};
+        games[index++] = game_record;
+        free(current_game_id);
+    }
+    SnapshotPlayer *players = (SnapshotPlayer*) (games + header.number_of_games);
+    index = 0;
+    MAP_FOREACH(int*, current_player_id, tournament->players)
+    {
+        Player current_player = mapGet(tournament->players, current_player_id);
+        SnapshotPlayer player_record = {*current_player_id, playerGetWins(current_player),
+                                        playerGetLoses(current_player), playerGetDraws(current_player),
+                                        playerGetTotalPlayTime(current_player)};
+        players[index++] = player_record;
+        free(current_player_id);
+    }
+
+    bool written = spillStoreWrite(tournament->cache->store, &tournament->spill_slot, record, size);
+    free(record);
+    if (written == false)
+    {
+        return false;
+    }
+
+    mapDestroy(tournament->games);
+    mapDestroy(tournament->players);
+    tournament->games = NULL;
+    tournament->players = NULL;
+    tournament->evicted = true;
+    tournament->evicted_games = header.number_of_games;
+    tournament->evicted_players = header.number_of_players;
+    tournament->cache->evicted_games += header.number_of_games;
+    tournament->cache->evicted_players += header.number_of_players;
+    cacheUnlink(tournament->cache, tournament);
+    return true;
+}
+
+/**
+*	spillRecordLoad: fills empty games and players maps from a spilled tournament's record.
+*
+* @param record - The record.
+* @param games_map - The games map to fill.
+* @param players_map - The players map to fill.
+*
+* @return
+* 	false - In case of memory error.
+*   true - Otherwise.
+*/
+static bool spillRecordLoad(const char *record, Map games_map, Map players_map)
+{
+    SpillRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    const SnapshotGame *games = (const SnapshotGame*) (record + sizeof(header));
+    for (int index = 0; index < header.number_of_games; index++)
+    {
+        Game game = gameCreate((Winner) games[index].winner, games[index].play_time, games[index].first_player,
+                               games[index].second_player);
+        if (game == NULL)
+        {
+            return false;
+        }
+        MapResult put_result = mapPut(games_map, (MapKeyElement) &games[index].game_id, game);
+        gameDestroy(game);
+        if (put_result != MAP_SUCCESS)
+        {
+            return false;
+        }
+    }
+
+    const SnapshotPlayer *players = (const SnapshotPlayer*) (games + header.number_of_games);
+    for (int index = 0; index < header.number_of_players; index++)
+    {
+        Player player = playerCreate(players[index].player_id);
+        if (player == NULL)
+        {
+            return false;
+        }
+        playerSetStats(player, players[index].wins, players[index].loses, players[index].draws,
+                       players[index].total_play_time);
+        MapResult put_result = mapPut(players_map, (MapKeyElement) &players[index].player_id, player);
+        playerDestroy(player);
+        if (put_result != MAP_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+*	tournamentLoad: reads the games and players of an evicted tournament back from the spill file.
+*
+* @param tournament - The evicted tournament.
+*
+* @return
+* 	false - If there was a memory allocation or read error. The tournament is left evicted.
+*   true - Otherwise. The tournament is resident, and the most recently used.
+*/
+static bool tournamentLoad(Tournament tournament)
+{
+    char *record = malloc(tournament->spill_slot.size);
+    Map games_map = gameMapFactory();
+    Map players_map = playerMapFactory();
+    if (record == NULL || games_map == NULL || players_map == NULL ||
+        spillStoreRead(tournament->cache->store, &tournament->spill_slot, record) == false ||
+        spillRecordLoad(record, games_map, players_map) == false)
+    {
+        free(record);
+        mapDestroy(games_map);
+        mapDestroy(players_map);
+        return false;
+    }
+    free(record);
+
+    tournament->games = games_map;
+    tournament->players = players_map;
+    tournament->evicted = false;
+    tournament->cache->evicted_games -= tournament->evicted_games;
+    tournament->cache->evicted_players -= tournament->evicted_players;
+    tournament->evicted_games = 0;
+    tournament->evicted_players = 0;
+    cacheLinkMostRecent(tournament->cache, tournament);
+    return true;
+}
+
+/**
+*	cacheEvictLeastRecent: evicts the least recently used resident tournaments of the cache, until no more
+*                          than its capacity are resident.
+*
+* @param cache - The cache.
+* @param keep - A tournament which is not evicted, as it is in use. NULL if there is none.
+*
+* @return
+* 	None
+*/
+static void cacheEvictLeastRecent(TournamentCache cache, Tournament keep)
+{
+    while (cache->number_of_resident > cache->capacity)
+    {
+        Tournament victim = cache->least_recent;
+        // A tournament which can't be written stays resident, and is retried on the next eviction
+        if (victim == keep || tournamentEvict(victim) == false)
+        {
+            return;
+        }
+    }
+}
+
+/**
+*	tournamentMakeResident: makes sure the games and players of a tournament are in memory, reading them back
+*                           from the spill file if it was evicted, and marks it as the most recently used.
+*                           Other tournaments may be evicted, which invalidates their maps.
+*
+* @param tournament - The tournament.
+*
+* @return
+* 	false - If the tournament was evicted and couldn't be read back.
+*   true - Otherwise.
+*/
+static bool tournamentMakeResident(Tournament tournament)
+{
+    if (tournament->cache == NULL)
+    {
+        return true;
+    }
+    if (tournament->evicted == true)
+    {
+        if (tournamentLoad(tournament) == false)
+        {
+            return false;
+        }
+    }
+    else if (tournament->cache->most_recent != tournament)
+    {
+        cacheUnlink(tournament->cache, tournament);
+        cacheLinkMostRecent(tournament->cache, tournament);
+    }
+    cacheEvictLeastRecent(tournament->cache, tournament);
+    return true;
+}
+
+TournamentCache tournamentCacheCreate(const char *path, int capacity)
+{
+    TournamentCache cache = malloc(sizeof(*cache));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+    cache->store = spillStoreCreate(path);
+    if (cache->store == NULL)
+    {
+        free(cache);
+        return NULL;
+    }
+    cache->capacity = (capacity > 0) ? capacity : 1;
+    cache->number_of_resident = 0;
+    cache->most_recent = NULL;
+    cache->least_recent = NULL;
+    cache->evicted_games = 0;
+    cache->evicted_players = 0;
+    return cache;
+}
+
+void tournamentCacheDestroy(TournamentCache cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    spillStoreDestroy(cache->store);
+    free(cache);
+}
+
+void tournamentCacheSetCapacity(TournamentCache cache, int capacity)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    cache->capacity = (capacity > 0) ? capacity : 1;
+    cacheEvictLeastRecent(cache, NULL);
+}
+
+void tournamentCacheGetEvicted(TournamentCache cache, int *number_of_games, int *number_of_players)
+{
+    *number_of_games = (cache != NULL) ? cache->evicted_games : 0;
+    *number_of_players = (cache != NULL) ? cache->evicted_players : 0;
+}
+
+bool tournamentSpill(Tournament tournament, TournamentCache cache)
+{
+    if (tournament == NULL || cache == NULL)
+    {
+        return false;
+    }
+    if (tournament->cache != NULL)
+    {
+        return tournament->cache == cache;
+    }
+
+    // Only the summary stays in memory, so the longest game is found while the games are still there
+    tournamentGetLongestGameTime(tournament);
+    tournament->cache = cache;
+    cacheLinkMostRecent(cache, tournament);
+    if (tournamentEvict(tournament) == false)
+    {
+        cacheUnlink(cache, tournament);
+        tournament->cache = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool tournamentIsEvicted(Tournament tournament)
+{
+    return tournament != NULL && tournament->evicted == true;
+}
+
+Tournament tournamentCreate(int max_games_per_player, const char* location)
+{
+    Tournament new_tournament = malloc(sizeof(*new_tournament));
+    if (new_tournament == NULL)
+    {
+        return NULL;
+    }
+
+    new_tournament->location = copyLocation(location);
+    if (new_tournament->location == NULL && location != NULL)
+    {
+        free(new_tournament);
+        return NULL;
+    }
+
+    new_tournament->games = gameMapFactory();
+    if (new_tournament->games == NULL)
+    {
+        free(new_tournament->location);
+        free(new_tournament);
+        return NULL;
+    }
+
+    new_tournament->players = playerMapFactory();
+    if (new_tournament->players == NULL)
+    {
+        mapDestroy(new_tournament->games);
+        free(new_tournament->location);
+        free(new_tournament);
+        return NULL;
+    }
+
+    new_tournament->winner = TOURNAMENT_NOT_ENDED;
+    new_tournament->max_games_per_player = max_games_per_player;
+    new_tournament->number_of_games = 0;
+    new_tournament->number_of_players = 0;
+    new_tournament->longest_game_time = 0;
+    new_tournament->longest_game_count = 0;
+    new_tournament->longest_game_stale = false;
+    new_tournament->total_play_time = 0;
+    new_tournament->last_game_id = 0;
+    new_tournament->dirty = true;
+    new_tournament->statistics = NULL;
+    new_tournament->statistics_length = 0;
+    if (chessMutexInit(&new_tournament->lock) == false)
+    {
+        mapDestroy(new_tournament->players);
+        mapDestroy(new_tournament->games);
+        free(new_tournament->location);
+        free(new_tournament);
+        return NULL;
+    }
+    tournamentInitSpill(new_tournament);
+
+    return new_tournament;
+}
+
+int tournamentGetMemoryFootprint(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return sizeof(*tournament) + (tournament->location != NULL ? (int) strlen(tournament->location) + 1 : 0);
+}
+
+void tournamentDestroy(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return;
+    }
+
+    if (tournament->cache != NULL && tournament->evicted == true)
+    {
+        tournament->cache->evicted_games -= tournament->evicted_games;
+        tournament->cache->evicted_players -= tournament->evicted_players;
+    }
+    else if (tournament->cache != NULL)
+    {
+        cacheUnlink(tournament->cache, tournament);
+    }
+    mapDestroy(tournament->games); 
+    mapDestroy(tournament->players);
+    chessMutexDestroy(&tournament->lock);
+    free(tournament->location);
+    tournament->location = NULL;
+    free(tournament->statistics);
+    tournament->statistics = NULL;
+    tournament->longest_game_time = 0;
+    tournament->max_games_per_player = 0;
+    tournament->number_of_games = 0;
+    tournament->total_play_time = 0;
+    tournament->winner = 0;
+    free(tournament);
+}
+
+Tournament tournamentCopy(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return NULL;
+    }
+
+    Tournament tournament_cpy = malloc(sizeof(*tournament_cpy));
+    if (tournament_cpy == NULL)
+    {
+        return NULL;
+    }
+    if (chessMutexInit(&tournament_cpy->lock) == false)
+    {
+        free(tournament_cpy);
+        return NULL;
+    }
+
+    tournamentInitSpill(tournament_cpy);
+    tournament_cpy->games = mapCopy(tournamentGetGamesMap(tournament));
+    tournament_cpy->players = mapCopy(tournamentGetPlayersMap(tournament));
+    tournament_cpy->location = copyLocation(tournament->location);
+    tournament_cpy->statistics = NULL;
+    tournament_cpy->statistics_length = 0;
+    if (tournament_cpy->games == NULL || tournament_cpy->players == NULL ||
+        (tournament_cpy->location == NULL && tournament->location != NULL))
+    {
+        tournamentDestroy(tournament_cpy);
+        return NULL;
+    }
+
+    tournament_cpy->winner = tournament->winner;
+    tournament_cpy->max_games_per_player = tournament->max_games_per_player;
+    tournament_cpy->number_of_games = tournament->number_of_games;
+    tournament_cpy->number_of_players = tournament->number_of_players;
+    tournament_cpy->longest_game_time = tournament->longest_game_time;
+    tournament_cpy->longest_game_count = tournament->longest_game_count;
+    tournament_cpy->longest_game_stale = tournament->longest_game_stale;
+    tournament_cpy->total_play_time = tournament->total_play_time;
+    tournament_cpy->last_game_id = tournament->last_game_id;
+    tournament_cpy->dirty = tournament->dirty;
+    // The cached statistics can be rendered again, so a failed copy only drops them
+    if (tournament->statistics != NULL)
+    {
+        tournament_cpy->statistics = malloc(tournament->statistics_length);
+        if (tournament_cpy->statistics != NULL)
+        {
+            memcpy(tournament_cpy->statistics, tournament->statistics, tournament->statistics_length);
+            tournament_cpy->statistics_length = tournament->statistics_length;
+        }
+    }
+    
+    return tournament_cpy;
+}
+
+void tournamentLock(Tournament tournament)
+{
+    chessMutexLock(&tournament->lock);
+}
+
+void tournamentUnlock(Tournament tournament)
+{
+    chessMutexUnlock(&tournament->lock);
+}
+
+int tournamentGetWinner(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return tournament->winner;
+}
+
+void tournamentSetWinner(Tournament tournament, int winner_id)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->winner = winner_id;
+    tournamentDropStatistics(tournament);
+}
+
+Map tournamentGetGamesMap(Tournament tournament)
+{
+    if (tournament == NULL || tournamentMakeResident(tournament) == false)
+    {
+        return NULL;
+    }
+    return tournament->games;
+}
+
+Map tournamentGetPlayersMap(Tournament tournament)
+{
+    if (tournament == NULL || tournamentMakeResident(tournament) == false)
+    {
+        return NULL;
+    }
+    return tournament->players;
+}
+
+int tournamentGetMaxGamesPerPlayer(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return tournament->max_games_per_player;
+}
+
+void tournamentSetMaxGamesPerPlayer(Tournament tournament, int max)
+{
+    if (tournament == NULL)
+    {
+        return;
+    }
+    tournament->max_games_per_player = max;
+}
+
+const char* tournamentGetLocation(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return INVALID_LOCATION;
+    }
+    return tournament->location;
+}
+
+bool tournamentSetLocation(Tournament tournament, const char *location)
+{
+    if (tournament == NULL)
+    {
+        return false;
+    }
+
+    char* new_location = copyLocation(location);
+    if (new_location == NULL && location != NULL)
+    {
+        return false;
+    }
+    free(tournament->location);
+    tournament->location = new_location;
+    return true;
+}
+
+int countGamesPlayerPlayedInTournament(Tournament tournament, int player_id)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST; 
+    }
+
+    Player player = mapGet(tournamentGetPlayersMap(tournament), &player_id);
+    if (player == NULL)
+    {
+        return 0;
+    }
+    return playerGetWins(player) + playerGetLoses(player) + playerGetDraws(player);
+}
+
+bool isMaxGamesPerPlayerExceeded(Tournament tournament, int player_id)
+{
+    return (tournament->max_games_per_player <= countGamesPlayerPlayedInTournament(tournament, player_id));
+}
+
+int tournamentGetNumberOfGames(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return tournament->number_of_games;
+}
+
+void tournamentUpdateNumberOfGames(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->number_of_games++;
+}
+
+void tournamentUpdateNumberOfPlayers(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->number_of_players++;
+}
+
+void tournamentDecreaseNumberOfPlayers(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->number_of_players--;
+}
+
+int tournamentGetNumberOfPlayers(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return tournament->number_of_players;
+}
+
+/**
+*	tournamentRecalculateLongestGameTime: scans the tournament's games and recalculates the longest game time
+*                                         and the number of games that lasted that long.
+*
+* @param tournament - the tournament whose longest game time needs to be recalculated.
+*
+* @return
+*      none
+*/
+static void tournamentRecalculateLongestGameTime(Tournament tournament)
+{
+    tournament->longest_game_time = 0;
+    tournament->longest_game_count = 0;
+    tournament->longest_game_stale = false;
+
+    Map games_map = tournamentGetGamesMap(tournament);
+    MAP_FOREACH (Game, current_game_id, games_map)
+    {
+        Game current_game = mapGet(games_map, current_game_id);
+        tournamentUpdateLongestGameTime(tournament, gameGetPlayTime(current_game));
+        free(current_game_id);
+    }
+}
+
+int tournamentGetLongestGameTime(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    if (tournament->longest_game_stale == true)
+    {
+        tournamentRecalculateLongestGameTime(tournament);
+    }
+    return tournament->longest_game_time;
+}
+
+void tournamentUpdateLongestGameTime(Tournament tournament, int game_play_time)
+{
+    if(tournament == NULL || tournament->longest_game_stale == true)
+    {
+        return;
+    }
+    if (tournament->longest_game_time < game_play_time || tournament->longest_game_count == 0)
+    {
+        tournament->longest_game_time = game_play_time;
+        tournament->longest_game_count = 1;
+    }
+    else if (tournament->longest_game_time == game_play_time)
+    {
+        tournament->longest_game_count++;
+    }
+}
+
+int tournamentGetTotalPlayTime(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return tournament->total_play_time;
+}
+
+void tournamentUpdateTotalPlayTime(Tournament tournament, int game_play_time)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->total_play_time = tournament->total_play_time + game_play_time;
+}
+
+void tournamentUpdateStats(Tournament tournament, int play_time)
+{
+    tournamentUpdateNumberOfGames(tournament);
+    tournamentUpdateLongestGameTime(tournament, play_time);
+    tournamentUpdateTotalPlayTime(tournament, play_time);
+}
+
+int tournamentGenerateGameID(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    tournament->last_game_id++;
+    return tournament->last_game_id;
+}
+
+void tournamentRemoveGameStats(Tournament tournament, int play_time)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->number_of_games--;
+    tournament->total_play_time = tournament->total_play_time - play_time;
+
+    if (tournament->longest_game_stale == false && tournament->longest_game_time == play_time)
+    {
+        tournament->longest_game_count--;
+        if (tournament->longest_game_count == 0)
+        {
+            tournament->longest_game_stale = true;
+        }
+    }
+}
+
+int tournamentGetLastGameID(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return TOURNAMENT_NOT_EXIST;
+    }
+    return tournament->last_game_id;
+}
+
+void tournamentRestoreStats(Tournament tournament, int number_of_games, int number_of_players,
+                            int total_play_time, int last_game_id)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->number_of_games = number_of_games;
+    tournament->number_of_players = number_of_players;
+    tournament->total_play_time = total_play_time;
+    tournament->last_game_id = last_game_id;
+    tournament->longest_game_time = 0;
+    tournament->longest_game_count = 0;
+    tournament->longest_game_stale = true;
+}
+
+bool tournamentIsDirty(Tournament tournament)
+{
+    if(tournament == NULL)
+    {
+        return false;
+    }
+    return tournament->dirty;
+}
+
+void tournamentSetDirty(Tournament tournament, bool dirty)
+{
+    if(tournament == NULL)
+    {
+        return;
+    }
+    tournament->dirty = dirty;
+    if (dirty == true)
+    {
+        tournamentDropStatistics(tournament);
+    }
+}
+
+const char* tournamentGetStatistics(Tournament tournament, int* length)
+{
+    if(tournament == NULL || tournament->statistics == NULL)
+    {
+        return NULL;
+    }
+    *length = tournament->statistics_length;
+    return tournament->statistics;
+}
+
+void tournamentSetStatistics(Tournament tournament, char* statistics, int length)
+{
+    if(tournament == NULL)
+    {
+        free(statistics);
+        return;
+    }
+    tournamentDropStatistics(tournament);
+    tournament->statistics = statistics;
+    tournament->statistics_length = (statistics != NULL) ? length : 0;
+}
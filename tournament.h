@@ -11,6 +11,9 @@
 /* type for representing a tournament */
 typedef struct tournament_t *Tournament;
 
+/* type for representing the cache of tournaments whose games and players were spilled to a file */
+typedef struct tournament_cache_t *TournamentCache;
+
 
 /**
  * copyDataTournament: copies a data, whose type is a tournament, from a given tournament.
@@ -85,7 +88,7 @@ Map tournamentMapFactory();
  * tournamentCreate: creates a tournament.
  *
  * @param max_games_per_player = the tournament's max games per player.
- * @param location - the tournament's location.
+ * @param location - the tournament's location. The tournament keeps its own copy.
  *
  * @return
  *      a new tournament in case of success.
@@ -93,6 +96,18 @@ Map tournamentMapFactory();
  */
 Tournament tournamentCreate(int max_games_per_player, const char* location);
 
+/**
+ * tournamentGetMemoryFootprint: gets the size in bytes of a given tournament and its location, without its
+ *                               games and players.
+ *
+ * @param tournament - the tournament which we need to find the size of.
+ *
+ * @return
+ *      TOURNAMENT_NOT_EXIST if the tournament parameter is null.
+ *      the size of the tournament if successful.
+ */
+int tournamentGetMemoryFootprint(Tournament tournament);
+
 /**
  * tournamentDestroy: deletes a given tournament.
  *
@@ -116,26 +131,51 @@ Tournament tournamentCopy(Tournament tournament);
 
 /**
  * tournamentGetGamesMap: finds the map of games of given tournament.
+ *                        a spilled tournament is read back into memory if it was evicted, which may evict
+ *                        other tournaments of its cache - so maps of other spilled tournaments must not be
+ *                        held across this call.
  *
  * @param tournament - the tournament which we need to find the games map for.
  *
  * @return
- *      NULL if tournament is null.
+ *      NULL if tournament is null, or it was evicted and couldn't be read back.
  *      map of games of the given tournament if successful.
  */
 Map tournamentGetGamesMap(Tournament tournament);
 
 /**
  * tournamentGetPlayersMap: finds the map of players of given tournament.
+ *                          spilled tournaments are read back as by tournamentGetGamesMap.
  *
  * @param tournament - the tournament which we need to find the players map for.
  *
  * @return
- *      NULL if tournament is null.
+ *      NULL if tournament is null, or it was evicted and couldn't be read back.
  *      map of players of the given tournament if successful.
  */
 Map tournamentGetPlayersMap(Tournament tournament);
 
+/**
+ * tournamentLock: locks a tournament, in the thread safe build. threads adding games to the same tournament
+ *                 hold its lock while they read and change its games, players and stats.
+ *
+ * @param tournament - the tournament to lock. must not be NULL.
+ *
+ * @return
+ *      none
+ */
+void tournamentLock(Tournament tournament);
+
+/**
+ * tournamentUnlock: unlocks a tournament locked by tournamentLock.
+ *
+ * @param tournament - the tournament to unlock. must not be NULL.
+ *
+ * @return
+ *      none
+ */
+void tournamentUnlock(Tournament tournament);
+
 /**
  * tournamentGetWinner: finds the winner of the given tournament.
  *
@@ -194,15 +234,18 @@ const char* tournamentGetLocation(Tournament tournament);
  * tournamentSetLocation: sets the location of the given tournament.
  *
  * @param tournament - the tournament which we need to set the location for.
- * @param location - the location of the given tournament.
+ * @param location - the location of the given tournament. The tournament keeps its own copy.
  *
  * @return
- *      none.
+ *      false if tournament is null or in case of memory error. The location is unchanged in that case.
+ *      true if the location was set.
  */
-void tournamentSetLocation(Tournament tournament, const char *location);
+bool tournamentSetLocation(Tournament tournament, const char *location);
 
 /**
  *  countGamesPlayerPlayerInTournament: counts the amount of games a player has played in the given tournament.
+ *                                      Every game the player played is recorded as a win, loss or draw in the
+ *                                      tournament's players map, so the count doesn't scan the tournament's games.
  *
  * @param tournament - the tournament in which we need to count the games a player has played.
  * @param player_id - the player whose games we are counting.
@@ -258,6 +301,17 @@ void  tournamentUpdateNumberOfGames(Tournament tournament);
  */
 void tournamentUpdateNumberOfPlayers(Tournament tournament);
 
+/**
+ * tournamentDecreaseNumberOfPlayers: updates the number of players participating in the tournament.
+ *                                    this function is used when two of the tournament's players are merged.
+ *
+ * @param tournament - the tournament which we need to update the number of players of.
+ *
+ * @return
+ *      none
+ */
+void tournamentDecreaseNumberOfPlayers(Tournament tournament);
+
 /**
  * tournamentGetNumberOfPlayers: gets the number of players who participated in the tournament
  *
@@ -322,4 +376,184 @@ void tournamentUpdateTotalPlayTime(Tournament tournament, int game_play_time);
  */
 void tournamentUpdateStats(Tournament tournament, int play_time);
 
+/**
+ * tournamentGenerateGameID: generates the ID of the next game added to the tournament.
+ *                           IDs start from 1 and are never reused, even if games are removed.
+ *
+ * @param tournament - the tournament which the new game is added to.
+ *
+ * @return
+ *      TOURNAMENT_NOT_EXIST if the tournament parameter is null.
+ *      the new game's ID if successful.
+ */
+int tournamentGenerateGameID(Tournament tournament);
+
+/**
+ * tournamentRemoveGameStats: removes a game's time from the tournament's number of games, total play time,
+ *                            and longest game time. If the removed game was the only longest game, the
+ *                            longest game time is recalculated from the games map the next time it is needed,
+ *                            so the games map must be updated before then.
+ *
+ * @param tournament - the tournament whose stats need to be updated.
+ * @param play_time - the play time of the removed game.
+ *
+ * @return
+ *      none
+ */
+void tournamentRemoveGameStats(Tournament tournament, int play_time);
+
+/**
+ * tournamentGetLastGameID: finds the ID of the last game generated for the tournament.
+ *
+ * @param tournament - the tournament which we need to find the last game ID of.
+ *
+ * @return
+ *      TOURNAMENT_NOT_EXIST if the tournament parameter is null.
+ *      the last game ID, or 0 if no game was added to the tournament.
+ */
+int tournamentGetLastGameID(Tournament tournament);
+
+/**
+ * tournamentRestoreStats: sets the stats of a tournament whose games were loaded from a snapshot.
+ *                         the longest game time is recalculated from the games when it's needed.
+ *
+ * @param tournament - the tournament whose stats are set.
+ * @param number_of_games - the number of games in the tournament.
+ * @param number_of_players - the number of players who participated in the tournament.
+ * @param total_play_time - the total play time of the tournament's games.
+ * @param last_game_id - the ID of the last game generated for the tournament.
+ *
+ * @return
+ *      none
+ */
+void tournamentRestoreStats(Tournament tournament, int number_of_games, int number_of_players,
+                            int total_play_time, int last_game_id);
+
+/**
+ * tournamentIsDirty: checks if the tournament changed since it was last saved in a checkpoint.
+ *                    a new tournament is dirty until it is first saved.
+ *
+ * @param tournament - the tournament to check.
+ *
+ * @return
+ *      false if the tournament parameter is null or the tournament didn't change.
+ *      true if the tournament changed.
+ */
+bool tournamentIsDirty(Tournament tournament);
+
+/**
+ * tournamentSetDirty: marks the tournament as changed, or as saved in a checkpoint.
+ *                     a tournament must be marked as changed whenever its games, players or stats change.
+ *                     marking it as changed also drops its cached statistics.
+ *
+ * @param tournament - the tournament to mark.
+ * @param dirty - true if the tournament changed, false if it was saved.
+ *
+ * @return
+ *      none
+ */
+void tournamentSetDirty(Tournament tournament, bool dirty);
+
+/**
+ * tournamentGetStatistics: gets the cached statistics text of an ended tournament.
+ *
+ * @param tournament - the tournament whose statistics are requested.
+ * @param length - output for the length of the text.
+ *
+ * @return
+ *      NULL if the tournament parameter is null or no statistics are cached.
+ *      the cached text otherwise. it is not null terminated.
+ */
+const char* tournamentGetStatistics(Tournament tournament, int* length);
+
+/**
+ * tournamentSetStatistics: caches the statistics text of an ended tournament, replacing any cached text.
+ *                          the cache is dropped when the tournament's winner is set or the tournament changes.
+ *
+ * @param tournament - the tournament whose statistics are cached.
+ * @param statistics - the text, allocated with malloc. the tournament takes ownership of it.
+ * @param length - the length of the text.
+ *
+ * @return
+ *      none
+ */
+void tournamentSetStatistics(Tournament tournament, char* statistics, int length);
+
+/**
+ * tournamentCacheCreate: creates a cache of spilled tournaments. the games and players of spilled tournaments
+ *                        are kept in a spill file, and only the given number of the most recently used are
+ *                        kept in memory as well.
+ *
+ * @param path - the path of the spill file, which is created, replacing any file in it.
+ * @param capacity - the number of spilled tournaments kept in memory. values below 1 are handled as 1.
+ *
+ * @return
+ *      NULL if the spill file couldn't be created or an allocation failed.
+ *      a new cache otherwise.
+ */
+TournamentCache tournamentCacheCreate(const char *path, int capacity);
+
+/**
+ * tournamentCacheDestroy: deallocates a cache, and removes its spill file. the tournaments spilled to the cache
+ *                         must be destroyed before it.
+ *
+ * @param cache - the cache. if cache is NULL nothing will be done.
+ *
+ * @return
+ *      none
+ */
+void tournamentCacheDestroy(TournamentCache cache);
+
+/**
+ * tournamentCacheSetCapacity: sets the number of spilled tournaments kept in memory, and evicts the least
+ *                             recently used tournaments beyond it.
+ *
+ * @param cache - the cache.
+ * @param capacity - the number of spilled tournaments kept in memory. values below 1 are handled as 1.
+ *
+ * @return
+ *      none
+ */
+void tournamentCacheSetCapacity(TournamentCache cache, int capacity);
+
+/**
+ * tournamentCacheGetEvicted: gets the number of games and tournament players which are currently kept only in
+ *                            the spill file.
+ *
+ * @param cache - the cache. NULL is handled as an empty cache.
+ * @param number_of_games - output for the number of evicted games.
+ * @param number_of_players - output for the number of evicted tournament players.
+ *
+ * @return
+ *      none
+ */
+void tournamentCacheGetEvicted(TournamentCache cache, int *number_of_games, int *number_of_players);
+
+/**
+ * tournamentSpill: writes the games and players of a tournament to the spill file of a cache, and evicts them
+ *                  from memory. only the tournament's summary - its winner, location, statistics and counts -
+ *                  stays in memory, and its games and players are read back when its maps are requested.
+ *                  the tournament is expected to be ended, so they rarely are.
+ *
+ * @param tournament - the tournament to spill.
+ * @param cache - the cache to spill the tournament to.
+ *
+ * @return
+ *      false if a parameter is NULL, the tournament is spilled to another cache, or writing failed - in which
+ *            case the tournament is left as it was.
+ *      true if the tournament is spilled.
+ */
+bool tournamentSpill(Tournament tournament, TournamentCache cache);
+
+/**
+ * tournamentIsEvicted: checks if the games and players of a spilled tournament are currently not in memory.
+ *
+ * @param tournament - the tournament.
+ *
+ * @return
+ *      true if the tournament is spilled and evicted.
+ *      false otherwise, or if tournament is NULL.
+ */
+bool tournamentIsEvicted(Tournament tournament);
+
 #endif /* TOURNAMENT_H_ */
\ No newline at end of file